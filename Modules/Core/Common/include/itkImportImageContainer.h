@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkPixelBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -160,6 +161,16 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
   /** @ITKEndGrouping */
+
+  /** Set/Get the allocator of the buffers allocated by this container. When
+   * it is not set, the global default allocator is used, and when neither is
+   * set, buffers are allocated with new[]. A buffer is released through the
+   * allocator it was allocated with.
+   * \sa PixelBufferAllocator::SetGlobalDefaultAllocator */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(Allocator, PixelBufferAllocator);
+  itkGetModifiableObjectMacro(Allocator, PixelBufferAllocator);
+  /** @ITKEndGrouping */
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -211,6 +222,16 @@ private:
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  PixelBufferAllocator::Pointer m_Allocator{};
+
+  /** Allocator of m_ImportPointer, or nullptr when it was allocated with
+   * new[] or imported. */
+  PixelBufferAllocator::Pointer m_BufferAllocator{};
+
+  /** Allocator of the buffer returned by the last AllocateElements(), until
+   * the container takes the buffer over. */
+  mutable PixelBufferAllocator::Pointer m_AllocatedElementsAllocator{};
 };
 } // end namespace itk
 
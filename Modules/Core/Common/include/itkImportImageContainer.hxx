@@ -29,6 +29,7 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <memory>    // For uninitialized_value_construct_n and destroy_n.
 
 namespace itk
 {
@@ -53,6 +54,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
+      m_AllocatedElementsAllocator = nullptr;
       TElement * temp = this->AllocateElements(size, UseValueInitialization);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
@@ -60,6 +62,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocator = std::move(m_AllocatedElementsAllocator);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -73,7 +76,9 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
+    m_AllocatedElementsAllocator = nullptr;
     m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    m_BufferAllocator = std::move(m_AllocatedElementsAllocator);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -94,12 +99,14 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
     if (m_Size < m_Capacity)
     {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      m_AllocatedElementsAllocator = nullptr;
+      TElement * temp = this->AllocateElements(size, false);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocator = std::move(m_AllocatedElementsAllocator);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -155,6 +162,32 @@ TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
                                                                      bool              UseValueInitialization) const
 {
+  const PixelBufferAllocator::Pointer allocator =
+    m_Allocator ? m_Allocator : PixelBufferAllocator::GetGlobalDefaultAllocator();
+  if (allocator)
+  {
+    const auto numberOfBytes = static_cast<SizeValueType>(size) * sizeof(TElement);
+    auto *     data = static_cast<TElement *>(allocator->Allocate(numberOfBytes, alignof(TElement)));
+    try
+    {
+      if (UseValueInitialization)
+      {
+        std::uninitialized_value_construct_n(data, size);
+      }
+      else
+      {
+        std::uninitialized_default_construct_n(data, size);
+      }
+    }
+    catch (...)
+    {
+      allocator->Deallocate(data, numberOfBytes, alignof(TElement));
+      throw;
+    }
+    m_AllocatedElementsAllocator = allocator;
+    return data;
+  }
+
   TElement * data = nullptr;
 
   try
@@ -188,8 +221,18 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_BufferAllocator)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      m_BufferAllocator->Deallocate(
+        m_ImportPointer, static_cast<SizeValueType>(m_Capacity) * sizeof(TElement), alignof(TElement));
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_BufferAllocator = nullptr;
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -205,6 +248,7 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  itkPrintSelfObjectMacro(Allocator);
 }
 } // end namespace itk
 
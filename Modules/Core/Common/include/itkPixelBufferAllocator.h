@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPixelBufferAllocator_h
+#define itkPixelBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+#include <atomic>
+
+namespace itk
+{
+struct PixelBufferAllocatorGlobals;
+
+/** \class PixelBufferAllocator
+ * \brief Base class of the allocators of image pixel buffers.
+ *
+ * ImportImageContainer allocates its buffer through the allocator set on
+ * the container, or else through the global default allocator, or, when
+ * neither is set, with new[]. The allocator provides raw memory; the
+ * container constructs and destroys the elements.
+ *
+ * Allocate() and Deallocate() keep statistics of the buffers handed out:
+ * the bytes currently allocated, their peak, and how many allocations
+ * were served by reusing memory. Subclasses implement AllocateBuffer() and
+ * DeallocateBuffer(), which may be called concurrently.
+ *
+ * \sa PoolPixelBufferAllocator
+ * \sa ImportImageContainer::SetAllocator
+ * \ingroup ITKSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PixelBufferAllocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PixelBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = PixelBufferAllocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PixelBufferAllocator);
+
+  /** Return a buffer of numberOfBytes, aligned to alignment, which must be
+   * a power of two. Throws a MemoryAllocationError on failure. */
+  void *
+  Allocate(SizeValueType numberOfBytes, SizeValueType alignment);
+
+  /** Release a buffer returned by Allocate() with the same size and
+   * alignment. */
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes, SizeValueType alignment);
+
+  /** Number of bytes allocated and not yet deallocated. */
+  SizeValueType
+  GetBytesLive() const
+  {
+    return m_BytesLive;
+  }
+
+  /** Largest value of GetBytesLive() since construction or the last
+   * ResetStatistics(). */
+  SizeValueType
+  GetPeakBytesLive() const
+  {
+    return m_PeakBytesLive;
+  }
+
+  /** Number of calls to Allocate() since construction or the last
+   * ResetStatistics(). */
+  SizeValueType
+  GetNumberOfAllocations() const
+  {
+    return m_NumberOfAllocations;
+  }
+
+  /** Number of those allocations served by reusing memory. */
+  SizeValueType
+  GetNumberOfReusedAllocations() const
+  {
+    return m_NumberOfReusedAllocations;
+  }
+
+  /** Fraction of the allocations served by reusing memory. */
+  double
+  GetReuseRate() const;
+
+  /** Reset the allocation counts, and the peak to the bytes currently
+   * live. */
+  void
+  ResetStatistics();
+
+  /** Set/Get the allocator used by image pixel containers which have no
+   * allocator of their own. The default, nullptr, allocates with new[].
+   *
+   * The pixel containers read the default without taking a lock. For that,
+   * an allocator which has been set as the default is kept alive until the
+   * end of the program, even after another one replaces it. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultAllocator(PixelBufferAllocator * allocator);
+  static Pointer
+  GetGlobalDefaultAllocator();
+  /** @ITKEndGrouping */
+
+protected:
+  PixelBufferAllocator() = default;
+  ~PixelBufferAllocator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Return a buffer of numberOfBytes aligned to alignment, or nullptr on
+   * failure. Set reused when the memory was not newly obtained from the
+   * system. */
+  virtual void *
+  AllocateBuffer(SizeValueType numberOfBytes, SizeValueType alignment, bool & reused) = 0;
+
+  /** Release a buffer returned by AllocateBuffer(). */
+  virtual void
+  DeallocateBuffer(void * buffer, SizeValueType numberOfBytes, SizeValueType alignment) = 0;
+
+private:
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(PixelBufferAllocatorGlobals, PimplGlobals);
+
+  static PixelBufferAllocatorGlobals * m_PimplGlobals;
+
+  std::atomic<SizeValueType> m_BytesLive{ 0 };
+  std::atomic<SizeValueType> m_PeakBytesLive{ 0 };
+  std::atomic<SizeValueType> m_NumberOfAllocations{ 0 };
+  std::atomic<SizeValueType> m_NumberOfReusedAllocations{ 0 };
+};
+} // end namespace itk
+
+#endif // itkPixelBufferAllocator_h
@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPoolPixelBufferAllocator_h
+#define itkPoolPixelBufferAllocator_h
+
+#include "itkPixelBufferAllocator.h"
+#include "itkObjectFactory.h"
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class PoolPixelBufferAllocator
+ * \brief Pixel buffer allocator which keeps released buffers for reuse.
+ *
+ * Requests are rounded up to size classes, four per power of two, so that
+ * at most a quarter of a buffer is unused. A released buffer is kept in the
+ * pool of its size class and alignment, and handed out again by a later
+ * request of the same class, until the pooled bytes would exceed
+ * MaximumPooledBytes. Pipelines which repeatedly allocate images of the
+ * same sizes thus stop returning memory to the system and faulting fresh
+ * pages in.
+ *
+ * Buffers are aligned to at least Alignment bytes. With UseHugePages,
+ * buffers of 2 MiB or more are aligned to 2 MiB and, on Linux, advised to
+ * be backed by transparent huge pages.
+ *
+ * \code
+ *   auto allocator = itk::PoolPixelBufferAllocator::New();
+ *   itk::PixelBufferAllocator::SetGlobalDefaultAllocator(allocator);
+ * \endcode
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PoolPixelBufferAllocator : public PixelBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PoolPixelBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = PoolPixelBufferAllocator;
+  using Superclass = PixelBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PoolPixelBufferAllocator);
+
+  /** Set/Get the minimum alignment of the buffers, a power of two. The
+   * default, 64, is the size of a cache line. It cannot change while
+   * buffers are allocated. */
+  /** @ITKStartGrouping */
+  void
+  SetAlignment(SizeValueType alignment);
+  itkGetConstMacro(Alignment, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether large buffers use huge pages. Default is off. It
+   * cannot change while buffers are allocated. */
+  /** @ITKStartGrouping */
+  void
+  SetUseHugePages(bool useHugePages);
+  itkGetConstMacro(UseHugePages, bool);
+  itkBooleanMacro(UseHugePages);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of bytes kept in the pools. Buffers released
+   * beyond it are returned to the system. Default is 1 GiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MaximumPooledBytes, SizeValueType);
+  itkGetConstMacro(MaximumPooledBytes, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Number of bytes currently kept in the pools. */
+  SizeValueType
+  GetPooledBytes() const;
+
+  /** Return all pooled buffers to the system. */
+  void
+  ReleasePooledBuffers();
+
+  /** Size class of a request of numberOfBytes. */
+  static SizeValueType
+  GetSizeClass(SizeValueType numberOfBytes);
+
+protected:
+  PoolPixelBufferAllocator() = default;
+  ~PoolPixelBufferAllocator() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void *
+  AllocateBuffer(SizeValueType numberOfBytes, SizeValueType alignment, bool & reused) override;
+
+  void
+  DeallocateBuffer(void * buffer, SizeValueType numberOfBytes, SizeValueType alignment) override;
+
+private:
+  /** Size class and alignment of the buffers of a pool. */
+  using PoolKeyType = std::pair<SizeValueType, SizeValueType>;
+
+  PoolKeyType
+  GetPoolKey(SizeValueType numberOfBytes, SizeValueType alignment) const;
+
+  void
+  ReleaseForLayoutChange();
+
+  SizeValueType m_Alignment{ 64 };
+  bool          m_UseHugePages{ false };
+  SizeValueType m_MaximumPooledBytes{ SizeValueType{ 1 } << 30 };
+
+  mutable std::mutex                           m_Mutex;
+  std::map<PoolKeyType, std::vector<void *>> m_Pools;
+  SizeValueType                                m_PooledBytes{ 0 };
+};
+} // end namespace itk
+
+#endif // itkPoolPixelBufferAllocator_h
@@ -21,9 +21,11 @@
 #include "itkConfigure.h"
 #include "itkIntTypes.h"
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <condition_variable>
 #include <thread>
 
@@ -43,6 +45,17 @@ namespace itk
  * Initially the thread pool is started with GlobalDefaultNumberOfThreads.
  * The jobs are submitted via AddWork method.
  *
+ * Each thread of the pool has its own queue of jobs. Jobs submitted by a
+ * thread of the pool go to its own queue, which it runs last-in first-out,
+ * and other jobs are spread over the queues. An idle thread steals the
+ * oldest job of another queue. A thread waiting for the result of jobs
+ * should call RunPendingJob() meanwhile, so that jobs submitted from within
+ * jobs (nested parallelism) run without adding threads, and cannot wait
+ * for threads which are all waiting themselves. Jobs may be submitted as
+ * part of a group, and a waiting thread then only runs jobs of the group
+ * it waits for: running an unrelated job could re-enter a lock that the
+ * waiting thread holds.
+ *
  * This implementation heavily borrows from:
  * https://github.com/progschj/ThreadPool
  *
@@ -92,14 +105,36 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
       [function, arguments...]() -> return_type { return function(arguments...); });
 
     std::future<return_type> res = task->get_future();
-    {
-      const std::lock_guard<std::mutex> lockGuard(this->GetMutex());
-      m_WorkQueue.emplace_back([task]() { (*task)(); });
-    }
-    m_Condition.notify_one();
+    this->AddJob([task]() { (*task)(); });
     return res;
   }
 
+  /** Add this job to the thread pool queue, as part of the given group of
+   * jobs. The group is any address which identifies the jobs, e.g. one on
+   * the stack of the submitting thread, and RunPendingJob(group) only runs
+   * jobs of that group. */
+  template <class Function, class... Arguments>
+  auto
+  AddWorkToGroup(const void * group, Function && function, Arguments &&... arguments)
+    -> std::future<std::invoke_result_t<Function, Arguments...>>
+  {
+    using return_type = std::invoke_result_t<Function, Arguments...>;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+      [function, arguments...]() -> return_type { return function(arguments...); });
+
+    std::future<return_type> res = task->get_future();
+    this->AddJob([task]() { (*task)(); }, group);
+    return res;
+  }
+
+  /** Run one job waiting in the queues, if any. Returns whether a job was
+   * run. Threads waiting for the jobs they submitted call this to help
+   * instead of blocking, passing the group of those jobs so that they only
+   * run jobs of it. Without a group, any job may be run. */
+  bool
+  RunPendingJob(const void * group = nullptr);
+
   /** Can call this method if we want to add extra threads to the pool. */
   void
   AddThreads(ThreadIdType count);
@@ -126,7 +161,7 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
   SetDoNotWaitForThreads(bool doNotWaitForThreads);
   /** @ITKEndGrouping */
 protected:
-  /** We need access to the mutex in AddWork, and the variable is only
+  /** We need access to the mutex in inline methods, and the variable is only
    * visible in the .cxx file, so this method returns it. */
   std::mutex &
   GetMutex() const;
@@ -137,24 +172,41 @@ protected:
   void
   CleanUp();
 
-  ~ThreadPool() override { this->CleanUp(); }
+  ~ThreadPool() override;
 
   static void
   PrepareForFork();
   static void
   ResumeFromFork();
 
+  /** Add a job to the queue of the calling thread of the pool, or else to
+   * the next queue. */
+  void
+  AddJob(std::function<void()> && job, const void * group = nullptr);
+
 private:
+  struct WorkQueue;
+
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(ThreadPoolGlobals, PimplGlobals);
 
-  /** This is a list of jobs submitted to the thread pool.
-   * This is the only place where the jobs are submitted.
-   * Filled by AddWork, emptied by ThreadExecute. */
-  std::deque<std::function<void()>> m_WorkQueue; // guarded by m_PimplGlobals->m_Mutex
+  /** The job queues, one per thread of the pool, each guarded by its own
+   * mutex. Filled by AddJob, emptied by RunPendingJob. Only the first
+   * m_NumberOfWorkQueues are in use. */
+  std::unique_ptr<WorkQueue[]> m_WorkQueues;
+  std::atomic<ThreadIdType>    m_NumberOfWorkQueues{ 0 };
+
+  /** Queue which receives the next job submitted from outside the pool. */
+  std::atomic<ThreadIdType> m_NextWorkQueue{ 0 };
+
+  /** Number of jobs waiting in the queues. */
+  std::atomic<SizeValueType> m_NumberOfPendingJobs{ 0 };
+
+  /** Number of threads waiting on m_Condition. */
+  std::atomic<ThreadIdType> m_NumberOfSleepingThreads{ 0 }; // modified under m_PimplGlobals->m_Mutex
 
   /** When a thread is idle, it is waiting on m_Condition.
-   * AddWork signals it to resume a (random) thread. */
+   * AddJob signals it to resume a (random) thread. */
   std::condition_variable m_Condition;
 
   /** Vector to hold all thread handles.
@@ -167,9 +219,14 @@ private:
   /** To lock on the internal variables */
   static ThreadPoolGlobals * m_PimplGlobals;
 
+  /** Pop a job, first from the queue of the given thread, then from the
+   * other queues. With a group, only a job of that group is popped. */
+  bool
+  PopJob(ThreadIdType threadIndex, const void * group, std::function<void()> & job);
+
   /** The continuously running thread function */
   static void
-  ThreadExecute();
+  ThreadExecute(ThreadIdType threadIndex);
 };
 
 } // namespace itk
@@ -62,8 +62,14 @@ VectorImage<TPixel, VImageDimension>::Initialize()
 
   // Replace the handle to the buffer. This is the safest thing to do,
   // since the same container can be shared by multiple images (e.g.
-  // Grafted outputs and in place filters).
-  m_Buffer = PixelContainer::New();
+  // Grafted outputs and in place filters). The allocator of the
+  // buffer is kept.
+  const PixelContainerPointer buffer = PixelContainer::New();
+  if (m_Buffer)
+  {
+    buffer->SetAllocator(m_Buffer->GetModifiableAllocator());
+  }
+  m_Buffer = buffer;
 }
 
 template <typename TPixel, unsigned int VImageDimension>
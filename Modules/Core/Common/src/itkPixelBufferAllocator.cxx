@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPixelBufferAllocator.h"
+#include "itkSingleton.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+struct PixelBufferAllocatorGlobals
+{
+  PixelBufferAllocatorGlobals() = default;
+
+  std::mutex                          m_Mutex;
+  std::atomic<PixelBufferAllocator *> m_GlobalDefaultAllocator{ nullptr };
+  // every allocator set as the global default, kept alive so that the
+  // default can be read without a lock
+  std::vector<PixelBufferAllocator::Pointer> m_GlobalDefaultAllocators;
+};
+
+itkGetGlobalSimpleMacro(PixelBufferAllocator, PixelBufferAllocatorGlobals, PimplGlobals);
+
+PixelBufferAllocatorGlobals * PixelBufferAllocator::m_PimplGlobals;
+
+void
+PixelBufferAllocator::SetGlobalDefaultAllocator(PixelBufferAllocator * allocator)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+
+  auto & allocators = m_PimplGlobals->m_GlobalDefaultAllocators;
+  if (allocator && std::find(allocators.begin(), allocators.end(), allocator) == allocators.end())
+  {
+    allocators.emplace_back(allocator);
+  }
+  m_PimplGlobals->m_GlobalDefaultAllocator.store(allocator, std::memory_order_release);
+}
+
+PixelBufferAllocator::Pointer
+PixelBufferAllocator::GetGlobalDefaultAllocator()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  // called for every allocation of a pixel container: no lock
+  return m_PimplGlobals->m_GlobalDefaultAllocator.load(std::memory_order_acquire);
+}
+
+void *
+PixelBufferAllocator::Allocate(SizeValueType numberOfBytes, SizeValueType alignment)
+{
+  bool   reused = false;
+  void * buffer = this->AllocateBuffer(numberOfBytes, alignment, reused);
+  if (buffer == nullptr)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+
+  ++m_NumberOfAllocations;
+  if (reused)
+  {
+    ++m_NumberOfReusedAllocations;
+  }
+  const SizeValueType bytesLive = (m_BytesLive += numberOfBytes);
+  SizeValueType       peak = m_PeakBytesLive;
+  while (bytesLive > peak && !m_PeakBytesLive.compare_exchange_weak(peak, bytesLive))
+  {
+  }
+  return buffer;
+}
+
+void
+PixelBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes, SizeValueType alignment)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  m_BytesLive -= numberOfBytes;
+  this->DeallocateBuffer(buffer, numberOfBytes, alignment);
+}
+
+double
+PixelBufferAllocator::GetReuseRate() const
+{
+  const SizeValueType numberOfAllocations = m_NumberOfAllocations;
+  return numberOfAllocations == 0 ? 0.0
+                                  : static_cast<double>(m_NumberOfReusedAllocations) / numberOfAllocations;
+}
+
+void
+PixelBufferAllocator::ResetStatistics()
+{
+  m_NumberOfAllocations = 0;
+  m_NumberOfReusedAllocations = 0;
+  m_PeakBytesLive = m_BytesLive.load();
+}
+
+void
+PixelBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BytesLive: " << m_BytesLive << std::endl;
+  os << indent << "PeakBytesLive: " << m_PeakBytesLive << std::endl;
+  os << indent << "NumberOfAllocations: " << m_NumberOfAllocations << std::endl;
+  os << indent << "NumberOfReusedAllocations: " << m_NumberOfReusedAllocations << std::endl;
+}
+} // end namespace itk
@@ -74,6 +74,23 @@ public:
 private:
   std::exception_ptr m_FirstCaughtException;
 };
+
+// Wait for the job of a future, running pending jobs of its group meanwhile,
+// so that jobs submitted from within jobs cannot wait for each other. Jobs
+// of other groups are not run, as they could need a lock held by the caller.
+template <typename TFuture>
+void
+WaitForJob(ThreadPool & threadPool, const void * group, TFuture & future, ProcessObject * filter)
+{
+  while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    if (!threadPool.RunPendingJob(group) &&
+        future.wait_for(threadCompletionPollingInterval) == std::future_status::timeout && filter)
+    {
+      filter->IncrementProgress(0);
+    }
+  }
+}
 } // namespace
 
 
@@ -128,11 +145,14 @@ PoolMultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfWorkUnits = std::min(this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
 
+  // identifies the jobs of this call
+  const char group{};
   for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
   {
     m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
     m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
-    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork(m_SingleMethod, &m_ThreadInfoArray[threadLoop]);
+    m_ThreadInfoArray[threadLoop].Future =
+      m_ThreadPool->AddWorkToGroup(&group, m_SingleMethod, &m_ThreadInfoArray[threadLoop]);
   }
 
   // Now, the parent thread calls this->SingleMethod() itself
@@ -145,7 +165,10 @@ PoolMultiThreader::SingleMethodExecute()
   // so now it waits for each of the other work units to finish
   for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
   {
-    exceptionHandler.TryAndCatch([this, threadLoop] { m_ThreadInfoArray[threadLoop].Future.get(); });
+    exceptionHandler.TryAndCatch([this, threadLoop, &group] {
+      WaitForJob(*m_ThreadPool, &group, m_ThreadInfoArray[threadLoop].Future, nullptr);
+      m_ThreadInfoArray[threadLoop].Future.get();
+    });
   }
 
   exceptionHandler.RethrowFirstCaughtException();
@@ -179,10 +202,13 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
       return ITK_THREAD_RETURN_DEFAULT_VALUE;
     };
 
+    // identifies the jobs of this call
+    const char    group{};
     SizeValueType workUnit = 1;
     for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
     {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(lambda, i, std::min(i + chunkSize, lastIndexPlus1));
+      m_ThreadInfoArray[workUnit++].Future =
+        m_ThreadPool->AddWorkToGroup(&group, lambda, i, std::min(i + chunkSize, lastIndexPlus1));
     }
     itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
 
@@ -198,16 +224,9 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
     // now wait for the other computations to finish
     for (SizeValueType i = 1; i < workUnit; ++i)
     {
-      exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-        std::future_status status;
-        do
-        {
-          status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter && status == std::future_status::timeout)
-          {
-            filter->IncrementProgress(0);
-          }
-        } while (status != std::future_status::ready);
+      exceptionHandler.TryAndCatch([this, i, &group, &reporter, &filter] {
+        WaitForJob(*m_ThreadPool, &group, m_ThreadInfoArray[i].Future, filter);
+        m_ThreadInfoArray[i].Future.get();
         reporter.CompletedPixel();
       });
     }
@@ -259,13 +278,15 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
       itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
       ImageIORegion iRegion;
       ThreadIdType  total = 0;
+      // identifies the jobs of this call
+      const char group{};
       for (ThreadIdType i = 1; i < splitCount; ++i)
       {
         iRegion = region;
         total = splitter->GetSplit(i, splitCount, iRegion);
         if (i < total)
         {
-          m_ThreadInfoArray[i].Future = m_ThreadPool->AddWork([funcP, iRegion]() {
+          m_ThreadInfoArray[i].Future = m_ThreadPool->AddWorkToGroup(&group, [funcP, iRegion]() {
             funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
             // make this lambda have the same signature as m_SingleMethod
             return ITK_THREAD_RETURN_DEFAULT_VALUE;
@@ -290,16 +311,8 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
       // now wait for the other computations to finish
       for (ThreadIdType i = 1; i < splitCount; ++i)
       {
-        exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-          std::future_status status;
-          do
-          {
-            status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-            if (filter && status == std::future_status::timeout)
-            {
-              filter->IncrementProgress(0);
-            }
-          } while (status != std::future_status::ready);
+        exceptionHandler.TryAndCatch([this, i, &group, &reporter, &filter] {
+          WaitForJob(*m_ThreadPool, &group, m_ThreadInfoArray[i].Future, filter);
           m_ThreadInfoArray[i].Future.get();
           reporter.CompletedPixel();
         });
@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPoolPixelBufferAllocator.h"
+#include <algorithm>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+constexpr SizeValueType HugePageSize = SizeValueType{ 1 } << 21;
+
+void *
+AlignedNew(SizeValueType numberOfBytes, SizeValueType alignment)
+{
+  return ::operator new(static_cast<size_t>(numberOfBytes), std::align_val_t(alignment), std::nothrow);
+}
+
+void
+AlignedDelete(void * buffer, SizeValueType alignment)
+{
+  ::operator delete(buffer, std::align_val_t(alignment));
+}
+} // namespace
+
+PoolPixelBufferAllocator::~PoolPixelBufferAllocator()
+{
+  this->ReleasePooledBuffers();
+}
+
+void
+PoolPixelBufferAllocator::SetAlignment(SizeValueType alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+  {
+    itkExceptionMacro("Alignment " << alignment << " is not a power of two.");
+  }
+  if (alignment != m_Alignment)
+  {
+    this->ReleaseForLayoutChange();
+    m_Alignment = alignment;
+    this->Modified();
+  }
+}
+
+void
+PoolPixelBufferAllocator::SetUseHugePages(bool useHugePages)
+{
+  if (useHugePages != m_UseHugePages)
+  {
+    this->ReleaseForLayoutChange();
+    m_UseHugePages = useHugePages;
+    this->Modified();
+  }
+}
+
+void
+PoolPixelBufferAllocator::ReleaseForLayoutChange()
+{
+  // buffers are released with the alignment they were allocated with
+  if (this->GetBytesLive() > 0)
+  {
+    itkExceptionMacro("The alignment of the buffers cannot change while buffers are allocated.");
+  }
+  this->ReleasePooledBuffers();
+}
+
+SizeValueType
+PoolPixelBufferAllocator::GetSizeClass(SizeValueType numberOfBytes)
+{
+  constexpr SizeValueType minimumSizeClass = 64;
+  if (numberOfBytes <= minimumSizeClass)
+  {
+    return minimumSizeClass;
+  }
+  // largest power of two below numberOfBytes, split in four steps
+  SizeValueType base = minimumSizeClass;
+  while (2 * base < numberOfBytes)
+  {
+    base <<= 1;
+  }
+  const SizeValueType step = base / 4;
+  return base + (numberOfBytes - base + step - 1) / step * step;
+}
+
+PoolPixelBufferAllocator::PoolKeyType
+PoolPixelBufferAllocator::GetPoolKey(SizeValueType numberOfBytes, SizeValueType alignment) const
+{
+  const SizeValueType sizeClass = GetSizeClass(numberOfBytes);
+  alignment = std::max(alignment, m_Alignment);
+  if (m_UseHugePages && sizeClass >= HugePageSize)
+  {
+    alignment = std::max(alignment, HugePageSize);
+  }
+  return { sizeClass, alignment };
+}
+
+void *
+PoolPixelBufferAllocator::AllocateBuffer(SizeValueType numberOfBytes, SizeValueType alignment, bool & reused)
+{
+  const PoolKeyType key = this->GetPoolKey(numberOfBytes, alignment);
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    const auto                        pool = m_Pools.find(key);
+    if (pool != m_Pools.end() && !pool->second.empty())
+    {
+      void * buffer = pool->second.back();
+      pool->second.pop_back();
+      m_PooledBytes -= key.first;
+      reused = true;
+      return buffer;
+    }
+  }
+
+  void * buffer = AlignedNew(key.first, key.second);
+  if (buffer == nullptr)
+  {
+    // memory held by the pools may satisfy the request
+    this->ReleasePooledBuffers();
+    buffer = AlignedNew(key.first, key.second);
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (buffer != nullptr && key.second >= HugePageSize)
+  {
+    madvise(buffer, static_cast<size_t>(key.first), MADV_HUGEPAGE);
+  }
+#endif
+  reused = false;
+  return buffer;
+}
+
+void
+PoolPixelBufferAllocator::DeallocateBuffer(void * buffer, SizeValueType numberOfBytes, SizeValueType alignment)
+{
+  const PoolKeyType key = this->GetPoolKey(numberOfBytes, alignment);
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_PooledBytes + key.first <= m_MaximumPooledBytes)
+    {
+      m_Pools[key].push_back(buffer);
+      m_PooledBytes += key.first;
+      return;
+    }
+  }
+  AlignedDelete(buffer, key.second);
+}
+
+SizeValueType
+PoolPixelBufferAllocator::GetPooledBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_PooledBytes;
+}
+
+void
+PoolPixelBufferAllocator::ReleasePooledBuffers()
+{
+  std::map<PoolKeyType, std::vector<void *>> pools;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    pools.swap(m_Pools);
+    m_PooledBytes = 0;
+  }
+  for (const auto & pool : pools)
+  {
+    for (void * buffer : pool.second)
+    {
+      AlignedDelete(buffer, pool.first.second);
+    }
+  }
+}
+
+void
+PoolPixelBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+  itkPrintSelfBooleanMacro(UseHugePages);
+  os << indent << "MaximumPooledBytes: " << m_MaximumPooledBytes << std::endl;
+  os << indent << "PooledBytes: " << this->GetPooledBytes() << std::endl;
+}
+} // end namespace itk
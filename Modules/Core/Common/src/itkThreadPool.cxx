@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <iterator>
+#include <limits>
 #include <mutex>
 
 
@@ -61,6 +63,26 @@ struct ThreadPoolGlobals
 
 itkGetGlobalSimpleMacro(ThreadPool, ThreadPoolGlobals, PimplGlobals);
 
+struct ThreadPool::WorkQueue
+{
+  struct Job
+  {
+    std::function<void()> m_Function;
+    const void *          m_Group;
+  };
+
+  std::mutex      m_Mutex;
+  std::deque<Job> m_Jobs; // guarded by m_Mutex
+};
+
+namespace
+{
+constexpr ThreadIdType NotAPoolThread = std::numeric_limits<ThreadIdType>::max();
+
+// Index of the calling thread in the pool.
+thread_local ThreadIdType t_ThreadIndex = NotAPoolThread;
+} // namespace
+
 ThreadPool::Pointer
 ThreadPool::New()
 {
@@ -111,25 +133,117 @@ ThreadPool::ThreadPool()
 
   m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
   m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
-  const ThreadIdType threadCount = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
-  m_Threads.reserve(threadCount);
-  for (ThreadIdType i = 0; i < threadCount; ++i)
-  {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
-  }
+
+  // the queues are allocated once, as idle threads may steal at any time
+  m_WorkQueues = std::make_unique<WorkQueue[]>(ITK_MAX_THREADS);
+  this->AddThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+ThreadPool::~ThreadPool()
+{
+  this->CleanUp();
 }
 
 void
 ThreadPool::AddThreads(ThreadIdType count)
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
-  m_Threads.reserve(m_Threads.size() + count);
+  const auto threadCount = static_cast<ThreadIdType>(m_Threads.size());
+  // threads beyond ITK_MAX_THREADS do not have a queue of their own
+  m_NumberOfWorkQueues = std::max<ThreadIdType>(
+    m_NumberOfWorkQueues, std::min<ThreadIdType>(threadCount + count, ITK_MAX_THREADS));
+  m_Threads.reserve(threadCount + count);
   for (ThreadIdType i = 0; i < count; ++i)
   {
-    m_Threads.emplace_back(&ThreadPool::ThreadExecute);
+    m_Threads.emplace_back(&ThreadPool::ThreadExecute, threadCount + i);
+  }
+}
+
+void
+ThreadPool::AddJob(std::function<void()> && job, const void * group)
+{
+  const ThreadIdType numberOfWorkQueues = m_NumberOfWorkQueues;
+  ThreadIdType       queueIndex = t_ThreadIndex;
+  if (queueIndex >= numberOfWorkQueues)
+  {
+    queueIndex = m_NextWorkQueue++ % numberOfWorkQueues;
+  }
+  // counted before it is queued, so that the count never drops below the
+  // number of queued jobs when another thread pops it right away
+  ++m_NumberOfPendingJobs;
+  {
+    WorkQueue &                       queue = m_WorkQueues[queueIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    queue.m_Jobs.push_back({ std::move(job), group });
+  }
+
+  if (m_NumberOfSleepingThreads > 0)
+  {
+    // a thread going to sleep either sees the job, or waits already
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    }
+    m_Condition.notify_one();
   }
 }
 
+bool
+ThreadPool::PopJob(ThreadIdType threadIndex, const void * group, std::function<void()> & job)
+{
+  if (m_NumberOfPendingJobs == 0)
+  {
+    return false;
+  }
+  const ThreadIdType numberOfWorkQueues = m_NumberOfWorkQueues;
+  const auto         isInGroup = [group](const WorkQueue::Job & queued) {
+    return group == nullptr || queued.m_Group == group;
+  };
+
+  // newest job of the own queue, which is likely to be hot in the cache
+  if (threadIndex < numberOfWorkQueues)
+  {
+    WorkQueue &                       queue = m_WorkQueues[threadIndex];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    const auto                        found = std::find_if(queue.m_Jobs.rbegin(), queue.m_Jobs.rend(), isInGroup);
+    if (found != queue.m_Jobs.rend())
+    {
+      job = std::move(found->m_Function);
+      queue.m_Jobs.erase(std::next(found).base());
+      --m_NumberOfPendingJobs;
+      return true;
+    }
+  }
+
+  // oldest job of another queue, which is likely to be the largest
+  const ThreadIdType first = threadIndex < numberOfWorkQueues ? threadIndex + 1 : 0;
+  for (ThreadIdType i = 0; i < numberOfWorkQueues; ++i)
+  {
+    WorkQueue &                       queue = m_WorkQueues[(first + i) % numberOfWorkQueues];
+    const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+    const auto                        found = std::find_if(queue.m_Jobs.begin(), queue.m_Jobs.end(), isInGroup);
+    if (found != queue.m_Jobs.end())
+    {
+      job = std::move(found->m_Function);
+      queue.m_Jobs.erase(found);
+      --m_NumberOfPendingJobs;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+ThreadPool::RunPendingJob(const void * group)
+{
+  std::function<void()> job;
+  if (this->PopJob(t_ThreadIndex, group, job))
+  {
+    job();
+    return true;
+  }
+  return false;
+}
+
 std::mutex &
 ThreadPool::GetMutex() const
 {
@@ -140,7 +254,7 @@ int
 ThreadPool::GetNumberOfCurrentlyIdleThreads() const
 {
   const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
-  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_WorkQueue.size()); // lousy approximation
+  return static_cast<int>(m_Threads.size()) - static_cast<int>(m_NumberOfPendingJobs); // lousy approximation
 }
 
 void
@@ -187,28 +301,29 @@ ThreadPool::ResumeFromFork()
 }
 
 void
-ThreadPool::ThreadExecute()
+ThreadPool::ThreadExecute(ThreadIdType threadIndex)
 {
+  t_ThreadIndex = threadIndex;
+
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
 
   while (true)
   {
-    std::function<void()> task;
-
+    if (threadPool->RunPendingJob())
     {
-      std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
-      threadPool->m_Condition.wait(mutexHolder,
-                                   [threadPool] { return threadPool->m_Stopping || !threadPool->m_WorkQueue.empty(); });
-      if (threadPool->m_Stopping && threadPool->m_WorkQueue.empty())
-      {
-        return;
-      }
-      task = std::move(threadPool->m_WorkQueue.front());
-      threadPool->m_WorkQueue.pop_front();
+      continue;
     }
 
-    task(); // execute the task
+    std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
+    ++threadPool->m_NumberOfSleepingThreads;
+    threadPool->m_Condition.wait(
+      mutexHolder, [threadPool] { return threadPool->m_Stopping || threadPool->m_NumberOfPendingJobs > 0; });
+    --threadPool->m_NumberOfSleepingThreads;
+    if (threadPool->m_Stopping && threadPool->m_NumberOfPendingJobs == 0)
+    {
+      return;
+    }
   }
 }
 
@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPoolPixelBufferAllocator.h"
+
+#include "itkImage.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+
+TEST(PoolPixelBufferAllocator, SizeClasses)
+{
+  using itk::PoolPixelBufferAllocator;
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(0), 64u);
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(64), 64u);
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(65), 80u);
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(128), 128u);
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(1000), 1024u);
+  EXPECT_EQ(PoolPixelBufferAllocator::GetSizeClass(1025), 1280u);
+
+  for (itk::SizeValueType numberOfBytes = 1; numberOfBytes < 100000; numberOfBytes += 37)
+  {
+    const itk::SizeValueType sizeClass = PoolPixelBufferAllocator::GetSizeClass(numberOfBytes);
+    EXPECT_GE(sizeClass, numberOfBytes);
+    EXPECT_LE(sizeClass, std::max<itk::SizeValueType>(64, numberOfBytes + numberOfBytes / 4));
+  }
+}
+
+
+TEST(PoolPixelBufferAllocator, ReusesReleasedBuffers)
+{
+  const auto allocator = itk::PoolPixelBufferAllocator::New();
+
+  void * const buffer = allocator->Allocate(1000, 8);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % allocator->GetAlignment(), 0u);
+  EXPECT_EQ(allocator->GetBytesLive(), 1000u);
+  allocator->Deallocate(buffer, 1000, 8);
+  EXPECT_EQ(allocator->GetBytesLive(), 0u);
+  EXPECT_EQ(allocator->GetPooledBytes(), 1024u);
+
+  // same size class
+  void * const reused = allocator->Allocate(1010, 8);
+  EXPECT_EQ(reused, buffer);
+  EXPECT_EQ(allocator->GetPooledBytes(), 0u);
+  void * const other = allocator->Allocate(3000, 8);
+  EXPECT_NE(other, buffer);
+
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 3u);
+  EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 1u);
+  EXPECT_DOUBLE_EQ(allocator->GetReuseRate(), 1.0 / 3.0);
+  EXPECT_EQ(allocator->GetPeakBytesLive(), 4010u);
+
+  allocator->Deallocate(reused, 1010, 8);
+  allocator->Deallocate(other, 3000, 8);
+  allocator->ResetStatistics();
+  EXPECT_EQ(allocator->GetNumberOfAllocations(), 0u);
+  EXPECT_EQ(allocator->GetPeakBytesLive(), 0u);
+
+  allocator->SetMaximumPooledBytes(0);
+  allocator->ReleasePooledBuffers();
+  void * const unpooled = allocator->Allocate(1000, 8);
+  allocator->Deallocate(unpooled, 1000, 8);
+  EXPECT_EQ(allocator->GetPooledBytes(), 0u);
+}
+
+
+TEST(PoolPixelBufferAllocator, Alignment)
+{
+  const auto allocator = itk::PoolPixelBufferAllocator::New();
+  EXPECT_THROW(allocator->SetAlignment(48), itk::ExceptionObject);
+
+  allocator->SetAlignment(4096);
+  void * const buffer = allocator->Allocate(10, 1);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 4096, 0u);
+  EXPECT_THROW(allocator->SetAlignment(64), itk::ExceptionObject);
+  allocator->Deallocate(buffer, 10, 1);
+
+  allocator->UseHugePagesOn();
+  const itk::SizeValueType hugeSize = itk::SizeValueType{ 3 } << 20;
+  void * const hugeBuffer = allocator->Allocate(hugeSize, 8);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(hugeBuffer) % (itk::SizeValueType{ 1 } << 21), 0u);
+  allocator->Deallocate(hugeBuffer, hugeSize, 8);
+}
+
+
+TEST(PoolPixelBufferAllocator, AllocatesImageBuffers)
+{
+  using ImageType = itk::Image<float, 3>;
+  const auto allocator = itk::PoolPixelBufferAllocator::New();
+
+  const ImageType::SizeType size{ { 20, 10, 5 } };
+  const auto                numberOfBytes = static_cast<itk::SizeValueType>(20 * 10 * 5 * sizeof(float));
+  {
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->GetPixelContainer()->SetAllocator(allocator);
+    image->AllocateInitialized();
+    EXPECT_EQ(allocator->GetBytesLive(), numberOfBytes);
+    EXPECT_EQ(image->GetPixel({ { 19, 9, 4 } }), 0.0f);
+
+    // a released image keeps its allocator
+    image->Initialize();
+    EXPECT_EQ(allocator->GetBytesLive(), 0u);
+    EXPECT_EQ(image->GetPixelContainer()->GetAllocator(), allocator.GetPointer());
+    image->SetRegions(size);
+    image->Allocate();
+    EXPECT_EQ(allocator->GetNumberOfReusedAllocations(), 1u);
+  }
+  EXPECT_EQ(allocator->GetBytesLive(), 0u);
+
+  // global default
+  itk::PixelBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  EXPECT_EQ(itk::PixelBufferAllocator::GetGlobalDefaultAllocator(), allocator);
+  {
+    auto image = itk::Image<std::string, 2>::New();
+    image->SetRegions(itk::Size<2>{ { 4, 6 } });
+    image->Allocate();
+    image->GetBufferPointer()[23] = "not a short string, allocated on the heap";
+    EXPECT_EQ(allocator->GetBytesLive(), 24 * sizeof(std::string));
+
+    // growing the buffer copies the elements into a new buffer
+    image->GetPixelContainer()->Reserve(30);
+    EXPECT_EQ(image->GetBufferPointer()[23], "not a short string, allocated on the heap");
+    EXPECT_EQ(allocator->GetBytesLive(), 30 * sizeof(std::string));
+  }
+  itk::PixelBufferAllocator::SetGlobalDefaultAllocator(nullptr);
+  EXPECT_EQ(allocator->GetBytesLive(), 0u);
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  EXPECT_EQ(allocator->GetBytesLive(), 0u);
+}
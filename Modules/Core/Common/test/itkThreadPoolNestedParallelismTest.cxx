@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkTimeProbe.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Sum of sqrt(i) over the region, computed by nested parallel loops: an outer
+// loop over slices, each running an inner loop over its rows on another
+// multithreader, each of whose rows runs a region loop over its columns.
+double
+NestedSum(unsigned int numberOfWorkUnits, itk::SizeValueType size)
+{
+  auto outer = itk::PoolMultiThreader::New();
+  outer->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  std::vector<double> sliceSums(size);
+  outer->ParallelizeArray(
+    0,
+    size,
+    [numberOfWorkUnits, size, &sliceSums](itk::SizeValueType slice) {
+      auto inner = itk::PoolMultiThreader::New();
+      inner->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+      std::vector<double> rowSums(size);
+      inner->ParallelizeArray(
+        0,
+        size,
+        [numberOfWorkUnits, size, slice, &rowSums](itk::SizeValueType row) {
+          auto innermost = itk::PoolMultiThreader::New();
+          innermost->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+          std::atomic<double> sum{ 0.0 };
+          const itk::IndexValueType index[1] = { 0 };
+          const itk::SizeValueType  regionSize[1] = { size };
+          innermost->ParallelizeImageRegion(
+            1,
+            index,
+            regionSize,
+            [size, slice, row, &sum](const itk::IndexValueType * chunkIndex, const itk::SizeValueType * chunkSize) {
+              double chunkSum = 0.0;
+              for (itk::SizeValueType column = 0; column < chunkSize[0]; ++column)
+              {
+                const auto i = (slice * size + row) * size + static_cast<itk::SizeValueType>(chunkIndex[0]) + column;
+                chunkSum += std::sqrt(static_cast<double>(i));
+              }
+              double expected = sum.load();
+              while (!sum.compare_exchange_weak(expected, expected + chunkSum))
+              {
+              }
+            },
+            nullptr);
+          rowSums[row] = sum;
+        },
+        nullptr);
+
+      for (const double rowSum : rowSums)
+      {
+        sliceSums[slice] += rowSum;
+      }
+    },
+    nullptr);
+
+  double sum = 0.0;
+  for (const double sliceSum : sliceSums)
+  {
+    sum += sliceSum;
+  }
+  return sum;
+}
+} // namespace
+
+// Checks that nested parallel loops on the thread pool complete with the
+// right result, including when there are more work units than threads, and
+// reports the time taken for each number of threads up to the given maximum.
+// The thread pool of the process only grows, so this is an executable of its
+// own rather than a test of a test driver shared with other tests.
+int
+main(int argc, char * argv[])
+{
+  const unsigned int maximumNumberOfThreads = argc > 1 ? static_cast<unsigned int>(std::stoi(argv[1]))
+                                                       : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const itk::SizeValueType size = argc > 2 ? std::stoul(argv[2]) : 32;
+
+  double expected = 0.0;
+  for (itk::SizeValueType i = 0; i < size * size * size; ++i)
+  {
+    expected += std::sqrt(static_cast<double>(i));
+  }
+
+  int result = EXIT_SUCCESS;
+  std::cout << "Threads  Time (s)" << std::endl;
+  for (unsigned int numberOfThreads = 1; numberOfThreads <= maximumNumberOfThreads; numberOfThreads *= 2)
+  {
+    // the pool can only grow
+    auto threader = itk::PoolMultiThreader::New();
+    threader->SetMaximumNumberOfThreads(numberOfThreads);
+
+    itk::TimeProbe probe;
+    probe.Start();
+    const double sum = NestedSum(numberOfThreads, size);
+    probe.Stop();
+    std::cout << std::setw(7) << numberOfThreads << "  " << probe.GetTotal() << std::endl;
+
+    if (std::abs(sum - expected) > 1e-9 * expected)
+    {
+      std::cerr << "Sum with " << numberOfThreads << " threads is " << sum << ", expected " << expected << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // more work units than threads
+  if (std::abs(NestedSum(4 * maximumNumberOfThreads, size) - expected) > 1e-9 * expected)
+  {
+    std::cerr << "Sum with " << 4 * maximumNumberOfThreads << " work units is wrong" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  if (result == EXIT_SUCCESS)
+  {
+    std::cout << "Test PASSED" << std::endl;
+  }
+  return result;
+}
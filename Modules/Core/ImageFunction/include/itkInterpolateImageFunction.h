@@ -113,6 +113,23 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a block of continuous index positions
+   *
+   * Equivalent to calling EvaluateAtContinuousIndex() on each of the
+   * \c numberOfIndices indices, but lets subclasses evaluate the whole
+   * block without a virtual call per position. No bounds checking is done.
+   */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -104,6 +104,17 @@ public:
     return this->EvaluateOptimized(Dispatch<ImageDimension>(), index);
   }
 
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateOptimized(Dispatch<ImageDimension>(), indices[i]);
+    }
+  }
+
   SizeType
   GetRadius() const override
   {
@@ -146,6 +146,11 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Back transform from cartesian to azimuth-elevation.  */
   inline InputPointType
   BackTransform(const OutputPointType & point) const
@@ -18,6 +18,7 @@
 #ifndef itkAzimuthElevationToCartesianTransform_hxx
 #define itkAzimuthElevationToCartesianTransform_hxx
 
+#include <typeinfo>
 
 namespace itk
 {
@@ -66,6 +67,26 @@ AzimuthElevationToCartesianTransform<TParametersValueType, VDimension>::Transfor
   return result;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+AzimuthElevationToCartesianTransform<TParametersValueType, VDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // a derived class may override TransformPoint()
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputPoints[i] = Self::TransformPoint(inputPoints[i]);
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 AzimuthElevationToCartesianTransform<TParametersValueType, VDimension>::TransformAzElToCartesian(
@@ -239,6 +239,19 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
   /** @ITKEndGrouping */
+
+  /** Transform a block of points. Consecutive points which lie on a line
+   * along one axis of the control point lattice, such as the pixels of an
+   * image scanline parallel to the lattice, are transformed together: the
+   * coefficients are first weighted along the other axes, which have the same
+   * weights for the whole line, leaving SplineOrder + 1 weights per point
+   * instead of (SplineOrder + 1)^SpaceDimension. Derived classes, which may
+   * override TransformPoint(), transform one point at a time. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
@@ -323,6 +336,15 @@ private:
   void
   SetFixedParametersFromCoefficientImageInformation();
 
+  /** Transform points whose lattice continuous indices, given by \c indices,
+   * differ only along \c lineDimension. */
+  void
+  TransformPointsAlongLatticeLine(const InputPointType *      inputPoints,
+                                  const ContinuousIndexType * indices,
+                                  OutputPointType *           outputPoints,
+                                  SizeValueType               numberOfPoints,
+                                  unsigned int                lineDimension) const;
+
   void
   SetFixedParametersFromTransformDomainInformation(const OriginType &             meshOrigin,
                                                    const PhysicalDimensionsType & meshPhysical,
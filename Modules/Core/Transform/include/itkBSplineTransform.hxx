@@ -19,9 +19,16 @@
 #define itkBSplineTransform_hxx
 
 
+#include "itkBSplineKernelFunction.h"
 #include "itkContinuousIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkIndexRange.h"
+#include "itkMath.h"
+
+#include <algorithm>
+#include <typeinfo>
+#include <vector>
 
 namespace itk
 {
@@ -592,6 +599,192 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  // a derived class may override TransformPoint(), which the lattice lines
+  // would bypass
+  const ImageType * const coefficientImage = this->m_CoefficientImages[0];
+  if (numberOfPoints < 2 || !coefficientImage->GetBufferPointer() || typeid(*this) != typeid(Self))
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  std::vector<ContinuousIndexType> indices(numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    indices[i] =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+        inputPoints[i]);
+  }
+
+  // The lattice dimension along which the indices differ, or SpaceDimension
+  // when they differ along more than one dimension.
+  const auto getLineDimension = [](const ContinuousIndexType & first, const ContinuousIndexType & second) {
+    unsigned int lineDimension = 0;
+    unsigned int numberOfDifferences = 0;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      if (!Math::FloatAlmostEqual(first[j], second[j], 64))
+      {
+        lineDimension = j;
+        ++numberOfDifferences;
+      }
+    }
+    return numberOfDifferences > 1 ? SpaceDimension : lineDimension;
+  };
+
+  SizeValueType lineBegin = 0;
+  while (lineBegin < numberOfPoints)
+  {
+    const unsigned int lineDimension =
+      lineBegin + 1 < numberOfPoints ? getLineDimension(indices[lineBegin], indices[lineBegin + 1]) : SpaceDimension;
+    if (lineDimension == SpaceDimension)
+    {
+      outputPoints[lineBegin] = this->TransformPoint(inputPoints[lineBegin]);
+      ++lineBegin;
+      continue;
+    }
+
+    SizeValueType lineEnd = lineBegin + 2;
+    while (lineEnd < numberOfPoints &&
+           getLineDimension(indices[lineBegin], indices[lineEnd]) == lineDimension)
+    {
+      ++lineEnd;
+    }
+    this->TransformPointsAlongLatticeLine(inputPoints + lineBegin,
+                                          indices.data() + lineBegin,
+                                          outputPoints + lineBegin,
+                                          lineEnd - lineBegin,
+                                          lineDimension);
+    lineBegin = lineEnd;
+  }
+}
+
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPointsAlongLatticeLine(
+  const InputPointType *      inputPoints,
+  const ContinuousIndexType * indices,
+  OutputPointType *           outputPoints,
+  SizeValueType               numberOfPoints,
+  unsigned int                lineDimension) const
+{
+  // The continuous index along the line of each point, or NaN when the
+  // support region of the point does not lie totally within the grid.
+  std::vector<double> lineIndices(numberOfPoints);
+  SizeValueType       firstInside = numberOfPoints;
+  IndexValueType      minimumStart = NumericTraits<IndexValueType>::max();
+  IndexValueType      maximumStart = NumericTraits<IndexValueType>::NonpositiveMin();
+  ContinuousIndexType firstInsideIndex;
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    ContinuousIndexType index = indices[i];
+    if (!this->InsideValidRegion(index))
+    {
+      lineIndices[i] = NumericTraits<double>::quiet_NaN();
+      continue;
+    }
+    if (firstInside == numberOfPoints)
+    {
+      firstInside = i;
+      firstInsideIndex = index;
+    }
+    lineIndices[i] = index[lineDimension];
+    const auto start = Math::Floor<IndexValueType>(lineIndices[i] + 0.5 - SplineOrder / 2.0);
+    minimumStart = std::min(minimumStart, start);
+    maximumStart = std::max(maximumStart, start);
+  }
+
+  // Weight the coefficients along the other dimensions, with the weights of
+  // the first point inside, which hold for the whole line.
+  std::vector<double> lineCoefficients;
+  if (firstInside < numberOfPoints)
+  {
+    IndexType                                       supportIndex;
+    Matrix<double, SpaceDimension, SplineOrder + 1> weights1D;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      supportIndex[j] = Math::Floor<IndexValueType>(firstInsideIndex[j] + 0.5 - SplineOrder / 2.0);
+      double x = firstInsideIndex[j] - static_cast<double>(supportIndex[j]);
+      for (unsigned int k = 0; k <= SplineOrder; ++k)
+      {
+        weights1D[j][k] = BSplineKernelFunction<SplineOrder>::FastEvaluate(x);
+        x -= 1.0;
+      }
+    }
+
+    auto supportSize = SizeType::Filled(SplineOrder + 1);
+    supportSize[lineDimension] = 1;
+
+    const ImageType * const coefficientImage = this->m_CoefficientImages[0];
+    const auto lineLength = static_cast<SizeValueType>(maximumStart - minimumStart) + SplineOrder + 1;
+    lineCoefficients.assign(lineLength * SpaceDimension, 0.0);
+    for (SizeValueType l = 0; l < lineLength; ++l)
+    {
+      double * const lineCoefficient = &lineCoefficients[l * SpaceDimension];
+      for (const auto & offset : ZeroBasedIndexRange<SpaceDimension>(supportSize))
+      {
+        IndexType coefficientIndex;
+        double    weight = 1.0;
+        for (unsigned int j = 0; j < SpaceDimension; ++j)
+        {
+          if (j == lineDimension)
+          {
+            coefficientIndex[j] = minimumStart + static_cast<IndexValueType>(l);
+          }
+          else
+          {
+            coefficientIndex[j] = supportIndex[j] + offset[j];
+            weight *= weights1D[j][offset[j]];
+          }
+        }
+
+        const OffsetValueType bufferOffset = coefficientImage->ComputeOffset(coefficientIndex);
+        for (unsigned int j = 0; j < SpaceDimension; ++j)
+        {
+          lineCoefficient[j] += weight * this->m_CoefficientImages[j]->GetBufferPointer()[bufferOffset];
+        }
+      }
+    }
+  }
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    const InputPointType & point = inputPoints[i];
+    if (std::isnan(lineIndices[i]))
+    {
+      // NOTE: if the support region does not lie totally within the grid
+      // we assume zero displacement and return the input point
+      outputPoints[i] = point;
+      continue;
+    }
+
+    const auto start = Math::Floor<IndexValueType>(lineIndices[i] + 0.5 - SplineOrder / 2.0);
+    double     x = lineIndices[i] - static_cast<double>(start);
+
+    const double * lineCoefficient = &lineCoefficients[static_cast<SizeValueType>(start - minimumStart) * SpaceDimension];
+    double         displacement[SpaceDimension]{};
+    for (unsigned int k = 0; k <= SplineOrder; ++k, lineCoefficient += SpaceDimension)
+    {
+      const double weight = BSplineKernelFunction<SplineOrder>::FastEvaluate(x);
+      x -= 1.0;
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        displacement[j] += weight * lineCoefficient[j];
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoints[i][j] = point[j] + static_cast<ScalarType>(displacement[j]);
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
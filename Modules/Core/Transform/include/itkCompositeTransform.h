@@ -20,6 +20,7 @@
 
 #include "itkMultiTransform.h"
 
+#include <algorithm> // For copy_n.
 #include <deque>
 
 namespace itk
@@ -81,6 +82,13 @@ namespace itk
  * sub transform and adding them to a composite transform in reverse order.
  * The m_TransformsToOptimizeFlags is copied in reverse for the inverse.
  *
+ * Collapsing:
+ * CollapseLinearTransforms merges each run of consecutive linear transforms
+ * that are not set for optimization, such as the initial rigid and affine
+ * transforms ahead of a B-spline transform, into a single affine transform.
+ * A point is then mapped through one matrix product for the whole run
+ * instead of one virtual call per sub transform.
+ *
  * \ingroup ITKTransform
  */
 template <typename TParametersValueType = double, unsigned int VDimension = 3>
@@ -271,6 +279,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform a block of points, passing the whole block to each transform
+   * of the queue in turn. Derived classes, which may override
+   * TransformPoint(), transform one point at a time. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -399,6 +415,15 @@ public:
   virtual void
   FlattenTransformQueue();
 
+  /**
+   * Flatten the transform queue, then replace each run of consecutive linear
+   * transforms which are not set to be optimized by a single affine transform,
+   * so that it costs one matrix product per point. The optimized transforms,
+   * and hence the parameters, are left unchanged.
+   */
+  virtual void
+  CollapseLinearTransforms();
+
   /**
    * Compute the Jacobian with respect to the parameters for the composite
    * transform using Jacobian rule. See comments in the implementation.
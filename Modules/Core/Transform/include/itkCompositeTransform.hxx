@@ -18,6 +18,9 @@
 #ifndef itkCompositeTransform_hxx
 #define itkCompositeTransform_hxx
 
+#include "itkAffineTransform.h"
+
+#include <typeinfo>
 
 namespace itk
 {
@@ -70,6 +73,31 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // a derived class may override TransformPoint()
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  if (outputPoints != inputPoints)
+  {
+    std::copy_n(inputPoints, numberOfPoints, outputPoints);
+  }
+  /* Apply in reverse queue order.  */
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
@@ -585,7 +613,10 @@ CompositeTransform<TParametersValueType, VDimension>::ComputeJacobianWithRespect
     }
 
     /* Transform the point so it's ready for next transform's Jacobian */
-    transformedPoint = transform->TransformPoint(transformedPoint);
+    if (tind > 0)
+    {
+      transformedPoint = transform->TransformPoint(transformedPoint);
+    }
   }
 }
 
@@ -938,6 +969,77 @@ CompositeTransform<TParametersValueType, VDimension>::FlattenTransformQueue()
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::CollapseLinearTransforms()
+{
+  this->FlattenTransformQueue();
+
+  const auto isCollapsible = [this](const SizeValueType n) {
+    return !this->m_TransformsToOptimizeFlags[n] && this->m_TransformQueue[n]->IsLinear();
+  };
+
+  TransformQueueType            transformQueue;
+  TransformsToOptimizeFlagsType transformsToOptimizeFlags;
+
+  SizeValueType       n = 0;
+  const SizeValueType numberOfTransforms = this->GetNumberOfTransforms();
+  while (n < numberOfTransforms)
+  {
+    SizeValueType runEnd = n;
+    while (runEnd < numberOfTransforms && isCollapsible(runEnd))
+    {
+      ++runEnd;
+    }
+    if (runEnd - n < 2)
+    {
+      transformQueue.push_back(this->m_TransformQueue[n]);
+      transformsToOptimizeFlags.push_back(this->m_TransformsToOptimizeFlags[n]);
+      ++n;
+      continue;
+    }
+
+    /* Compose the run in reverse queue order, as it is applied. A linear
+     * transform maps x to A x + b, where the columns of A are the transformed
+     * unit vectors and b is the transformed origin. */
+    using AffineTransformType = AffineTransform<TParametersValueType, VDimension>;
+    typename AffineTransformType::MatrixType       matrix;
+    typename AffineTransformType::OutputVectorType offset{};
+    matrix.SetIdentity();
+    for (SizeValueType m = runEnd; m > n; --m)
+    {
+      const TransformType * const                    transform = this->m_TransformQueue[m - 1].GetPointer();
+      typename AffineTransformType::MatrixType       transformMatrix;
+      typename AffineTransformType::OutputVectorType transformOffset =
+        transform->TransformPoint(InputPointType{}) - OutputPointType{};
+      for (unsigned int c = 0; c < VDimension; ++c)
+      {
+        InputVectorType unitVector{};
+        unitVector[c] = 1.0;
+        const OutputVectorType column = transform->TransformVector(unitVector);
+        for (unsigned int r = 0; r < VDimension; ++r)
+        {
+          transformMatrix[r][c] = column[r];
+        }
+      }
+      offset = transformMatrix * offset + transformOffset;
+      matrix = transformMatrix * matrix;
+    }
+
+    auto collapsedTransform = AffineTransformType::New();
+    collapsedTransform->SetMatrix(matrix);
+    collapsedTransform->SetOffset(offset);
+    transformQueue.push_back(collapsedTransform.GetPointer());
+    transformsToOptimizeFlags.push_back(false);
+    n = runEnd;
+  }
+
+  this->m_TransformQueue = transformQueue;
+  this->m_TransformsToOptimizeFlags = transformsToOptimizeFlags;
+  this->Modified();
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 CompositeTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
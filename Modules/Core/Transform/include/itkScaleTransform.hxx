@@ -20,6 +20,8 @@
 
 #include "itkMath.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 
@@ -117,6 +119,26 @@ ScaleTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoin
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+ScaleTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                  OutputPointType *      outputPoints,
+                                                                  SizeValueType          numberOfPoints) const
+{
+  if (typeid(*this) != typeid(Self))
+  {
+    // a derived class may override TransformPoint()
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputPoints[i] = Self::TransformPoint(inputPoints[i]);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 ScaleTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & vect) const
@@ -180,6 +180,23 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a block of points.
+   * Equivalent to calling \c TransformPoint on each of the \c numberOfPoints
+   * input points, but lets subclasses process the whole block without a
+   * virtual call per point. When the input and output spaces have the same
+   * dimension, \c inputPoints and \c outputPoints may be the same array.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+    }
+  }
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
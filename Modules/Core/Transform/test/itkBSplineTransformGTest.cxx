@@ -22,6 +22,8 @@
 #include "itkBSplineTransform.h"
 
 #include "itkImageRegionConstIterator.h"
+#include <cmath>
+#include <vector>
 
 namespace
 {
@@ -205,3 +207,60 @@ TEST(ITKBSplineTransform, NumberOfWeights)
   testNumberOfWeights(*itk::BSplineTransform<float, 2>::New());
   testNumberOfWeights(*itk::BSplineTransform<float, 2, 2>::New());
 }
+
+
+TEST(ITKBSplineTransform, TransformPointsMatchesTransformPoint)
+{
+  using BSplineType = itk::BSplineTransform<double, 3, 3>;
+  using PointType = BSplineType::InputPointType;
+
+  auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-1.0, 2.0, 0.5));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(20.0, 16.0, 12.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(5, 4, 3));
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int p = 0; p < parameters.size(); ++p)
+  {
+    parameters[p] = 0.7 * std::sin(1.3 * p) + 0.2 * std::cos(0.4 * p);
+  }
+  bspline->SetParameters(parameters);
+
+  const auto expectTransformPointsMatches = [&bspline](const std::vector<PointType> & points) {
+    std::vector<PointType> transformedPoints(points.size());
+    bspline->TransformPoints(points.data(), transformedPoints.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      ITK_EXPECT_VECTOR_NEAR(transformedPoints[i], bspline->TransformPoint(points[i]), 1e-12) << points[i];
+    }
+  };
+
+  // Scanlines along each axis of the lattice, crossing the border of the
+  // transform domain, followed by points which are not on a line.
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    std::vector<PointType> points;
+    for (int i = -10; i < 60; ++i)
+    {
+      PointType point = itk::MakePoint(4.3, 7.1, 5.7);
+      point[axis] = -2.0 + 0.4 * i;
+      points.push_back(point);
+    }
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+      points.push_back(itk::MakePoint(1.0 + 3.1 * i, 3.0 + 2.3 * i, 1.0 + 1.7 * i));
+    }
+    expectTransformPointsMatches(points);
+  }
+
+  // Several scanlines in one block, and a single point.
+  std::vector<PointType> points;
+  for (unsigned int line = 0; line < 4; ++line)
+  {
+    for (unsigned int i = 0; i < 25; ++i)
+    {
+      points.push_back(itk::MakePoint(0.8 * i, 3.0 + 2.5 * line, 6.0 - line));
+    }
+  }
+  expectTransformPointsMatches(points);
+  expectTransformPointsMatches({ itk::MakePoint(5.0, 5.0, 5.0) });
+}
@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkCompositeTransform.h"
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkEuler2DTransform.h"
+#include "itkScaleTransform.h"
+#include "itkTranslationTransform.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+using PointType = CompositeTransformType::InputPointType;
+
+CompositeTransformType::Pointer
+MakeCompositeTransform()
+{
+  auto rigid = itk::Euler2DTransform<double>::New();
+  rigid->SetCenter(itk::MakePoint(10.0, 12.0));
+  rigid->SetAngle(0.2);
+  rigid->SetTranslation(itk::MakeVector(1.5, -2.0));
+
+  auto affine = itk::AffineTransform<double, Dimension>::New();
+  auto affineParameters = affine->GetParameters();
+  affineParameters[0] = 1.1;
+  affineParameters[1] = 0.05;
+  affineParameters[2] = -0.07;
+  affineParameters[3] = 0.9;
+  affineParameters[4] = 3.0;
+  affineParameters[5] = 0.5;
+  affine->SetParameters(affineParameters);
+
+  auto bspline = itk::BSplineTransform<double, Dimension, 3>::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-5.0, -5.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(40.0, 40.0));
+  bspline->SetTransformDomainMeshSize(itk::BSplineTransform<double, Dimension, 3>::MeshSizeType::Filled(4));
+  auto bsplineParameters = bspline->GetParameters();
+  for (unsigned int p = 0; p < bsplineParameters.size(); ++p)
+  {
+    bsplineParameters[p] = 0.5 * std::sin(0.9 * p);
+  }
+  bspline->SetParameters(bsplineParameters);
+
+  auto translation = itk::TranslationTransform<double, Dimension>::New();
+  translation->SetOffset(itk::MakeVector(-0.5, 0.25));
+
+  auto scale = itk::ScaleTransform<double, Dimension>::New();
+  scale->SetScale(itk::MakeVector(1.2, 0.8));
+  scale->SetCenter(itk::MakePoint(4.0, 2.0));
+
+  // The transforms are applied from the back of the queue: scale, translation,
+  // B-spline, affine and then rigid.
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(rigid);
+  composite->AddTransform(affine);
+  composite->AddTransform(bspline);
+  composite->AddTransform(translation);
+  composite->AddTransform(scale);
+  composite->SetAllTransformsToOptimizeOff();
+  composite->SetNthTransformToOptimizeOn(2);
+  return composite;
+}
+
+std::vector<PointType>
+MakePoints()
+{
+  std::vector<PointType> points;
+  for (double x = -3.0; x < 30.0; x += 4.3)
+  {
+    for (double y = -2.0; y < 30.0; y += 3.7)
+    {
+      points.push_back(itk::MakePoint(x, y));
+    }
+  }
+  return points;
+}
+} // namespace
+
+
+TEST(CompositeTransform, CollapseLinearTransformsMergesFixedLinearRuns)
+{
+  const auto         composite = MakeCompositeTransform();
+  const auto         original = MakeCompositeTransform();
+  const auto * const bspline = composite->GetNthTransformConstPointer(2);
+
+  composite->CollapseLinearTransforms();
+
+  ASSERT_EQ(composite->GetNumberOfTransforms(), 3u);
+  EXPECT_FALSE(composite->GetNthTransformToOptimize(0));
+  EXPECT_TRUE(composite->GetNthTransformToOptimize(1));
+  EXPECT_FALSE(composite->GetNthTransformToOptimize(2));
+  EXPECT_EQ(composite->GetNthTransformConstPointer(1), bspline);
+  EXPECT_EQ(composite->GetNumberOfParameters(), original->GetNumberOfParameters());
+  EXPECT_EQ(composite->GetParameters(), original->GetParameters());
+
+  for (const auto & point : MakePoints())
+  {
+    const PointType expected = original->TransformPoint(point);
+    const PointType actual = composite->TransformPoint(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      EXPECT_NEAR(actual[d], expected[d], 1e-10) << point;
+    }
+
+    CompositeTransformType::JacobianType expectedJacobian;
+    CompositeTransformType::JacobianType actualJacobian;
+    original->ComputeJacobianWithRespectToParameters(point, expectedJacobian);
+    composite->ComputeJacobianWithRespectToParameters(point, actualJacobian);
+    ASSERT_EQ(actualJacobian.cols(), expectedJacobian.cols());
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      for (unsigned int p = 0; p < expectedJacobian.cols(); ++p)
+      {
+        EXPECT_NEAR(actualJacobian[d][p], expectedJacobian[d][p], 1e-10) << point;
+      }
+    }
+  }
+}
+
+
+TEST(CompositeTransform, CollapseLinearTransformsKeepsOptimizedLinearTransforms)
+{
+  const auto composite = MakeCompositeTransform();
+  composite->SetNthTransformToOptimizeOn(1);
+  const auto * const optimizedAffine = composite->GetNthTransformConstPointer(1);
+
+  composite->CollapseLinearTransforms();
+
+  ASSERT_EQ(composite->GetNumberOfTransforms(), 4u);
+  EXPECT_EQ(composite->GetNthTransformConstPointer(1), optimizedAffine);
+  EXPECT_TRUE(composite->GetNthTransformToOptimize(1));
+  EXPECT_TRUE(composite->GetNthTransformToOptimize(2));
+}
+
+
+TEST(CompositeTransform, CollapseLinearTransformsFlattensNestedComposites)
+{
+  const auto original = MakeCompositeTransform();
+  auto       nested = CompositeTransformType::New();
+  nested->AddTransform(original->GetNthTransformModifiablePointer(3));
+  nested->AddTransform(original->GetNthTransformModifiablePointer(4));
+  nested->SetAllTransformsToOptimizeOff();
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(original->GetNthTransformModifiablePointer(0));
+  composite->AddTransform(original->GetNthTransformModifiablePointer(1));
+  composite->AddTransform(nested);
+  composite->SetAllTransformsToOptimizeOff();
+
+  composite->CollapseLinearTransforms();
+
+  ASSERT_EQ(composite->GetNumberOfTransforms(), 1u);
+  EXPECT_TRUE(composite->IsLinear());
+  for (const auto & point : MakePoints())
+  {
+    const PointType expected = original->GetNthTransformConstPointer(0)->TransformPoint(
+      original->GetNthTransformConstPointer(1)->TransformPoint(original->GetNthTransformConstPointer(3)->TransformPoint(
+        original->GetNthTransformConstPointer(4)->TransformPoint(point))));
+    const PointType actual = composite->TransformPoint(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      EXPECT_NEAR(actual[d], expected[d], 1e-10) << point;
+    }
+  }
+}
+
+
+TEST(CompositeTransform, TransformPointsMatchesTransformPoint)
+{
+  const auto composite = MakeCompositeTransform();
+  composite->CollapseLinearTransforms();
+
+  const std::vector<PointType> points = MakePoints();
+  std::vector<PointType>       transformedPoints(points.size());
+  composite->TransformPoints(points.data(), transformedPoints.data(), points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const PointType expected = composite->TransformPoint(points[i]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      EXPECT_NEAR(transformedPoints[i][d], expected[d], 1e-12) << points[i];
+    }
+  }
+}
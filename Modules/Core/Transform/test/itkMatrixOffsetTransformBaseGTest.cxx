@@ -20,11 +20,37 @@
 #include "itkMatrixOffsetTransformBase.h"
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 
 
 namespace
 {
 
+// A transform which overrides TransformPoint(), as derived classes outside ITK may do.
+class ShiftedMatrixOffsetTransform : public itk::MatrixOffsetTransformBase<double, 3, 3>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ShiftedMatrixOffsetTransform);
+
+  using Self = ShiftedMatrixOffsetTransform;
+  using Superclass = itk::MatrixOffsetTransformBase<double, 3, 3>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkOverrideGetNameOfClassMacro(ShiftedMatrixOffsetTransform);
+  itkNewMacro(Self);
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    return Superclass::TransformPoint(point) + itk::MakeFilled<OutputVectorType>(1.0);
+  }
+
+protected:
+  ShiftedMatrixOffsetTransform() = default;
+  ~ShiftedMatrixOffsetTransform() override = default;
+};
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 Check_New_MatrixOffsetTransformBase()
@@ -77,3 +103,59 @@ TEST(MatrixOffsetTransformBase, SetFixedParametersThrowsWhenSizeIsLessThanNDimen
   Assert_SetFixedParameters_throws_when_size_is_less_than_NDimensions<3>();
   Assert_SetFixedParameters_throws_when_size_is_less_than_NDimensions<4>();
 }
+
+
+// Checks that transforming a block of points gives the same points as transforming them one at a time, also when
+// the block is transformed in place.
+TEST(MatrixOffsetTransformBase, TransformPointsMatchesTransformPoint)
+{
+  using TransformBaseType = itk::MatrixOffsetTransformBase<double, 3, 3>;
+  using PointType = TransformBaseType::InputPointType;
+
+  auto                              transformBase = TransformBaseType::New();
+  TransformBaseType::ParametersType parameters(transformBase->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.25 + 0.5 * std::sin(1.0 + i);
+  }
+  transformBase->SetParameters(parameters);
+  transformBase->SetCenter(itk::MakePoint(1.0, -2.0, 3.0));
+
+  std::vector<PointType> points(37);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i] = itk::MakePoint(0.5 * i, 7.0 - 0.25 * i, 0.125 * i * i);
+  }
+
+  std::vector<PointType> transformedPoints(points.size());
+  transformBase->TransformPoints(points.data(), transformedPoints.data(), points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(transformedPoints[i], transformBase->TransformPoint(points[i]));
+  }
+
+  transformBase->TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_EQ(points, transformedPoints);
+}
+
+
+// Checks that transforming a block of points calls TransformPoint() of a derived class which overrides it.
+TEST(MatrixOffsetTransformBase, TransformPointsCallsOverriddenTransformPoint)
+{
+  using PointType = ShiftedMatrixOffsetTransform::InputPointType;
+
+  const auto transform = ShiftedMatrixOffsetTransform::New();
+
+  std::vector<PointType> points(5);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i] = itk::MakePoint(0.5 * i, -1.0 * i, 2.0);
+  }
+
+  std::vector<PointType> transformedPoints(points.size());
+  transform->TransformPoints(points.data(), transformedPoints.data(), points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(transformedPoints[i], transform->TransformPoint(points[i]));
+  }
+}
@@ -27,6 +27,8 @@
 
 #include "vnl/vnl_vector.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -67,6 +69,11 @@ namespace itk
  *     See the IJ article and the test file for an example.
  *  5. The 'Z' parameter in Sled's 1998 paper \cite sled1998 is the square root
  *     of the class variable 'm_WienerFilterNoise'.
+ *  6. The passes over the pixels run in parallel. Their results do not
+ *     depend on the number of work units, but the intensity histogram and
+ *     the convergence measurement are summed per block of pixels. These
+ *     sums round differently than the serial sums of earlier versions of
+ *     this filter, so the output may differ slightly from theirs.
  *
  * The basic algorithm iterates between sharpening the intensity histogram of
  * the corrected input image and spatially smoothing those results with a
@@ -410,7 +417,7 @@ private:
    * bias field estimate.
    */
   RealImagePointer
-  UpdateBiasFieldEstimate(RealImageType *, size_t);
+  UpdateBiasFieldEstimate(RealImageType *, const std::vector<size_t> & numberOfIncludedPixelsPerBlock);
 
   /**
    * Convergence is determined by the coefficient of variation of the difference
@@ -419,6 +426,26 @@ private:
   RealType
   CalculateConvergenceMeasurement(const RealImageType *, const RealImageType *) const;
 
+  /**
+   * The passes over the pixels run in parallel over blocks of PixelBlockSize
+   * consecutive pixels. The blocks do not depend on the number of work units,
+   * and the results of the blocks are combined in block order, so that the
+   * output does not depend on the number of work units either.
+   */
+  static constexpr SizeValueType PixelBlockSize = 16384;
+
+  static SizeValueType
+  GetNumberOfPixelBlocks(SizeValueType numberOfPixels)
+  {
+    return (numberOfPixels + PixelBlockSize - 1) / PixelBlockSize;
+  }
+
+  /** Call blockFunction(block, firstPixel, endPixel) for each block of pixels,
+   * in parallel, with the number of work units of the filter. */
+  template <typename TBlockFunction>
+  void
+  ParallelizeOverPixelBlocks(SizeValueType numberOfPixels, const TBlockFunction & blockFunction) const;
+
   MaskPixelType m_MaskLabel{};
   bool          m_UseMaskLabel{ false };
 
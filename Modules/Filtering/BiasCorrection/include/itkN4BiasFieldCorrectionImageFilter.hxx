@@ -32,6 +32,8 @@
 #include "itkSubtractImageFilter.h"
 #include "itkVectorIndexSelectionCastImageFilter.h"
 
+#include <algorithm>
+
 ITK_GCC_PRAGMA_PUSH
 ITK_GCC_SUPPRESS_Wfloat_equal
 #include "vnl/algo/vnl_fft_1d.h"
@@ -123,24 +125,29 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
   const ImageBufferRange logInputImageBufferRange{ *logInputImage };
   const size_t           numberOfPixels = logInputImageBufferRange.size();
 
-  // Number of pixels of the input image that are included with the filter.
-  size_t numberOfIncludedPixels = 0;
+  // Number of pixels of the input image that are included with the filter,
+  // per block of pixels.
+  std::vector<size_t> numberOfIncludedPixelsPerBlock(GetNumberOfPixelBlocks(numberOfPixels));
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    size_t numberOfIncludedPixels = 0;
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      ++numberOfIncludedPixels;
-      auto && logInputPixel = logInputImageBufferRange[indexValue];
-
-      if (logInputPixel > typename InputImageType::PixelType{})
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+        ++numberOfIncludedPixels;
+        auto && logInputPixel = logInputImageBufferRange[indexValue];
+
+        if (logInputPixel > typename InputImageType::PixelType{})
+        {
+          logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+        }
       }
     }
-  }
+    numberOfIncludedPixelsPerBlock[block] = numberOfIncludedPixels;
+  });
 
   // Duplicate logInputImage since we reuse the original at each iteration.
 
@@ -200,7 +207,7 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
       // Smooth the residual bias field estimate and add the resulting
       // control point grid to get the new total bias field estimate.
 
-      const RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixels);
+      const RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixelsPerBlock);
 
       this->m_CurrentConvergenceMeasurement = this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField);
       logBiasField = newLogBiasField;
@@ -268,58 +275,102 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Sharpen
   // in real space are denoted by a single uppercase letter whereas their
   // frequency counterparts are indicated by a trailing lowercase 'f'.
 
-  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-  RealType binMinimum = NumericTraits<RealType>::max();
+  const auto          unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
+  const size_t        numberOfPixels = unsharpenedImageBufferRange.size();
+  const SizeValueType numberOfBlocks = GetNumberOfPixelBlocks(numberOfPixels);
 
-  const auto   unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-  const size_t numberOfPixels = unsharpenedImageBufferRange.size();
+  // The range is the one of the serial loop, which only updates the minimum
+  // with pixels which do not raise the running maximum. For that, each block
+  // starts with the running maximum of the blocks before it.
+  std::vector<RealType> blockMaxima(numberOfBlocks, NumericTraits<RealType>::NonpositiveMin());
+  std::vector<RealType> blockMinima(numberOfBlocks, NumericTraits<RealType>::max());
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    RealType blockMaximum = NumericTraits<RealType>::NonpositiveMin();
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
-      if (pixel > binMaximum)
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        binMaximum = pixel;
+        blockMaximum = std::max(blockMaximum, unsharpenedImageBufferRange[indexValue]);
       }
-      else if (pixel < binMinimum)
+    }
+    blockMaxima[block] = blockMaximum;
+  });
+
+  std::vector<RealType> runningMaxima(numberOfBlocks);
+  RealType              binMaximum = NumericTraits<RealType>::NonpositiveMin();
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    runningMaxima[block] = binMaximum;
+    binMaximum = std::max(binMaximum, blockMaxima[block]);
+  }
+
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    RealType runningMaximum = runningMaxima[block];
+    RealType blockMinimum = NumericTraits<RealType>::max();
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
+    {
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        binMinimum = pixel;
+        const RealType pixel = unsharpenedImageBufferRange[indexValue];
+        if (pixel > runningMaximum)
+        {
+          runningMaximum = pixel;
+        }
+        else if (pixel < blockMinimum)
+        {
+          blockMinimum = pixel;
+        }
       }
     }
-  }
+    blockMinima[block] = blockMinimum;
+  });
+
+  const RealType binMinimum = *std::min_element(blockMinima.cbegin(), blockMinima.cend());
   const RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
 
   // Create the intensity profile (within the masked region, if applicable)
   // using a triangular parzen windowing scheme.
 
-  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  std::vector<vnl_vector<RealType>> blockHistograms(numberOfBlocks);
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    vnl_vector<RealType> & blockH = blockHistograms[block];
+    blockH.set_size(this->m_NumberOfHistogramBins);
+    blockH.fill(0.0);
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
-
-      const RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
-      const RealType     offset = cidx - static_cast<RealType>(idx);
-
-      if (offset == 0.0)
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        H[idx] += 1.0;
-      }
-      else if (idx < this->m_NumberOfHistogramBins - 1)
-      {
-        H[idx] += 1.0 - offset;
-        H[idx + 1] += offset;
+        const RealType pixel = unsharpenedImageBufferRange[indexValue];
+
+        const RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
+        const unsigned int idx = itk::Math::floor(cidx);
+        const RealType     offset = cidx - static_cast<RealType>(idx);
+
+        if (offset == 0.0)
+        {
+          blockH[idx] += 1.0;
+        }
+        else if (idx < this->m_NumberOfHistogramBins - 1)
+        {
+          blockH[idx] += 1.0 - offset;
+          blockH[idx + 1] += offset;
+        }
       }
     }
+  });
+
+  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  for (const vnl_vector<RealType> & blockH : blockHistograms)
+  {
+    H += blockH;
   }
 
   // Determine information about the intensity histogram and zero-pad
@@ -442,39 +493,40 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Sharpen
 
   E = E.extract(this->m_NumberOfHistogramBins, histogramOffset);
 
-  // Sharpen the image with the new mapping, E(u|v)
-  sharpenedImage->FillBuffer(0);
-
+  // Sharpen the image with the new mapping, E(u|v). Excluded pixels are
+  // set to zero.
   const ImageBufferRange sharpenedImageBufferRange{ *sharpenedImage };
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType, size_t firstPixel, size_t endPixel) {
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      const RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
-
       RealType correctedPixel = 0;
-      if (idx < E.size() - 1)
-      {
-        correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
-      }
-      else
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        correctedPixel = E.back();
+        const RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
+        const unsigned int idx = itk::Math::floor(cidx);
+
+        if (idx < E.size() - 1)
+        {
+          correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+        }
+        else
+        {
+          correctedPixel = E.back();
+        }
       }
       sharpenedImageBufferRange[indexValue] = correctedPixel;
     }
-  }
+  });
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
-  RealImageType * fieldEstimate,
-  const size_t    numberOfIncludedPixels)
+  RealImageType *             fieldEstimate,
+  const std::vector<size_t> & numberOfIncludedPixelsPerBlock)
 {
   // Temporarily set the direction cosine to identity since the B-spline
   // approximation algorithm works in parametric space and not physical
@@ -497,47 +549,56 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateB
 
   const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
 
+  // Each block of pixels fills its own part of the point containers, which
+  // thus keep the order of the pixels.
+  std::vector<size_t> firstPointOfBlock(numberOfIncludedPixelsPerBlock.size());
+  size_t              numberOfIncludedPixels = 0;
+  for (size_t block = 0; block < numberOfIncludedPixelsPerBlock.size(); ++block)
+  {
+    firstPointOfBlock[block] = numberOfIncludedPixels;
+    numberOfIncludedPixels += numberOfIncludedPixelsPerBlock[block];
+  }
+
   const PointSetPointer fieldPoints = PointSetType::New();
   auto &                pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-  pointSTLContainer.reserve(numberOfIncludedPixels);
+  pointSTLContainer.resize(numberOfIncludedPixels);
   auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-  pointDataSTLContainer.reserve(numberOfIncludedPixels);
+  pointDataSTLContainer.resize(numberOfIncludedPixels);
 
   auto   weights = BSplineFilterType::WeightsContainerType::New();
   auto & weightSTLContainer = weights->CastToSTLContainer();
-  weightSTLContainer.reserve(numberOfIncludedPixels);
+  weightSTLContainer.resize(numberOfIncludedPixels);
 
   const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
   const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
   const MaskPixelType maskLabel = this->GetMaskLabel();
   const bool          useMaskLabel = this->GetUseMaskLabel();
 
-  ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                      parametricFieldEstimate->GetRequestedRegion());
+  const RealType * const fieldEstimateBuffer = parametricFieldEstimate->GetBufferPointer();
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    size_t pointId = firstPointOfBlock[block];
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      PointType point;
-      parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
-
-      ScalarType scalar;
-      scalar[0] = It.Get();
-
-      pointDataSTLContainer.push_back(scalar);
-      pointSTLContainer.push_back(point);
-
-      RealType confidenceWeight = 1.0;
-      if (!confidenceImageBufferRange.empty())
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        confidenceWeight = confidenceImageBufferRange[indexValue];
+        parametricFieldEstimate->TransformIndexToPhysicalPoint(
+          parametricFieldEstimate->ComputeIndex(static_cast<OffsetValueType>(indexValue)), pointSTLContainer[pointId]);
+
+        pointDataSTLContainer[pointId][0] = fieldEstimateBuffer[indexValue];
+
+        RealType confidenceWeight = 1.0;
+        if (!confidenceImageBufferRange.empty())
+        {
+          confidenceWeight = confidenceImageBufferRange[indexValue];
+        }
+        weightSTLContainer[pointId] = confidenceWeight;
+        ++pointId;
       }
-      weightSTLContainer.push_back(confidenceWeight);
     }
-  }
+  });
 
   auto bspliner = BSplineFilterType::New();
 
@@ -649,10 +710,6 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Calcula
 
   // Calculate statistics over the mask region
 
-  RealType mu = 0.0;
-  RealType sigma = 0.0;
-  RealType N = 0.0;
-
   const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
   const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
   const MaskPixelType maskLabel = this->GetMaskLabel();
@@ -661,20 +718,52 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Calcula
   const auto   subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
   const size_t numberOfPixels = subtracterImageBufferRange.size();
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  // Running count, mean, and sum of squared differences from the mean of
+  // each block of pixels.
+  struct Moments
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    RealType N{ 0.0 };
+    RealType mu{ 0.0 };
+    RealType sigma{ 0.0 };
+  };
+  std::vector<Moments> blockMoments(GetNumberOfPixelBlocks(numberOfPixels));
+
+  this->ParallelizeOverPixelBlocks(numberOfPixels, [&](SizeValueType block, size_t firstPixel, size_t endPixel) {
+    RealType mu = 0.0;
+    RealType sigma = 0.0;
+    RealType N = 0.0;
+    for (size_t indexValue = firstPixel; indexValue < endPixel; ++indexValue)
     {
-      const RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
-      N += 1.0;
-
-      if (N > 1.0)
+      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+           (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
+          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
       {
-        sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+        const RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
+        N += 1.0;
+
+        if (N > 1.0)
+        {
+          sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+        }
+        mu = mu * (1.0 - 1.0 / N) + pixel / N;
       }
-      mu = mu * (1.0 - 1.0 / N) + pixel / N;
+    }
+    blockMoments[block] = { N, mu, sigma };
+  });
+
+  // Combine the blocks in order with the pairwise update of Chan et al.
+  RealType mu = 0.0;
+  RealType sigma = 0.0;
+  RealType N = 0.0;
+  for (const Moments & moments : blockMoments)
+  {
+    if (moments.N > 0.0)
+    {
+      const RealType combinedN = N + moments.N;
+      const RealType delta = moments.mu - mu;
+      sigma = sigma + moments.sigma + itk::Math::sqr(delta) * N * moments.N / combinedN;
+      mu = mu + delta * moments.N / combinedN;
+      N = combinedN;
     }
   }
   sigma = std::sqrt(sigma / (N - 1.0));
@@ -682,6 +771,26 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Calcula
   return (sigma / mu);
 }
 
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+template <typename TBlockFunction>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ParallelizeOverPixelBlocks(
+  SizeValueType          numberOfPixels,
+  const TBlockFunction & blockFunction) const
+{
+  // the multithreader of the filter may be shared, so it is left unchanged
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    GetNumberOfPixelBlocks(numberOfPixels),
+    [numberOfPixels, &blockFunction](SizeValueType block) {
+      const SizeValueType firstPixel = block * PixelBlockSize;
+      blockFunction(block, firstPixel, std::min(firstPixel + PixelBlockSize, numberOfPixels));
+    },
+    nullptr);
+}
+
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::PrintSelf(std::ostream & os,
@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using MaskImageType = itk::Image<unsigned char, 3>;
+
+// Two tissue classes under a smooth multiplicative bias field, with a mask
+// which excludes the background.
+void
+MakeBiasedImage(ImageType::Pointer & image, MaskImageType::Pointer & mask)
+{
+  const ImageType::SizeType size{ { 48, 40, 36 } };
+  image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  mask = MaskImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const bool                 foreground = index[0] > 2 && index[0] < 45;
+    const float                tissue = (index[0] / 6 + index[1] / 5 + index[2] / 4) % 2 ? 100.0f : 60.0f;
+    const float bias = 1.0f + 0.3f * std::sin(0.05f * index[0]) + 0.2f * std::cos(0.07f * index[1] + 0.03f * index[2]);
+    it.Set(foreground ? tissue * bias : 0.0f);
+    mask->SetPixel(index, foreground ? 1 : 0);
+  }
+}
+
+ImageType::Pointer
+Correct(const ImageType * image, const MaskImageType * mask, itk::ThreadIdType numberOfWorkUnits)
+{
+  using FilterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetMaskImage(mask);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->SetMaximumNumberOfIterations(FilterType::VariableSizeArrayType(2, 5));
+  filter->SetNumberOfFittingLevels(2);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+double
+CoefficientOfVariationOfClass(const ImageType * image, const ImageType * classImage, float classValue)
+{
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double n = 0.0;
+  const auto * const classBuffer = classImage->GetBufferPointer();
+  const auto * const buffer = image->GetBufferPointer();
+  for (size_t i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    const ImageType::IndexType index = image->ComputeIndex(static_cast<itk::OffsetValueType>(i));
+    const float tissue = (index[0] / 6 + index[1] / 5 + index[2] / 4) % 2 ? 100.0f : 60.0f;
+    if (classBuffer[i] > 0.0f && tissue == classValue)
+    {
+      sum += buffer[i];
+      sumOfSquares += static_cast<double>(buffer[i]) * buffer[i];
+      n += 1.0;
+    }
+  }
+  const double mean = sum / n;
+  return std::sqrt(sumOfSquares / n - mean * mean) / mean;
+}
+} // namespace
+
+
+TEST(N4BiasFieldCorrectionImageFilter, ResultDoesNotDependOnNumberOfWorkUnits)
+{
+  ImageType::Pointer     image;
+  MaskImageType::Pointer mask;
+  MakeBiasedImage(image, mask);
+
+  const ImageType::Pointer serial = Correct(image, mask, 1);
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 3, 16 })
+  {
+    const ImageType::Pointer parallel = Correct(image, mask, numberOfWorkUnits);
+    const size_t             numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+    for (size_t i = 0; i < numberOfPixels; ++i)
+    {
+      ASSERT_EQ(serial->GetBufferPointer()[i], parallel->GetBufferPointer()[i])
+        << "at pixel " << i << " with " << numberOfWorkUnits << " work units";
+    }
+  }
+
+  // the bias is reduced within each tissue class
+  for (const float classValue : { 60.0f, 100.0f })
+  {
+    EXPECT_LT(CoefficientOfVariationOfClass(serial, image, classValue),
+              0.5 * CoefficientOfVariationOfClass(image, image, classValue));
+  }
+}
@@ -31,6 +31,13 @@ namespace itk
  *
  * \brief Iteratively estimate the inverse field of a displacement field.
  *
+ * At each iteration, the displacement field is composed with the current
+ * estimate of its inverse by evaluating it through the interpolator, which is
+ * a linear interpolator by default. The interpolator set by SetInterpolator()
+ * therefore changes the estimated inverse field. In earlier versions, this
+ * composition always used ComposeDisplacementFieldsImageFilter with its own
+ * linear interpolator, and SetInterpolator() had no effect on the output.
+ *
  * \author Nick Tustison
  * \author Brian Avants
  *
@@ -116,7 +123,7 @@ public:
   itkGetInputMacro(InverseFieldInitialEstimate, InverseDisplacementFieldType);
   /** @ITKEndGrouping */
 
-  /* Set the interpolator. */
+  /* Set the interpolator through which the displacement field is evaluated. */
   virtual void
   SetInterpolator(InterpolatorType * interpolator);
 
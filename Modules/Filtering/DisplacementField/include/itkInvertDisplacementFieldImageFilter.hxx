@@ -19,8 +19,8 @@
 #define itkInvertDisplacementFieldImageFilter_hxx
 
 
-#include "itkComposeDisplacementFieldsImageFilter.h"
-#include "itkImageDuplicator.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include <mutex>
 #include "itkProgressTransformer.h"
@@ -76,22 +76,17 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   const typename DisplacementFieldType::ConstPointer displacementField = this->GetInput();
 
-  typename InverseDisplacementFieldType::Pointer inverseDisplacementField;
+  const typename InverseDisplacementFieldType::Pointer inverseDisplacementField = this->GetOutput();
 
   if (this->GetInverseFieldInitialEstimate())
   {
-    using DuplicatorType = ImageDuplicator<InverseDisplacementFieldType>;
-    auto duplicator = DuplicatorType::New();
-    duplicator->SetInputImage(this->GetInverseFieldInitialEstimate());
-    duplicator->Update();
-
-    inverseDisplacementField = duplicator->GetOutput();
-
-    this->SetNthOutput(0, inverseDisplacementField);
+    ImageAlgorithm::Copy(this->GetInverseFieldInitialEstimate(),
+                         inverseDisplacementField.GetPointer(),
+                         inverseDisplacementField->GetRequestedRegion(),
+                         inverseDisplacementField->GetRequestedRegion());
   }
   else
   {
-    inverseDisplacementField = this->GetOutput();
     inverseDisplacementField->FillBuffer(zeroVector);
   }
 
@@ -100,6 +95,14 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     this->m_DisplacementFieldSpacing[d] = displacementField->GetSpacing()[d];
   }
 
+  this->m_Interpolator->SetInputImage(displacementField);
+
+  // The composed field and the scaled norm image are allocated once, and
+  // overwritten at each iteration.
+  this->m_ComposedField->CopyInformation(displacementField);
+  this->m_ComposedField->SetRegions(displacementField->GetRequestedRegion());
+  this->m_ComposedField->Allocate();
+
   this->m_ScaledNormImage->CopyInformation(displacementField);
   this->m_ScaledNormImage->SetRegions(displacementField->GetRequestedRegion());
   this->m_ScaledNormImage->AllocateInitialized();
@@ -118,16 +121,9 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     itkDebugMacro("Iteration " << iteration << ": mean error norm = " << this->m_MeanErrorNorm
                                << ", max error norm = " << this->m_MaxErrorNorm);
 
-    using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
-    auto composer = ComposerType::New();
-    composer->SetDisplacementField(displacementField);
-    composer->SetWarpingField(inverseDisplacementField);
-
-    this->m_ComposedField = composer->GetOutput();
-    this->m_ComposedField->Update();
-    this->m_ComposedField->DisconnectPipeline();
-
-    // Multithread processing to multiply each element of the composed field by 1 / spacing
+    // Multithread processing to compose the displacement field with the
+    // current inverse estimate, and to multiply each element of the composed
+    // field by 1 / spacing
     this->m_MeanErrorNorm = RealType{};
     this->m_MaxErrorNorm = RealType{};
 
@@ -210,6 +206,12 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::DynamicThreadedGe
   }
   else
   {
+    // Compose the displacement field with the current inverse estimate, as
+    // ComposeDisplacementFieldsImageFilter does, and keep the negated error.
+    const InverseDisplacementFieldType * inverseField = this->GetOutput();
+
+    ImageRegionConstIteratorWithIndex<InverseDisplacementFieldType> ItI(inverseField, region);
+
     VectorType inverseSpacing;
     RealType   localMean{};
     RealType   localMax{};
@@ -217,10 +219,33 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::DynamicThreadedGe
     {
       inverseSpacing[d] = 1.0 / this->m_DisplacementFieldSpacing[d];
     }
-    for (ItE.GoToBegin(), ItS.GoToBegin(); !ItE.IsAtEnd(); ++ItE, ++ItS)
+
+    PointType pointIn1;
+    PointType pointIn2;
+    PointType pointIn3;
+
+    for (ItI.GoToBegin(), ItE.GoToBegin(), ItS.GoToBegin(); !ItI.IsAtEnd(); ++ItI, ++ItE, ++ItS)
     {
-      const VectorType & displacement = ItE.Get();
-      RealType           scaledNorm = 0.0;
+      inverseField->TransformIndexToPhysicalPoint(ItI.GetIndex(), pointIn1);
+
+      const VectorType & inverseDisplacement = ItI.Get();
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        pointIn2[d] = pointIn1[d] + inverseDisplacement[d];
+      }
+
+      typename InterpolatorType::OutputType forwardDisplacement{};
+      if (this->m_Interpolator->IsInsideBuffer(pointIn2))
+      {
+        forwardDisplacement = this->m_Interpolator->Evaluate(pointIn2);
+      }
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        pointIn3[d] = pointIn2[d] + forwardDisplacement[d];
+      }
+
+      const VectorType displacement = pointIn3 - pointIn1;
+      RealType         scaledNorm = 0.0;
       for (unsigned int d = 0; d < ImageDimension; ++d)
       {
         scaledNorm += itk::Math::sqr(displacement[d] * inverseSpacing[d]);
@@ -24,6 +24,8 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -178,10 +180,14 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   const TransformType * transform = this->GetInput()->Get();
 
   // Define a few variables that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;       // Coordinates of output pixel
-  PointType transformedPoint;  // Coordinates of transformed pixel
-  PixelType displacementPixel; // the difference, cast to pixel type
+  // to an output pixel. The points of a scanline are transformed as one
+  // block, which lets the transform share work between them.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<PointType>                               outputPoints(lineLength); // Coordinates of output pixels
+  std::vector<typename TransformType::InputPointType>  transformInputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+  PointType                                            transformedPoint;  // Coordinates of transformed pixel
+  PixelType                                            displacementPixel; // the difference, cast to pixel type
 
 
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
@@ -189,24 +195,30 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   // Walk the output region for this thread.
   for (ImageScanlineIterator outIt(output, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    while (!outIt.IsAtEndOfLine())
+    // Determine the coordinates of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
     {
-      // Determine the index of the current output pixel
-      output->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+      output->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+      transformInputPoints[i] = outputPoints[i];
+    }
+
+    // Compute corresponding input pixel positions
+    transform->TransformPoints(transformInputPoints.data(), transformedPoints.data(), lineLength);
 
-      // Compute corresponding input pixel position
-      transformedPoint = transform->TransformPoint(outputPoint);
+    for (SizeValueType i = 0; i < lineLength; ++i, ++outIt)
+    {
+      transformedPoint = transformedPoints[i];
 
-      const typename PointType::VectorType displacementVector = transformedPoint - outputPoint;
+      const typename PointType::VectorType displacementVector = transformedPoint - outputPoints[i];
       // Cast PointType -> PixelType
       for (IndexValueType idx = 0; idx < ImageDimension; ++idx)
       {
         displacementPixel[idx] = static_cast<typename PixelType::ValueType>(displacementVector[idx]);
       }
       outIt.Set(displacementPixel);
-      ++outIt;
     }
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(lineLength);
   }
 }
 
@@ -52,6 +52,12 @@ namespace itk
  *
  *  For algorithmic details see \cite maurer2003.
  *
+ *  \par Multithreading
+ *  Each dimension is processed in turn, by parallel tasks over the lines of
+ *  the image along that dimension. The lines are processed in blocks of
+ *  adjacent lines, copied to contiguous line buffers, so that lines along
+ *  the slow axes are not accessed with a large stride.
+ *
  * \ingroup ImageFeatureExtraction
  * \ingroup ITKDistanceMap
  *
@@ -164,28 +170,33 @@ protected:
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
+  /** Number of adjacent lines copied together to the line buffers. */
+  static constexpr unsigned int LineBlockSize = 16;
 
+private:
+  /** Compute the distance along dimension d for the lines of the region,
+   * which spans the requested region along d. On the last dimension, also
+   * take the square root of the distances unless SquaredDistance is set. */
   void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
+  ProcessLines(unsigned int d, const OutputImageRegionType & region);
 
+  /** Compute the distance along dimension d on one line of nd pixels, whose
+   * foreground pixels are flagged in isForeground, using the work buffers g
+   * and h of nd elements. */
   void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
-  {
-    itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
-  }
+  Voronoi(unsigned int        d,
+          OutputPixelType *   line,
+          const bool *        isForeground,
+          OutputSizeValueType nd,
+          OutputPixelType *   g,
+          OutputPixelType *   h) const;
 
-private:
-  void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
+  bool
+  Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType) const;
 
   InputPixelType   m_BackgroundValue{};
   InputSpacingType m_Spacing{};
 
-  unsigned int m_CurrentDimension{ 0 };
-
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
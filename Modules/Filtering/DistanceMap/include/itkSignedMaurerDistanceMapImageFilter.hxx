@@ -22,10 +22,14 @@
 #include "itkImageRegionIterator.h"
 #include "itkBinaryThresholdImageFilter.h"
 #include "itkBinaryContourImageFilter.h"
+#include "itkIndexRange.h"
 #include "itkProgressReporter.h"
 #include "itkProgressAccumulator.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMath.h"
-#include "vnl/vnl_vector.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace itk
 {
@@ -34,68 +38,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SignedMaurerDista
   : m_BackgroundValue(InputPixelType{})
   , m_Spacing()
   , m_InputCache(nullptr)
-{
-  this->DynamicMultiThreadingOff();
-}
-
-template <typename TInputImage, typename TOutputImage>
-unsigned int
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SplitRequestedRegion(unsigned int            i,
-                                                                                    unsigned int            num,
-                                                                                    OutputImageRegionType & splitRegion)
-{
-  // Get the output pointer
-  OutputImageType * outputPtr = this->GetOutput();
-
-  // Initialize the splitRegion to the output requested region
-  splitRegion = outputPtr->GetRequestedRegion();
-
-  const OutputSizeType & requestedRegionSize = splitRegion.GetSize();
-
-  OutputIndexType splitIndex = splitRegion.GetIndex();
-  OutputSizeType  splitSize = splitRegion.GetSize();
-
-  // split on the outermost dimension available
-  // and avoid the current dimension
-  int splitAxis = static_cast<int>(outputPtr->GetImageDimension()) - 1;
-  while ((requestedRegionSize[splitAxis] == 1) || (splitAxis == static_cast<int>(m_CurrentDimension)))
-  {
-    --splitAxis;
-    if (splitAxis < 0)
-    { // cannot split
-      itkDebugMacro("Cannot Split");
-      return 1;
-    }
-  }
-
-  // determine the actual number of pieces that will be generated
-  auto range = static_cast<double>(requestedRegionSize[splitAxis]);
-
-  auto               valuesPerThread = static_cast<unsigned int>(std::ceil(range / static_cast<double>(num)));
-  const unsigned int maxThreadIdUsed =
-    static_cast<unsigned int>(std::ceil(range / static_cast<double>(valuesPerThread))) - 1;
-
-  // Split the region
-  if (i < maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    splitSize[splitAxis] = valuesPerThread;
-  }
-  if (i == maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    // last thread needs to process the "rest" dimension being split
-    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
-  }
-
-  // set the split region ivars
-  splitRegion.SetIndex(splitIndex);
-  splitRegion.SetSize(splitSize);
-
-  itkDebugMacro("Split Piece: " << splitRegion);
-
-  return maxThreadIdUsed + 1;
-}
+{}
 
 template <typename TInputImage, typename TOutputImage>
 void
@@ -148,218 +91,166 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   this->GraftOutput(borderFilter->GetOutput());
 
-  // Set up the multithreaded processing
-  typename ImageSource<OutputImageType>::ThreadStruct str;
-  str.Filter = this;
-
-  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+  // process the dimensions in turn, each by parallel tasks over the lines
+  // along the dimension
+  const OutputImageRegionType region = outputPtr->GetRequestedRegion();
 
-  // multithread the execution
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
   for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    m_CurrentDimension = d;
-    this->GetMultiThreader()->SingleMethodExecute();
+    multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      d, region, [this, d](const OutputImageRegionType & lineRegion) { this->ProcessLines(d, lineRegion); }, nullptr);
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType                  threadId)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ProcessLines(unsigned int                  d,
+                                                                            const OutputImageRegionType & region)
 {
-  OutputImageType * outputImage = this->GetOutput();
-
-  const InputRegionType region = outputRegionForThread;
-  InputSizeType         size = region.GetSize();
-  InputIndexType        startIndex = outputRegionForThread.GetIndex();
-
   OutputImageType * outputPtr = this->GetOutput();
 
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector<InputSizeValueType> NumberOfRows;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
-  {
-    NumberOfRows.push_back(1);
-    for (unsigned int d = 0; d < InputImageDimension; ++d)
-    {
-      if (d != i)
-      {
-        NumberOfRows[i] *= size[d];
-      }
-    }
-  }
-
-  // set the progress reporter. Use a pointer to be able to destroy it before
-  // the creation of progress2
-  // so it won't set wrong progress at the end of ThreadedGenerateData()
-  float progressPerDimension = 0.67f / float{ ImageDimension };
-  if (!this->m_SquaredDistance)
-  {
-    progressPerDimension = 0.67f / (float{ ImageDimension } + 1);
-  }
-  auto progress =
-    std::make_unique<ProgressReporter>(this,
-                                       threadId,
-                                       NumberOfRows[m_CurrentDimension],
-                                       30,
-                                       0.33f + static_cast<float>(m_CurrentDimension * progressPerDimension),
-                                       progressPerDimension);
-
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each
-  // dimension.
-  vnl_vector<unsigned int> k(InputImageDimension - 1);
-  unsigned int             count = 0;
-  k[count] = 1;
-  for (unsigned int d = m_CurrentDimension + InputImageDimension - 1; d > m_CurrentDimension + 1; d--)
-  {
-    k[count + 1] = k[count] * size[d % InputImageDimension];
-    ++count;
-  }
-  k.flip();
-
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType       index;
-  OutputIndexType          offsetIndex{};
-  const InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType          idx{};
-
-  for (InputSizeValueType n = 0; n < tempRow; ++n)
+  TotalProgressReporter progress(
+    this, outputPtr->GetRequestedRegion().GetNumberOfPixels(), 100, 0.67f / float{ ImageDimension });
+
+  // Blocks of adjacent lines are copied to contiguous line buffers. The lines
+  // of a block are adjacent along the first other dimension, so that the
+  // copies read and write consecutive pixels even when the lines are along a
+  // slow axis.
+  const unsigned int    blockDimension = (d == 0 && ImageDimension > 1) ? 1 : 0;
+  OutputImageRegionType blockRegion = region;
+  blockRegion.SetSize(d, 1);
+  SizeValueType blockSize = 1;
+  if (blockDimension != d)
   {
-    index = n;
-    count = 0;
-    for (unsigned int d = m_CurrentDimension + 1; d < m_CurrentDimension + InputImageDimension; ++d)
-    {
-      offsetIndex[d % InputImageDimension] =
-        static_cast<OutputIndexValueType>(static_cast<double>(index) / static_cast<double>(k[count]));
-      idx[d % InputImageDimension] =
-        offsetIndex[d % InputImageDimension] + static_cast<OutputIndexValueType>(startIndex[d % InputImageDimension]);
-
-      index %= k[count];
-      ++count;
-    }
-    this->Voronoi(m_CurrentDimension, idx, outputImage);
-    progress->CompletedPixel();
+    blockSize = LineBlockSize;
+    blockRegion.SetIndex(blockDimension, 0);
+    blockRegion.SetSize(blockDimension, (region.GetSize(blockDimension) + blockSize - 1) / blockSize);
   }
-  progress.reset();
-
-  if (m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance)
-  {
-    using OutputIterator = ImageRegionIterator<OutputImageType>;
-    using InputIterator = ImageRegionConstIterator<InputImageType>;
 
-    const typename OutputImageType::RegionType outputRegion = outputRegionForThread;
+  const OutputSizeValueType    nd = region.GetSize(d);
+  std::vector<OutputPixelType> lines(blockSize * nd);
+  const auto                   isForeground = std::make_unique<bool[]>(blockSize * nd);
+  std::vector<OutputPixelType> g(nd);
+  std::vector<OutputPixelType> h(nd);
 
-    OutputIterator Ot(outputPtr, outputRegion);
-    InputIterator  It(m_InputCache, outputRegion);
+  OutputPixelType * const      outputBuffer = outputPtr->GetBufferPointer();
+  const InputPixelType * const inputBuffer = m_InputCache->GetBufferPointer();
+  const OffsetValueType        outputStride = outputPtr->GetOffsetTable()[d];
+  const OffsetValueType        outputBlockStride = outputPtr->GetOffsetTable()[blockDimension];
+  const OffsetValueType        inputStride = m_InputCache->GetOffsetTable()[d];
+  const OffsetValueType        inputBlockStride = m_InputCache->GetOffsetTable()[blockDimension];
 
-    Ot.GoToBegin();
-    It.GoToBegin();
+  const bool takeSquareRoot = (d == ImageDimension - 1) && !this->m_SquaredDistance;
 
-    ProgressReporter progress2(this,
-                               threadId,
-                               outputRegionForThread.GetNumberOfPixels(),
-                               30,
-                               0.33f + static_cast<float>(ImageDimension * progressPerDimension),
-                               progressPerDimension);
+  using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
 
-    using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
-
-    while (!Ot.IsAtEnd())
+  for (OutputIndexType lineIndex : ImageRegionIndexRange<ImageDimension>(blockRegion))
+  {
+    SizeValueType numberOfLines = 1;
+    if (blockDimension != d)
     {
-      // cast to a real type is required on some platforms
-      const auto outputValue =
-        static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(Ot.Get()))));
+      lineIndex[blockDimension] = region.GetIndex(blockDimension) + lineIndex[blockDimension] * blockSize;
+      numberOfLines = std::min(
+        blockSize,
+        static_cast<SizeValueType>(region.GetIndex(blockDimension) + region.GetSize(blockDimension) -
+                                   lineIndex[blockDimension]));
+    }
+    const OffsetValueType outputOffset = outputPtr->ComputeOffset(lineIndex);
+    const OffsetValueType inputOffset = m_InputCache->ComputeOffset(lineIndex);
 
-      if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
+    // visit the pixels of the block in memory order
+    const auto forEachPixelOfBlock = [d, nd, numberOfLines](const auto & function) {
+      if (d == 0)
       {
-        if (this->GetInsideIsPositive())
+        for (SizeValueType b = 0; b < numberOfLines; ++b)
         {
-          Ot.Set(outputValue);
-        }
-        else
-        {
-          Ot.Set(-outputValue);
+          for (OutputSizeValueType i = 0; i < nd; ++i)
+          {
+            function(b, i);
+          }
         }
       }
       else
       {
-        if (this->GetInsideIsPositive())
+        for (OutputSizeValueType i = 0; i < nd; ++i)
         {
-          Ot.Set(-outputValue);
+          for (SizeValueType b = 0; b < numberOfLines; ++b)
+          {
+            function(b, i);
+          }
         }
-        else
+      }
+    };
+
+    forEachPixelOfBlock([&](SizeValueType b, OutputSizeValueType i) {
+      lines[b * nd + i] = outputBuffer[outputOffset + i * outputStride + b * outputBlockStride];
+      isForeground[b * nd + i] = Math::NotExactlyEquals(
+        inputBuffer[inputOffset + i * inputStride + b * inputBlockStride], this->m_BackgroundValue);
+    });
+
+    for (SizeValueType b = 0; b < numberOfLines; ++b)
+    {
+      OutputPixelType * const line = lines.data() + b * nd;
+      const bool * const      lineIsForeground = isForeground.get() + b * nd;
+
+      this->Voronoi(d, line, lineIsForeground, nd, g.data(), h.data());
+
+      if (takeSquareRoot)
+      {
+        for (OutputSizeValueType i = 0; i < nd; ++i)
         {
-          Ot.Set(outputValue);
+          // cast to a real type is required on some platforms
+          const auto outputValue =
+            static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(line[i]))));
+          line[i] = (lineIsForeground[i] == this->m_InsideIsPositive) ? outputValue : -outputValue;
         }
       }
-
-      ++Ot;
-      ++It;
-      progress2.CompletedPixel();
     }
+
+    forEachPixelOfBlock([&](SizeValueType b, OutputSizeValueType i) {
+      outputBuffer[outputOffset + i * outputStride + b * outputBlockStride] = lines[b * nd + i];
+    });
+
+    progress.Completed(numberOfLines * nd);
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int      d,
-                                                                       OutputIndexType   idx,
-                                                                       OutputImageType * output)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int        d,
+                                                                       OutputPixelType *   line,
+                                                                       const bool *        isForeground,
+                                                                       OutputSizeValueType nd,
+                                                                       OutputPixelType *   g,
+                                                                       OutputPixelType *   h) const
 {
-  const OutputRegionType    oRegion = output->GetRequestedRegion();
-  const OutputSizeValueType nd = oRegion.GetSize()[d];
-
-  vnl_vector<OutputPixelType> g(nd, 0);
-  vnl_vector<OutputPixelType> h(nd, 0);
-
-
-  const InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType        startIndex = iRegion.GetIndex();
-
-  OutputPixelType di;
+  const auto position = [this, d](OutputSizeValueType i) {
+    if (this->m_UseImageSpacing)
+    {
+      return static_cast<OutputPixelType>(i * this->m_Spacing[d]);
+    }
+    return static_cast<OutputPixelType>(i);
+  };
 
   int l = -1;
 
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
-
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i) * static_cast<OutputPixelType>(this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
+    const OutputPixelType di = line[i];
 
     if (Math::NotExactlyEquals(di, NumericTraits<OutputPixelType>::max()))
     {
-      if (l < 1)
-      {
-        ++l;
-        g(l) = di;
-        h(l) = iw;
-      }
-      else
+      const OutputPixelType iw = position(i);
+
+      while ((l >= 1) && this->Remove(g[l - 1], g[l], di, h[l - 1], h[l], iw))
       {
-        while ((l >= 1) && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw))
-        {
-          --l;
-        }
-        ++l;
-        g(l) = di;
-        h(l) = iw;
+        --l;
       }
+      ++l;
+      g[l] = di;
+      h[l] = iw;
     }
   }
 
@@ -372,25 +263,16 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
 
   l = 0;
 
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i * this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
+    const OutputPixelType iw = position(i);
 
-    OutputPixelType d1 = itk::Math::abs(g(l)) + (h(l) - iw) * (h(l) - iw);
+    OutputPixelType d1 = itk::Math::abs(g[l]) + (h[l] - iw) * (h[l] - iw);
 
     while (l < ns)
     {
       // be sure to compute d2 *only* if l < ns
-      const OutputPixelType d2 = itk::Math::abs(g(l + 1)) + (h(l + 1) - iw) * (h(l + 1) - iw);
+      const OutputPixelType d2 = itk::Math::abs(g[l + 1]) + (h[l + 1] - iw) * (h[l + 1] - iw);
       // then compare d1 and d2
       if (d1 <= d2)
       {
@@ -399,30 +281,8 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       ++l;
       d1 = d2;
     }
-    idx[d] = i + startIndex[d];
 
-    if (Math::NotExactlyEquals(m_InputCache->GetPixel(idx), this->m_BackgroundValue))
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, d1);
-      }
-      else
-      {
-        output->SetPixel(idx, -d1);
-      }
-    }
-    else
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, -d1);
-      }
-      else
-      {
-        output->SetPixel(idx, d1);
-      }
-    }
+    line[i] = (isForeground[i] == this->m_InsideIsPositive) ? d1 : -d1;
   }
 }
 
@@ -433,7 +293,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Remove(OutputPixe
                                                                       OutputPixelType df,
                                                                       OutputPixelType x1,
                                                                       OutputPixelType x2,
-                                                                      OutputPixelType xf)
+                                                                      OutputPixelType xf) const
 {
   const OutputPixelType a = x2 - x1;
   const OutputPixelType b = xf - x2;
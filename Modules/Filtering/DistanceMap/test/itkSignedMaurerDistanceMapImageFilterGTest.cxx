@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+// A few overlapping ellipsoids, cut by the image border.
+template <typename TImage>
+typename TImage::Pointer
+MakeMask(const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing)
+{
+  auto mask = TImage::New();
+  mask->SetRegions(size);
+  mask->SetSpacing(spacing);
+  mask->AllocateInitialized();
+
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    double                           first = 0.0;
+    double                           second = 0.0;
+    for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+    {
+      const double x = static_cast<double>(index[i]) / static_cast<double>(size[i]);
+      first += (x - 0.3) * (x - 0.3) * (i + 1);
+      second += (x - 0.75 + 0.1 * i) * (x - 0.75 + 0.1 * i);
+    }
+    it.Set(first < 0.06 || second < 0.04 ? 1 : 0);
+  }
+  return mask;
+}
+
+template <typename TMask, typename TOutput>
+typename TOutput::Pointer
+ComputeDistanceMap(const TMask * mask, itk::ThreadIdType numberOfWorkUnits, bool squared, bool useSpacing)
+{
+  auto filter = itk::SignedMaurerDistanceMapImageFilter<TMask, TOutput>::New();
+  filter->SetInput(mask);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->SetSquaredDistance(squared);
+  filter->SetUseImageSpacing(useSpacing);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+// Compares the distance map with the distance to the nearest of its zero
+// pixels, the boundary of the object, found by exhaustive search.
+template <typename TMask, typename TOutput>
+void
+CheckAgainstExhaustiveSearch(const TMask * mask, const TOutput * output, bool squared, bool useSpacing)
+{
+  using IndexType = typename TOutput::IndexType;
+  std::vector<IndexType> boundary;
+  for (itk::ImageRegionConstIteratorWithIndex<TOutput> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (std::abs(it.Get()) < 1e-6)
+    {
+      boundary.push_back(it.GetIndex());
+    }
+  }
+  ASSERT_FALSE(boundary.empty());
+
+  for (itk::ImageRegionConstIteratorWithIndex<TOutput> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double minimum = std::numeric_limits<double>::max();
+    for (const IndexType & boundaryIndex : boundary)
+    {
+      double distance = 0.0;
+      for (unsigned int i = 0; i < TOutput::ImageDimension; ++i)
+      {
+        const double spacing = useSpacing ? output->GetSpacing()[i] : 1.0;
+        const double difference = (it.GetIndex()[i] - boundaryIndex[i]) * spacing;
+        distance += difference * difference;
+      }
+      minimum = std::min(minimum, distance);
+    }
+    const double expected =
+      (mask->GetPixel(it.GetIndex()) != 0 ? -1.0 : 1.0) * (squared ? minimum : std::sqrt(minimum));
+    ASSERT_NEAR(it.Get(), expected, 1e-4 * std::max(1.0, std::abs(expected))) << "at " << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(SignedMaurerDistanceMapImageFilter, MatchesExhaustiveSearch)
+{
+  using MaskType = itk::Image<unsigned char, 3>;
+  using OutputType = itk::Image<float, 3>;
+
+  const auto mask = MakeMask<MaskType>({ { 23, 17, 12 } }, itk::MakeVector(1.5, 0.7, 2.0));
+  for (const bool squared : { false, true })
+  {
+    for (const bool useSpacing : { false, true })
+    {
+      const auto output = ComputeDistanceMap<MaskType, OutputType>(mask, 4, squared, useSpacing);
+      CheckAgainstExhaustiveSearch<MaskType, OutputType>(mask, output, squared, useSpacing);
+    }
+  }
+}
+
+
+TEST(SignedMaurerDistanceMapImageFilter, ResultDoesNotDependOnNumberOfWorkUnits)
+{
+  using MaskType = itk::Image<short, 3>;
+  using OutputType = itk::Image<double, 3>;
+
+  const auto mask = MakeMask<MaskType>({ { 45, 38, 21 } }, itk::MakeVector(0.9, 1.1, 1.7));
+  const auto serial = ComputeDistanceMap<MaskType, OutputType>(mask, 1, false, true);
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 3, 7, 64 })
+  {
+    const auto   parallel = ComputeDistanceMap<MaskType, OutputType>(mask, numberOfWorkUnits, false, true);
+    const size_t numberOfPixels = mask->GetBufferedRegion().GetNumberOfPixels();
+    for (size_t i = 0; i < numberOfPixels; ++i)
+    {
+      ASSERT_EQ(serial->GetBufferPointer()[i], parallel->GetBufferPointer()[i])
+        << "at pixel " << i << " with " << numberOfWorkUnits << " work units";
+    }
+  }
+}
+
+
+TEST(SignedMaurerDistanceMapImageFilter, InsideIsPositive)
+{
+  using MaskType = itk::Image<unsigned char, 2>;
+  using OutputType = itk::Image<float, 2>;
+
+  const auto mask = MakeMask<MaskType>({ { 40, 31 } }, itk::MakeVector(1.0, 1.0));
+  const auto insideIsNegative = ComputeDistanceMap<MaskType, OutputType>(mask, 3, false, true);
+  CheckAgainstExhaustiveSearch<MaskType, OutputType>(mask, insideIsNegative, false, true);
+
+  auto filter = itk::SignedMaurerDistanceMapImageFilter<MaskType, OutputType>::New();
+  filter->SetInput(mask);
+  filter->InsideIsPositiveOn();
+  filter->SetNumberOfWorkUnits(5);
+  filter->Update();
+  for (itk::ImageRegionConstIteratorWithIndex<OutputType> it(filter->GetOutput(), mask->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_EQ(it.Get(), -insideIsNegative->GetPixel(it.GetIndex()));
+  }
+}
@@ -22,10 +22,12 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkPriorityQueueContainer.h"
 #include "ITKFastMarchingExport.h"
 
 #include <queue>
 #include <functional>
+#include <unordered_map>
 
 namespace itk
 {
@@ -46,10 +48,27 @@ public:
     NoHandles,
     Strict
   };
+
+  /**
+   * \class Heap
+   * \ingroup ITKFastMarching
+   * Priority queue holding the trial nodes.
+   * */
+  enum class Heap : uint8_t
+  {
+    /** std::priority_queue, to which a node is pushed again each time its
+     * value is updated. The outdated entries are skipped when popped. */
+    StdPriorityQueue = 0,
+    /** itk::PriorityQueueContainer indexed by node, holding each trial node
+     * once and decreasing its key in place when its value is updated. */
+    IndexedPriorityQueue
+  };
 };
 // Define how to print enumeration
 extern ITKFastMarching_EXPORT std::ostream &
                               operator<<(std::ostream & out, const FastMarchingTraitsEnums::TopologyCheck value);
+extern ITKFastMarching_EXPORT std::ostream &
+                              operator<<(std::ostream & out, const FastMarchingTraitsEnums::Heap value);
 
 /**
  * \class FastMarchingBase
@@ -63,8 +82,10 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses a priority queue to locate the next proper node to update, selected
+ * with SetHeapType(): by default a std::priority_queue, which may hold
+ * several entries for the same node, or an itk::PriorityQueueContainer with
+ * decrease-key, which holds each trial node once.
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,10 +112,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * Use itk::PriorityQueueContainer instead.
- *
  * \par Topology constraints:
  * Additional flexibility in this class includes the implementation of
  * topology constraints for image-based fast marching.  Further details
@@ -158,19 +175,8 @@ public:
   using StoppingCriterionType = FastMarchingStoppingCriterionBase<TInput, TOutput>;
   using StoppingCriterionPointer = typename StoppingCriterionType::Pointer;
 
-  /*
-  using ElementIdentifier = long;
-
-  using PriorityQueueElementType = MinPriorityQueueElementWrapper< NodeType,
-    OutputPixelType,
-    ElementIdentifier >;
-
-  using PriorityQueueType = PriorityQueueContainer< PriorityQueueElementType,
-    PriorityQueueElementType, OutputPixelType, ElementIdentifier >;
-  using PriorityQueuePointer = typename PriorityQueueType::Pointer;
-  */
-
   using TopologyCheckEnum = FastMarchingTraitsEnums::TopologyCheck;
+  using HeapEnum = FastMarchingTraitsEnums::Heap;
 #if !defined(ITK_LEGACY_REMOVE)
   using TopologyCheckType = FastMarchingTraitsEnums::TopologyCheck;
   /**Exposes enums values for backwards compatibility*/
@@ -185,6 +191,17 @@ public:
   itkSetEnumMacro(TopologyCheck, TopologyCheckEnum);
   itkGetConstReferenceMacro(TopologyCheck, TopologyCheckEnum);
   /** @ITKEndGrouping */
+  /** Set/Get the priority queue holding the trial nodes. The
+   * IndexedPriorityQueue holds each trial node once, which bounds the size of
+   * the queue by the size of the front; the StdPriorityQueue (default) holds
+   * one entry per update of a node. */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(HeapType, HeapEnum);
+  itkGetConstReferenceMacro(HeapType, HeapEnum);
+  /** @ITKEndGrouping */
+  /** Get the largest number of entries held by the priority queue during the
+   * last update. */
+  itkGetConstMacro(PeakHeapSize, SizeValueType);
   /** Set/Get TrialPoints */
   /** @ITKStartGrouping */
   itkSetObjectMacro(TrialPoints, NodePairContainerType);
@@ -255,7 +272,6 @@ protected:
 
   bool m_CollectPoints{};
 
-  // PriorityQueuePointer m_Heap;
   using HeapContainerType = std::vector<NodePairType>;
   using NodeComparerType = std::greater<NodePairType>;
 
@@ -263,8 +279,70 @@ protected:
 
   PriorityQueueType m_Heap{};
 
+  using ElementIdentifier = IdentifierType;
+
+  using PriorityQueueElementType = MinPriorityQueueElementWrapper<NodeType, OutputPixelType, ElementIdentifier>;
+
+  using IndexedPriorityQueueType = PriorityQueueContainer<PriorityQueueElementType *,
+                                                          ElementWrapperPointerInterface<PriorityQueueElementType *>,
+                                                          OutputPixelType,
+                                                          ElementIdentifier>;
+  using IndexedPriorityQueuePointer = typename IndexedPriorityQueueType::Pointer;
+
+  /** Hash of a node: an image index or a mesh point identifier. */
+  struct NodeHasher
+  {
+    template <unsigned int VDimension>
+    size_t
+    operator()(const Index<VDimension> & index) const noexcept
+    {
+      size_t hash = 0;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        hash ^= std::hash<IndexValueType>{}(index[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+
+    template <typename TNode>
+    size_t
+    operator()(const TNode & node) const noexcept
+    {
+      return std::hash<TNode>{}(node);
+    }
+  };
+
+  /** Heap of the trial nodes, used with the IndexedPriorityQueue, whose
+   * elements point to m_HeapElements. */
+  IndexedPriorityQueuePointer m_IndexedHeap{};
+
+  /** Element of each trial node in m_IndexedHeap, whose address is stable
+   * while it is queued. */
+  std::unordered_map<NodeType, PriorityQueueElementType, NodeHasher> m_HeapElements{};
+
   TopologyCheckEnum m_TopologyCheck{};
 
+  HeapEnum m_HeapType{ HeapEnum::StdPriorityQueue };
+
+  SizeValueType m_PeakHeapSize{ 0 };
+
+  /** \brief Queue a trial node, or decrease its value if it is already in the
+   * IndexedPriorityQueue */
+  void
+  PushNodePair(const NodePairType & iNodePair);
+
+  /** \brief Remove the trial node with the smallest value from the heap */
+  NodePairType
+  PopNodePair();
+
+  /** \brief Check if the heap is empty */
+  [[nodiscard]] bool
+  IsHeapEmpty() const;
+
+  /** \brief Remove all nodes from the heap and release its memory */
+  void
+  ClearHeap();
+
   /** \brief Get the total number of nodes in the domain */
   [[nodiscard]] virtual IdentifierType
   GetTotalNumberOfNodes() const = 0;
@@ -22,6 +22,7 @@
 
 #include "itkProgressReporter.h"
 #include "itkMath.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -41,7 +42,7 @@ FastMarchingBase<TInput, TOutput>::FastMarchingBase()
   , m_TopologyCheck(TopologyCheckEnum::Nothing)
 {
   this->ProcessObject::SetNumberOfRequiredInputs(0);
-  // m_Heap = PriorityQueueType::New();
+  m_IndexedHeap = IndexedPriorityQueueType::New();
 }
 // -----------------------------------------------------------------------------
 
@@ -54,6 +55,87 @@ FastMarchingBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) c
   os << indent << "Speed constant: " << m_SpeedConstant << std::endl;
   os << indent << "Topology check: " << m_TopologyCheck << std::endl;
   os << indent << "Normalization Factor: " << m_NormalizationFactor << std::endl;
+  os << indent << "Heap type: " << m_HeapType << std::endl;
+  os << indent << "Peak heap size: " << m_PeakHeapSize << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+void
+FastMarchingBase<TInput, TOutput>::PushNodePair(const NodePairType & iNodePair)
+{
+  SizeValueType heapSize = 0;
+  if (m_HeapType == HeapEnum::IndexedPriorityQueue)
+  {
+    const auto [elementIt, inserted] =
+      m_HeapElements.try_emplace(iNodePair.GetNode(), iNodePair.GetNode(), iNodePair.GetValue());
+    PriorityQueueElementType * element = &elementIt->second;
+    if (inserted)
+    {
+      m_IndexedHeap->Push(element);
+    }
+    else
+    {
+      element->m_Priority = iNodePair.GetValue();
+      m_IndexedHeap->Update(element);
+    }
+    heapSize = m_IndexedHeap->Size();
+  }
+  else
+  {
+    m_Heap.push(iNodePair);
+    heapSize = m_Heap.size();
+  }
+  m_PeakHeapSize = std::max(m_PeakHeapSize, heapSize);
+}
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+auto
+FastMarchingBase<TInput, TOutput>::PopNodePair() -> NodePairType
+{
+  if (m_HeapType == HeapEnum::IndexedPriorityQueue)
+  {
+    const PriorityQueueElementType * element = m_IndexedHeap->Peek();
+    const NodePairType               nodePair(element->m_Element, element->m_Priority);
+    m_IndexedHeap->Pop();
+    m_HeapElements.erase(nodePair.GetNode());
+    return nodePair;
+  }
+
+  const NodePairType nodePair = m_Heap.top();
+  m_Heap.pop();
+  return nodePair;
+}
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+bool
+FastMarchingBase<TInput, TOutput>::IsHeapEmpty() const
+{
+  if (m_HeapType == HeapEnum::IndexedPriorityQueue)
+  {
+    return m_IndexedHeap->Empty();
+  }
+  return m_Heap.empty();
+}
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template <typename TInput, typename TOutput>
+void
+FastMarchingBase<TInput, TOutput>::ClearHeap()
+{
+  PriorityQueueType().swap(m_Heap);
+  m_IndexedHeap->Clear();
+  m_HeapElements = {};
 }
 
 // -----------------------------------------------------------------------------
@@ -88,16 +170,8 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
   }
 
   // make sure the heap is empty
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
+  this->ClearHeap();
+  m_PeakHeapSize = 0;
 
   this->InitializeOutput(oDomain);
 
@@ -124,18 +198,9 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
 
   try
   {
-    // while( !m_Heap->Empty() )
-    while (!m_Heap.empty())
+    while (!this->IsHeapEmpty())
     {
-      // PriorityQueueElementType element = m_Heap->Peek();
-      // m_Heap->Pop();
-      //
-      // NodeType current_node = element.m_Element;
-      // OutputPixelType current_value = element.m_Priority;
-
-
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+      const NodePairType current_node_pair = this->PopNodePair();
 
       const NodeType current_node = current_node_pair.GetNode();
       current_value = this->GetOutputValue(output, current_node);
@@ -178,14 +243,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
     // it.
     //
     // RELEASE MEMORY!!!
-    while (!m_Heap.empty())
-    {
-      m_Heap.pop();
-    }
-    /*while( !m_Heap->Empty() )
-      {
-      m_Heap->Pop();
-      }*/
+    this->ClearHeap();
 
     throw ProcessAborted(__FILE__, __LINE__);
   }
@@ -193,14 +251,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
   m_TargetReachedValue = current_value;
 
   // let's release some useless memory...
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*while( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }*/
+  this->ClearHeap();
 }
 // -----------------------------------------------------------------------------
 
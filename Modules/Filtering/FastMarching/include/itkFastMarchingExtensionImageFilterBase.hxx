@@ -226,7 +226,7 @@ FastMarchingExtensionImageFilterBase<TInput, TOutput, TAuxValue, VAuxDimension>:
     // node.SetValue( outputPixel );
     // node.SetIndex( index );
     // m_TrialHeap.push(node);
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->PushNodePair(NodePairType(iNode, outputPixel));
 
     // update auxiliary values
     for (unsigned int k = 0; k < AuxDimension; ++k)
@@ -186,7 +186,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::UpdateValue(OutputImageType * oIma
     this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
     // Insert point into trial heap
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->PushNodePair(NodePairType(iNode, outputPixel));
   }
 }
 
@@ -528,8 +528,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType *
         outputPixel = pointsIter->Value().GetValue();
         this->SetOutputValue(oImage, idx, outputPixel);
 
-        // this->m_Heap->Push( PriorityQueueElementType( idx, pointsIter->second ) );
-        this->m_Heap.push(pointsIter->Value());
+        this->PushNodePair(pointsIter->Value());
       }
       ++pointsIter;
     }
@@ -37,4 +37,20 @@ operator<<(std::ostream & out, const FastMarchingTraitsEnums::TopologyCheck valu
     }
   }();
 }
+
+std::ostream &
+operator<<(std::ostream & out, const FastMarchingTraitsEnums::Heap value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case FastMarchingTraitsEnums::Heap::StdPriorityQueue:
+        return "itk::FastMarchingTraitsEnums::Heap::StdPriorityQueue";
+      case FastMarchingTraitsEnums::Heap::IndexedPriorityQueue:
+        return "itk::FastMarchingTraitsEnums::Heap::IndexedPriorityQueue";
+      default:
+        return "INVALID VALUE FOR itk::FastMarchingTraitsEnums::Heap";
+    }
+  }();
+}
 } // end namespace itk
@@ -128,6 +128,9 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     auto topologyCheck = ImageFastMarching::TopologyCheckEnum::Nothing;
     ITK_TEST_SET_GET_VALUE(topologyCheck, fmm->GetTopologyCheck());
 
+    auto heapType = ImageFastMarching::HeapEnum::StdPriorityQueue;
+    ITK_TEST_SET_GET_VALUE(heapType, fmm->GetHeapType());
+
     ITK_TEST_SET_GET_NULL_VALUE(fmm->GetTrialPoints());
 
     ITK_TEST_SET_GET_NULL_VALUE(fmm->GetAlivePoints());
@@ -155,6 +158,10 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     fmm->SetTopologyCheck(topologyCheck);
     ITK_TEST_SET_GET_VALUE(topologyCheck, fmm->GetTopologyCheck());
 
+    heapType = ImageFastMarching::HeapEnum::IndexedPriorityQueue;
+    fmm->SetHeapType(heapType);
+    ITK_TEST_SET_GET_VALUE(heapType, fmm->GetHeapType());
+
     auto                                     processedPoints = ImageFastMarching::NodePairContainerType::New();
     typename ImageFastMarching::NodePairType node_pair;
     constexpr ImageType::OffsetType          offset = { { 28, 35 } };
@@ -219,6 +226,14 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     std::cout << "STREAMED ENUM VALUE FastMarchingTraitsEnums::TopologyCheck: " << ee << std::endl;
   }
 
+  // Test streaming enumeration for FastMarchingTraitsEnums::Heap elements
+  const std::set<itk::FastMarchingTraitsEnums::Heap> allHeap{ itk::FastMarchingTraitsEnums::Heap::StdPriorityQueue,
+                                                              itk::FastMarchingTraitsEnums::Heap::IndexedPriorityQueue };
+  for (const auto & ee : allHeap)
+  {
+    std::cout << "STREAMED ENUM VALUE FastMarchingTraitsEnums::Heap: " << ee << std::endl;
+  }
+
 
   return EXIT_SUCCESS;
 }
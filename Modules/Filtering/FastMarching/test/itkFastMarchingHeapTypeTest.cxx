@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingQuadEdgeMeshFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkQuadEdgeMeshExtendedTraits.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+#include <iomanip>
+#include <unordered_map>
+
+namespace
+{
+using HeapEnum = itk::FastMarchingTraitsEnums::Heap;
+
+// Approximate number of bytes held by the heap per entry: one node pair for
+// the StdPriorityQueue; for the IndexedPriorityQueue, one pointer in the heap
+// and one element in the hash map of the queued nodes.
+template <typename TNode, typename TValue>
+size_t
+BytesPerHeapEntry(HeapEnum heapType)
+{
+  if (heapType == HeapEnum::StdPriorityQueue)
+  {
+    return sizeof(itk::NodePair<TNode, TValue>);
+  }
+  using ElementType = itk::MinPriorityQueueElementWrapper<TNode, TValue, itk::IdentifierType>;
+  using MapNodeType = typename std::unordered_map<TNode, ElementType>::value_type;
+  return sizeof(ElementType *) + sizeof(MapNodeType) + 2 * sizeof(void *);
+}
+
+template <typename TFilter>
+void
+Report(const char * domain, HeapEnum heapType, const TFilter * filter, const itk::TimeProbe & probe)
+{
+  const itk::SizeValueType peakHeapSize = filter->GetPeakHeapSize();
+  const size_t             bytes =
+    peakHeapSize * BytesPerHeapEntry<typename TFilter::NodeType, typename TFilter::OutputPixelType>(heapType);
+  const char * heapName = heapType == HeapEnum::StdPriorityQueue ? "StdPriorityQueue" : "IndexedPriorityQueue";
+  std::cout << std::setw(6) << domain << "  " << std::setw(20) << std::left << heapName << std::right << "  "
+            << std::setw(10) << probe.GetTotal() << "  " << std::setw(12) << peakHeapSize << "  " << std::setw(10)
+            << bytes / 1024 << std::endl;
+}
+
+// Arrival time on a cube with a spatially varying speed, from its center.
+template <typename TImage>
+typename TImage::Pointer
+MarchImage(const TImage * speed, HeapEnum heapType)
+{
+  using FastMarchingType = itk::FastMarchingImageFilterBase<TImage, TImage>;
+  using CriterionType = itk::FastMarchingThresholdStoppingCriterion<TImage, TImage>;
+
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(1e6);
+
+  typename TImage::IndexType center;
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    center[i] = speed->GetLargestPossibleRegion().GetSize(i) / 2;
+  }
+  auto trial = FastMarchingType::NodePairContainerType::New();
+  trial->push_back(typename FastMarchingType::NodePairType(center, 0.0));
+
+  auto marcher = FastMarchingType::New();
+  marcher->SetInput(speed);
+  marcher->SetTrialPoints(trial);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetHeapType(heapType);
+
+  itk::TimeProbe probe;
+  probe.Start();
+  marcher->Update();
+  probe.Stop();
+
+  Report("image", heapType, marcher.GetPointer(), probe);
+  return marcher->GetOutput();
+}
+
+template <typename TMesh>
+typename TMesh::Pointer
+MarchMesh(const TMesh * sphere, HeapEnum heapType)
+{
+  using FastMarchingType = itk::FastMarchingQuadEdgeMeshFilterBase<TMesh, TMesh>;
+  using CriterionType = itk::FastMarchingThresholdStoppingCriterion<TMesh, TMesh>;
+
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(1e6);
+
+  auto trial = FastMarchingType::NodePairContainerType::New();
+  trial->push_back(typename FastMarchingType::NodePairType(0, 0.0));
+
+  auto marcher = FastMarchingType::New();
+  marcher->SetInput(sphere);
+  marcher->SetTrialPoints(trial);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetHeapType(heapType);
+
+  itk::TimeProbe probe;
+  probe.Start();
+  marcher->Update();
+  probe.Stop();
+
+  Report("mesh", heapType, marcher.GetPointer(), probe);
+  return marcher->GetOutput();
+}
+} // namespace
+
+// Compares the arrival times, time taken and peak heap size of the two heap
+// types on an image of imageSize^3 voxels and on a sphere mesh of the given
+// resolution. Run with an imageSize of 512 to benchmark large volumes.
+int
+itkFastMarchingHeapTypeTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " imageSize sphereResolution" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const auto imageSize = static_cast<itk::SizeValueType>(std::stoul(argv[1]));
+  const auto sphereResolution = static_cast<unsigned int>(std::stoul(argv[2]));
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto speed = ImageType::New();
+  speed->SetRegions(ImageType::SizeType::Filled(imageSize));
+  speed->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(speed, speed->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(1.0f + 0.5f * std::sin(0.2f * index[0]) * std::cos(0.15f * index[1] + 0.1f * index[2]));
+  }
+
+  using TraitsType = itk::QuadEdgeMeshExtendedTraits<PixelType, Dimension, 2, double, double, PixelType, bool, bool>;
+  using MeshType = itk::QuadEdgeMesh<PixelType, Dimension, TraitsType>;
+
+  auto sphereSource = itk::RegularSphereMeshSource<MeshType>::New();
+  sphereSource->SetResolution(sphereResolution);
+  sphereSource->Update();
+  const MeshType::Pointer sphere = sphereSource->GetOutput();
+  for (MeshType::PointIdentifier id = 0; id < sphere->GetNumberOfPoints(); ++id)
+  {
+    sphere->SetPointData(id, 1.0f + 0.5f * static_cast<float>(id % 3));
+  }
+
+  std::cout << "Domain  Heap                  Time (s)    Peak entries  Peak KiB" << std::endl;
+
+  int result = EXIT_SUCCESS;
+
+  const ImageType::Pointer stdImage = MarchImage<ImageType>(speed, HeapEnum::StdPriorityQueue);
+  const ImageType::Pointer indexedImage = MarchImage<ImageType>(speed, HeapEnum::IndexedPriorityQueue);
+  double                   maximumImageDifference = 0.0;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(stdImage, stdImage->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    maximumImageDifference = std::max(
+      maximumImageDifference, static_cast<double>(std::abs(it.Get() - indexedImage->GetPixel(it.GetIndex()))));
+  }
+  if (maximumImageDifference > 1e-4)
+  {
+    std::cerr << "Image arrival times differ by " << maximumImageDifference << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  const MeshType::Pointer stdMesh = MarchMesh<MeshType>(sphere, HeapEnum::StdPriorityQueue);
+  const MeshType::Pointer indexedMesh = MarchMesh<MeshType>(sphere, HeapEnum::IndexedPriorityQueue);
+  double                  maximumMeshDifference = 0.0;
+  for (MeshType::PointIdentifier id = 0; id < stdMesh->GetNumberOfPoints(); ++id)
+  {
+    PixelType stdValue{};
+    PixelType indexedValue{};
+    stdMesh->GetPointData(id, &stdValue);
+    indexedMesh->GetPointData(id, &indexedValue);
+    maximumMeshDifference = std::max(maximumMeshDifference, static_cast<double>(std::abs(stdValue - indexedValue)));
+  }
+  if (maximumMeshDifference > 1e-4)
+  {
+    std::cerr << "Mesh arrival times differ by " << maximumMeshDifference << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  if (result == EXIT_SUCCESS)
+  {
+    std::cout << "Test PASSED" << std::endl;
+  }
+  return result;
+}
@@ -27,6 +27,7 @@
 #include "itkSize.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
+#include <type_traits> // For is_same_v and is_arithmetic_v.
 
 
 namespace itk
@@ -344,7 +345,9 @@ protected:
   NonlinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
   /** Implementation for resampling that works for with linear
-   *  transformation types. */
+   *  transformation types. With a linear or nearest neighbor interpolator
+   *  and a scalar input image, the part of each scan line that maps inside
+   *  the input buffer is interpolated directly from the buffer. */
   virtual void
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
@@ -373,6 +376,44 @@ private:
   void
   InitializeTransform();
 
+  /** Scalar pixels of an itk::Image can be interpolated directly from its buffer. */
+  static constexpr bool CanInterpolateBufferDirectly =
+    std::is_same_v<InputImageType, Image<InputPixelType, InputImageDimension>> && std::is_arithmetic_v<InputPixelType>;
+
+  /** Interpolation that LinearThreadedGenerateData evaluates directly on the input buffer, for the part of each
+   * scan line that maps inside the buffer. */
+  enum class DirectInterpolationEnum : uint8_t
+  {
+    None,
+    Linear,
+    NearestNeighbor
+  };
+
+  /** Returns Linear or NearestNeighbor when m_Interpolator is exactly a LinearInterpolateImageFunction (up to three
+   * dimensions) or a NearestNeighborInterpolateImageFunction, and the input supports direct buffer access. */
+  [[nodiscard]] DirectInterpolationEnum
+  GetDirectInterpolation() const;
+
+  /** The buffer of the input image, as accessed by the direct interpolation. */
+  struct InputBufferType
+  {
+    const InputPixelType * Pixels;
+    OffsetValueType        Strides[InputImageDimension];
+    IndexValueType         StartIndex[InputImageDimension];
+    IndexValueType         EndIndex[InputImageDimension];
+  };
+
+  /** Evaluates the linear interpolation at a continuous index inside the input buffer. Uses the same arithmetic as
+   * LinearInterpolateImageFunction, without its bounds checks and virtual calls. */
+  template <typename TInputBuffer>
+  static InterpolatorOutputType
+  EvaluateLinearInsideBuffer(const TInputBuffer & buffer, const ContinuousInputIndexType & index);
+
+  /** Evaluates the nearest neighbor interpolation at a continuous index inside the input buffer. */
+  template <typename TInputBuffer>
+  static InterpolatorOutputType
+  EvaluateNearestNeighborInsideBuffer(const TInputBuffer & buffer, const ContinuousInputIndexType & index);
+
   SizeType                m_Size{};         // Size of the output image
   InterpolatorPointerType m_Interpolator{}; // Image function for
                                             // interpolation
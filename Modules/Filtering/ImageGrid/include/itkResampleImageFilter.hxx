@@ -26,9 +26,14 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkMath.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 #include <algorithm>   // For max.
+#include <cmath>       // For ceil and floor.
 #include <type_traits> // For is_same.
+#include <typeinfo>    // For typeid.
+#include <vector>
 
 namespace itk
 {
@@ -378,45 +383,57 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
-
   using OutputType = typename InterpolatorType::OutputType;
 
+  // The points of a scanline are transformed as one block, which lets the
+  // transform share work between them.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+
   // Walk the output region
-  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
+    // Determine the coordinates of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
+    {
+      OutputPointType outputPoint; // Coordinates of current output pixel
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+      outputPoints[i] = outputPoint;
+    }
 
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), transformedPoints.data(), lineLength);
 
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
+    for (SizeValueType i = 0; i < lineLength; ++i, ++outIt)
+    {
+      const InputPointType inputPoint = transformedPoints[i];
 
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      ContinuousInputIndexType inputIndex;
+      const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
-    {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
-    }
-    else
-    {
-      if (m_Extrapolator.IsNull())
+      OutputType value;
+      // Evaluate input at right position and copy to the output
+      if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
+        outIt.Set(Self::CastPixelWithBoundsChecking(value));
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
+        }
+        else
+        {
+          value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
+          outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        }
       }
     }
-    progress.CompletedPixel();
+    progress.Completed(lineLength);
   }
 }
 
@@ -460,6 +477,66 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  const auto inputIndexAt = [&firstIndexValueOfLargestPossibleRegion, &firstSizeValueOfLargestPossibleRegion](
+                              const ContinuousInputIndexType & startIndex,
+                              const Vector<TInterpolatorPrecisionType, InputImageDimension> & vectorFromStartIndex,
+                              const IndexValueType                                            scanlineIndex) {
+    // Perform linear interpolation from startIndex, along vectorFromStartIndex
+    const double alpha =
+      (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
+
+    ContinuousInputIndexType inputIndex(startIndex);
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      inputIndex[i] += alpha * vectorFromStartIndex[i];
+    }
+    return inputIndex;
+  };
+
+  const auto interpolateOrExtrapolate = [this, &defaultValue](const ContinuousInputIndexType & inputIndex) {
+    // Evaluate input at right position
+    if (m_Interpolator->IsInsideBuffer(inputIndex))
+    {
+      return Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex));
+    }
+    if (m_Extrapolator.IsNull())
+    {
+      return defaultValue; // default background value
+    }
+    return Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex));
+  };
+
+  const DirectInterpolationEnum  directInterpolation = this->GetDirectInterpolation();
+  const ContinuousInputIndexType startContinuousIndexOfBuffer = m_Interpolator->GetStartContinuousIndex();
+  const ContinuousInputIndexType endContinuousIndexOfBuffer = m_Interpolator->GetEndContinuousIndex();
+
+  InputBufferType inputBuffer{};
+  if constexpr (CanInterpolateBufferDirectly)
+  {
+    inputBuffer.Pixels = inputPtr->GetBufferPointer();
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      inputBuffer.Strides[i] = inputPtr->GetOffsetTable()[i];
+      inputBuffer.StartIndex[i] = m_Interpolator->GetStartIndex()[i];
+      inputBuffer.EndIndex[i] = m_Interpolator->GetEndIndex()[i];
+    }
+  }
+
+  // Same test as ImageFunction::IsInsideBuffer, without the virtual call.
+  const auto isInsideBuffer = [&startContinuousIndexOfBuffer,
+                               &endContinuousIndexOfBuffer](const ContinuousInputIndexType & inputIndex) {
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      if (!(inputIndex[i] >= startContinuousIndexOfBuffer[i] && inputIndex[i] < endContinuousIndexOfBuffer[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const auto lineLength = static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -473,46 +550,198 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = outIt.GetIndex()[0];
-
+    IndexValueType       scanlineIndex = outIt.GetIndex()[0];
+    const IndexValueType endOfLine = scanlineIndex + lineLength;
 
-    while (!outIt.IsAtEndOfLine())
+    // The pixels of [spanBegin, spanEnd) map inside the input buffer, and are
+    // interpolated directly from the buffer, without bounds checks.
+    IndexValueType spanBegin = endOfLine;
+    IndexValueType spanEnd = endOfLine;
+    if (directInterpolation != DirectInterpolationEnum::None)
     {
-
-      // Perform linear interpolation from startIndex, along vectorFromStartIndex
-      const double alpha =
-        (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
-
-      ContinuousInputIndexType inputIndex(startIndex);
+      // Estimate the span by intersecting the scan line with the buffer. The
+      // continuous index is monotone along the scan line, so the pixels inside
+      // the buffer are contiguous, and the estimate only needs its ends to be
+      // shrunk until they are inside, using the exact test.
+      double spanBeginEstimate = scanlineIndex;
+      double spanEndEstimate = endOfLine;
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
-        inputIndex[i] += alpha * vectorFromStartIndex[i];
+        const double start = startIndex[i];
+        const double step = vectorFromStartIndex[i] / firstSizeValueOfLargestPossibleRegion;
+        if (step == 0.0)
+        {
+          if (!(start >= startContinuousIndexOfBuffer[i] && start < endContinuousIndexOfBuffer[i]))
+          {
+            spanEndEstimate = spanBeginEstimate;
+          }
+          continue;
+        }
+        const double crossing1 =
+          firstIndexValueOfLargestPossibleRegion + (startContinuousIndexOfBuffer[i] - start) / step;
+        const double crossing2 =
+          firstIndexValueOfLargestPossibleRegion + (endContinuousIndexOfBuffer[i] - start) / step;
+        // Written such that NaN crossings leave the estimate unchanged.
+        if (std::min(crossing1, crossing2) > spanBeginEstimate)
+        {
+          spanBeginEstimate = std::min(crossing1, crossing2);
+        }
+        if (std::max(crossing1, crossing2) < spanEndEstimate)
+        {
+          spanEndEstimate = std::max(crossing1, crossing2);
+        }
       }
-
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      if (spanBeginEstimate < spanEndEstimate)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        spanBegin = static_cast<IndexValueType>(std::ceil(spanBeginEstimate));
+        spanEnd = std::min(static_cast<IndexValueType>(std::floor(spanEndEstimate)) + 1, endOfLine);
+        while (spanBegin < spanEnd && !isInsideBuffer(inputIndexAt(startIndex, vectorFromStartIndex, spanBegin)))
+        {
+          ++spanBegin;
+        }
+        while (spanEnd > spanBegin && !isInsideBuffer(inputIndexAt(startIndex, vectorFromStartIndex, spanEnd - 1)))
+        {
+          --spanEnd;
+        }
       }
-      else
+    }
+
+    for (; scanlineIndex < spanBegin; ++scanlineIndex, ++outIt)
+    {
+      outIt.Set(interpolateOrExtrapolate(inputIndexAt(startIndex, vectorFromStartIndex, scanlineIndex)));
+    }
+    if constexpr (CanInterpolateBufferDirectly)
+    {
+      if (directInterpolation == DirectInterpolationEnum::Linear)
       {
-        if (m_Extrapolator.IsNull())
+        for (; scanlineIndex < spanEnd; ++scanlineIndex, ++outIt)
         {
-          outIt.Set(defaultValue); // default background value
+          outIt.Set(Self::CastPixelWithBoundsChecking(Self::EvaluateLinearInsideBuffer(
+            inputBuffer, inputIndexAt(startIndex, vectorFromStartIndex, scanlineIndex))));
         }
-        else
+      }
+      else
+      {
+        for (; scanlineIndex < spanEnd; ++scanlineIndex, ++outIt)
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          outIt.Set(Self::CastPixelWithBoundsChecking(Self::EvaluateNearestNeighborInsideBuffer(
+            inputBuffer, inputIndexAt(startIndex, vectorFromStartIndex, scanlineIndex))));
         }
       }
-
-      ++outIt;
-      ++scanlineIndex;
+    }
+    for (; scanlineIndex < endOfLine; ++scanlineIndex, ++outIt)
+    {
+      outIt.Set(interpolateOrExtrapolate(inputIndexAt(startIndex, vectorFromStartIndex, scanlineIndex)));
     }
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
 
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  GetDirectInterpolation() const -> DirectInterpolationEnum
+{
+  if constexpr (CanInterpolateBufferDirectly)
+  {
+    // Subclasses of the interpolators may override their evaluation, so the
+    // exact type is required.
+    const InterpolatorType & interpolator = *m_Interpolator;
+    if (InputImageDimension <= 3 && typeid(interpolator) == typeid(LinearInterpolatorType))
+    {
+      return DirectInterpolationEnum::Linear;
+    }
+    if (typeid(interpolator) ==
+        typeid(NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>))
+    {
+      return DirectInterpolationEnum::NearestNeighbor;
+    }
+  }
+  return DirectInterpolationEnum::None;
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <typename TInputBuffer>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  EvaluateLinearInsideBuffer(const TInputBuffer & buffer, const ContinuousInputIndexType & index)
+    -> InterpolatorOutputType
+{
+  using RealType = InterpolatorOutputType;
+  using InternalComputationType = TInterpolatorPrecisionType;
+  constexpr unsigned int numberOfNeighbors = 1U << InputImageDimension;
+
+  OffsetValueType         offset = 0;
+  InternalComputationType distance[InputImageDimension];
+  OffsetValueType         neighborOffset[InputImageDimension];
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    const IndexValueType baseIndex = std::max(Math::Floor<IndexValueType>(index[i]), buffer.StartIndex[i]);
+    offset += (baseIndex - buffer.StartIndex[i]) * buffer.Strides[i];
+    distance[i] = index[i] - static_cast<InternalComputationType>(baseIndex);
+
+    // Like LinearInterpolateImageFunction, do not interpolate along a
+    // dimension when the index is on (or before) the base pixel, or when the
+    // base pixel is the last one of the buffer.
+    const bool hasNeighbor = distance[i] > 0.0 && baseIndex < buffer.EndIndex[i];
+    distance[i] = hasNeighbor ? distance[i] : InternalComputationType{};
+    neighborOffset[i] = hasNeighbor ? buffer.Strides[i] : 0;
+  }
+
+  const InputPixelType * const basePixel = buffer.Pixels + offset;
+
+  RealType values[numberOfNeighbors];
+  for (unsigned int neighbor = 0; neighbor < numberOfNeighbors; ++neighbor)
+  {
+    OffsetValueType neighborPixelOffset = 0;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      neighborPixelOffset += (neighbor & (1U << i)) ? neighborOffset[i] : 0;
+    }
+    values[neighbor] = static_cast<RealType>(basePixel[neighborPixelOffset]);
+  }
+
+  // Interpolate across "x" first, then across "y" and "z", in the order of
+  // LinearInterpolateImageFunction, to get the same values.
+  for (unsigned int i = 0, numberOfValues = numberOfNeighbors / 2; i < InputImageDimension; ++i, numberOfValues /= 2)
+  {
+    for (unsigned int n = 0; n < numberOfValues; ++n)
+    {
+      values[n] = (distance[i] > 0.0)
+                    ? static_cast<RealType>(values[2 * n] + (values[2 * n + 1] - values[2 * n]) * distance[i])
+                    : values[2 * n];
+    }
+  }
+  return values[0];
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <typename TInputBuffer>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  EvaluateNearestNeighborInsideBuffer(const TInputBuffer & buffer, const ContinuousInputIndexType & index)
+    -> InterpolatorOutputType
+{
+  OffsetValueType offset = 0;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    offset += (Math::Round<IndexValueType>(index[i]) - buffer.StartIndex[i]) * buffer.Strides[i];
+  }
+  return static_cast<InterpolatorOutputType>(buffer.Pixels[offset]);
+}
+
 template <typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -19,7 +19,11 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
 #include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -111,6 +115,104 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// An interpolator that evaluates exactly like TInterpolator, but whose type
+// makes ResampleImageFilter call it for each pixel, instead of interpolating
+// directly from the input buffer.
+template <typename TInterpolator>
+class PerPixelInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PerPixelInterpolator);
+
+  using Self = PerPixelInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  PerPixelInterpolator() = default;
+  ~PerPixelInterpolator() override = default;
+};
+
+
+// Resamples the image through an affine transform that maps the output scan
+// lines partially outside the input image.
+template <typename TImage>
+typename TImage::Pointer
+ResampleThroughAffineTransform(const TImage & image, itk::InterpolateImageFunction<TImage, double> & interpolator)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  const auto transform = itk::AffineTransform<double, Dimension>::New();
+  transform->Rotate(0, 1, 0.3);
+  transform->Scale(0.8);
+  transform->Translate(itk::MakeFilled<typename itk::AffineTransform<double, Dimension>::OutputVectorType>(-2.5));
+  if constexpr (Dimension > 2)
+  {
+    transform->Rotate(1, 2, -0.2);
+  }
+
+  const auto filter = itk::ResampleImageFilter<TImage, TImage>::New();
+  filter->SetInput(&image);
+  filter->SetTransform(transform);
+  filter->SetInterpolator(&interpolator);
+  filter->SetDefaultPixelValue(7);
+  filter->SetSize(image.GetLargestPossibleRegion().GetSize() + itk::MakeFilled<typename TImage::SizeType>(6));
+  filter->SetOutputOrigin(itk::MakeFilled<typename TImage::PointType>(-3.0));
+  filter->SetOutputSpacing(itk::MakeFilled<typename TImage::SpacingType>(0.9));
+  filter->Update();
+  return filter->GetOutput();
+}
+
+
+// Tests that the linear and nearest neighbor interpolation directly from the
+// input buffer yields the same output as calling the interpolators per pixel.
+template <typename TImage>
+void
+Expect_direct_interpolation_equals_per_pixel_interpolation(const typename TImage::SizeType & imageSize)
+{
+  const auto image = TImage::New();
+  image->SetRegions(imageSize);
+  image->Allocate();
+  image->SetSpacing(itk::MakeFilled<typename TImage::SpacingType>(1.1));
+
+  std::default_random_engine randomEngine;
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(std::uniform_int_distribution<>{ 0, 1000 }(randomEngine)));
+  }
+
+  const auto expect_equal_outputs = [&image](auto & directInterpolator, auto & perPixelInterpolator) {
+    const auto directOutput = ResampleThroughAffineTransform(*image, directInterpolator);
+    const auto perPixelOutput = ResampleThroughAffineTransform(*image, perPixelInterpolator);
+
+    size_t numberOfDefaultPixels = 0;
+    size_t numberOfDifferentPixels = 0;
+
+    itk::ImageRegionConstIterator<TImage> perPixelIt(perPixelOutput, perPixelOutput->GetBufferedRegion());
+    for (itk::ImageRegionConstIterator<TImage> directIt(directOutput, directOutput->GetBufferedRegion());
+         !directIt.IsAtEnd();
+         ++directIt, ++perPixelIt)
+    {
+      numberOfDefaultPixels += (perPixelIt.Get() == 7) ? 1 : 0;
+      numberOfDifferentPixels += (directIt.Get() != perPixelIt.Get()) ? 1 : 0;
+    }
+    EXPECT_EQ(numberOfDifferentPixels, 0);
+
+    // Both the direct and the per-pixel evaluation should have been exercised.
+    EXPECT_GT(numberOfDefaultPixels, 0);
+    EXPECT_LT(numberOfDefaultPixels, directOutput->GetBufferedRegion().GetNumberOfPixels());
+  };
+
+  using LinearInterpolatorType = itk::LinearInterpolateImageFunction<TImage>;
+  using NearestNeighborInterpolatorType = itk::NearestNeighborInterpolateImageFunction<TImage>;
+
+  expect_equal_outputs(*LinearInterpolatorType::New(), *PerPixelInterpolator<LinearInterpolatorType>::New());
+  expect_equal_outputs(*NearestNeighborInterpolatorType::New(),
+                       *PerPixelInterpolator<NearestNeighborInterpolatorType>::New());
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -172,3 +274,10 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+TEST(ResampleImageFilter, DirectInterpolationEqualsPerPixelInterpolation)
+{
+  Expect_direct_interpolation_equals_per_pixel_interpolation<itk::Image<float, 2>>({ { 40, 30 } });
+  Expect_direct_interpolation_equals_per_pixel_interpolation<itk::Image<short, 3>>({ { 17, 13, 11 } });
+}
@@ -21,6 +21,7 @@
 #include "itkScanlineFilterCommon.h"
 #include "itkLabelMap.h"
 #include "itkLabelObject.h"
+#include "itkCompactLabelMap.h"
 
 namespace itk
 {
@@ -35,14 +36,17 @@ namespace itk
  * that are reached earlier by a raster order scan have a lower
  * label.
  *
- * The GetOutput() function of this class returns an itk::LabelMap.
+ * The GetOutput() function of this class returns an itk::LabelMap, or an
+ * itk::CompactLabelMap when TOutputImage is a CompactLabelMap. The lines of
+ * a CompactLabelMap are written directly in its line array, without
+ * allocating any object.
  *
  * This implementation was taken from the Insight Journal paper:
  * https://doi.org/10.54294/q6auw4
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
- * \sa ConnectedComponentImageFilter, LabelImageToLabelMapFilter, LabelMap, LabelObject
+ * \sa ConnectedComponentImageFilter, LabelImageToLabelMapFilter, LabelMap, LabelObject, CompactLabelMap
  * \ingroup ITKLabelMap
  *
  * \sphinx
@@ -110,6 +114,8 @@ public:
   using OutputSizeType = typename TOutputImage::SizeType;
   using OutputOffsetType = typename TOutputImage::OffsetType;
   using OutputImagePixelType = typename TOutputImage::PixelType;
+  using LabelObjectType = typename TOutputImage::LabelObjectType;
+  using LabelObjectPointer = typename LabelObjectType::Pointer;
 
   /**
    * Set/Get whether the connected components are defined strictly by
@@ -182,6 +188,17 @@ protected:
   using WorkUnitData = typename ScanlineFunctions::WorkUnitData;
 
 private:
+  /** Add the lines of the line map to the label objects of a LabelMap. */
+  template <typename TLabelObject>
+  void
+  FillOutput(LabelMap<TLabelObject> * output, ProgressReporter & progress);
+
+  /** Copy the lines of the line map to the line array of a CompactLabelMap,
+   * sorted by label. */
+  template <typename TLabel, unsigned int VLabelMapDimension>
+  void
+  FillOutput(CompactLabelMap<TLabel, VLabelMapDimension> * output, ProgressReporter & progress);
+
   OutputPixelType m_OutputBackgroundValue{};
   InputPixelType  m_InputForegroundValue{};
   SizeValueType   m_NumberOfObjects{};
@@ -124,26 +124,101 @@ BinaryImageToLabelMapFilter<TInputImage, TOutputImage>::GenerateData()
                                             << ").");
   }
 
-  for (SizeValueType thisIdx = 0; thisIdx < linecount; ++thisIdx)
+  this->FillOutput(output, progress);
+
+  // clear and make sure memory is freed
+  std::deque<WorkUnitData>().swap(this->m_WorkUnitResults);
+  OffsetVectorType().swap(this->m_LineOffsets);
+  LineMapType().swap(this->m_LineMap);
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TLabelObject>
+void
+BinaryImageToLabelMapFilter<TInputImage, TOutputImage>::FillOutput(LabelMap<TLabelObject> * output,
+                                                                   ProgressReporter &       progress)
+{
+  // create the label objects in label order, so they are simply appended to
+  // the label map, and keep them at hand to add the lines without searching
+  // the label map for each line
+  std::vector<typename TLabelObject::Pointer> labelObjects;
+  labelObjects.reserve(m_NumberOfObjects);
+  std::vector<SizeValueType> objectOfLabel(this->m_UnionFind.size());
+  for (InternalLabelType label = 1; label < this->m_UnionFind.size(); ++label)
+  {
+    if (this->m_UnionFind[label] == label)
+    {
+      objectOfLabel[label] = labelObjects.size();
+      auto labelObject = TLabelObject::New();
+      labelObject->SetLabel(this->m_Consecutive[label]);
+      output->AddLabelObject(labelObject);
+      labelObjects.push_back(labelObject);
+    }
+  }
+
+  for (const LineEncodingType & line : this->m_LineMap)
   {
     // now fill the labelled sections
-    auto       cIt = this->m_LineMap[thisIdx].begin();
-    const auto cEnd = this->m_LineMap[thisIdx].end();
+    for (const RunLength & run : line)
+    {
+      const InternalLabelType Ilab = this->LookupSet(run.label);
+      labelObjects[objectOfLabel[Ilab]]->AddLine(run.where, run.length);
+    }
+    progress.CompletedPixel();
+  }
+}
 
-    while (cIt != cEnd)
+template <typename TInputImage, typename TOutputImage>
+template <typename TLabel, unsigned int VLabelMapDimension>
+void
+BinaryImageToLabelMapFilter<TInputImage, TOutputImage>::FillOutput(
+  CompactLabelMap<TLabel, VLabelMapDimension> * output,
+  ProgressReporter &                            progress)
+{
+  using CompactLabelMapType = CompactLabelMap<TLabel, VLabelMapDimension>;
+
+  // the objects are numbered in label order
+  typename CompactLabelMapType::LabelVectorType labels;
+  labels.reserve(m_NumberOfObjects);
+  std::vector<SizeValueType> objectOfLabel(this->m_UnionFind.size());
+  for (InternalLabelType label = 1; label < this->m_UnionFind.size(); ++label)
+  {
+    if (this->m_UnionFind[label] == label)
+    {
+      objectOfLabel[label] = labels.size();
+      labels.push_back(this->m_Consecutive[label]);
+    }
+  }
+
+  // count the lines of each object, and place them at the position of their
+  // object in the line array. The line map is in raster order, so the lines
+  // of each object are in raster order too.
+  typename CompactLabelMapType::LineOffsetContainerType lineOffsets(labels.size() + 1);
+  for (const LineEncodingType & line : this->m_LineMap)
+  {
+    for (const RunLength & run : line)
+    {
+      ++lineOffsets[objectOfLabel[this->LookupSet(run.label)] + 1];
+    }
+  }
+  for (SizeValueType i = 1; i < lineOffsets.size(); ++i)
+  {
+    lineOffsets[i] += lineOffsets[i - 1];
+  }
+
+  typename CompactLabelMapType::LineContainerType lines(lineOffsets.back());
+  std::vector<SizeValueType>                      nextLine(lineOffsets.begin(), lineOffsets.end() - 1);
+  for (const LineEncodingType & line : this->m_LineMap)
+  {
+    for (const RunLength & run : line)
     {
-      const InternalLabelType Ilab = this->LookupSet(cIt->label);
-      const OutputPixelType   lab = this->m_Consecutive[Ilab];
-      output->SetLine(cIt->where, cIt->length, lab);
-      ++cIt;
+      lines[nextLine[objectOfLabel[this->LookupSet(run.label)]]++] =
+        typename CompactLabelMapType::LineType(run.where, run.length);
     }
     progress.CompletedPixel();
   }
 
-  // clear and make sure memory is freed
-  std::deque<WorkUnitData>().swap(this->m_WorkUnitResults);
-  OffsetVectorType().swap(this->m_LineOffsets);
-  LineMapType().swap(this->m_LineMap);
+  output->SetLines(labels, lineOffsets, std::move(lines));
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -0,0 +1,396 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactLabelMap_h
+#define itkCompactLabelMap_h
+
+#include "itkImageBase.h"
+#include "itkWeakPointer.h"
+#include "itkCompactLabelObject.h"
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class CompactLabelMap
+ *  \brief Label map storing the lines of all its objects in a single array.
+ *
+ * CompactLabelMap represents a labeled image as LabelMap does, but stores
+ * the lines of all the label objects in one contiguous array, sorted by
+ * label and, for each label, in raster order. The label objects are
+ * CompactLabelObject instances stored contiguously in label order, each one
+ * referring to the range of its lines in the array. A label map with N
+ * objects and L lines thus uses three allocations, whatever N, instead of
+ * at least two per object for LabelMap.
+ *
+ * The content of the label map is set at once with SetLines(), typically by
+ * BinaryImageToLabelMapFilter. The label objects can't be modified, and
+ * have no attribute: CompactLabelMap is meant for the large label maps
+ * which are converted back to images or read object by object. The filters
+ * derived from LabelMapFilter which only read the lines of the objects,
+ * such as LabelMapToLabelImageFilter and LabelMapToBinaryImageFilter,
+ * accept a CompactLabelMap as input, and process its objects concurrently.
+ *
+ * To iterate over the label objects, use:
+   \code
+   for (typename LabelMapType::ConstIterator it(labelMap); !it.IsAtEnd(); ++it)
+     {
+     const LabelMapType::LabelObjectType * labelObject = it.GetLabelObject();
+     }
+   \endcode
+ *
+ * \sa LabelMap, CompactLabelObject, BinaryImageToLabelMapFilter
+ * \ingroup ImageObjects
+ * \ingroup LabeledImageObject
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabel, unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT CompactLabelMap : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompactLabelMap);
+
+  /** Standard class type aliases */
+  using Self = CompactLabelMap;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CompactLabelMap);
+
+  using LabelObjectType = CompactLabelObject<TLabel, VImageDimension>;
+
+  using typename Superclass::SizeValueType;
+  using LengthType = SizeValueType;
+
+  /** Dimension of the image. */
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** Label type alias support */
+  using LabelType = TLabel;
+  using PixelType = LabelType;
+
+  using LineType = typename LabelObjectType::LineType;
+
+  /** types used to set and expose the labels and the lines */
+  using LabelVectorType = std::vector<LabelType>;
+  using LineContainerType = std::vector<LineType>;
+  using LineOffsetContainerType = std::vector<SizeValueType>;
+
+  /** Index type alias support An index is used to access pixel values. */
+  using typename Superclass::IndexType;
+
+  /** Offset type alias support An offset is used to access pixel values. */
+  using typename Superclass::OffsetType;
+
+  /** Size type alias support A size is used to define region bounds. */
+  using typename Superclass::SizeType;
+
+  /** Direction type alias support A matrix of direction cosines. */
+  using typename Superclass::DirectionType;
+
+  /** Region type alias support A region is used to specify a subset of an image.
+   */
+  using typename Superclass::RegionType;
+
+  /** Spacing type alias support  Spacing holds the size of a pixel.  The
+   * spacing is the geometric distance between image samples. */
+  using typename Superclass::SpacingType;
+
+  /** Origin type alias support  The origin is the geometric coordinates
+   * of the index (0,0). */
+  using typename Superclass::PointType;
+
+  /** Offset type alias (relative position between indices) */
+  using typename Superclass::OffsetValueType;
+
+  /** Restore the data object to its initial state. This means releasing
+   * memory. */
+  void
+  Initialize() override;
+
+  /**  */
+  void
+  Allocate(bool initialize = false) override;
+
+  virtual void
+  Graft(const Self * imgData);
+
+  /**
+   * Replace the content of the label map. labels are the labels of the
+   * objects, in increasing order. The lines of labels[i] are the lines
+   * lineOffsets[i] to lineOffsets[i + 1] - 1 of lines, so lineOffsets has
+   * one more element than labels, and its last element is the number of
+   * lines. The lines of a label are sorted in raster order if they are not.
+   * This method throws an exception if the labels are not increasing, if
+   * one of them is the background label, or if the offsets are invalid.
+   */
+  void
+  SetLines(const LabelVectorType & labels, const LineOffsetContainerType & lineOffsets, LineContainerType lines);
+
+  /** Return the lines of all the label objects, sorted by label. */
+  const LineContainerType &
+  GetLines() const
+  {
+    return m_LineContainer;
+  }
+
+  /**
+   * Return the LabelObject with the label given in parameter. The label is
+   * searched with a binary search.
+   * This method throws an exception if the label doesn't exist in this image,
+   * or if the label is the background one.
+   */
+  /** @ITKStartGrouping */
+  LabelObjectType *
+  GetLabelObject(const LabelType & label);
+  const LabelObjectType *
+  GetLabelObject(const LabelType & label) const;
+  /** @ITKEndGrouping */
+  /**
+   * Return true is the image contains the label given in parameter and false
+   * otherwise. If the label is the background one, true is also returned, so
+   * this method may not be a good enough test before calling GetLabelObject().
+   */
+  bool
+  HasLabel(const LabelType label) const;
+
+  /**
+   * Return the LabelObject with at the position given in parameter. This
+   * method runs in constant time.
+   * This method throws an exception if the index doesn't exist in this image.
+   */
+  /** @ITKStartGrouping */
+  LabelObjectType *
+  GetNthLabelObject(const SizeValueType & pos);
+  const LabelObjectType *
+  GetNthLabelObject(const SizeValueType & pos) const;
+  /** @ITKEndGrouping */
+  /**
+   * Return the pixel value at a given index in the image. If the given index
+   * is contained in several objects, only the smallest label of those objects
+   * is returned. This method
+   * has a worst case complexity of O(L) where L is the number of lines in the
+   * image - use it with care.
+   */
+  const LabelType &
+  GetPixel(const IndexType & idx) const;
+
+  /**
+   * Remove all the labels in the image
+   */
+  void
+  ClearLabels();
+
+  /**
+   * Return the number of label objects in the image
+   */
+  typename Self::SizeValueType
+  GetNumberOfLabelObjects() const
+  {
+    return static_cast<SizeValueType>(m_LabelObjectContainer.size());
+  }
+
+  /**
+   * Return the labels of the label objects available in the label map
+   */
+  LabelVectorType
+  GetLabels() const;
+
+  /**
+   * Set/Get the background label
+   */
+  /** @ITKStartGrouping */
+  itkGetConstMacro(BackgroundValue, LabelType);
+  itkSetMacro(BackgroundValue, LabelType);
+  /** @ITKEndGrouping */
+
+  /**
+   * \class ConstIterator
+   * \brief A forward iterator over the LabelObjects of a CompactLabelMap
+   * \ingroup ITKLabelMap
+   */
+  class ConstIterator
+  {
+  public:
+    ConstIterator() = default;
+
+    ConstIterator(const Self * lm)
+      : m_Iterator(lm->m_LabelObjectContainer.data())
+      , m_Begin(lm->m_LabelObjectContainer.data())
+      , m_End(lm->m_LabelObjectContainer.data() + lm->m_LabelObjectContainer.size())
+    {}
+
+    [[nodiscard]] const LabelObjectType *
+    GetLabelObject() const
+    {
+      return m_Iterator;
+    }
+
+    [[nodiscard]] const LabelType &
+    GetLabel() const
+    {
+      return m_Iterator->GetLabel();
+    }
+
+    ConstIterator
+    operator++(int)
+    {
+      ConstIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    ConstIterator &
+    operator++()
+    {
+      ++m_Iterator;
+      return *this;
+    }
+
+    bool
+    operator==(const ConstIterator & iter) const
+    {
+      return m_Iterator == iter.m_Iterator && m_Begin == iter.m_Begin && m_End == iter.m_End;
+    }
+
+    ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(ConstIterator);
+
+    void
+    GoToBegin()
+    {
+      m_Iterator = m_Begin;
+    }
+
+    [[nodiscard]] bool
+    IsAtEnd() const
+    {
+      return m_Iterator == m_End;
+    }
+
+  private:
+    const LabelObjectType * m_Iterator{};
+    const LabelObjectType * m_Begin{};
+    const LabelObjectType * m_End{};
+  };
+
+  /**
+   * \class Iterator
+   * \brief A forward iterator over the LabelObjects of a CompactLabelMap
+   *
+   * The label objects are read-only: this iterator only exists for the
+   * filters written for LabelMap, which get non-const label objects.
+   * \ingroup ITKLabelMap
+   */
+  class Iterator
+  {
+  public:
+    Iterator() = default;
+
+    Iterator(Self * lm)
+      : m_Iterator(lm->m_LabelObjectContainer.data())
+      , m_Begin(lm->m_LabelObjectContainer.data())
+      , m_End(lm->m_LabelObjectContainer.data() + lm->m_LabelObjectContainer.size())
+    {}
+
+    LabelObjectType *
+    GetLabelObject()
+    {
+      return m_Iterator;
+    }
+
+    [[nodiscard]] const LabelType &
+    GetLabel() const
+    {
+      return m_Iterator->GetLabel();
+    }
+
+    Iterator
+    operator++(int)
+    {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    Iterator &
+    operator++()
+    {
+      ++m_Iterator;
+      return *this;
+    }
+
+    bool
+    operator==(const Iterator & iter) const
+    {
+      return m_Iterator == iter.m_Iterator && m_Begin == iter.m_Begin && m_End == iter.m_End;
+    }
+
+    ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Iterator);
+
+    void
+    GoToBegin()
+    {
+      m_Iterator = m_Begin;
+    }
+
+    [[nodiscard]] bool
+    IsAtEnd() const
+    {
+      return m_Iterator == m_End;
+    }
+
+  private:
+    LabelObjectType * m_Iterator{};
+    LabelObjectType * m_Begin{};
+    LabelObjectType * m_End{};
+  };
+
+protected:
+  CompactLabelMap() = default;
+  ~CompactLabelMap() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+  void
+  Graft(const DataObject * data) override;
+  using Superclass::Graft;
+
+private:
+  /** the LabelObject container type */
+  using LabelObjectContainerType = std::vector<LabelObjectType>;
+
+  /** Create the label objects of the lines, which are in
+   * m_LineContainer. */
+  void
+  SetLabelObjects(const LabelVectorType & labels, const LineOffsetContainerType & lineOffsets);
+
+  LineContainerType        m_LineContainer{};
+  LabelObjectContainerType m_LabelObjectContainer{};
+  LabelType                m_BackgroundValue{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompactLabelMap.hxx"
+#endif
+
+#endif
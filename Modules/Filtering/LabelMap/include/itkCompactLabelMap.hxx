@@ -0,0 +1,288 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactLabelMap_hxx
+#define itkCompactLabelMap_hxx
+
+#include "itkLabelObjectLineComparator.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<LabelType>::PrintType>(m_BackgroundValue)
+     << std::endl;
+  os << indent << "NumberOfLabelObjects: " << m_LabelObjectContainer.size() << std::endl;
+  os << indent << "NumberOfLines: " << m_LineContainer.size() << std::endl;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::Initialize()
+{
+  this->ClearLabels();
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::Allocate(bool)
+{
+  this->Initialize();
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::Graft(const Self * imgData)
+{
+  if (imgData == nullptr)
+  {
+    return; // nothing to do
+  }
+  // call the superclass' implementation
+  Superclass::Graft(imgData);
+
+  // Now copy anything remaining that is needed. The label objects refer to
+  // the lines of their label map, so they are recreated on the copied lines.
+  if (imgData != this)
+  {
+    LabelVectorType         labels;
+    LineOffsetContainerType lineOffsets;
+    labels.reserve(imgData->m_LabelObjectContainer.size());
+    lineOffsets.reserve(imgData->m_LabelObjectContainer.size() + 1);
+    lineOffsets.push_back(0);
+    for (const LabelObjectType & labelObject : imgData->m_LabelObjectContainer)
+    {
+      labels.push_back(labelObject.GetLabel());
+      lineOffsets.push_back(lineOffsets.back() + labelObject.GetNumberOfLines());
+    }
+    m_LineContainer = imgData->m_LineContainer;
+    this->SetLabelObjects(labels, lineOffsets);
+  }
+  m_BackgroundValue = imgData->m_BackgroundValue;
+}
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::Graft(const DataObject * data)
+{
+  if (data == nullptr)
+  {
+    return; // nothing to do
+  }
+
+  // Attempt to cast data to an Image
+  const auto * imgData = dynamic_cast<const Self *>(data);
+
+  if (imgData == nullptr)
+  {
+    // pointer could not be cast back down
+    itkExceptionMacro("itk::CompactLabelMap::Graft() cannot cast " << typeid(data).name() << " to "
+                                                                   << typeid(const Self *).name());
+  }
+  this->Graft(imgData);
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::SetLines(const LabelVectorType &         labels,
+                                                   const LineOffsetContainerType & lineOffsets,
+                                                   LineContainerType               lines)
+{
+  if (lineOffsets.size() != labels.size() + 1 || lineOffsets.front() != 0 || lineOffsets.back() != lines.size())
+  {
+    itkExceptionMacro("Invalid line offsets: " << labels.size() + 1 << " offsets from 0 to " << lines.size()
+                                               << " expected.");
+  }
+  for (SizeValueType i = 0; i < labels.size(); ++i)
+  {
+    if (labels[i] == m_BackgroundValue)
+    {
+      itkExceptionMacro("Label " << static_cast<typename NumericTraits<LabelType>::PrintType>(labels[i])
+                                 << " is the background label.");
+    }
+    if (i > 0 && !(labels[i - 1] < labels[i]))
+    {
+      itkExceptionMacro("The labels are not in increasing order.");
+    }
+    if (lineOffsets[i + 1] < lineOffsets[i])
+    {
+      itkExceptionMacro("The line offsets are not in increasing order.");
+    }
+  }
+
+  m_LineContainer = std::move(lines);
+
+  // the lines of each label are kept in raster order
+  const Functor::LabelObjectLineComparator<LineType> comparator;
+  for (SizeValueType i = 0; i < labels.size(); ++i)
+  {
+    const auto begin = m_LineContainer.begin() + lineOffsets[i];
+    const auto end = m_LineContainer.begin() + lineOffsets[i + 1];
+    if (!std::is_sorted(begin, end, comparator))
+    {
+      std::sort(begin, end, comparator);
+    }
+  }
+
+  this->SetLabelObjects(labels, lineOffsets);
+  this->Modified();
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::SetLabelObjects(const LabelVectorType &         labels,
+                                                          const LineOffsetContainerType & lineOffsets)
+{
+  m_LabelObjectContainer.clear();
+  m_LabelObjectContainer.reserve(labels.size());
+  for (SizeValueType i = 0; i < labels.size(); ++i)
+  {
+    m_LabelObjectContainer.emplace_back(
+      labels[i], m_LineContainer.data() + lineOffsets[i], lineOffsets[i + 1] - lineOffsets[i]);
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetLabelObject(const LabelType & label) -> LabelObjectType *
+{
+  return const_cast<LabelObjectType *>(static_cast<const Self *>(this)->GetLabelObject(label));
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetLabelObject(const LabelType & label) const -> const LabelObjectType *
+{
+  if (m_BackgroundValue == label)
+  {
+    itkExceptionMacro("Label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
+                               << " is the background label.");
+  }
+  const auto it = std::lower_bound(
+    m_LabelObjectContainer.begin(),
+    m_LabelObjectContainer.end(),
+    label,
+    [](const LabelObjectType & labelObject, const LabelType & l) { return labelObject.GetLabel() < l; });
+  if (it == m_LabelObjectContainer.end() || it->GetLabel() != label)
+  {
+    itkExceptionMacro("No label object with label " << static_cast<typename NumericTraits<LabelType>::PrintType>(label)
+                                                    << '.');
+  }
+  return &*it;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+bool
+CompactLabelMap<TLabel, VImageDimension>::HasLabel(const LabelType label) const
+{
+  if (label == m_BackgroundValue)
+  {
+    return true;
+  }
+  const auto it = std::lower_bound(
+    m_LabelObjectContainer.begin(),
+    m_LabelObjectContainer.end(),
+    label,
+    [](const LabelObjectType & labelObject, const LabelType & l) { return labelObject.GetLabel() < l; });
+  return it != m_LabelObjectContainer.end() && it->GetLabel() == label;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetPixel(const IndexType & idx) const -> const LabelType &
+{
+  // the objects are sorted by label, so the first one found has the
+  // smallest label
+  for (const LabelObjectType & labelObject : m_LabelObjectContainer)
+  {
+    if (labelObject.HasIndex(idx))
+    {
+      return labelObject.GetLabel();
+    }
+  }
+  return m_BackgroundValue;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetNthLabelObject(const SizeValueType & pos) -> LabelObjectType *
+{
+  return const_cast<LabelObjectType *>(static_cast<const Self *>(this)->GetNthLabelObject(pos));
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetNthLabelObject(const SizeValueType & pos) const
+  -> const LabelObjectType *
+{
+  if (const auto numberOfLabelObjects = m_LabelObjectContainer.size(); numberOfLabelObjects <= pos)
+  {
+    itkExceptionMacro("Can't access label object at position " << pos << ". The label map has only "
+                                                               << numberOfLabelObjects << " label objects registered.");
+  }
+  return &m_LabelObjectContainer[pos];
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+CompactLabelMap<TLabel, VImageDimension>::ClearLabels()
+{
+  if (!m_LabelObjectContainer.empty() || !m_LineContainer.empty())
+  {
+    LabelObjectContainerType().swap(m_LabelObjectContainer);
+    LineContainerType().swap(m_LineContainer);
+    this->Modified();
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelMap<TLabel, VImageDimension>::GetLabels() const -> LabelVectorType
+{
+  LabelVectorType res;
+
+  res.reserve(this->GetNumberOfLabelObjects());
+  for (const LabelObjectType & labelObject : m_LabelObjectContainer)
+  {
+    res.push_back(labelObject.GetLabel());
+  }
+  return res;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,287 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactLabelObject_h
+#define itkCompactLabelObject_h
+
+#include "itkLabelObjectLine.h"
+#include "itkMacro.h"
+
+namespace itk
+{
+/**
+ * \class CompactLabelObject
+ *  \brief A read-only view of the lines of a label in a CompactLabelMap.
+ *
+ * CompactLabelObject is the label object type of CompactLabelMap. It is not
+ * allocated separately: the label objects are stored contiguously in the
+ * label map, and each one refers to its range of lines in the single line
+ * array of the label map. It only stores the label, the position of its
+ * first line and its number of lines.
+ *
+ * CompactLabelObject provides the read-only part of the interface of
+ * LabelObject, including the ConstLineIterator and ConstIndexIterator
+ * classes, so the filters which only read the lines of the label objects
+ * accept a CompactLabelMap. It has no attribute, and can't be modified.
+ *
+ * A label object stays valid as long as the lines of its label map are not
+ * replaced.
+ *
+ * \sa CompactLabelMap, LabelObject
+ * \ingroup DataRepresentation
+ * \ingroup LabeledImageObject
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabel, unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT CompactLabelObject
+{
+public:
+  /** Standard class type aliases */
+  using Self = CompactLabelObject;
+  using LabelObjectType = Self;
+
+  /** The label objects are owned by their label map. */
+  using Pointer = Self *;
+  using ConstPointer = const Self *;
+
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  using IndexType = Index<VImageDimension>;
+  using OffsetType = Offset<VImageDimension>;
+  using LabelType = TLabel;
+  using LineType = LabelObjectLine<VImageDimension>;
+  using LengthType = typename LineType::LengthType;
+  using SizeValueType = itk::SizeValueType;
+
+  CompactLabelObject() = default;
+
+  CompactLabelObject(const LabelType & label, const LineType * lines, SizeValueType numberOfLines)
+    : m_Label(label)
+    , m_Lines(lines)
+    , m_NumberOfLines(numberOfLines)
+  {}
+
+  /**
+   * Get the label associated with the object.
+   */
+  [[nodiscard]] const LabelType &
+  GetLabel() const
+  {
+    return m_Label;
+  }
+
+  /**
+   * Return true if the object contain the given index and false otherwise.
+   * Worst case complexity is O(L) where L is the number of lines in the object.
+   */
+  bool
+  HasIndex(const IndexType & idx) const;
+
+  [[nodiscard]] SizeValueType
+  GetNumberOfLines() const
+  {
+    return m_NumberOfLines;
+  }
+
+  const LineType &
+  GetLine(SizeValueType i) const;
+
+  /**
+   * Returns the number of pixels contained in the object.
+   */
+  SizeValueType
+  Size() const;
+
+  /**
+   * Returns true if there no line in the object (and thus no pixel in
+   * the object.
+   */
+  [[nodiscard]] bool
+  Empty() const
+  {
+    return m_NumberOfLines == 0;
+  }
+
+  /**
+   * Get the index of the ith pixel associated with the object.
+   * Valid indices are from 0 to LabelObject->GetSize() - 1.
+   */
+  IndexType
+  GetIndex(SizeValueType offset) const;
+
+  /**
+   * \class ConstLineIterator
+   * \brief A forward iterator over the lines of a CompactLabelObject
+   * \ingroup ITKLabelMap
+   */
+  class ConstLineIterator
+  {
+  public:
+    ConstLineIterator() = default;
+
+    ConstLineIterator(const Self * lo)
+      : m_Iterator(lo->m_Lines)
+      , m_Begin(lo->m_Lines)
+      , m_End(lo->m_Lines + lo->m_NumberOfLines)
+    {}
+
+    [[nodiscard]] const LineType &
+    GetLine() const
+    {
+      return *m_Iterator;
+    }
+
+    ConstLineIterator
+    operator++(int)
+    {
+      const ConstLineIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    ConstLineIterator &
+    operator++()
+    {
+      ++m_Iterator;
+      return *this;
+    }
+
+    bool
+    operator==(const ConstLineIterator & iter) const
+    {
+      return m_Iterator == iter.m_Iterator && m_Begin == iter.m_Begin && m_End == iter.m_End;
+    }
+
+    ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(ConstLineIterator);
+
+    void
+    GoToBegin()
+    {
+      m_Iterator = m_Begin;
+    }
+
+    [[nodiscard]] bool
+    IsAtEnd() const
+    {
+      return m_Iterator == m_End;
+    }
+
+  private:
+    const LineType * m_Iterator{};
+    const LineType * m_Begin{};
+    const LineType * m_End{};
+  };
+
+  /**
+   * \class ConstIndexIterator
+   * \brief A forward iterator over the indexes of a CompactLabelObject
+   * \ingroup ITKLabelMap
+   */
+  class ConstIndexIterator
+  {
+  public:
+    ConstIndexIterator() = default;
+
+    ConstIndexIterator(const Self * lo)
+      : m_Begin(lo->m_Lines)
+      , m_End(lo->m_Lines + lo->m_NumberOfLines)
+    {
+      GoToBegin();
+    }
+
+    [[nodiscard]] const IndexType &
+    GetIndex() const
+    {
+      return m_Index;
+    }
+
+    ConstIndexIterator &
+    operator++()
+    {
+      m_Index[0]++;
+      if (m_Index[0] >= m_Iterator->GetIndex()[0] + static_cast<OffsetValueType>(m_Iterator->GetLength()))
+      {
+        // we've reached the end of the line - go to the next one
+        ++m_Iterator;
+        NextValidLine();
+      }
+      return *this;
+    }
+
+    ConstIndexIterator
+    operator++(int)
+    {
+      ConstIndexIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool
+    operator==(const ConstIndexIterator & iter) const
+    {
+      return m_Index == iter.m_Index && m_Iterator == iter.m_Iterator && m_Begin == iter.m_Begin && m_End == iter.m_End;
+    }
+
+    ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(ConstIndexIterator);
+
+    void
+    GoToBegin()
+    {
+      m_Iterator = m_Begin;
+      m_Index.Fill(0);
+      NextValidLine();
+    }
+
+    [[nodiscard]] bool
+    IsAtEnd() const
+    {
+      return m_Iterator == m_End;
+    }
+
+  private:
+    void
+    NextValidLine()
+    {
+      // search for the next valid position
+      while (m_Iterator != m_End && m_Iterator->GetLength() == 0)
+      {
+        ++m_Iterator;
+      }
+      if (m_Iterator != m_End)
+      {
+        m_Index = m_Iterator->GetIndex();
+      }
+    }
+
+    const LineType * m_Iterator{};
+    const LineType * m_Begin{};
+    const LineType * m_End{};
+    IndexType        m_Index{};
+  };
+
+private:
+  LabelType        m_Label{};
+  const LineType * m_Lines{};
+  SizeValueType    m_NumberOfLines{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompactLabelObject.hxx"
+#endif
+
+#endif
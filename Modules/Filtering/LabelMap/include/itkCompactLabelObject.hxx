@@ -0,0 +1,79 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactLabelObject_hxx
+#define itkCompactLabelObject_hxx
+
+namespace itk
+{
+template <typename TLabel, unsigned int VImageDimension>
+bool
+CompactLabelObject<TLabel, VImageDimension>::HasIndex(const IndexType & idx) const
+{
+  for (SizeValueType i = 0; i < m_NumberOfLines; ++i)
+  {
+    if (m_Lines[i].HasIndex(idx))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelObject<TLabel, VImageDimension>::GetLine(SizeValueType i) const -> const LineType &
+{
+  return m_Lines[i];
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelObject<TLabel, VImageDimension>::Size() const -> SizeValueType
+{
+  SizeValueType size = 0;
+  for (SizeValueType i = 0; i < m_NumberOfLines; ++i)
+  {
+    size += m_Lines[i].GetLength();
+  }
+  return size;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+CompactLabelObject<TLabel, VImageDimension>::GetIndex(SizeValueType offset) const -> IndexType
+{
+  SizeValueType o = offset;
+  for (SizeValueType i = 0; i < m_NumberOfLines; ++i)
+  {
+    const SizeValueType size = m_Lines[i].GetLength();
+    if (o < size)
+    {
+      IndexType idx = m_Lines[i].GetIndex();
+      idx[0] += o;
+      return idx;
+    }
+    o -= size;
+  }
+  itkGenericExceptionMacro("Invalid offset: " << offset);
+}
+} // end namespace itk
+
+#endif
@@ -22,6 +22,8 @@
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
 
+#include <unordered_map>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -91,6 +93,13 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
   InputLineIteratorType it(this->GetInput(), regionForThread);
   it.SetDirection(0);
 
+  // the label objects of this thread are found with a single hash lookup
+  // per run, rather than by searching the label map. The runs of an object
+  // often follow each other, so the last object used is also kept.
+  OutputImageType *                                           temporaryImage = m_TemporaryImages[threadId];
+  std::unordered_map<OutputImagePixelType, LabelObjectType *> labelObjects;
+  LabelObjectType *                                           labelObject = nullptr;
+
   for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
   {
     it.GoToBeginOfLine();
@@ -112,7 +121,24 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
           ++it;
         }
         // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        const auto label = static_cast<OutputImagePixelType>(value);
+        if (labelObject == nullptr || labelObject->GetLabel() != label)
+        {
+          LabelObjectType *& threadLabelObject = labelObjects[label];
+          if (threadLabelObject == nullptr)
+          {
+            // the first run of the label in this thread
+            if (!temporaryImage->HasLabel(label))
+            {
+              const auto newLabelObject = LabelObjectType::New();
+              newLabelObject->SetLabel(label);
+              temporaryImage->AddLabelObject(newLabelObject);
+            }
+            threadLabelObject = temporaryImage->GetLabelObject(label);
+          }
+          labelObject = threadLabelObject;
+        }
+        labelObject->AddLine(idx, length);
       }
       else
       {
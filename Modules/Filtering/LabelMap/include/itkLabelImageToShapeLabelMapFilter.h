@@ -101,7 +101,7 @@ public:
   /** @ITKEndGrouping */
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false, because of the high computation time required.
+   * Default value is false.
    */
   /** @ITKStartGrouping */
   itkSetMacro(ComputeFeretDiameter, bool);
@@ -110,7 +110,7 @@ public:
   /** @ITKEndGrouping */
   /**
    * Set/Get whether the perimeter should be computed or not.
-   * Default value is false, because of the high computation time required.
+   * Default value is false.
    */
   /** @ITKStartGrouping */
   itkSetMacro(ComputePerimeter, bool);
@@ -370,7 +370,17 @@ LabelMap<TLabelObject>::AddLabelObject(LabelObjectType * labelObject)
 {
   itkAssertOrThrowMacro((labelObject != nullptr), "Input LabelObject can't be Null");
 
-  m_LabelObjectContainer[labelObject->GetLabel()] = labelObject;
+  const LabelType label = labelObject->GetLabel();
+  if (m_LabelObjectContainer.empty() || m_LabelObjectContainer.rbegin()->first < label)
+  {
+    // the objects are usually added in increasing label order: append the
+    // object without searching the container
+    m_LabelObjectContainer.emplace_hint(m_LabelObjectContainer.end(), label, labelObject);
+  }
+  else
+  {
+    m_LabelObjectContainer[label] = labelObject;
+  }
   this->Modified();
 }
 
@@ -29,7 +29,9 @@
 #define itkLabelMapFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -43,6 +45,10 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The objects are distributed dynamically to the work units, the largest
+ * ones first, so a few large objects don't leave the other threads idle at
+ * the end of the computation.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -135,7 +141,10 @@ protected:
   std::mutex m_LabelObjectContainerLock{};
 
 private:
-  typename InputImageType::Iterator m_LabelObjectIterator{};
+  /** The objects to process, sorted by decreasing number of lines. */
+  std::vector<LabelObjectType *> m_LabelObjects{};
+
+  std::atomic<SizeValueType> m_NextLabelObject{};
 };
 } // end namespace itk
 
@@ -27,6 +27,7 @@
  *=========================================================================*/
 #ifndef itkLabelMapFilter_hxx
 #define itkLabelMapFilter_hxx
+#include <algorithm>
 #include <mutex>
 #include "itkTotalProgressReporter.h"
 
@@ -68,13 +69,30 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  m_LabelObjectIterator = typename InputImageType::Iterator(this->GetLabelMap());
+  InputImageType * labelMap = this->GetLabelMap();
+
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve(labelMap->GetNumberOfLabelObjects());
+  for (typename InputImageType::Iterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    m_LabelObjects.push_back(it.GetLabelObject());
+  }
+
+  // the processing time of an object mostly depends on its number of lines:
+  // start with the largest objects, so the work units finish together
+  std::stable_sort(
+    m_LabelObjects.begin(), m_LabelObjects.end(), [](const LabelObjectType * a, const LabelObjectType * b) {
+      return a->GetNumberOfLines() > b->GetNumberOfLines();
+    });
+  m_NextLabelObject = 0;
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
 {
+  m_LabelObjects = std::vector<LabelObjectType *>();
+
   this->UpdateProgress(1.0);
 }
 
@@ -82,35 +100,16 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType &)
 {
-  const auto            numberOfLabelObjects = this->GetLabelMap()->GetNumberOfLabelObjects();
+  const SizeValueType   numberOfLabelObjects = m_LabelObjects.size();
   TotalProgressReporter progress(this, numberOfLabelObjects, numberOfLabelObjects);
-  while (true)
-  {
-    LabelObjectType * labelObject = nullptr;
-    // begin mutex lock
-    {
-      const std::lock_guard<std::mutex> lockGuard(m_LabelObjectContainerLock);
 
-      if (m_LabelObjectIterator.IsAtEnd())
-      {
-        // mutex lock holder deleted
-        return;
-      }
-
-      // get the label object
-      labelObject = m_LabelObjectIterator.GetLabelObject();
-
-      // increment the iterator now, so it will not be invalidated if the object
-      // is destroyed
-      ++m_LabelObjectIterator;
-
-      // unlock the mutex, so the other threads can get an object
-    }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
+  // each work unit takes the next object until all of them are processed. The
+  // list is built beforehand, so an object can be removed from the label map
+  // while the others are processed.
+  for (SizeValueType i = m_NextLabelObject++; i < numberOfLabelObjects; i = m_NextLabelObject++)
+  {
+    // run the user defined method for that object
+    this->ThreadedProcessLabelObject(m_LabelObjects[i]);
 
     progress.CompletedPixel();
   }
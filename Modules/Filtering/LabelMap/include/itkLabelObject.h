@@ -18,11 +18,11 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
 #include "itkObjectFactory.h"
+#include <vector>
 
 namespace itk
 {
@@ -34,7 +34,8 @@ namespace itk
  * It should be used associated with the LabelMap.
  *
  * LabelObject store mainly 2 things: the label of the object, and a set of lines
- * which are part of the object.
+ * which are part of the object. The lines are stored contiguously, in the order
+ * they were added.
  * No attribute is available in that class, so this class can be used as a base class
  * to implement a label object with attribute, or when no attribute is needed (see the
  * reconstruction filters for an example. If a simple attribute is needed,
@@ -271,7 +272,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -361,7 +362,7 @@ public:
     }
 
   private:
-    using LineContainerType = typename std::deque<LineType>;
+    using LineContainerType = typename std::vector<LineType>;
     using InternalIteratorType = typename LineContainerType::const_iterator;
     void
     NextValidLine()
@@ -389,7 +390,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
-  using LineContainerType = typename std::deque<LineType>;
+  using LineContainerType = typename std::vector<LineType>;
 
   LineContainerType m_LineContainer{};
   LabelType         m_Label{};
@@ -20,6 +20,7 @@
 
 #include "itkInPlaceLabelMapFilter.h"
 #include "itkLexicographicCompare.h"
+#include <vector>
 
 namespace itk
 {
@@ -30,15 +31,15 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * The label objects are processed concurrently. The Feret diameter is
+ * searched among the vertices of the convex hull of the object, and the
+ * perimeter is computed from the intercepts of the lines of the object, so
+ * both can be computed on label maps with many objects.
+ *
+ * ShapeLabelMapFilter takes an optional parameter, the exact copy of the
+ * input LabelMap stored in an Image. It can be set with SetLabelImage().
+ * It is no longer used by the computation of the attributes, and is only
+ * kept for backward compatibility.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -97,7 +98,7 @@ public:
 
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false because of the high computation time required.
+   * Default value is false.
    */
   /** @ITKStartGrouping */
   itkSetMacro(ComputeFeretDiameter, bool);
@@ -123,7 +124,7 @@ public:
   itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
   itkBooleanMacro(ComputeOrientedBoundingBox);
   /** @ITKEndGrouping */
-  /** Set the label image */
+  /** Set the label image. It is not used anymore. */
   void
   SetLabelImage(const TLabelImage * input)
   {
@@ -137,9 +138,6 @@ protected:
   void
   ThreadedProcessLabelObject(LabelObjectType * labelObject) override;
 
-  void
-  BeforeThreadedGenerateData() override;
-
   void
   AfterThreadedGenerateData() override;
 
@@ -159,6 +157,11 @@ private:
   void
   ComputeOrientedBoundingBox(LabelObjectType * labelObject);
 
+  /** Keep only the points which are a vertex of the 2D convex hull of the
+   * points lying in the same plane, parallel to the axes axis0 and axis1. */
+  static void
+  KeepConvexHullVertices(std::vector<IndexType> & points, unsigned int axis0, unsigned int axis1);
+
   using Offset2Type = itk::Offset<2>;
   using Offset3Type = itk::Offset<3>;
   using Spacing2Type = itk::Vector<double, 2>;
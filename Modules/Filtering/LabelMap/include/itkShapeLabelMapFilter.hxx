@@ -19,18 +19,15 @@
 #define itkShapeLabelMapFilter_hxx
 
 #include "itkProgressReporter.h"
-#include "itkConstNeighborhoodIterator.h"
-#include "itkConstShapedNeighborhoodIterator.h"
 #include "itkLabelMapToLabelImageFilter.h"
-#include "itkConstantBoundaryCondition.h"
 #include "itkGeometryUtilities.h"
-#include "itkConnectedComponentAlgorithm.h"
 #include "vnl/algo/vnl_real_eigensystem.h"
 #include "vnl/algo/vnl_symmetric_eigensystem.h"
 #include "itkMath.h"
 #include "itkLexicographicCompare.h"
-#include <deque>
+#include <algorithm>
 #include <map>
+#include <numeric>
 
 namespace itk
 {
@@ -39,29 +36,6 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ShapeLabelMapFilter()
   : m_ComputePerimeter(true)
 {}
 
-template <typename TImage, typename TLabelImage>
-void
-ShapeLabelMapFilter<TImage, TLabelImage>::BeforeThreadedGenerateData()
-{
-  Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if (m_ComputeFeretDiameter)
-  {
-    if (!m_LabelImage)
-    {
-      // generate an image of the labelized image
-      using LCI2IType = LabelMapToLabelImageFilter<TImage, LabelImageType>;
-      auto lci2i = LCI2IType::New();
-      lci2i->SetInput(this->GetOutput());
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-    }
-  }
-}
-
 template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
@@ -419,41 +393,121 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ThreadedProcessLabelObject(LabelObject
 
 template <typename TImage, typename TLabelImage>
 void
-ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType * labelObject)
+ShapeLabelMapFilter<TImage, TLabelImage>::KeepConvexHullVertices(std::vector<IndexType> & points,
+                                                                 unsigned int             axis0,
+                                                                 unsigned int             axis1)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
-
-  using IndexListType = typename std::deque<IndexType>;
-  IndexListType idxList;
-
-  using NeighborIteratorType = typename itk::ConstNeighborhoodIterator<LabelImageType>;
-  auto                                      neighborHoodRadius = SizeType::Filled(1);
-  NeighborIteratorType                      it(neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion());
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
-
-  using NeighborIndexType = typename NeighborIteratorType::NeighborIndexType;
+  const auto inSamePlane = [axis0, axis1](const IndexType & a, const IndexType & b) {
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (i != axis0 && i != axis1 && a[i] != b[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  };
 
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit(labelObject);
-  while (!iit.IsAtEnd())
+  // sort the points plane by plane, and along axis0 then axis1 in each plane
+  std::sort(points.begin(), points.end(), [axis0, axis1](const IndexType & a, const IndexType & b) {
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (i != axis0 && i != axis1 && a[i] != b[i])
+      {
+        return a[i] < b[i];
+      }
+    }
+    if (a[axis0] != b[axis0])
+    {
+      return a[axis0] < b[axis0];
+    }
+    return a[axis1] < b[axis1];
+  });
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+
+  // positive if o, a and b turn counterclockwise
+  const auto cross = [axis0, axis1](const IndexType & o, const IndexType & a, const IndexType & b) {
+    return (a[axis0] - o[axis0]) * (b[axis1] - o[axis1]) - (a[axis1] - o[axis1]) * (b[axis0] - o[axis0]);
+  };
+
+  std::vector<IndexType> vertices;
+  std::vector<IndexType> hull;
+  auto                   planeBegin = points.begin();
+  while (planeBegin != points.end())
   {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    auto planeEnd = planeBegin + 1;
+    while (planeEnd != points.end() && inSamePlane(*planeBegin, *planeEnd))
+    {
+      ++planeEnd;
+    }
 
-    // Push the pixel in the list if it is on the border of the object
-    for (NeighborIndexType i = 0; i < it.Size(); ++i)
+    if (planeEnd - planeBegin <= 2)
     {
-      if (it.GetPixel(i) != label)
+      vertices.insert(vertices.end(), planeBegin, planeEnd);
+    }
+    else
+    {
+      // monotone chain: the lower hull, then the upper hull. The points on
+      // the edges of the hull are removed.
+      hull.clear();
+      for (auto it = planeBegin; it != planeEnd; ++it)
       {
-        idxList.push_back(iit.GetIndex());
-        break;
+        while (hull.size() >= 2 && cross(hull[hull.size() - 2], hull.back(), *it) <= 0)
+        {
+          hull.pop_back();
+        }
+        hull.push_back(*it);
+      }
+      const size_t lowerHullSize = hull.size();
+      for (auto it = planeEnd - 1; it != planeBegin;)
+      {
+        --it;
+        while (hull.size() > lowerHullSize && cross(hull[hull.size() - 2], hull.back(), *it) <= 0)
+        {
+          hull.pop_back();
+        }
+        hull.push_back(*it);
       }
+      // the first point is also the last one
+      hull.pop_back();
+      vertices.insert(vertices.end(), hull.begin(), hull.end());
+    }
+    planeBegin = planeEnd;
+  }
+  points.swap(vertices);
+}
+
+template <typename TImage, typename TLabelImage>
+void
+ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType * labelObject)
+{
+  // The two farthest pixels of the object are vertices of its convex hull.
+  // Only the first and the last pixel of a line can be such a vertex.
+  std::vector<IndexType> points;
+  points.reserve(2 * labelObject->GetNumberOfLines());
+  typename LabelObjectType::ConstLineIterator lit(labelObject);
+  while (!lit.IsAtEnd())
+  {
+    IndexType idx = lit.GetLine().GetIndex();
+    points.push_back(idx);
+    if (lit.GetLine().GetLength() > 1)
+    {
+      idx[0] += lit.GetLine().GetLength() - 1;
+      points.push_back(idx);
+    }
+    ++lit;
+  }
+
+  // A vertex of the convex hull of the object is also a vertex of the convex
+  // hull of any planar section of the object. Remove the points which are not
+  // a vertex of the convex hull of their section by each plane parallel to two
+  // axes.
+  for (unsigned int axis1 = 1; axis1 < ImageDimension; ++axis1)
+  {
+    for (unsigned int axis0 = 0; axis0 < axis1; ++axis0)
+    {
+      KeepConvexHullVertices(points, axis0, axis1);
     }
-    ++iit;
   }
 
   ImageType * output = this->GetOutput();
@@ -462,10 +516,10 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType *
 
   // We can now search the feret diameter
   double feretDiameter = 0;
-  for (auto iIt1 = idxList.begin(); iIt1 != idxList.end(); ++iIt1)
+  for (auto iIt1 = points.begin(); iIt1 != points.end(); ++iIt1)
   {
     auto iIt2 = iIt1;
-    for (iIt2++; iIt2 != idxList.end(); ++iIt2)
+    for (iIt2++; iIt2 != points.end(); ++iIt2)
     {
       // Compute the length between the 2 indexes
       double length = 0;
@@ -491,106 +545,138 @@ template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ComputePerimeter(LabelObjectType * labelObject)
 {
-  // store the lines in a N-1D image of vectors
-  using VectorLineType = std::deque<typename LabelObjectType::LineType>;
-  using LineImageType = itk::Image<VectorLineType, ImageDimension - 1>;
-  auto                              lineImage = LineImageType::New();
-  typename LineImageType::IndexType lIdx;
-  typename LineImageType::SizeType  lSize;
-  const RegionType                  boundingBox = labelObject->GetBoundingBox();
-  for (unsigned int i = 0; i < ImageDimension - 1; ++i)
-  {
-    lIdx[i] = boundingBox.GetIndex()[i + 1];
-    lSize[i] = boundingBox.GetSize()[i + 1];
-  }
-  const typename LineImageType::RegionType lRegion(lIdx, lSize);
-  // enlarge the region a bit to avoid boundary problems
-  typename LineImageType::RegionType elRegion(lRegion);
-  lSize.Fill(1);
-  elRegion.PadByRadius(lSize);
-  // std::cout << boundingBox << "  " << lRegion << "  " << elRegion << std::endl;
-  // now initialize the image
-  lineImage->SetRegions(elRegion);
-  lineImage->AllocateInitialized();
-
-  // std::cout << "lineContainer.size(): " << lineContainer.size() << std::endl;
-
-  // Iterate over all the lines and fill the image of lines
-  typename LabelObjectType::ConstLineIterator lit(labelObject);
-  while (!lit.IsAtEnd())
+  using LineType = typename LabelObjectType::LineType;
+
+  // the rows are the lines of the bounding box along the axis 0
+  const RegionType boundingBox = labelObject->GetBoundingBox();
+  OffsetType       rowStride{};
+  SizeValueType    numberOfRows = 1;
+  for (unsigned int i = 1; i < ImageDimension; ++i)
   {
-    const IndexType & idx = lit.GetLine().GetIndex();
-    for (unsigned int i = 0; i < ImageDimension - 1; ++i)
+    rowStride[i] = static_cast<OffsetValueType>(numberOfRows);
+    numberOfRows *= boundingBox.GetSize(i);
+  }
+  const auto rowOf = [&boundingBox, &rowStride](const IndexType & idx) {
+    OffsetValueType row = 0;
+    for (unsigned int i = 1; i < ImageDimension; ++i)
     {
-      lIdx[i] = idx[i + 1];
+      row += (idx[i] - boundingBox.GetIndex(i)) * rowStride[i];
+    }
+    return static_cast<SizeValueType>(row);
+  };
+
+  // sort the lines by row, keeping their order in each row. The lines of the
+  // row r are lines[rowBegin[r]] to lines[rowBegin[r + 1] - 1].
+  const SizeValueType        numberOfLines = labelObject->GetNumberOfLines();
+  std::vector<SizeValueType> rowBegin(numberOfRows + 1, 0);
+  for (SizeValueType l = 0; l < numberOfLines; ++l)
+  {
+    ++rowBegin[rowOf(labelObject->GetLine(l).GetIndex()) + 1];
+  }
+  std::partial_sum(rowBegin.begin(), rowBegin.end(), rowBegin.begin());
+  std::vector<LineType> lines(numberOfLines);
+  {
+    std::vector<SizeValueType> rowEnd(rowBegin.begin(), rowBegin.end() - 1);
+    for (SizeValueType l = 0; l < numberOfLines; ++l)
+    {
+      const LineType & line = labelObject->GetLine(l);
+      lines[rowEnd[rowOf(line.GetIndex())]++] = line;
     }
-    lineImage->GetPixel(lIdx).push_back(lit.GetLine());
-    ++lit;
   }
 
-  // a data structure to store the number of intercepts on each direction
-  using MapInterceptType = typename std::map<OffsetType, SizeValueType, Functor::LexicographicCompare>;
-  MapInterceptType intercepts;
-  // int nbOfDirections = static_cast<int>(std::pow(2.0, int{ ImageDimension })) - 1;
-  // intercepts.resize(nbOfDirections + 1);  // code begins at position 1
+  // the number of intercepts on each direction. The direction no, with all
+  // its components equal to 0 or 1, is stored at the position
+  // sum( no[i] << i ).
+  SizeValueType interceptCounts[1u << ImageDimension] = {};
 
-  // now iterate over the vectors of lines
-  using LineImageIteratorType = ConstShapedNeighborhoodIterator<LineImageType>;
-  LineImageIteratorType lIt(lSize, lineImage, lRegion); // the original, non padded region
-  setConnectivity(&lIt, true);
-  for (lIt.GoToBegin(); !lIt.IsAtEnd(); ++lIt)
+  // the offsets to the neighbor rows
+  std::vector<OffsetType> neighborOffsets;
   {
-    const VectorLineType & ls = lIt.GetCenterPixel();
+    OffsetType offset{};
+    for (unsigned int i = 1; i < ImageDimension; ++i)
+    {
+      offset[i] = -1;
+    }
+    for (;;)
+    {
+      if (offset != OffsetType{})
+      {
+        neighborOffsets.push_back(offset);
+      }
+      unsigned int i = 1;
+      while (i < ImageDimension && offset[i] == 1)
+      {
+        offset[i] = -1;
+        ++i;
+      }
+      if (i == ImageDimension)
+      {
+        break;
+      }
+      ++offset[i];
+    }
+  }
+
+  for (SizeValueType row = 0; row < numberOfRows; ++row)
+  {
+    const LineType * lsBegin = lines.data() + rowBegin[row];
+    const LineType * lsEnd = lines.data() + rowBegin[row + 1];
+    if (lsBegin == lsEnd)
+    {
+      // no contribution of the empty rows
+      continue;
+    }
 
     // there are two intercepts on the 0 axis for each line
-    OffsetType no{};
-    no[0] = 1;
-    // std::cout << no << "-> " << 2 * ls.size() << std::endl;
-    intercepts[no] += 2 * static_cast<SizeValueType>(ls.size());
+    interceptCounts[1] += 2 * static_cast<SizeValueType>(lsEnd - lsBegin);
 
     // and look at the neighbors
-    typename LineImageIteratorType::ConstIterator ci;
-    for (ci = lIt.Begin(); ci != lIt.End(); ++ci)
-    {
-      // std::cout << "-------------" << std::endl;
-      // the vector of lines in the neighbor
-      const VectorLineType & ns = ci.Get();
-      // prepare the offset to be stored in the intercepts map
-      typename LineImageType::OffsetType lno = ci.GetNeighborhoodOffset();
-      no[0] = 0;
-      for (unsigned int i = 0; i < ImageDimension - 1; ++i)
+    const IndexType & rowIndex = lsBegin->GetIndex();
+    for (const OffsetType & lno : neighborOffsets)
+    {
+      // the lines in the neighbor row, if it is in the bounding box
+      const LineType * nsBegin = nullptr;
+      const LineType * nsEnd = nullptr;
+      bool             isInside = true;
+      OffsetValueType  neighborRow = static_cast<OffsetValueType>(row);
+      unsigned int     direction = 0;
+      for (unsigned int i = 1; i < ImageDimension; ++i)
+      {
+        const IndexValueType neighborIndex = rowIndex[i] + lno[i];
+        isInside = isInside && neighborIndex >= boundingBox.GetIndex(i) &&
+                   neighborIndex < boundingBox.GetIndex(i) + static_cast<IndexValueType>(boundingBox.GetSize(i));
+        neighborRow += lno[i] * rowStride[i];
+        if (lno[i] != 0)
+        {
+          direction |= 1u << i;
+        }
+      }
+      if (isInside)
       {
-        no[i + 1] = itk::Math::abs(lno[i]);
+        nsBegin = lines.data() + rowBegin[neighborRow];
+        nsEnd = lines.data() + rowBegin[neighborRow + 1];
       }
-      OffsetType dno = no; // offset for the diagonal
-      dno[0] = 1;
+      SizeValueType & no = interceptCounts[direction];
+      SizeValueType & dno = interceptCounts[direction | 1]; // the diagonal
 
       // now process the two lines to search the pixels on the contour of the object
-      if (ls.empty())
-      {
-        // std::cout << "ls.empty()" << std::endl;
-        // nothing to do
-      }
-      if (ns.empty())
+      if (nsBegin == nsEnd)
       {
         // no line in the neighbors - all the lines in ls are on the contour
-        for (auto li = ls.begin(); li != ls.end(); ++li)
+        for (const LineType * li = lsBegin; li != lsEnd; ++li)
         {
-          // std::cout << "ns.empty()" << std::endl;
-          const typename LabelObjectType::LineType & l = *li;
           // add as much intercepts as the line size
-          intercepts[no] += l.GetLength();
+          no += li->GetLength();
           // and 2 times as much diagonal intercepts as the line size
-          intercepts[dno] += l.GetLength() * 2;
+          dno += li->GetLength() * 2;
         }
       }
       else
       {
-        // std::cout << "else" << std::endl;
         // TODO - fix the code when the line starts at  NumericTraits<IndexValueType>::NonpositiveMin()
         // or end at  NumericTraits<IndexValueType>::max()
-        auto li = ls.begin();
-        auto ni = ns.begin();
+        const LineType * li = lsBegin;
+        const LineType * ni = nsBegin;
 
         constexpr IndexValueType lZero = 0;
         IndexValueType           lMin = 0;
@@ -599,24 +685,18 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputePerimeter(LabelObjectType * lab
         IndexValueType nMin = NumericTraits<IndexValueType>::NonpositiveMin() + 1;
         IndexValueType nMax = ni->GetIndex()[0] - 1;
 
-        while (li != ls.end())
+        while (li != lsEnd)
         {
           // update the current line min and max. Neighbor line data is already up to date.
           lMin = li->GetIndex()[0];
           lMax = lMin + li->GetLength() - 1;
 
           // add as much intercepts as intersections of the 2 lines
-          intercepts[no] += std::max(lZero, std::min(lMax, nMax) - std::max(lMin, nMin) + 1);
-          // std::cout << "============" << std::endl;
-          // std::cout << "  lMin:" << lMin << " lMax:" << lMax << " nMin:" << nMin << " nMax:" << nMax;
-          // std::cout << " count: " << std::max( 0l, std::min(lMax, nMax) - std::max(lMin, nMin) + 1 ) << std::endl;
-          // std::cout << "  " << no << ": " << intercepts[no] << std::endl;
-          // std::cout << std::max( lZero, std::min(lMax, nMax+1) - std::max(lMin, nMin+1) + 1 ) << std::endl;
-          // std::cout << std::max( lZero, std::min(lMax, nMax-1) - std::max(lMin, nMin-1) + 1 ) << std::endl;
+          no += std::max(lZero, std::min(lMax, nMax) - std::max(lMin, nMin) + 1);
           // left diagonal intercepts
-          intercepts[dno] += std::max(lZero, std::min(lMax, nMax + 1) - std::max(lMin, nMin + 1) + 1);
+          dno += std::max(lZero, std::min(lMax, nMax + 1) - std::max(lMin, nMin + 1) + 1);
           // right diagonal intercepts
-          intercepts[dno] += std::max(lZero, std::min(lMax, nMax - 1) - std::max(lMin, nMin - 1) + 1);
+          dno += std::max(lZero, std::min(lMax, nMax - 1) - std::max(lMin, nMin - 1) + 1);
 
           // go to the next line or the next neighbor depending on where we are
           if (nMax <= lMax)
@@ -625,7 +705,7 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputePerimeter(LabelObjectType * lab
             nMin = ni->GetIndex()[0] + ni->GetLength();
             ++ni;
 
-            if (ni != ns.end())
+            if (ni != nsEnd)
             {
               nMax = ni->GetIndex()[0] - 1;
             }
@@ -644,6 +724,19 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputePerimeter(LabelObjectType * lab
     }
   }
 
+  // a data structure to store the number of intercepts on each direction
+  using MapInterceptType = typename std::map<OffsetType, SizeValueType, Functor::LexicographicCompare>;
+  MapInterceptType intercepts;
+  for (unsigned int direction = 1; direction < (1u << ImageDimension); ++direction)
+  {
+    OffsetType no;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      no[i] = (direction >> i) & 1;
+    }
+    intercepts[no] = interceptCounts[direction];
+  }
+
   // compute the perimeter based on the intercept counts
   const double perimeter = PerimeterFromInterceptCount(intercepts, this->GetOutput()->GetSpacing());
   labelObject->SetPerimeter(perimeter);
@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkBinaryImageToLabelMapFilter.h"
+#include "itkCompactLabelMap.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include <vector>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using BinaryImageType = itk::Image<unsigned char, Dimension>;
+using LabelImageType = itk::Image<unsigned int, Dimension>;
+using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned int, Dimension>>;
+using CompactLabelMapType = itk::CompactLabelMap<unsigned int, Dimension>;
+using LineType = CompactLabelMapType::LineType;
+using IndexType = CompactLabelMapType::IndexType;
+
+// a random binary image with many small objects
+BinaryImageType::Pointer
+CreateBinaryImage()
+{
+  auto image = BinaryImageType::New();
+  image->SetRegions(BinaryImageType::SizeType{ { 47, 31, 19 } });
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(2024);
+  for (itk::ImageRegionIterator<BinaryImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(generator->GetVariate() < 0.08 ? 255 : 0);
+  }
+  return image;
+}
+
+bool
+SameLine(const LineType & line1, const LineType & line2)
+{
+  return line1.GetIndex() == line2.GetIndex() && line1.GetLength() == line2.GetLength();
+}
+
+template <typename TLabelMap>
+typename TLabelMap::Pointer
+LabelBinaryImage(const BinaryImageType * image, bool fullyConnected, unsigned int numberOfWorkUnits)
+{
+  auto filter = itk::BinaryImageToLabelMapFilter<BinaryImageType, TLabelMap>::New();
+  filter->SetInput(image);
+  filter->SetFullyConnected(fullyConnected);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+template <typename TLabelMap>
+LabelImageType::Pointer
+ToLabelImage(const TLabelMap * labelMap, unsigned int numberOfWorkUnits)
+{
+  auto filter = itk::LabelMapToLabelImageFilter<TLabelMap, LabelImageType>::New();
+  filter->SetInput(labelMap);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+} // namespace
+
+
+TEST(CompactLabelMap, BinaryImageToLabelMap)
+{
+  const auto image = CreateBinaryImage();
+
+  for (const bool fullyConnected : { false, true })
+  {
+    const auto labelMap = LabelBinaryImage<LabelMapType>(image, fullyConnected, 1);
+    ASSERT_GT(labelMap->GetNumberOfLabelObjects(), 100u);
+
+    for (const unsigned int numberOfWorkUnits : { 1, 4 })
+    {
+      const auto compactLabelMap = LabelBinaryImage<CompactLabelMapType>(image, fullyConnected, numberOfWorkUnits);
+
+      // the same objects with the same lines, in the same order
+      ASSERT_EQ(compactLabelMap->GetNumberOfLabelObjects(), labelMap->GetNumberOfLabelObjects());
+      EXPECT_EQ(compactLabelMap->GetLabels(), labelMap->GetLabels());
+      EXPECT_EQ(compactLabelMap->GetBackgroundValue(), labelMap->GetBackgroundValue());
+      itk::SizeValueType numberOfLines = 0;
+      for (itk::SizeValueType i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i)
+      {
+        const auto * labelObject = labelMap->GetNthLabelObject(i);
+        const auto * compactLabelObject = compactLabelMap->GetNthLabelObject(i);
+        EXPECT_EQ(compactLabelObject, compactLabelMap->GetLabelObject(labelObject->GetLabel()));
+        ASSERT_EQ(compactLabelObject->GetNumberOfLines(), labelObject->GetNumberOfLines());
+        for (itk::SizeValueType l = 0; l < labelObject->GetNumberOfLines(); ++l)
+        {
+          EXPECT_TRUE(SameLine(compactLabelObject->GetLine(l), labelObject->GetLine(l)));
+        }
+        EXPECT_EQ(compactLabelObject->Size(), labelObject->Size());
+        numberOfLines += labelObject->GetNumberOfLines();
+      }
+      EXPECT_EQ(compactLabelMap->GetLines().size(), numberOfLines);
+
+      // the objects are read concurrently by the label map filters
+      const auto labelImage = ToLabelImage(labelMap.GetPointer(), 1);
+      const auto compactLabelImage = ToLabelImage(compactLabelMap.GetPointer(), numberOfWorkUnits);
+      itk::ImageRegionIterator<LabelImageType> it(labelImage, labelImage->GetLargestPossibleRegion());
+      itk::ImageRegionIterator<LabelImageType> compactIt(compactLabelImage, labelImage->GetLargestPossibleRegion());
+      for (; !it.IsAtEnd(); ++it, ++compactIt)
+      {
+        ASSERT_EQ(compactIt.Get(), it.Get());
+      }
+    }
+  }
+}
+
+
+TEST(CompactLabelMap, SetLines)
+{
+  auto labelMap = CompactLabelMapType::New();
+  labelMap->SetRegions(CompactLabelMapType::SizeType{ { 10, 10, 10 } });
+  labelMap->Allocate();
+  EXPECT_EQ(labelMap->GetNumberOfLabelObjects(), 0u);
+
+  // the lines of label 5 are given out of raster order
+  const std::vector<LineType> lines{ LineType({ { 1, 2, 3 } }, 4),
+                                     LineType({ { 0, 0, 1 } }, 2),
+                                     LineType({ { 6, 1, 1 } }, 1),
+                                     LineType({ { 2, 0, 1 } }, 3) };
+  labelMap->SetLines({ 2, 5 }, { 0, 1, 4 }, lines);
+
+  ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), 2u);
+  EXPECT_EQ(labelMap->GetLabels(), CompactLabelMapType::LabelVectorType({ 2, 5 }));
+  EXPECT_TRUE(labelMap->HasLabel(0));
+  EXPECT_TRUE(labelMap->HasLabel(2));
+  EXPECT_FALSE(labelMap->HasLabel(3));
+  EXPECT_TRUE(labelMap->HasLabel(5));
+
+  const auto * labelObject = labelMap->GetLabelObject(5);
+  EXPECT_EQ(labelObject, labelMap->GetNthLabelObject(1));
+  EXPECT_EQ(labelObject->GetLabel(), 5u);
+  ASSERT_EQ(labelObject->GetNumberOfLines(), 3u);
+  EXPECT_TRUE(SameLine(labelObject->GetLine(0), LineType({ { 0, 0, 1 } }, 2)));
+  EXPECT_TRUE(SameLine(labelObject->GetLine(1), LineType({ { 2, 0, 1 } }, 3)));
+  EXPECT_TRUE(SameLine(labelObject->GetLine(2), LineType({ { 6, 1, 1 } }, 1)));
+  EXPECT_EQ(labelObject->Size(), 6u);
+  EXPECT_EQ(labelObject->GetIndex(3), IndexType({ { 3, 0, 1 } }));
+  EXPECT_TRUE(labelObject->HasIndex({ { 4, 0, 1 } }));
+  EXPECT_FALSE(labelObject->HasIndex({ { 5, 0, 1 } }));
+
+  std::vector<IndexType> indices;
+  for (CompactLabelMapType::LabelObjectType::ConstIndexIterator it(labelObject); !it.IsAtEnd(); ++it)
+  {
+    indices.push_back(it.GetIndex());
+  }
+  EXPECT_EQ(indices.size(), 6u);
+  EXPECT_EQ(indices.back(), IndexType({ { 6, 1, 1 } }));
+
+  EXPECT_EQ(labelMap->GetPixel({ { 3, 2, 3 } }), 2u);
+  EXPECT_EQ(labelMap->GetPixel({ { 6, 1, 1 } }), 5u);
+  EXPECT_EQ(labelMap->GetPixel({ { 6, 2, 1 } }), 0u);
+
+  std::vector<unsigned int> labels;
+  for (CompactLabelMapType::ConstIterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    labels.push_back(it.GetLabel());
+    EXPECT_EQ(it.GetLabelObject()->GetLabel(), it.GetLabel());
+  }
+  EXPECT_EQ(labels, std::vector<unsigned int>({ 2, 5 }));
+
+  // a graft copies the lines
+  auto graft = CompactLabelMapType::New();
+  graft->Graft(labelMap);
+  labelMap->ClearLabels();
+  EXPECT_EQ(labelMap->GetNumberOfLabelObjects(), 0u);
+  ASSERT_EQ(graft->GetNumberOfLabelObjects(), 2u);
+  EXPECT_TRUE(SameLine(graft->GetLabelObject(5)->GetLine(2), LineType({ { 6, 1, 1 } }, 1)));
+
+  // invalid contents
+  EXPECT_THROW(labelMap->SetLines({ 5, 2 }, { 0, 1, 4 }, lines), itk::ExceptionObject);
+  EXPECT_THROW(labelMap->SetLines({ 0, 5 }, { 0, 1, 4 }, lines), itk::ExceptionObject);
+  EXPECT_THROW(labelMap->SetLines({ 2, 5 }, { 0, 1, 3 }, lines), itk::ExceptionObject);
+  EXPECT_THROW(labelMap->SetLines({ 2, 5 }, { 0, 4 }, lines), itk::ExceptionObject);
+  EXPECT_THROW(labelMap->GetLabelObject(3), itk::ExceptionObject);
+  EXPECT_THROW(graft->GetLabelObject(0), itk::ExceptionObject);
+  EXPECT_THROW(graft->GetNthLabelObject(2), itk::ExceptionObject);
+}
@@ -19,8 +19,11 @@
 #include "itkGTest.h"
 
 #include "itkImage.h"
+#include "itkImageRegionIterator.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
 #include "itkTestingMacros.h"
+#include <algorithm>
+#include <vector>
 
 
 namespace Math = itk::Math;
@@ -535,3 +538,55 @@ TEST_F(ShapeLabelMapFixture, 2D_T2x4)
     labelObject->Print(std::cout);
   }
 }
+
+
+TEST_F(ShapeLabelMapFixture, 3D_FeretDiameterOfIrregularObjects)
+{
+  using Utils = FixtureUtilities<3>;
+  using ImageType = Utils::ImageType;
+  using IndexType = ImageType::IndexType;
+
+  // several irregular objects, with an anisotropic spacing
+  const ImageType::Pointer image(Utils::CreateImage());
+  image->SetSpacing(itk::MakeVector(1.0, 1.5, 0.7));
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const IndexType idx = it.GetIndex();
+    if ((idx[0] * idx[0] + 3 * idx[1] + 2 * idx[2] * idx[2]) % 5 != 0)
+    {
+      it.Set(1 + (idx[0] / 9 + idx[1] / 7 * 3 + idx[2] / 13 * 12) % 5);
+    }
+  }
+
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<ImageType>;
+  auto l2s = L2SType::New();
+  l2s->SetInput(image);
+  l2s->ComputeFeretDiameterOn();
+  l2s->SetNumberOfWorkUnits(3);
+  l2s->Update();
+
+  // the largest distance between two pixels of the object
+  const auto & spacing = image->GetSpacing();
+  for (const auto & labelObject : l2s->GetOutput()->GetLabelObjects())
+  {
+    std::vector<IndexType> indices;
+    for (Utils::LabelObjectType::ConstIndexIterator it(labelObject); !it.IsAtEnd(); ++it)
+    {
+      indices.push_back(it.GetIndex());
+    }
+    double expected = 0.0;
+    for (const IndexType & idx1 : indices)
+    {
+      for (const IndexType & idx2 : indices)
+      {
+        double length = 0.0;
+        for (unsigned int i = 0; i < Utils::Dimension; ++i)
+        {
+          length += Math::sqr((idx1[i] - idx2[i]) * spacing[i]);
+        }
+        expected = std::max(expected, length);
+      }
+    }
+    EXPECT_NEAR(std::sqrt(expected), labelObject->GetFeretDiameter(), 1e-10) << "label " << labelObject->GetLabel();
+  }
+}
@@ -22,6 +22,7 @@
 #include "itkShapedNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include <queue>
 
 // #define BASIC
@@ -41,6 +42,11 @@ namespace itk
  * antiraster propagation steps followed by a FIFO based propagation
  * step \cite vincent1993.
  *
+ * The image is split in slabs which are reconstructed on several threads,
+ * then the values are propagated across the borders between the slabs with
+ * the FIFO based step. The result does not depend on the number of work
+ * units.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -174,6 +180,37 @@ private:
   using InIndexType = typename InputImageType::IndexType;
   using CNInputIterator = ConstShapedNeighborhoodIterator<InputImageType>;
   using NOutputIterator = ShapedNeighborhoodIterator<OutputImageType>;
+  using IndexListType = typename NOutputIterator::IndexListType;
+  using FifoType = std::queue<OutputImageIndexType>;
+
+  /** Reconstruct the marker image in the given region, ignoring the pixels
+   * outside of the region along the split axis. Returns false if a marker
+   * pixel does not follow the precondition. */
+  bool
+  ReconstructRegion(const MarkerImageType *       markerImage,
+                    const MaskImageType *         maskImage,
+                    const OutputImageRegionType & region,
+                    unsigned int                  splitAxis,
+                    TotalProgressReporter &       progress);
+
+  /** FIFO based propagation step, restricted to the given region along the
+   * split axis. */
+  void
+  PropagateFifo(const MarkerImageType *       markerImage,
+                const MaskImageType *         maskImage,
+                const OutputImageRegionType & region,
+                unsigned int                  splitAxis,
+                FifoType &                    IndexFifo,
+                TotalProgressReporter &       progress);
+
+  /** Return the neighbors in indexList which are in the region along the
+   * split axis when the iterator is at index. */
+  static IndexListType
+  GetIndexListInRegion(const NOutputIterator &       it,
+                       const IndexListType &         indexList,
+                       const OutputImageRegionType & region,
+                       const OutputImageIndexType &  index,
+                       unsigned int                  splitAxis);
 }; // end of class
 } // end namespace itk
 
@@ -21,6 +21,10 @@
 #include "itkMath.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkConnectedComponentAlgorithm.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+
+#include <atomic>
 
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
@@ -69,11 +73,6 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
 {
   // Allocate the output
   this->AllocateOutputs();
-  // there are 2 passes that use all pixels and a 3rd that uses some
-  // subset of the pixels. We'll just pretend that the third pass
-  // takes the same as each of the others. Is it OK to update more
-  // often than pixels?
-  ProgressReporter progress(this, 0, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * 3);
 
   TCompare compare;
 
@@ -132,52 +131,163 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     markerImageP = output;
   }
 
-  // declare our queue type
-  using FifoType = typename std::queue<OutputImageIndexType>;
-  FifoType IndexFifo;
-
-  NOutputIterator   outNIt;
-  InputIteratorType mskIt;
-  CNInputIterator   mskNIt;
-  auto              kernelRadius = ISizeType::Filled(1);
+  // the region to reconstruct
+  OutputImageRegionType region = output->GetRequestedRegion();
   if (m_UseInternalCopy)
   {
     FaceCalculatorType faceCalculator;
 
-    FaceListTypeIt fit;
-
-    FaceListType faceList = faceCalculator(maskImageP, maskImageP->GetLargestPossibleRegion(), kernelRadius);
+    const FaceListType faceList =
+      faceCalculator(maskImageP, maskImageP->GetLargestPossibleRegion(), ISizeType::Filled(1));
     // we will only be processing the body region
-    fit = faceList.begin();
-    // must be a better way of doing this
-    const NOutputIterator tt(kernelRadius, markerImageP, *fit);
-    outNIt = tt;
-
-    const InputIteratorType ttt(maskImageP, *fit);
-    mskIt = ttt;
-    const CNInputIterator tttt(kernelRadius, maskImageP, *fit);
-    mskNIt = tttt;
+    region = *faceList.begin();
   }
-  else
+
+  // The region is split in slabs along the slowest dimension. The slabs are
+  // reconstructed in parallel, each one ignoring the neighbors in the other
+  // slabs. The reconstruction is then completed with a FIFO propagation
+  // initialized with the pixels on both sides of the borders between slabs.
+  // The reconstruction is unique, so the output does not depend on the
+  // number of slabs.
+  auto               splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(region, this->GetNumberOfWorkUnits());
+  // the splitter uses the slowest dimension with more than one pixel
+  unsigned int splitAxis = OutputImageDimension - 1;
+  while (splitAxis > 0 && region.GetSize(splitAxis) <= 1)
+  {
+    --splitAxis;
+  }
+
+  std::atomic<bool> validMarker{ true };
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      OutputImageRegionType slabRegion = region;
+      splitter->GetSplit(slab, numberOfSlabs, slabRegion);
+      // there are 2 passes that use all pixels and a 3rd that uses some
+      // subset of the pixels. We'll just pretend that the third pass
+      // takes the same as each of the others.
+      TotalProgressReporter progress(this, region.GetNumberOfPixels() * 3);
+      if (!this->ReconstructRegion(markerImageP, maskImageP, slabRegion, splitAxis, progress))
+      {
+        validMarker = false;
+      }
+    },
+    nullptr);
+
+  // be sure that the pixels in the images follow the preconditions
+  if (!validMarker)
   {
-    const NOutputIterator tt(kernelRadius, markerImageP, output->GetRequestedRegion());
-    outNIt = tt;
+    if (compare(0, 1))
+    {
+      itkExceptionMacro("Marker pixels must be <= mask pixels.");
+    }
+    else
+    {
+      itkExceptionMacro("Marker pixels must be >= mask pixels.");
+    }
+  }
 
-    const InputIteratorType ttt(maskImageP, output->GetRequestedRegion());
-    mskIt = ttt;
-    const CNInputIterator tttt(kernelRadius, maskImageP, output->GetRequestedRegion());
-    mskNIt = tttt;
+  if (numberOfSlabs > 1)
+  {
+    FifoType IndexFifo;
+    for (unsigned int slab = 1; slab < numberOfSlabs; ++slab)
+    {
+      // the last slice of the previous slab and the first slice of this one
+      OutputImageRegionType borderRegion = region;
+      splitter->GetSplit(slab, numberOfSlabs, borderRegion);
+      borderRegion.SetIndex(splitAxis, borderRegion.GetIndex(splitAxis) - 1);
+      borderRegion.SetSize(splitAxis, 2);
+      for (ImageRegionConstIteratorWithIndex<MarkerImageType> it(markerImageP, borderRegion); !it.IsAtEnd(); ++it)
+      {
+        IndexFifo.push(it.GetIndex());
+      }
+    }
+    TotalProgressReporter progress(this, region.GetNumberOfPixels() * 3);
+    this->PropagateFifo(markerImageP, maskImageP, region, splitAxis, IndexFifo, progress);
   }
 
-  setConnectivityPrevious(&outNIt, m_FullyConnected);
+  if (m_UseInternalCopy)
+  {
+    using CropType = typename itk::CropImageFilter<InputImageType, OutputImageType>;
+    auto crop = CropType::New();
+
+    crop->SetInput(markerImageP);
+    crop->SetUpperBoundaryCropSize(padSize);
+    crop->SetLowerBoundaryCropSize(padSize);
+    crop->GraftOutput(this->GetOutput());
+    /** execute the minipipeline */
+    crop->Update();
+
+    /** graft the minipipeline output back into this filter's output */
+    this->GraftOutput(crop->GetOutput());
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+auto
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GetIndexListInRegion(
+  const NOutputIterator &       it,
+  const IndexListType &         indexList,
+  const OutputImageRegionType & region,
+  const OutputImageIndexType &  index,
+  unsigned int                  splitAxis) -> IndexListType
+{
+  const IndexValueType first = region.GetIndex(splitAxis);
+  const IndexValueType last = first + static_cast<IndexValueType>(region.GetSize(splitAxis)) - 1;
+
+  IndexListType result;
+  for (const auto n : indexList)
+  {
+    const IndexValueType neighborIndex = index[splitAxis] + it.GetOffset(n)[splitAxis];
+    if (neighborIndex >= first && neighborIndex <= last)
+    {
+      result.push_back(n);
+    }
+  }
+  return result;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+bool
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::ReconstructRegion(
+  const MarkerImageType *       markerImage,
+  const MaskImageType *         maskImage,
+  const OutputImageRegionType & region,
+  unsigned int                  splitAxis,
+  TotalProgressReporter &       progress)
+{
+  TCompare compare;
+
+  // the neighbors outside of the region along the split axis are
+  // ignored, so the index lists used on the first and on the last slice of
+  // the region are computed once
+  const OutputImageIndexType firstIndex = region.GetIndex();
+  OutputImageIndexType       lastIndex = firstIndex;
+  lastIndex[splitAxis] += static_cast<IndexValueType>(region.GetSize(splitAxis)) - 1;
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  const SizeValueType sliceSize = numberOfPixels / region.GetSize(splitAxis);
+
+  auto            kernelRadius = ISizeType::Filled(1);
+  NOutputIterator outNIt(kernelRadius, markerImage, region);
+  CNInputIterator mskNIt(kernelRadius, maskImage, region);
 
   ConstantBoundaryCondition<OutputImageType> oBC;
   oBC.SetConstant(m_MarkerValue);
+  ConstantBoundaryCondition<InputImageType> iBC;
+  iBC.SetConstant(m_MarkerValue);
+
+  setConnectivityPrevious(&outNIt, m_FullyConnected);
   outNIt.OverrideBoundaryCondition(&oBC);
 
-  mskIt.GoToBegin();
+  IndexListType indexList = outNIt.GetActiveIndexList();
+  IndexListType firstSliceIndexList = GetIndexListInRegion(outNIt, indexList, region, firstIndex, splitAxis);
+
   // scan in forward raster order
-  for (outNIt.GoToBegin(), mskIt.GoToBegin(); !outNIt.IsAtEnd(); ++outNIt, ++mskIt)
+  InputIteratorType mskIt(maskImage, region);
+  SizeValueType     pixel = 0;
+  for (outNIt.GoToBegin(), mskIt.GoToBegin(); !outNIt.IsAtEnd(); ++outNIt, ++mskIt, ++pixel)
   {
     InputImagePixelType V = outNIt.GetCenterPixel();
     auto                iV = static_cast<OutputImagePixelType>(mskIt.Get());
@@ -185,21 +295,13 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     // be sure that the pixels in the images follow the preconditions
     if (compare(V, iV))
     {
-      if (compare(0, 1))
-      {
-        itkExceptionMacro("Marker pixels must be <= mask pixels.");
-      }
-      else
-      {
-        itkExceptionMacro("Marker pixels must be >= mask pixels.");
-      }
+      return false;
     }
 
     // visit the previous neighbours
-    typename NOutputIterator::ConstIterator sIt;
-    for (sIt = outNIt.Begin(); !sIt.IsAtEnd(); ++sIt)
+    for (const auto n : (pixel < sliceSize ? firstSliceIndexList : indexList))
     {
-      const InputImagePixelType VN = sIt.Get();
+      const InputImagePixelType VN = outNIt.GetPixel(n);
       if (compare(VN, V))
       {
         outNIt.SetCenterPixel(VN);
@@ -221,27 +323,28 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
   setConnectivityLater(&outNIt, m_FullyConnected);
   outNIt.OverrideBoundaryCondition(&oBC);
   outNIt.GoToEnd();
-  // mskIt.GoToEnd();
-
-  ConstantBoundaryCondition<InputImageType> iBC;
-  iBC.SetConstant(m_MarkerValue);
 
   setConnectivityLater(&mskNIt, m_FullyConnected);
   mskNIt.OverrideBoundaryCondition(&iBC);
 
-  typename NOutputIterator::IndexListType oIndexList = outNIt.GetActiveIndexList();
-  typename NOutputIterator::IndexListType mIndexList = mskNIt.GetActiveIndexList();
+  // the mask and output iterators have the same active neighbors
+  indexList = outNIt.GetActiveIndexList();
+  IndexListType lastSliceIndexList = GetIndexListInRegion(outNIt, indexList, region, lastIndex, splitAxis);
+
+  FifoType IndexFifo;
 
   mskNIt.GoToEnd();
+  pixel = numberOfPixels;
   while (!outNIt.IsAtBegin())
   {
     --outNIt;
     --mskNIt;
-    InputImagePixelType                     V = outNIt.GetCenterPixel();
-    typename NOutputIterator::ConstIterator sIt;
-    for (sIt = outNIt.Begin(); !sIt.IsAtEnd(); ++sIt)
+    --pixel;
+    const IndexListType & laterIndexList = (pixel >= numberOfPixels - sliceSize ? lastSliceIndexList : indexList);
+    InputImagePixelType   V = outNIt.GetCenterPixel();
+    for (const auto n : laterIndexList)
     {
-      const InputImagePixelType VN = sIt.Get();
+      const InputImagePixelType VN = outNIt.GetPixel(n);
       if (compare(VN, V))
       {
         outNIt.SetCenterPixel(VN);
@@ -256,12 +359,10 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     }
 
     // now put indexes in the fifo
-    // typename CNInputIterator::ConstIterator mIt;
-    auto mLIt = mIndexList.begin();
-    for (auto oLIt = oIndexList.begin(); oLIt != oIndexList.end(); ++oLIt, ++mLIt)
+    for (const auto n : laterIndexList)
     {
-      const InputImagePixelType VN = outNIt.GetPixel(*oLIt);
-      const InputImagePixelType iN = mskNIt.GetPixel(*mLIt);
+      const InputImagePixelType VN = outNIt.GetPixel(n);
+      const InputImagePixelType iN = mskNIt.GetPixel(n);
       if (compare(V, VN) && compare(iN, VN))
       {
         IndexFifo.push(outNIt.GetIndex());
@@ -271,17 +372,50 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     progress.CompletedPixel();
   }
 
+  // now process the fifo - this fill the parts that weren't dealt
+  // with by the raster and anti-raster passes
+  this->PropagateFifo(markerImage, maskImage, region, splitAxis, IndexFifo, progress);
+
+  return true;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+void
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::PropagateFifo(const MarkerImageType *       markerImage,
+                                                                              const MaskImageType *         maskImage,
+                                                                              const OutputImageRegionType & region,
+                                                                              unsigned int                  splitAxis,
+                                                                              FifoType &                    IndexFifo,
+                                                                              TotalProgressReporter &       progress)
+{
+  TCompare compare;
+
+  const IndexValueType firstSlice = region.GetIndex(splitAxis);
+  const IndexValueType lastSlice = firstSlice + static_cast<IndexValueType>(region.GetSize(splitAxis)) - 1;
+
   // Now we want to check the full neighborhood
+  auto            kernelRadius = ISizeType::Filled(1);
+  NOutputIterator outNIt(kernelRadius, markerImage, region);
+  CNInputIterator mskNIt(kernelRadius, maskImage, region);
+
   setConnectivity(&outNIt, m_FullyConnected);
   setConnectivity(&mskNIt, m_FullyConnected);
-  mskNIt.OverrideBoundaryCondition(&iBC);
+
+  ConstantBoundaryCondition<OutputImageType> oBC;
+  oBC.SetConstant(m_MarkerValue);
   outNIt.OverrideBoundaryCondition(&oBC);
-  oIndexList = outNIt.GetActiveIndexList();
-  mIndexList = mskNIt.GetActiveIndexList();
-  // now process the fifo - this fill the parts that weren't dealt
-  // with by the raster and anti-raster passes
-  // typename NOutputIterator::Iterator sIt;
-  const typename CNInputIterator::ConstIterator mIt;
+  ConstantBoundaryCondition<InputImageType> iBC;
+  iBC.SetConstant(m_MarkerValue);
+  mskNIt.OverrideBoundaryCondition(&iBC);
+
+  // the neighbors outside of the region along the split axis are
+  // ignored, so they are not modified by the propagation
+  const IndexListType indexList = outNIt.GetActiveIndexList();
+  OutputImageIndexType firstSliceIndex = region.GetIndex();
+  OutputImageIndexType lastSliceIndex = firstSliceIndex;
+  lastSliceIndex[splitAxis] = lastSlice;
+  const IndexListType firstSliceIndexList = GetIndexListInRegion(outNIt, indexList, region, firstSliceIndex, splitAxis);
+  const IndexListType lastSliceIndexList = GetIndexListInRegion(outNIt, indexList, region, lastSliceIndex, splitAxis);
 
   while (!IndexFifo.empty())
   {
@@ -290,46 +424,40 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     // reposition the iterators
     outNIt += I - outNIt.GetIndex();
     mskNIt += I - mskNIt.GetIndex();
+
+    const IndexListType * neighborIndexList = &indexList;
+    if (I[splitAxis] == firstSlice)
+    {
+      neighborIndexList = &firstSliceIndexList;
+    }
+    else if (I[splitAxis] == lastSlice)
+    {
+      neighborIndexList = &lastSliceIndexList;
+    }
+
     const InputImagePixelType V = outNIt.GetCenterPixel();
-    auto                      mLIt = mIndexList.begin();
-    for (auto oLIt = oIndexList.begin(); oLIt != oIndexList.end(); ++oLIt, ++mLIt)
+    for (const auto n : *neighborIndexList)
     {
-      const InputImagePixelType VN = outNIt.GetPixel(*oLIt);
-      const InputImagePixelType iN = mskNIt.GetPixel(*mLIt);
+      const InputImagePixelType VN = outNIt.GetPixel(n);
+      const InputImagePixelType iN = mskNIt.GetPixel(n);
       // candidate for dilation via flooding
       if (compare(V, VN) && Math::NotAlmostEquals(iN, VN))
       {
         if (compare(iN, V))
         {
           // not clamped by the mask, propagate the center value
-          outNIt.SetPixel(*oLIt, V);
+          outNIt.SetPixel(n, V);
         }
         else
         {
           // apply the clamping
-          outNIt.SetPixel(*oLIt, iN);
+          outNIt.SetPixel(n, iN);
         }
-        IndexFifo.push(outNIt.GetIndex(*oLIt));
+        IndexFifo.push(outNIt.GetIndex(n));
       }
     }
     progress.CompletedPixel();
   }
-
-  if (m_UseInternalCopy)
-  {
-    using CropType = typename itk::CropImageFilter<InputImageType, OutputImageType>;
-    auto crop = CropType::New();
-
-    crop->SetInput(markerImageP);
-    crop->SetUpperBoundaryCropSize(padSize);
-    crop->SetLowerBoundaryCropSize(padSize);
-    crop->GraftOutput(this->GetOutput());
-    /** execute the minipipeline */
-    crop->Update();
-
-    /** graft the minipipeline output back into this filter's output */
-    this->GraftOutput(crop->GetOutput());
-  }
 }
 
 template <typename TInputImage, typename TOutputImage, typename TCompare>
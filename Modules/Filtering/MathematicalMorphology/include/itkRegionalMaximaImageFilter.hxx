@@ -79,6 +79,7 @@ RegionalMaximaImageFilter<TInputImage, TOutputImage>::GenerateData()
   auto regionalMax = ValuedRegionalMaximaImageFilter<TInputImage, TInputImage>::New();
   regionalMax->SetInput(input);
   regionalMax->SetFullyConnected(m_FullyConnected);
+  regionalMax->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   progress->RegisterInternalFilter(regionalMax, 0.67f);
   regionalMax->Update();
 
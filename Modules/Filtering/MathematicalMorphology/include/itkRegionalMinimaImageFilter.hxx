@@ -80,6 +80,7 @@ RegionalMinimaImageFilter<TInputImage, TOutputImage>::GenerateData()
   auto regionalMin = ValuedRegionalMinimaImageFilter<TInputImage, TInputImage>::New();
   regionalMin->SetInput(input);
   regionalMin->SetFullyConnected(m_FullyConnected);
+  regionalMin->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   progress->RegisterInternalFilter(regionalMin, 0.67f);
   regionalMin->Update();
 
@@ -21,6 +21,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkShapedNeighborhoodIterator.h"
 #include "itkConstantBoundaryCondition.h"
+#include "itkTotalProgressReporter.h"
 #include <stack>
 
 namespace itk
@@ -57,6 +58,11 @@ namespace itk
  *
  * The implementation uses the functor model from itkMaximumImageFilter.
  *
+ * The image is split in slabs along its slowest dimension, and the slabs
+ * are processed in parallel with the flooding stopped at the slab borders.
+ * The flat zones which cross a border are completed by a final sequential
+ * flood, so the output does not depend on the number of work units.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Finding regional extrema - methods and performance"
@@ -164,6 +170,23 @@ private:
   using ConstInputIterator = ConstShapedNeighborhoodIterator<InputImageType>;
   using NOutputIterator = ShapedNeighborhoodIterator<OutputImageType>;
   using IndexStack = std::stack<OutIndexType>;
+
+  /** Mark the flat zones of the region which are not extrema, without
+   * modifying the output outside of the region. */
+  void
+  FloodRegion(const InputImageType *        input,
+              OutputImageType *             output,
+              const OutputImageRegionType & region,
+              TotalProgressReporter &       progress);
+
+  /** Set to the marker value the pixels of the region connected to index
+   * with the value V. */
+  void
+  FloodZone(NOutputIterator &             outNIt,
+            const OutputImageRegionType & region,
+            const OutIndexType &          index,
+            OutputImagePixelType          V,
+            IndexStack &                  IS);
 }; // end of class
 } // end namespace itk
 
@@ -19,10 +19,13 @@
 #define itkValuedRegionalExtremaImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkNumericTraits.h"
-#include "itkProgressReporter.h"
 #include "itkConnectedComponentAlgorithm.h"
 
+#include <atomic>
+
 
 namespace itk
 {
@@ -70,135 +73,238 @@ ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunctio
   const InputImageType * input = this->GetInput();
   OutputImageType *      output = this->GetOutput();
 
-  // 2 phases
-  ProgressReporter progress(this, 0, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * 2);
+  const OutputImageRegionType region = output->GetRequestedRegion();
+
+  // The region is split in slabs along the slowest dimension. The slabs are
+  // copied and flooded in parallel, each flood being stopped at the slab
+  // borders. The flat zones which cross a border are then completed by a
+  // sequential flood started from the border pixels. The set of regional
+  // extrema is unique, so the output does not depend on the number of slabs.
+  auto               splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(region, this->GetNumberOfWorkUnits());
+  // the splitter uses the slowest dimension with more than one pixel
+  unsigned int splitAxis = OutputImageDimension - 1;
+  while (splitAxis > 0 && region.GetSize(splitAxis) <= 1)
+  {
+    --splitAxis;
+  }
 
   // copy input to output - isn't there a better way?
   using InputIterator = ImageRegionConstIterator<TInputImage>;
   using OutputIterator = ImageRegionIterator<TOutputImage>;
 
-  InputIterator  inIt(input, output->GetRequestedRegion());
-  OutputIterator outIt(output, output->GetRequestedRegion());
+  const InputImagePixelType firstValue = input->GetPixel(region.GetIndex());
+  std::atomic<bool>         flat{ true };
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      OutputImageRegionType slabRegion = region;
+      splitter->GetSplit(slab, numberOfSlabs, slabRegion);
+      // 2 phases
+      TotalProgressReporter progress(this, region.GetNumberOfPixels() * 2);
+
+      InputIterator  inIt(input, slabRegion);
+      OutputIterator outIt(output, slabRegion);
+      bool           slabFlat = true;
+      while (!outIt.IsAtEnd())
+      {
+        const InputImagePixelType currentValue = inIt.Get();
+        outIt.Set(static_cast<OutputImagePixelType>(currentValue));
+        if (currentValue != firstValue)
+        {
+          slabFlat = false;
+        }
+        ++inIt;
+        ++outIt;
+        progress.CompletedPixel();
+      }
+      if (!slabFlat)
+      {
+        flat = false;
+      }
+    },
+    nullptr);
 
-  const InputImagePixelType firstValue = inIt.Get();
-  this->m_Flat = true;
+  this->m_Flat = flat;
 
-  while (!outIt.IsAtEnd())
+  // if the image is flat, there is no need to do the work:
+  // the image will be unchanged
+  if (this->m_Flat)
   {
-    const InputImagePixelType currentValue = inIt.Get();
-    outIt.Set(static_cast<OutputImagePixelType>(currentValue));
-    if (currentValue != firstValue)
-    {
-      this->m_Flat = false;
-    }
-    ++inIt;
-    ++outIt;
-    progress.CompletedPixel();
+    return;
   }
 
-  // if the image is flat, there is no need to do the work:
-  // the image will be unchanged
-  if (!this->m_Flat)
+  // Now for the real work!
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      OutputImageRegionType slabRegion = region;
+      splitter->GetSplit(slab, numberOfSlabs, slabRegion);
+      TotalProgressReporter progress(this, region.GetNumberOfPixels() * 2);
+      this->FloodRegion(input, output, slabRegion, progress);
+    },
+    nullptr);
+
+  if (numberOfSlabs > 1)
   {
-    // Now for the real work!
-    // More iterators - use shaped ones so that we can set connectivity
-    // Note : all comments refer to finding regional minima, because
-    // it is briefer and clearer than trying to describe both regional
-    // maxima and minima processes at the same time
+    // A pixel left unmarked on one side of a border belongs to a flat zone
+    // which is not an extremum when its neighbor across the border has the
+    // same value and has been marked.
     auto            kernelRadius = ISizeType::Filled(1);
-    NOutputIterator outNIt(kernelRadius, output, output->GetRequestedRegion());
+    NOutputIterator outNIt(kernelRadius, output, region);
     setConnectivity(&outNIt, m_FullyConnected);
+    const typename NOutputIterator::IndexListType indexList = outNIt.GetActiveIndexList();
+
+    TFunction2 compareOut;
+    IndexStack IS;
+    for (unsigned int slab = 1; slab < numberOfSlabs; ++slab)
+    {
+      // the last slice of the previous slab and the first slice of this one
+      OutputImageRegionType borderRegion = region;
+      splitter->GetSplit(slab, numberOfSlabs, borderRegion);
+      borderRegion.SetIndex(splitAxis, borderRegion.GetIndex(splitAxis) - 1);
+      borderRegion.SetSize(splitAxis, 2);
+      for (ImageRegionConstIteratorWithIndex<OutputImageType> it(output, borderRegion); !it.IsAtEnd(); ++it)
+      {
+        const OutputImagePixelType V = it.Get();
+        if (!compareOut(V, m_MarkerValue))
+        {
+          continue;
+        }
+        const OutIndexType index = it.GetIndex();
+        for (const auto n : indexList)
+        {
+          const OutIndexType neighborIndex = index + outNIt.GetOffset(n);
+          if (neighborIndex[splitAxis] != index[splitAxis] && region.IsInside(neighborIndex) &&
+              output->GetPixel(neighborIndex) == m_MarkerValue &&
+              static_cast<OutputImagePixelType>(input->GetPixel(neighborIndex)) == V)
+          {
+            this->FloodZone(outNIt, region, index, V, IS);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
 
-    ConstInputIterator inNIt(kernelRadius, input, output->GetRequestedRegion());
-    setConnectivity(&inNIt, m_FullyConnected);
+template <typename TInputImage, typename TOutputImage, typename TFunction1, typename TFunction2>
+void
+ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunction2>::FloodRegion(
+  const InputImageType *        input,
+  OutputImageType *             output,
+  const OutputImageRegionType & region,
+  TotalProgressReporter &       progress)
+{
+  // More iterators - use shaped ones so that we can set connectivity
+  // Note : all comments refer to finding regional minima, because
+  // it is briefer and clearer than trying to describe both regional
+  // maxima and minima processes at the same time
+  auto            kernelRadius = ISizeType::Filled(1);
+  NOutputIterator outNIt(kernelRadius, output, region);
+  setConnectivity(&outNIt, m_FullyConnected);
 
-    ConstantBoundaryCondition<OutputImageType> iBC;
-    iBC.SetConstant(m_MarkerValue);
-    inNIt.OverrideBoundaryCondition(&iBC);
+  ConstInputIterator inNIt(kernelRadius, input, region);
+  setConnectivity(&inNIt, m_FullyConnected);
 
-    ConstantBoundaryCondition<OutputImageType> oBC;
-    oBC.SetConstant(m_MarkerValue);
-    outNIt.OverrideBoundaryCondition(&oBC);
+  ConstantBoundaryCondition<InputImageType> iBC;
+  iBC.SetConstant(m_MarkerValue);
+  inNIt.OverrideBoundaryCondition(&iBC);
 
-    TFunction1 compareIn;
-    TFunction2 compareOut;
+  ConstantBoundaryCondition<OutputImageType> oBC;
+  oBC.SetConstant(m_MarkerValue);
+  outNIt.OverrideBoundaryCondition(&oBC);
 
-    outIt.GoToBegin();
-    // set up the stack and neighbor list
-    IndexStack                              IS;
-    typename NOutputIterator::IndexListType IndexList = outNIt.GetActiveIndexList();
+  TFunction1 compareIn;
+  TFunction2 compareOut;
 
-    while (!outIt.IsAtEnd())
+  // set up the stack
+  IndexStack IS;
+
+  for (ImageRegionIterator<OutputImageType> outIt(output, region); !outIt.IsAtEnd(); ++outIt)
+  {
+    const OutputImagePixelType V = outIt.Get();
+    // if the output pixel value = the marker value then we have
+    // already visited this pixel and don't need to do so again
+    if (compareOut(V, m_MarkerValue))
     {
-      const OutputImagePixelType V = outIt.Get();
-      // if the output pixel value = the marker value then we have
-      // already visited this pixel and don't need to do so again
-      if (compareOut(V, m_MarkerValue))
-      {
-        // reposition the input iterator
-        inNIt += outIt.GetIndex() - inNIt.GetIndex();
+      // reposition the input iterator
+      inNIt += outIt.GetIndex() - inNIt.GetIndex();
 
-        auto Cent = static_cast<InputImagePixelType>(V);
+      auto Cent = static_cast<InputImagePixelType>(V);
 
-        // check each neighbor of the input pixel
-        typename ConstInputIterator::ConstIterator sIt;
-        for (sIt = inNIt.Begin(); !sIt.IsAtEnd(); ++sIt)
+      // check each neighbor of the input pixel. The input is only read, so
+      // the neighbors may lie in the other slabs.
+      for (auto sIt = inNIt.Begin(); !sIt.IsAtEnd(); ++sIt)
+      {
+        const InputImagePixelType Adjacent = sIt.Get();
+        if (compareIn(Adjacent, Cent))
         {
-          const InputImagePixelType Adjacent = sIt.Get();
-          if (compareIn(Adjacent, Cent))
-          {
-            // The centre pixel cannot be part of a regional minima
-            // because one of its neighbors is smaller.
-            // Set all pixels in the output image that are connected to
-            // the centre pixel and have the same value to
-            // m_MarkerValue
-            // This is the flood filling step. It is a simple, stack
-            // based, procedure. The original value (V) of the pixel is
-            // recorded and the pixel index in the output image
-            // is set to the marker value. The stack is initialized
-            // with the pixel index. The flooding procedure pops the
-            // stack, sets that index to the marker value and places the
-            // indexes of all neighbors with value V on the stack. The
-            // process terminates when the stack is empty.
-
-            outNIt += outIt.GetIndex() - outNIt.GetIndex();
-
-            OutputImagePixelType NVal;
-            OutIndexType         idx;
-            // Initialize the stack
-            IS.push(outNIt.GetIndex());
-            outNIt.SetCenterPixel(m_MarkerValue);
-
-            typename NOutputIterator::IndexListType::const_iterator LIt;
-
-            while (!IS.empty())
-            {
-              // Pop the stack
-              idx = IS.top();
-              IS.pop();
-              // position the iterator
-              outNIt += idx - outNIt.GetIndex();
-              // check neighbors
-              for (LIt = IndexList.begin(); LIt != IndexList.end(); ++LIt)
-              {
-                NVal = outNIt.GetPixel(*LIt);
-                if (NVal == V)
-                {
-                  // still in a flat zone
-                  IS.push(outNIt.GetIndex(*LIt));
-
-                  // set the output as the marker value
-                  outNIt.SetPixel(*LIt, m_MarkerValue);
-                }
-              }
-            }
-            // end flooding
-            break;
-          }
+          // The centre pixel cannot be part of a regional minima
+          // because one of its neighbors is smaller.
+          // Set all pixels in the output image that are connected to
+          // the centre pixel and have the same value to
+          // m_MarkerValue
+          this->FloodZone(outNIt, region, outIt.GetIndex(), V, IS);
+          break;
         }
       }
-      ++outIt;
-      progress.CompletedPixel();
+    }
+    progress.CompletedPixel();
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction1, typename TFunction2>
+void
+ValuedRegionalExtremaImageFilter<TInputImage, TOutputImage, TFunction1, TFunction2>::FloodZone(
+  NOutputIterator &             outNIt,
+  const OutputImageRegionType & region,
+  const OutIndexType &          index,
+  OutputImagePixelType          V,
+  IndexStack &                  IS)
+{
+  // This is the flood filling step. It is a simple, stack
+  // based, procedure. The original value (V) of the pixel is
+  // recorded and the pixel index in the output image
+  // is set to the marker value. The stack is initialized
+  // with the pixel index. The flooding procedure pops the
+  // stack, sets that index to the marker value and places the
+  // indexes of all neighbors with value V on the stack. The
+  // process terminates when the stack is empty.
+  // The flood does not leave the region, so that the slabs
+  // can be flooded concurrently.
+  const typename NOutputIterator::IndexListType & IndexList = outNIt.GetActiveIndexList();
+
+  outNIt += index - outNIt.GetIndex();
+
+  // Initialize the stack
+  IS.push(index);
+  outNIt.SetCenterPixel(m_MarkerValue);
+
+  while (!IS.empty())
+  {
+    // Pop the stack
+    const OutIndexType idx = IS.top();
+    IS.pop();
+    // position the iterator
+    outNIt += idx - outNIt.GetIndex();
+    // check neighbors
+    for (const auto n : IndexList)
+    {
+      const OutIndexType neighborIndex = outNIt.GetIndex(n);
+      if (region.IsInside(neighborIndex) && outNIt.GetPixel(n) == V)
+      {
+        // still in a flat zone
+        IS.push(neighborIndex);
+
+        // set the output as the marker value
+        outNIt.SetPixel(n, m_MarkerValue);
+      }
     }
   }
 }
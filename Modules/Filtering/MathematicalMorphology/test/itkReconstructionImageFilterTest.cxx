@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Check that the reconstruction does not depend on the number of work units
+template <typename TFilter>
+int
+CompareWorkUnits(const typename TFilter::MarkerImageType * marker,
+                 const typename TFilter::MaskImageType *   mask,
+                 bool                                      fullyConnected,
+                 bool                                      useInternalCopy)
+{
+  auto singleThreadedFilter = TFilter::New();
+  singleThreadedFilter->SetMarkerImage(marker);
+  singleThreadedFilter->SetMaskImage(mask);
+  singleThreadedFilter->SetFullyConnected(fullyConnected);
+  singleThreadedFilter->SetUseInternalCopy(useInternalCopy);
+  singleThreadedFilter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleThreadedFilter->Update());
+
+  auto multiThreadedFilter = TFilter::New();
+  multiThreadedFilter->SetMarkerImage(marker);
+  multiThreadedFilter->SetMaskImage(mask);
+  multiThreadedFilter->SetFullyConnected(fullyConnected);
+  multiThreadedFilter->SetUseInternalCopy(useInternalCopy);
+  multiThreadedFilter->SetNumberOfWorkUnits(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiThreadedFilter->Update());
+
+  const auto region = singleThreadedFilter->GetOutput()->GetLargestPossibleRegion();
+  itk::ImageRegionConstIterator<typename TFilter::OutputImageType> singleIt(singleThreadedFilter->GetOutput(), region);
+  itk::ImageRegionConstIterator<typename TFilter::OutputImageType> multiIt(multiThreadedFilter->GetOutput(), region);
+  for (; !singleIt.IsAtEnd(); ++singleIt, ++multiIt)
+  {
+    if (singleIt.Get() != multiIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in " << singleThreadedFilter->GetNameOfClass() << " with FullyConnected: " << fullyConnected
+                << " and UseInternalCopy: " << useInternalCopy << std::endl;
+      std::cerr << "Output with 7 work units differs at index " << singleIt.GetIndex() << ": expected "
+                << singleIt.Get() << ", but got " << multiIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkReconstructionImageFilterTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using PixelType = short;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  constexpr PixelType height = 8;
+
+  auto size = ImageType::SizeType::Filled(24);
+  size[2] = 31;
+
+  auto mask = ImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+
+  auto dilationMarker = ImageType::New();
+  dilationMarker->SetRegions(size);
+  dilationMarker->Allocate();
+
+  auto erosionMarker = ImageType::New();
+  erosionMarker->SetRegions(size);
+  erosionMarker->Allocate();
+
+  // random mask, and markers shifted by the height as in the h-maxima and
+  // h-minima filters, so the values have to flow across the whole image
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  itk::ImageRegionIterator<ImageType> maskIt(mask, mask->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<ImageType> dilationIt(dilationMarker, mask->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<ImageType> erosionIt(erosionMarker, mask->GetLargestPossibleRegion());
+  for (; !maskIt.IsAtEnd(); ++maskIt, ++dilationIt, ++erosionIt)
+  {
+    const auto value = static_cast<PixelType>(generator->GetIntegerVariate(100));
+    maskIt.Set(value);
+    dilationIt.Set(value - height);
+    erosionIt.Set(value + height);
+  }
+
+  using DilationFilterType = itk::ReconstructionByDilationImageFilter<ImageType, ImageType>;
+  using ErosionFilterType = itk::ReconstructionByErosionImageFilter<ImageType, ImageType>;
+
+  int testStatus = EXIT_SUCCESS;
+  for (const bool fullyConnected : { false, true })
+  {
+    for (const bool useInternalCopy : { false, true })
+    {
+      if (CompareWorkUnits<DilationFilterType>(dilationMarker, mask, fullyConnected, useInternalCopy) != EXIT_SUCCESS)
+      {
+        testStatus = EXIT_FAILURE;
+      }
+      if (CompareWorkUnits<ErosionFilterType>(erosionMarker, mask, fullyConnected, useInternalCopy) != EXIT_SUCCESS)
+      {
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The preconditions on the marker must still be checked
+  auto filter = DilationFilterType::New();
+  filter->SetMarkerImage(erosionMarker);
+  filter->SetMaskImage(mask);
+  filter->SetNumberOfWorkUnits(7);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
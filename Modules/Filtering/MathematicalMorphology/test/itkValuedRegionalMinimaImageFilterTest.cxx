@@ -25,6 +25,7 @@
 #include "itkRescaleIntensityImageFilter.h"
 #include "itkAndImageFilter.h"
 #include "itkSimpleFilterWatcher.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkTestingMacros.h"
 
 
@@ -75,6 +76,32 @@ itkValuedRegionalMinimaImageFilterTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
 
+  // The slabs are flooded in parallel: the output must not depend on the
+  // number of work units
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 2, 7 })
+  {
+    auto slabFilter = FilterType::New();
+    slabFilter->SetInput(reader->GetOutput());
+    slabFilter->SetFullyConnected(fullyConnected);
+    slabFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(slabFilter->Update());
+
+    ITK_TEST_EXPECT_EQUAL(slabFilter->GetFlat(), filter->GetFlat());
+    itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> slabIt(slabFilter->GetOutput(),
+                                                    slabFilter->GetOutput()->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it, ++slabIt)
+    {
+      if (it.Get() != slabIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in output with " << numberOfWorkUnits << " work units at index " << it.GetIndex()
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
   // Produce the same output with other filters
   using ConcaveFilterType = itk::HConcaveImageFilter<ImageType, ImageType>;
   auto concaveFilter = ConcaveFilterType::New();
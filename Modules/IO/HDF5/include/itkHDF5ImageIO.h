@@ -138,6 +138,31 @@ public:
   void
   Write(const void * buffer) override;
 
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the shape of the chunks in which the voxel data is stored, in
+   * ITK order (fastest moving dimension first). The components of a pixel
+   * are always stored in the same chunk. A missing or zero size selects the
+   * default: the size of the image, except for the slowest moving dimension
+   * which defaults to one, so that by default a chunk holds one (N-1)
+   * dimensional slice, matching the stream divisions of ImageFileWriter.
+   * ReadImageInformation() sets it to the chunk shape found in the file. */
+  /** @ITKStartGrouping */
+  itkSetMacro(ChunkSize, ChunkSizeType);
+  itkGetConstReferenceMacro(ChunkSize, ChunkSizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether deflate compressed chunks are compressed and
+   * decompressed concurrently by ITK, with HDF5 only storing and
+   * retrieving the compressed bytes. Writes of regions that are not aligned
+   * with the chunks, and datasets with other filters, go through the HDF5
+   * filter pipeline instead. On by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseParallelChunkCompression, bool);
+  itkGetConstMacro(UseParallelChunkCompression, bool);
+  itkBooleanMacro(UseParallelChunkCompression);
+  /** @ITKEndGrouping */
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -204,6 +229,16 @@ private:
   void
   SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpace);
 
+  /** Read or write the IORegion chunk by chunk, (de)compressing the chunks
+   * in parallel. Return false, without doing anything, when the dataset or
+   * the region does not allow it. */
+  /** @ITKStartGrouping */
+  bool
+  ReadChunks(void * buffer);
+  bool
+  WriteChunks(const void * buffer);
+  /** @ITKEndGrouping */
+
   /* A convenience function to ensure that the
    * state of the HDF5ImageIO object is returned
    * to a state similar to constructing a new
@@ -217,6 +252,8 @@ private:
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
   bool                         m_ImageInformationWritten{ false };
+  ChunkSizeType                m_ChunkSize{};
+  bool                         m_UseParallelChunkCompression{ true };
 };
 } // end namespace itk
 
@@ -12,6 +12,7 @@ itk_module(
   ITKIOImageBase
   PRIVATE_DEPENDS
   ITKHDF5
+  ITKZLIB
   TEST_DEPENDS
   ITKTestKernel
   ITKImageSources
@@ -22,8 +22,12 @@
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPrintHelper.h"
+#include "itk_zlib.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace itk
 {
@@ -49,9 +53,13 @@ HDF5ImageIO::~HDF5ImageIO() { this->ResetToInitialState(); }
 void
 HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
+  using namespace print_helper;
+
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+  os << indent << "UseParallelChunkCompression: " << (m_UseParallelChunkCompression ? "On" : "Off") << std::endl;
 }
 
 //
@@ -728,6 +736,22 @@ HDF5ImageIO::ReadImageInformation()
       }
     }
     //
+    // record the chunk shape, in ITK order
+    m_ChunkSize.clear();
+    {
+      const H5::DSetCreatPropList plist = imageSet.getCreatePlist();
+      if (plist.getLayout() == H5D_CHUNKED)
+      {
+        const int  nDims = imageSpace.getSimpleExtentNdims();
+        const auto chunkDims = make_unique_for_overwrite<hsize_t[]>(nDims);
+        plist.getChunk(nDims, chunkDims.get());
+        for (int i = 0; i < numDims; ++i)
+        {
+          m_ChunkSize.push_back(chunkDims[numDims - 1 - i]);
+        }
+      }
+    }
+    //
     // read out metadata
     MetaDataDictionary & metaDict = this->GetMetaDataDictionary();
     // Necessary to clear dict if ImageIO object is re-used
@@ -945,13 +969,352 @@ HDF5ImageIO::SetupStreaming(H5::DataSpace * imageSpace, H5::DataSpace * slabSpac
   imageSpace->selectHyperslab(H5S_SELECT_SET, HDFSize.get(), offset.get());
 }
 
+namespace
+{
+// The chunks of the voxel data set that overlap an IORegion. All the
+// coordinates are in ITK order (fastest moving first); the components of
+// a pixel are folded into the pixel size.
+struct ChunkLayout
+{
+  std::vector<hsize_t>              ImageSize;
+  std::vector<hsize_t>              ChunkSize;
+  std::vector<hsize_t>              RegionStart;
+  std::vector<hsize_t>              RegionSize;
+  size_t                            PixelSize;
+  size_t                            HDFRank;
+  std::vector<std::vector<hsize_t>> ChunkOrigins;
+  int                               DeflateLevel;
+
+  size_t
+  ChunkBytes() const
+  {
+    size_t bytes = PixelSize;
+    for (const hsize_t size : ChunkSize)
+    {
+      bytes *= size;
+    }
+    return bytes;
+  }
+
+  // The chunk offset expected by the direct chunk IO functions of HDF5.
+  std::vector<hsize_t>
+  HDFOffset(const std::vector<hsize_t> & origin) const
+  {
+    std::vector<hsize_t> offset(HDFRank, 0);
+    for (size_t d = 0; d < origin.size(); ++d)
+    {
+      offset[origin.size() - 1 - d] = origin[d];
+    }
+    return offset;
+  }
+
+  // Copy the part of the region stored in the chunk at origin, from a
+  // chunk buffer to a region buffer or the other way around.
+  void
+  Copy(const std::vector<hsize_t> & origin, char * chunk, char * region, bool chunkToRegion) const
+  {
+    const size_t         n = origin.size();
+    std::vector<hsize_t> lo(n);
+    std::vector<hsize_t> hi(n);
+    for (size_t d = 0; d < n; ++d)
+    {
+      lo[d] = std::max(origin[d], RegionStart[d]);
+      hi[d] = std::min({ origin[d] + ChunkSize[d], RegionStart[d] + RegionSize[d], ImageSize[d] });
+    }
+    const size_t         rowBytes = (hi[0] - lo[0]) * PixelSize;
+    std::vector<hsize_t> p(lo);
+    for (;;)
+    {
+      size_t chunkOffset = 0;
+      size_t regionOffset = 0;
+      size_t chunkStride = PixelSize;
+      size_t regionStride = PixelSize;
+      for (size_t d = 0; d < n; ++d)
+      {
+        chunkOffset += (p[d] - origin[d]) * chunkStride;
+        regionOffset += (p[d] - RegionStart[d]) * regionStride;
+        chunkStride *= ChunkSize[d];
+        regionStride *= RegionSize[d];
+      }
+      if (chunkToRegion)
+      {
+        std::memcpy(region + regionOffset, chunk + chunkOffset, rowBytes);
+      }
+      else
+      {
+        std::memcpy(chunk + chunkOffset, region + regionOffset, rowBytes);
+      }
+      size_t d = 1;
+      for (; d < n; ++d)
+      {
+        if (++p[d] < hi[d])
+        {
+          break;
+        }
+        p[d] = lo[d];
+      }
+      if (d >= n)
+      {
+        break;
+      }
+    }
+  }
+};
+
+// Fill in layout for a data set whose chunks are deflate compressed and
+// nothing else. Return false for any other data set.
+bool
+GetChunkLayout(const H5::DataSet &                             dataSet,
+               const ImageIORegion &                           region,
+               const std::vector<ImageIOBase::SizeValueType> & dimensions,
+               unsigned int                                    numComponents,
+               size_t                                          componentSize,
+               ChunkLayout &                                   layout)
+{
+  const H5::DSetCreatPropList plist = dataSet.getCreatePlist();
+  if (plist.getLayout() != H5D_CHUNKED || plist.getNfilters() != 1 ||
+      dataSet.getDataType().getSize() != componentSize)
+  {
+    return false;
+  }
+  // unallocated chunks are assumed to be zero
+  H5D_fill_value_t fillValueStatus;
+  if (H5Pfill_value_defined(plist.getId(), &fillValueStatus) < 0 || fillValueStatus != H5D_FILL_VALUE_DEFAULT)
+  {
+    return false;
+  }
+  unsigned int  flags = 0;
+  size_t        numValues = 1;
+  unsigned int  values[1] = { 0 };
+  char          name[1];
+  unsigned int  filterConfig = 0;
+  const H5Z_filter_t filter = plist.getFilter(0, flags, numValues, values, 0, name, filterConfig);
+  if (filter != H5Z_FILTER_DEFLATE || numValues < 1)
+  {
+    return false;
+  }
+  layout.DeflateLevel = static_cast<int>(values[0]);
+
+  const size_t n = dimensions.size();
+  layout.HDFRank = n + (numComponents > 1 ? 1 : 0);
+  std::vector<hsize_t> chunkDims(layout.HDFRank);
+  if (plist.getChunk(static_cast<int>(layout.HDFRank), chunkDims.data()) != static_cast<int>(layout.HDFRank) ||
+      (numComponents > 1 && chunkDims[n] != numComponents))
+  {
+    return false;
+  }
+  layout.PixelSize = numComponents * componentSize;
+  layout.ImageSize.resize(n);
+  layout.ChunkSize.resize(n);
+  layout.RegionStart.resize(n);
+  layout.RegionSize.resize(n);
+  for (size_t d = 0; d < n; ++d)
+  {
+    layout.ImageSize[d] = dimensions[d];
+    layout.ChunkSize[d] = chunkDims[n - 1 - d];
+    layout.RegionStart[d] = d < region.GetImageDimension() ? region.GetIndex(d) : 0;
+    layout.RegionSize[d] = d < region.GetImageDimension() ? region.GetSize(d) : 1;
+    if (layout.RegionSize[d] == 0)
+    {
+      return false;
+    }
+  }
+
+  // enumerate the chunks overlapping the region, fastest moving first
+  layout.ChunkOrigins.clear();
+  std::vector<hsize_t> first(n);
+  std::vector<hsize_t> origin(n);
+  for (size_t d = 0; d < n; ++d)
+  {
+    first[d] = layout.RegionStart[d] / layout.ChunkSize[d] * layout.ChunkSize[d];
+    origin[d] = first[d];
+  }
+  for (;;)
+  {
+    layout.ChunkOrigins.push_back(origin);
+    size_t d = 0;
+    for (; d < n; ++d)
+    {
+      origin[d] += layout.ChunkSize[d];
+      if (origin[d] < layout.RegionStart[d] + layout.RegionSize[d])
+      {
+        break;
+      }
+      origin[d] = first[d];
+    }
+    if (d >= n)
+    {
+      break;
+    }
+  }
+  return true;
+}
+} // end anonymous namespace
+
+bool
+HDF5ImageIO::ReadChunks(void * buffer)
+{
+#if H5_VERSION_GE(1, 10, 5)
+  ChunkLayout layout;
+  if (!m_UseParallelChunkCompression ||
+      !GetChunkLayout(*m_VoxelDataSet,
+                      this->GetIORegion(),
+                      m_Dimensions,
+                      this->GetNumberOfComponents(),
+                      this->GetComponentSize(),
+                      layout))
+  {
+    return false;
+  }
+  const hid_t  dataSetId = m_VoxelDataSet->getId();
+  const size_t chunkBytes = layout.ChunkBytes();
+  char * const region = static_cast<char *>(buffer);
+
+  // HDF5 retrieves a batch of compressed chunks, which are then inflated in
+  // parallel
+  const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const size_t                     batchSize = 2 * static_cast<size_t>(threader->GetNumberOfWorkUnits());
+  std::vector<std::vector<char>>   compressed(batchSize);
+  std::vector<unsigned int>        filterMasks(batchSize);
+  for (size_t first = 0; first < layout.ChunkOrigins.size(); first += batchSize)
+  {
+    const size_t last = std::min(first + batchSize, layout.ChunkOrigins.size());
+    for (size_t k = first; k < last; ++k)
+    {
+      const std::vector<hsize_t> offset = layout.HDFOffset(layout.ChunkOrigins[k]);
+      haddr_t                    address = 0;
+      hsize_t                    storageSize = 0;
+      if (H5Dget_chunk_info_by_coord(dataSetId, offset.data(), &filterMasks[k - first], &address, &storageSize) < 0)
+      {
+        itkExceptionMacro("Cannot locate a chunk of " << this->GetFileName());
+      }
+      compressed[k - first].resize(storageSize);
+      uint32_t filterMask = 0;
+      if (storageSize > 0 && H5Dread_chunk(dataSetId, H5P_DEFAULT, offset.data(), &filterMask, compressed[k - first].data()) < 0)
+      {
+        itkExceptionMacro("Cannot read a chunk of " << this->GetFileName());
+      }
+    }
+    threader->ParallelizeArray(
+      first,
+      last,
+      [&](SizeValueType k) {
+        const std::vector<char> & source = compressed[k - first];
+        std::vector<char>         chunk(chunkBytes, 0);
+        if (source.empty())
+        {
+          // unallocated chunk, holding the fill value
+        }
+        else if (filterMasks[k - first] & 1)
+        {
+          // stored without compression
+          std::copy_n(source.begin(), std::min(source.size(), chunkBytes), chunk.begin());
+        }
+        else
+        {
+          auto destinationSize = static_cast<uLongf>(chunkBytes);
+          if (uncompress(reinterpret_cast<Bytef *>(chunk.data()),
+                         &destinationSize,
+                         reinterpret_cast<const Bytef *>(source.data()),
+                         static_cast<uLong>(source.size())) != Z_OK ||
+              destinationSize != chunkBytes)
+          {
+            itkExceptionMacro("Cannot decompress a chunk of " << this->GetFileName());
+          }
+        }
+        layout.Copy(layout.ChunkOrigins[k], chunk.data(), region, true);
+      },
+      nullptr);
+  }
+  return true;
+#else
+  (void)buffer;
+  return false;
+#endif
+}
+
+bool
+HDF5ImageIO::WriteChunks(const void * buffer)
+{
+#if H5_VERSION_GE(1, 10, 5)
+  ChunkLayout layout;
+  if (!m_UseParallelChunkCompression ||
+      !GetChunkLayout(*m_VoxelDataSet,
+                      this->GetIORegion(),
+                      m_Dimensions,
+                      this->GetNumberOfComponents(),
+                      this->GetComponentSize(),
+                      layout))
+  {
+    return false;
+  }
+  // only whole chunks can be written directly
+  for (size_t d = 0; d < layout.ChunkSize.size(); ++d)
+  {
+    const hsize_t end = layout.RegionStart[d] + layout.RegionSize[d];
+    if (layout.RegionStart[d] % layout.ChunkSize[d] != 0 ||
+        (end % layout.ChunkSize[d] != 0 && end != layout.ImageSize[d]))
+    {
+      return false;
+    }
+  }
+  const hid_t  dataSetId = m_VoxelDataSet->getId();
+  const size_t chunkBytes = layout.ChunkBytes();
+  // the chunks are only read from the region buffer
+  char * const region = const_cast<char *>(static_cast<const char *>(buffer));
+
+  // a batch of chunks is deflated in parallel, then handed to HDF5
+  const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const size_t                     batchSize = 2 * static_cast<size_t>(threader->GetNumberOfWorkUnits());
+  std::vector<std::vector<char>>   compressed(batchSize);
+  for (size_t first = 0; first < layout.ChunkOrigins.size(); first += batchSize)
+  {
+    const size_t last = std::min(first + batchSize, layout.ChunkOrigins.size());
+    threader->ParallelizeArray(
+      first,
+      last,
+      [&](SizeValueType k) {
+        // edge chunks are padded with zeros
+        std::vector<char> chunk(chunkBytes, 0);
+        layout.Copy(layout.ChunkOrigins[k], chunk.data(), region, false);
+        std::vector<char> & destination = compressed[k - first];
+        auto                destinationSize = compressBound(static_cast<uLong>(chunkBytes));
+        destination.resize(destinationSize);
+        if (compress2(reinterpret_cast<Bytef *>(destination.data()),
+                      &destinationSize,
+                      reinterpret_cast<const Bytef *>(chunk.data()),
+                      static_cast<uLong>(chunkBytes),
+                      layout.DeflateLevel) != Z_OK)
+        {
+          itkExceptionMacro("Cannot compress a chunk of " << this->GetFileName());
+        }
+        destination.resize(destinationSize);
+      },
+      nullptr);
+    for (size_t k = first; k < last; ++k)
+    {
+      const std::vector<hsize_t> offset = layout.HDFOffset(layout.ChunkOrigins[k]);
+      if (H5Dwrite_chunk(
+            dataSetId, H5P_DEFAULT, 0, offset.data(), compressed[k - first].size(), compressed[k - first].data()) < 0)
+      {
+        itkExceptionMacro("Cannot write a chunk of " << this->GetFileName());
+      }
+    }
+  }
+  return true;
+#else
+  (void)buffer;
+  return false;
+#endif
+}
+
 void
 HDF5ImageIO::Read(void * buffer)
 {
-  const ImageIORegion            regionToRead = this->GetIORegion();
-  const ImageIORegion::SizeType  size = regionToRead.GetSize();
-  const ImageIORegion::IndexType start = regionToRead.GetIndex();
-
+  if (this->ReadChunks(buffer))
+  {
+    return;
+  }
   const H5::DataType voxelType = m_VoxelDataSet->getDataType();
   H5::DataSpace      imageSpace = m_VoxelDataSet->getSpace();
 
@@ -1070,14 +1433,25 @@ HDF5ImageIO::WriteImageInformation()
     const H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
+    // by default, set the chunk size to be the N-1 dimension
     // region
     const H5::DSetCreatPropList plist;
 
     // we have implicit compression enabled here?
     plist.setDeflate(this->GetCompressionLevel());
 
-    dims[0] = 1;
+    const int imageDims = this->GetNumberOfDimensions();
+    for (int i(0), j(imageDims - 1); i < imageDims; i++, j--)
+    {
+      if (i < static_cast<int>(m_ChunkSize.size()) && m_ChunkSize[i] > 0)
+      {
+        dims[j] = std::min<hsize_t>(m_ChunkSize[i], dims[j]);
+      }
+      else if (j == 0)
+      {
+        dims[j] = 1;
+      }
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
@@ -1258,6 +1632,10 @@ void
 HDF5ImageIO::Write(const void * buffer)
 {
   this->WriteImageInformation();
+  if (this->WriteChunks(buffer))
+  {
+    return;
+  }
   try
   {
     const int numComponents = this->GetNumberOfComponents();
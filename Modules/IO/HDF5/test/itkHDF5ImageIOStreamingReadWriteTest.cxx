@@ -16,6 +16,7 @@
  *
  *=========================================================================*/
 #include "itkHDF5ImageIOFactory.h"
+#include "itkHDF5ImageIO.h"
 #include "itkIOTestHelper.h"
 #include "itkPipelineMonitorImageFilter.h"
 #include "itkStreamingImageFilter.h"
@@ -89,7 +90,9 @@ private:
 
 template <typename TPixel>
 int
-HDF5ReadWriteTest2(const char * fileName)
+HDF5ReadWriteTest2(const char *                                  fileName,
+                   const itk::HDF5ImageIO::ChunkSizeType & chunkSize = {},
+                   bool                                    useParallelChunkCompression = true)
 {
   // Define image type.
   using ImageType = typename itk::Image<TPixel, 3>;
@@ -109,6 +112,10 @@ HDF5ReadWriteTest2(const char * fileName)
   using MonitorFilterType = typename itk::PipelineMonitorImageFilter<ImageType>;
   auto writerMonitor = MonitorFilterType::New();
   writerMonitor->SetInput(imageSource->GetOutput());
+  auto writerIO = itk::HDF5ImageIO::New();
+  writerIO->SetChunkSize(chunkSize);
+  writerIO->SetUseParallelChunkCompression(useParallelChunkCompression);
+  writer->SetImageIO(writerIO);
   writer->SetFileName(fileName);
   writer->SetInput(writerMonitor->GetOutput());
   writer->SetNumberOfStreamDivisions(5);
@@ -151,6 +158,9 @@ HDF5ReadWriteTest2(const char * fileName)
   // Read image with streaming.
   using ReaderType = typename itk::ImageFileReader<ImageType>;
   auto reader = ReaderType::New();
+  auto readerIO = itk::HDF5ImageIO::New();
+  readerIO->SetUseParallelChunkCompression(useParallelChunkCompression);
+  reader->SetImageIO(readerIO);
   reader->SetFileName(fileName);
   reader->SetUseStreaming(true);
   auto readerMonitor = MonitorFilterType::New();
@@ -203,6 +213,15 @@ HDF5ReadWriteTest2(const char * fileName)
     }
   }
 
+  // Check the chunk shape stored in the file.
+  const itk::HDF5ImageIO::ChunkSizeType expectedChunkSize =
+    chunkSize.empty() ? itk::HDF5ImageIO::ChunkSizeType{ 5, 5, 1 } : chunkSize;
+  if (readerIO->GetChunkSize() != expectedChunkSize)
+  {
+    std::cout << "Read chunk size doesn't match the written one" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // Check number of streaming regions.
   if (!readerMonitor->VerifyInputFilterExecutedStreaming(5))
   {
@@ -249,5 +268,10 @@ itkHDF5ImageIOStreamingReadWriteTest(int argc, char * argv[])
   result += HDF5ReadWriteTest2<unsigned char>("StreamingUCharImage.hdf5");
   result += HDF5ReadWriteTest2<float>("StreamingFloatImage.hdf5");
   result += HDF5ReadWriteTest2<itk::RGBPixel<unsigned char>>("StreamingRGBImage.hdf5");
+  // chunks not aligned with the streamed regions
+  result += HDF5ReadWriteTest2<float>("StreamingFloatChunkImage.hdf5", { 2, 3, 2 });
+  // aligned chunks, partially outside of the image
+  result += HDF5ReadWriteTest2<itk::RGBPixel<unsigned char>>("StreamingRGBChunkImage.hdf5", { 2, 3, 1 });
+  result += HDF5ReadWriteTest2<unsigned char>("StreamingUCharFilterImage.hdf5", { 2, 3, 1 }, false);
   return result != 0;
 }
@@ -121,6 +121,20 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the whole image is memory mapped from the file rather
+   * than read into a newly allocated buffer, when the ImageIO reports that
+   * its data can be mapped (see ImageIOBase::CanMemoryMapData()) and no
+   * pixel conversion is needed. The output then uses a
+   * MemoryMappedImageContainer: pages of the file are loaded on first
+   * access and shared with the page cache, and writes to the image are
+   * private copies that do not modify the file. Other reads fall back to
+   * reading the data. Default is off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+  /** @ITKEndGrouping */
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -139,6 +153,12 @@ protected:
   void
   TestFileExistanceAndReadability();
 
+  /** Memory map the data of the file as the pixel container of the output,
+   * when UseMemoryMapping is on and the output covers the whole file
+   * without conversion. Returns whether the output was mapped. */
+  bool
+  MemoryMapOutput();
+
   /** Prepare the allocation of the output image during the first back
    * propagation of the pipeline. */
   void
@@ -163,6 +183,8 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
 private:
   std::string m_ExceptionMessage{};
 
@@ -27,7 +27,9 @@
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMemoryMappedImageContainer.h"
 #include <fstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -49,6 +51,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -356,6 +359,12 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   const typename TOutputImage::Pointer output = this->GetOutput();
 
+  if (this->MemoryMapOutput())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
   itkDebugMacro("ImageFileReader::GenerateData() \n"
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
@@ -441,6 +450,57 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MemoryMapOutput()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementType = typename PixelContainerType::Element;
+  using ElementIdentifierType = typename PixelContainerType::ElementIdentifier;
+  using MappedContainerType = MemoryMappedImageContainer<ElementIdentifierType, ElementType>;
+
+  if constexpr (std::is_same_v<PixelContainerType, ImportImageContainer<ElementIdentifierType, ElementType>>)
+  {
+    const typename TOutputImage::Pointer output = this->GetOutput();
+    auto * const                         mappedContainer = dynamic_cast<MappedContainerType *>(output->GetPixelContainer());
+
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    const auto            sizeOfActualIORegion = static_cast<SizeValueType>(
+      m_ActualIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents()));
+    std::string           dataFileName;
+    ImageIOBase::SizeType dataOffset = 0;
+    if (m_UseMemoryMapping && m_ImageIO->GetComponentType() == ioType &&
+        m_ImageIO->GetNumberOfComponents() == output->GetNumberOfComponentsPerPixel() &&
+        m_ActualIORegion.GetNumberOfPixels() == output->GetRequestedRegion().GetNumberOfPixels() &&
+        static_cast<ImageIOBase::SizeType>(m_ActualIORegion.GetNumberOfPixels()) ==
+          m_ImageIO->GetImageSizeInPixels() &&
+        sizeOfActualIORegion % sizeof(ElementType) == 0)
+    {
+      m_ImageIO->SetFileName(this->GetFileName().c_str());
+      if (m_ImageIO->CanMemoryMapData(dataFileName, dataOffset) && dataOffset >= 0 &&
+          static_cast<SizeValueType>(dataOffset) % alignof(ElementType) == 0)
+      {
+        itkDebugMacro("Memory mapping " << sizeOfActualIORegion << " bytes at offset " << dataOffset << " of "
+                                        << dataFileName);
+        const auto container = MappedContainerType::New();
+        container->MapFile(dataFileName,
+                           static_cast<SizeValueType>(dataOffset),
+                           static_cast<ElementIdentifierType>(sizeOfActualIORegion / sizeof(ElementType)));
+        output->SetBufferedRegion(output->GetRequestedRegion());
+        output->SetPixelContainer(container);
+        return true;
+      }
+    }
+
+    if (mappedContainer != nullptr)
+    {
+      // do not read into the mapping of a previous update
+      output->SetPixelContainer(PixelContainerType::New());
+    }
+  }
+  return false;
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
@@ -468,6 +468,18 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine whether the pixel data of the file, as described by
+   * ReadImageInformation(), is stored uncompressed, in the native byte
+   * order and as one contiguous block of a single file, so that it can be
+   * memory mapped instead of read. If so, set dataFileName to the file
+   * holding the data and dataOffset to the position of its first byte.
+   * Default is false. */
+  virtual bool
+  CanMemoryMapData(std::string & itkNotUsed(dataFileName), SizeType & itkNotUsed(dataOffset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
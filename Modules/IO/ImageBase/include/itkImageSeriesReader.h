@@ -179,6 +179,24 @@ public:
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
 
+  /** Set/Get whether the slices are read concurrently. When enabled,
+   * the files are distributed dynamically over the work units of the
+   * MultiThreader, and each file is decoded directly into its final
+   * location in the output buffer. At most NumberOfWorkUnits files are
+   * being read at any time, so a dedicated MultiThreader (see
+   * SetMultiThreader()) together with SetNumberOfWorkUnits() bounds the
+   * number of slices in flight. The MetaDataDictionaryArray and the
+   * non-uniform sampling checks are the same as for sequential reading.
+   *
+   * If an ImageIO has been set, each work unit reads through its own
+   * instance created by ImageIO->CreateAnother(), so settings applied to
+   * the ImageIO object are not propagated. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseParallelReading, bool);
+  itkGetConstMacro(UseParallelReading, bool);
+  itkBooleanMacro(UseParallelReading);
+  /** @ITKEndGrouping */
+
   /** Set the relative threshold for issuing warnings about non-uniform sampling */
   /** @ITKStartGrouping */
   itkSetMacro(SpacingWarningRelThreshold, double);
@@ -218,6 +236,8 @@ protected:
 
   bool m_UseStreaming{ true };
 
+  bool m_UseParallelReading{ false };
+
   bool m_SpacingDefined{ false };
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
@@ -228,6 +248,23 @@ private:
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** What is known about a slice once its pixels have been read. */
+  struct SliceInformation
+  {
+    bool                             Read{ false };
+    typename TOutputImage::PointType Origin{};
+    MetaDataDictionary               Dictionary{};
+  };
+
+  /** Read the file of the given slice into its part of the output
+   * buffer. May be called concurrently for different slices. */
+  void
+  ReadSlice(int                     slice,
+            const ImageRegionType & sliceRegionToRequest,
+            const SizeType &        validSize,
+            ImageIOBase *           imageIO,
+            SliceInformation &      sliceInformation);
+
   /** Array of MetaDataDictionaries. This allows to hold information from the
    * ImageIO objects after reading every sub image in the series */
   DictionaryArrayType m_MetaDataDictionaryArray{};
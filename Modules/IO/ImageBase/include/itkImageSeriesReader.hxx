@@ -24,7 +24,9 @@
 #include "itkVector.h"
 #include "itkMath.h"
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include <atomic>
 #include <cstddef> // For ptrdiff_t.
 #include <iomanip>
 
@@ -39,6 +41,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "UseParallelReading: " << m_UseParallelReading << std::endl;
   os << indent << "FileNames:" << std::endl;
   for (const auto & fileName : m_FileNames)
   {
@@ -259,9 +262,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->SetBufferedRegion(requestedRegion);
   output->Allocate();
 
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
-
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
@@ -270,140 +270,110 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
-
-  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-  double                             maxSpacingDeviation = 0.0;
-  bool                               prevSliceIsValid = false;
-
-  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+  IndexType  sliceStartIndex = requestedRegion.GetIndex();
+  const auto numberOfFiles = static_cast<int>(m_FileNames.size());
 
+  // select the slices which contribute pixels to the requested region
+  std::vector<int> slicesToRead;
   for (int i = 0; i != numberOfFiles; ++i)
   {
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
-
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
-
-    // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    if (requestedRegion.IsInside(sliceStartIndex))
     {
-      continue;
+      slicesToRead.push_back(i);
     }
+  }
 
-    // configure reader
-    auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+  std::vector<SliceInformation> slices(static_cast<size_t>(numberOfFiles));
 
-    TOutputImage * readerOutput = reader->GetOutput();
+  if (m_UseParallelReading && slicesToRead.size() > 1)
+  {
+    const ThreadIdType numberOfWorkUnits =
+      std::min(this->GetNumberOfWorkUnits(), static_cast<ThreadIdType>(slicesToRead.size()));
+
+    // Each work unit takes the next unread slice, so that slices which
+    // are slow to decode do not hold back the other work units.
+    std::atomic<size_t> nextSlice{ 0 };
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [this, &nextSlice, &slicesToRead, &slices, &sliceRegionToRequest, &validSize](SizeValueType) {
+        ImageIOBase::Pointer imageIO;
+        if (m_ImageIO)
+        {
+          imageIO = dynamic_cast<ImageIOBase *>(m_ImageIO->CreateAnother().GetPointer());
+        }
 
-    if (m_ImageIO)
+        TotalProgressReporter progress(this, slicesToRead.size());
+        for (size_t k = nextSlice++; k < slicesToRead.size(); k = nextSlice++)
+        {
+          const int i = slicesToRead[k];
+          this->ReadSlice(i, sliceRegionToRequest, validSize, imageIO, slices[i]);
+          progress.CompletedPixel();
+        }
+      },
+      nullptr);
+  }
+  else
+  {
+    // progress reported on a per slice basis
+    ProgressReporter progress(this, 0, slicesToRead.size(), 100);
+    for (const int i : slicesToRead)
     {
-      reader->SetImageIO(m_ImageIO);
+      this->ReadSlice(i, sliceRegionToRequest, validSize, m_ImageIO, slices[i]);
+      progress.CompletedPixel();
     }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
+  }
 
-    // update the data or info
-    if (!insideRequestedRegion)
-    {
-      reader->UpdateOutputInformation();
-    }
-    else
-    {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
+  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
+  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
+  double                             maxSpacingDeviation = 0.0;
+  bool                               prevSliceIsValid = false;
 
-      // propagate the requested region to determine what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
+  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
 
-      // check that the size of each slice is the same
-      if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
-      {
-        itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
-                          << readerOutput->GetLargestPossibleRegion().GetSize()
-                          << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
-      }
+  // The per slice book keeping is done in slice order, independent of
+  // the order in which the slices were read.
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    SliceInformation & slice = slices[i];
+    bool               nonUniformSampling = false;
+    double             spacingDeviation = 0.0;
 
-      // get the size of the region to be read
-      const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+    // check if we need this slice
+    if (!slice.Read && !needToUpdateMetaDataDictionaryArray)
+    {
+      continue;
+    }
 
-      if (readSize == sliceRegionToRequest.GetSize())
+    if (!slice.Read)
+    {
+      // only the meta data of this slice is needed
+      const int iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+      auto      reader = ReaderType::New();
+      reader->SetFileName(m_FileNames[iFileName].c_str());
+      if (m_ImageIO)
       {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool bufferDelete = false;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
-        {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer,
-            static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
-            bufferDelete);
-        }
-        else
-        {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer(
-            outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
-        }
-        readerOutput->UpdateOutputData();
+        reader->SetImageIO(m_ImageIO);
       }
-      else
+      reader->UpdateOutputInformation();
+      if (!reader->GetImageIO())
       {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
-
-        reader->Update();
-
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
-
-        // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        }
-
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        continue;
       }
-
+      slice.Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+    }
+    else
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = slice.Origin;
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -430,18 +400,15 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = slice.Origin;
         prevSliceIsValid = true;
       }
+    }
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
-
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    // Move the MetaDataDictionary into the array
+    if (needToUpdateMetaDataDictionaryArray)
     {
-      MetaDataDictionary newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      MetaDataDictionary newDictionary = std::move(slice.Dictionary);
       if (nonUniformSampling)
       {
         // slice-specific information
@@ -479,6 +446,120 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   }
 }
 
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ReadSlice(int                     slice,
+                                           const ImageRegionType & sliceRegionToRequest,
+                                           const SizeType &        validSize,
+                                           ImageIOBase *           imageIO,
+                                           SliceInformation &      sliceInformation)
+{
+  TOutputImage * output = this->GetOutput();
+
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const auto            numberOfFiles = static_cast<int>(m_FileNames.size());
+  const int             iFileName = (m_ReverseOrder ? numberOfFiles - slice - 1 : slice);
+
+  // configure reader
+  auto reader = ReaderType::New();
+  reader->SetFileName(m_FileNames[iFileName].c_str());
+
+  TOutputImage * readerOutput = reader->GetOutput();
+
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(m_UseStreaming);
+  readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+  // read the meta data information
+  readerOutput->UpdateOutputInformation();
+
+  // propagate the requested region to determine what the region
+  // will actually be read
+  readerOutput->PropagateRequestedRegion();
+
+  // check that the size of each slice is the same
+  if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
+  {
+    itkExceptionMacro("Size mismatch! The size of  "
+                      << m_FileNames[iFileName].c_str() << " is " << readerOutput->GetLargestPossibleRegion().GetSize()
+                      << " and does not match the required size " << validSize << " from file "
+                      << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+  }
+
+  // get the size of the region to be read
+  const SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+
+  if (readSize == sliceRegionToRequest.GetSize())
+  {
+    // if the buffer of the ImageReader is going to match that of
+    // ourselves, then set the ImageReader's buffer to a section
+    // of ours
+
+    const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+    using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+    const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+
+    const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                    ? (slice - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                    : 0;
+
+    const ptrdiff_t numberOfPixelComponentsUpToSlice =
+      numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+    const bool bufferDelete = false;
+
+    typename TOutputImage::InternalPixelType * outputSliceBuffer =
+      output->GetBufferPointer() + numberOfPixelComponentsUpToSlice;
+
+    if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+    {
+      // if the input image type is a vector image then the number
+      // of components needs to be set for the size
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer,
+        static_cast<unsigned long>(numberOfPixelsInSlice * numberOfInternalComponentsPerPixel),
+        bufferDelete);
+    }
+    else
+    {
+      // otherwise the actual number of pixels needs to be passed
+      readerOutput->GetPixelContainer()->SetImportPointer(
+        outputSliceBuffer, static_cast<unsigned long>(numberOfPixelsInSlice), bufferDelete);
+    }
+    readerOutput->UpdateOutputData();
+  }
+  else
+  {
+    // the read region isn't going to match exactly what we need
+    // to update to buffer created by the reader, then copy
+
+    reader->Update();
+
+    // output of buffer copy
+    ImageRegionType outRegion = requestedRegion;
+
+    // set the moving dimension to the slice, with a size of 1
+    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    {
+      outRegion.SetIndex(this->m_NumberOfDimensionsInImage, slice);
+      outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+    }
+
+    ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+  }
+
+  sliceInformation.Read = true;
+  sliceInformation.Origin = readerOutput->GetOrigin();
+  if (reader->GetImageIO())
+  {
+    sliceInformation.Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+  }
+}
+
 template <typename TOutputImage>
 auto
 ImageSeriesReader<TOutputImage>::GetMetaDataDictionaryArray() const -> DictionaryArrayRawPointer
@@ -0,0 +1,77 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+
+#include "ITKIOImageBaseExport.h"
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFile
+ * \brief A copy-on-write mapping of a range of bytes of a file.
+ *
+ * The mapped memory is readable and writable. Pages are read from the
+ * file when first accessed, and are shared with the page cache until they
+ * are written to; writes are private to the mapping and never reach the
+ * file. The range is unmapped when the object is destroyed.
+ *
+ * \sa MemoryMappedImageContainer
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedFile
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Map length bytes of fileName, starting at offset. Throws an
+   * ExceptionObject when the file cannot be opened or mapped, or is too
+   * short. */
+  MemoryMappedFile(const std::string & fileName, SizeValueType offset, SizeValueType length);
+
+  ~MemoryMappedFile();
+
+  /** Return the address of the byte at offset in the file. */
+  void *
+  GetPointer() const
+  {
+    return m_Pointer;
+  }
+
+  /** Return the number of mapped bytes requested. */
+  SizeValueType
+  GetLength() const
+  {
+    return m_Length;
+  }
+
+private:
+  /** Start and size of the mapping, which begins at the page boundary
+   * preceding the requested offset. */
+  void *        m_Address{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+
+  void *        m_Pointer{ nullptr };
+  SizeValueType m_Length{ 0 };
+};
+} // end namespace itk
+
+#endif // itkMemoryMappedFile_h
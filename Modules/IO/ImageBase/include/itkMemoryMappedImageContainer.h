@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_h
+#define itkMemoryMappedImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+#include <memory>
+
+namespace itk
+{
+/** \class MemoryMappedImageContainer
+ *  \brief An image pixel container whose elements are mapped from a file.
+ *
+ * After MapFile(), the elements of the container are the bytes of the
+ * file, mapped copy-on-write: the image reads them from the page cache
+ * without copying, and writes to the image do not change the file. The
+ * file is unmapped when the container is destroyed, or when it is resized
+ * beyond its capacity or given another buffer; until then it behaves as
+ * an ImportImageContainer.
+ *
+ * \sa MemoryMappedFile
+ * \sa ImageFileReader::SetUseMemoryMapping
+ * \ingroup ImageObjects
+ * \ingroup ITKIOImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using typename Superclass::ElementIdentifier;
+  using typename Superclass::Element;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImageContainer);
+
+  /** Map size elements stored in fileName at offset as the buffer of the
+   * container. The offset must be a multiple of the alignment of TElement.
+   * Throws an ExceptionObject when the file cannot be mapped. */
+  void
+  MapFile(const std::string & fileName, SizeValueType offset, ElementIdentifier size);
+
+  /** Return whether the buffer of the container is mapped from a file. */
+  bool
+  IsMapped() const
+  {
+    return m_MappedFile != nullptr;
+  }
+
+protected:
+  MemoryMappedImageContainer() = default;
+  ~MemoryMappedImageContainer() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Unmap the file, or free the memory when it is not mapped. */
+  void
+  DeallocateManagedMemory() override;
+
+private:
+  std::unique_ptr<MemoryMappedFile> m_MappedFile{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMemoryMappedImageContainer.hxx"
+#endif
+
+#endif
@@ -0,0 +1,68 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageContainer_hxx
+#define itkMemoryMappedImageContainer_hxx
+
+
+namespace itk
+{
+
+template <typename TElementIdentifier, typename TElement>
+MemoryMappedImageContainer<TElementIdentifier, TElement>::~MemoryMappedImageContainer()
+{
+  // the destructor of the superclass does not call the override
+  DeallocateManagedMemory();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::MapFile(const std::string & fileName,
+                                                                  SizeValueType       offset,
+                                                                  ElementIdentifier   size)
+{
+  if (offset % alignof(TElement) != 0)
+  {
+    itkExceptionMacro("Offset " << offset << " in " << fileName << " is not aligned for the element type.");
+  }
+  auto mappedFile =
+    std::make_unique<MemoryMappedFile>(fileName, offset, static_cast<SizeValueType>(size) * sizeof(TElement));
+
+  // releases any previous buffer or mapping
+  this->SetImportPointer(static_cast<TElement *>(mappedFile->GetPointer()), size, false);
+  m_MappedFile = std::move(mappedFile);
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
+{
+  Superclass::DeallocateManagedMemory();
+  m_MappedFile.reset();
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Mapped: " << (this->IsMapped() ? "true" : "false") << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -19,6 +19,8 @@ itk_module(
   ITKTestKernel
   ITKIOGDCM
   ITKIOMeta
+  ITKIONRRD
+  ITKIORAW
   ITKImageIntensity
   DESCRIPTION
   "${DOCUMENTATION}"
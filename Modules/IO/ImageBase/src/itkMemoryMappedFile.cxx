@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+
+#include "itksys/SystemTools.hxx"
+
+#ifdef _WIN32
+#  include "itksys/Encoding.hxx"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+MemoryMappedFile::MemoryMappedFile(const std::string & fileName, SizeValueType offset, SizeValueType length)
+  : m_Length(length)
+{
+  if (length == 0)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeValueType granularity = systemInfo.dwAllocationGranularity;
+#else
+  const auto granularity = static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+#endif
+  const SizeValueType alignedOffset = offset - offset % granularity;
+  m_MappedLength = length + (offset - alignedOffset);
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping.");
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeValueType>(fileSize.QuadPart) < offset + length)
+  {
+    CloseHandle(file);
+    itkGenericExceptionMacro("File " << fileName << " is too short to map " << length << " bytes at offset " << offset
+                                     << '.');
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    itkGenericExceptionMacro("Cannot memory map " << fileName << '.');
+  }
+  m_Address = MapViewOfFile(mapping,
+                            FILE_MAP_COPY,
+                            static_cast<DWORD>(static_cast<uint64_t>(alignedOffset) >> 32),
+                            static_cast<DWORD>(alignedOffset & 0xffffffff),
+                            static_cast<SIZE_T>(m_MappedLength));
+  // the view keeps the mapping alive
+  CloseHandle(mapping);
+  if (m_Address == nullptr)
+  {
+    itkGenericExceptionMacro("Cannot memory map " << fileName << '.');
+  }
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for memory mapping: "
+                                            << itksys::SystemTools::GetLastSystemError());
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeValueType>(fileStatus.st_size) < offset + length)
+  {
+    close(file);
+    itkGenericExceptionMacro("File " << fileName << " is too short to map " << length << " bytes at offset " << offset
+                                     << '.');
+  }
+  // MAP_PRIVATE pages are copied when first written to
+  void * address = mmap(nullptr,
+                        static_cast<size_t>(m_MappedLength),
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE,
+                        file,
+                        static_cast<off_t>(alignedOffset));
+  // the mapping keeps the file referenced
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkGenericExceptionMacro("Cannot memory map " << fileName << ": " << itksys::SystemTools::GetLastSystemError());
+  }
+  m_Address = address;
+#endif
+
+  m_Pointer = static_cast<char *>(m_Address) + (offset - alignedOffset);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  if (m_Address == nullptr)
+  {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(m_Address);
+#else
+  munmap(m_Address, static_cast<size_t>(m_MappedLength));
+#endif
+}
+} // end namespace itk
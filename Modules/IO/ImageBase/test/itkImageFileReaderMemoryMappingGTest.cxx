@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMemoryMappedImageContainer.h"
+#include "itkRawImageIO.h"
+#include "itkVectorImage.h"
+#include "itkImage.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <fstream>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMappingTest : public ::testing::Test
+{
+  using ImageType = itk::Image<float, 3>;
+  using ByteImageType = itk::Image<unsigned char, 3>;
+  using VectorImageType = itk::VectorImage<short, 2>;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  template <typename TImage = ImageType>
+  static typename TImage::Pointer
+  MakeImage()
+  {
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::SizeType{ { 17, 9, 5 } });
+    image->Allocate();
+    auto * const buffer = image->GetBufferPointer();
+    for (size_t i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      buffer[i] = static_cast<typename TImage::PixelType>(0.5 * (i % 256));
+    }
+    return image;
+  }
+
+  template <typename TImage>
+  static bool
+  IsMapped(const TImage * image)
+  {
+    using MappedContainerType = itk::MemoryMappedImageContainer<itk::SizeValueType, typename TImage::PixelType>;
+    const auto * container = dynamic_cast<const MappedContainerType *>(image->GetPixelContainer());
+    return container != nullptr && container->IsMapped();
+  }
+
+  template <typename TImage>
+  static void
+  ExpectEqualPixels(const TImage * expected, const TImage * actual)
+  {
+    ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+    const size_t numberOfPixels = expected->GetBufferedRegion().GetNumberOfPixels();
+    for (size_t i = 0; i < numberOfPixels; ++i)
+    {
+      ASSERT_EQ(expected->GetBufferPointer()[i], actual->GetBufferPointer()[i]) << "at pixel " << i;
+    }
+  }
+
+  /** Read fileName with and without memory mapping, and check that the
+   * mapped image is as expected and writable without changing the file. */
+  template <typename TImage>
+  static void
+  CheckMappedRead(const std::string & fileName, const TImage * expected, itk::ImageIOBase * imageIO = nullptr)
+  {
+    auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    if (imageIO)
+    {
+      reader->SetImageIO(imageIO);
+    }
+    reader->UseMemoryMappingOn();
+    reader->Update();
+    const typename TImage::Pointer mapped = reader->GetOutput();
+    EXPECT_TRUE(IsMapped<TImage>(mapped));
+    ExpectEqualPixels<TImage>(expected, mapped);
+
+    // copy-on-write
+    mapped->GetBufferPointer()[3] = 1;
+    reader->Modified();
+    reader->UseMemoryMappingOff();
+    reader->Update();
+    EXPECT_FALSE(IsMapped<TImage>(reader->GetOutput()));
+    ExpectEqualPixels<TImage>(expected, reader->GetOutput());
+  }
+};
+
+} // namespace
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MetaImageLocalData)
+{
+  // the header length does not align the data for wider pixel types
+  const ByteImageType::Pointer image = MakeImage<ByteImageType>();
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest.mha");
+  CheckMappedRead<ByteImageType>("itkImageFileReaderMemoryMappingTest.mha", image);
+}
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MetaImageDataFile)
+{
+  const ImageType::Pointer image = MakeImage();
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest.mhd");
+  CheckMappedRead<ImageType>("itkImageFileReaderMemoryMappingTest.mhd", image);
+}
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, NrrdAttachedAndDetached)
+{
+  const ByteImageType::Pointer byteImage = MakeImage<ByteImageType>();
+  itk::WriteImage(byteImage, "itkImageFileReaderMemoryMappingTest.nrrd");
+  CheckMappedRead<ByteImageType>("itkImageFileReaderMemoryMappingTest.nrrd", byteImage);
+  const ImageType::Pointer image = MakeImage();
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest.nhdr");
+  CheckMappedRead<ImageType>("itkImageFileReaderMemoryMappingTest.nhdr", image);
+}
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, RawWithHeader)
+{
+  const ImageType::Pointer image = MakeImage();
+  const std::string        fileName = "itkImageFileReaderMemoryMappingTest.raw";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    const char    header[12] = "raw header";
+    file.write(header, sizeof(header));
+    file.write(reinterpret_cast<const char *>(image->GetBufferPointer()),
+               image->GetBufferedRegion().GetNumberOfPixels() * sizeof(float));
+  }
+
+  auto imageIO = itk::RawImageIO<float, 3>::New();
+  imageIO->SetFileDimensionality(3);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    imageIO->SetDimensions(i, image->GetBufferedRegion().GetSize(i));
+  }
+  if (itk::ByteSwapper<float>::SystemIsBigEndian())
+  {
+    imageIO->SetByteOrderToBigEndian();
+  }
+  else
+  {
+    imageIO->SetByteOrderToLittleEndian();
+  }
+  imageIO->SetHeaderSize(12);
+  CheckMappedRead<ImageType>(fileName, image, imageIO);
+}
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, VectorImage)
+{
+  auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::SizeType{ { 6, 4 } });
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+  for (size_t i = 0; i < 6 * 4 * 3; ++i)
+  {
+    image->GetBufferPointer()[i] = static_cast<short>(i);
+  }
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest2.mhd");
+
+  auto reader = itk::ImageFileReader<VectorImageType>::New();
+  reader->SetFileName("itkImageFileReaderMemoryMappingTest2.mhd");
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  const auto * container = dynamic_cast<const itk::MemoryMappedImageContainer<itk::SizeValueType, short> *>(
+    reader->GetOutput()->GetPixelContainer());
+  ASSERT_NE(container, nullptr);
+  EXPECT_TRUE(container->IsMapped());
+  ASSERT_EQ(reader->GetOutput()->GetNumberOfComponentsPerPixel(), 3u);
+  for (size_t i = 0; i < 6 * 4 * 3; ++i)
+  {
+    ASSERT_EQ(reader->GetOutput()->GetBufferPointer()[i], static_cast<short>(i));
+  }
+}
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, FallBackToReading)
+{
+  const ImageType::Pointer image = MakeImage();
+
+  // compressed data
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest3.mha", true);
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName("itkImageFileReaderMemoryMappingTest3.mha");
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  EXPECT_FALSE(IsMapped<ImageType>(reader->GetOutput()));
+  ExpectEqualPixels<ImageType>(image, reader->GetOutput());
+
+  // pixel conversion
+  itk::WriteImage(image, "itkImageFileReaderMemoryMappingTest4.mhd");
+  auto doubleReader = itk::ImageFileReader<itk::Image<double, 3>>::New();
+  doubleReader->SetFileName("itkImageFileReaderMemoryMappingTest4.mhd");
+  doubleReader->UseMemoryMappingOn();
+  doubleReader->Update();
+  EXPECT_EQ(doubleReader->GetOutput()->GetPixel({ { 16, 8, 4 } }), image->GetPixel({ { 16, 8, 4 } }));
+
+  // streamed region
+  reader->SetFileName("itkImageFileReaderMemoryMappingTest4.mhd");
+  const ImageType::RegionType region(ImageType::IndexType{ { 0, 0, 2 } }, ImageType::SizeType{ { 17, 9, 2 } });
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+  EXPECT_FALSE(IsMapped<ImageType>(reader->GetOutput()));
+  EXPECT_EQ(reader->GetOutput()->GetBufferedRegion(), region);
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 5, 3, 3 } }), image->GetPixel({ { 5, 3, 3 } }));
+}
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImage.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageSeriesReaderTest : public ::testing::Test
+{
+  using SliceType = itk::Image<unsigned short, 2>;
+  using VolumeType = itk::Image<unsigned short, 3>;
+  using ReaderType = itk::ImageSeriesReader<VolumeType>;
+
+  static constexpr unsigned int NumberOfSlices = 7;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    // write slices whose pixel values encode their position in the volume
+    for (unsigned int z = 0; z < NumberOfSlices; ++z)
+    {
+      auto slice = SliceType::New();
+      slice->SetRegions(SliceType::SizeType{ { 9, 5 } });
+      slice->Allocate();
+      SliceType::PointType origin;
+      origin[0] = 0.0;
+      origin[1] = 0.0;
+      slice->SetOrigin(origin);
+      unsigned short * const buffer = slice->GetBufferPointer();
+      for (size_t i = 0; i < slice->GetBufferedRegion().GetNumberOfPixels(); ++i)
+      {
+        buffer[i] = static_cast<unsigned short>(1000 * z + i);
+      }
+
+      const std::string fileName = "itkImageSeriesReaderGTest_" + std::to_string(z) + ".mha";
+      itk::WriteImage(slice, fileName);
+      m_FileNames.push_back(fileName);
+    }
+  }
+
+  static void
+  ExpectSameImages(const VolumeType * expected, const VolumeType * actual)
+  {
+    ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+    itk::ImageRegionConstIterator<VolumeType> expectedIt(expected, expected->GetBufferedRegion());
+    itk::ImageRegionConstIterator<VolumeType> actualIt(actual, actual->GetBufferedRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      ASSERT_EQ(expectedIt.Get(), actualIt.Get()) << "at index " << expectedIt.GetIndex();
+    }
+  }
+
+  ReaderType::FileNamesContainer m_FileNames{};
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderTest, ParallelReadingMatchesSequentialReading)
+{
+  for (const bool reverseOrder : { false, true })
+  {
+    auto sequentialReader = ReaderType::New();
+    sequentialReader->SetFileNames(m_FileNames);
+    sequentialReader->SetReverseOrder(reverseOrder);
+    sequentialReader->Update();
+
+    auto parallelReader = ReaderType::New();
+    parallelReader->SetFileNames(m_FileNames);
+    parallelReader->SetReverseOrder(reverseOrder);
+    parallelReader->UseParallelReadingOn();
+    EXPECT_TRUE(parallelReader->GetUseParallelReading());
+    parallelReader->Update();
+
+    ExpectSameImages(sequentialReader->GetOutput(), parallelReader->GetOutput());
+
+    const VolumeType::IndexType lastIndex{ { 0, 0, NumberOfSlices - 1 } };
+    EXPECT_EQ(parallelReader->GetOutput()->GetPixel(lastIndex), reverseOrder ? 0 : 1000 * (NumberOfSlices - 1));
+
+    ASSERT_EQ(parallelReader->GetMetaDataDictionaryArray()->size(), NumberOfSlices);
+    ASSERT_EQ(sequentialReader->GetMetaDataDictionaryArray()->size(), NumberOfSlices);
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, ParallelReadingOfRequestedRegion)
+{
+  const VolumeType::RegionType requestedRegion({ { 2, 1, 2 } }, { { 5, 3, 4 } });
+
+  auto sequentialReader = ReaderType::New();
+  sequentialReader->SetFileNames(m_FileNames);
+  sequentialReader->GetOutput()->UpdateOutputInformation();
+  sequentialReader->GetOutput()->SetRequestedRegion(requestedRegion);
+  sequentialReader->GetOutput()->Update();
+
+  auto parallelReader = ReaderType::New();
+  parallelReader->SetFileNames(m_FileNames);
+  parallelReader->UseParallelReadingOn();
+  parallelReader->SetNumberOfWorkUnits(3);
+  parallelReader->GetOutput()->UpdateOutputInformation();
+  parallelReader->GetOutput()->SetRequestedRegion(requestedRegion);
+  parallelReader->GetOutput()->Update();
+
+  ExpectSameImages(sequentialReader->GetOutput(), parallelReader->GetOutput());
+
+  const VolumeType::IndexType index{ { 3, 2, 4 } };
+  EXPECT_EQ(parallelReader->GetOutput()->GetPixel(index), 1000 * 4 + 2 * 9 + 3);
+}
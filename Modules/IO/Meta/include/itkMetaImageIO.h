@@ -82,6 +82,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Uncompressed binary data in the native byte order, stored locally or in
+   * a single data file, can be memory mapped when it is not subsampled. */
+  bool
+  CanMemoryMapData(std::string & dataFileName, SizeType & dataOffset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -24,6 +24,7 @@
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
 #include "metaImageUtils.h"
+#include <algorithm>
 
 // Function to join strings with a delimiter similar to python's ' '.join([1, 2, 3 ])
 template <typename ContainerType, typename DelimiterType, typename StreamType>
@@ -511,6 +512,66 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::CanMemoryMapData(std::string & dataFileName, SizeType & dataOffset)
+{
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1 ||
+      (this->GetComponentSize() > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()) ||
+      elementDataFileName.substr(0, 4) == "LIST" || elementDataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+
+  const auto dataSize = static_cast<SizeType>(this->GetImageSizeInBytes());
+  if (elementDataFileName == "LOCAL" || elementDataFileName == "Local" || elementDataFileName == "local")
+  {
+    dataFileName = m_FileName;
+    if (m_MetaImage.HeaderSize() == 0)
+    {
+      // The data follows the ElementDataFile field, which ends the header.
+      std::ifstream file(m_FileName.c_str(), std::ios::in | std::ios::binary);
+      std::string   line;
+      dataOffset = -1;
+      while (dataOffset < 0 && std::getline(file, line))
+      {
+        const auto start = line.find_first_not_of(" \t");
+        if (start != std::string::npos && line.compare(start, 15, "ElementDataFile") == 0)
+        {
+          dataOffset = static_cast<SizeType>(file.tellg());
+        }
+      }
+      return dataOffset >= 0;
+    }
+  }
+  else
+  {
+    std::string path;
+    if (MET_GetFilePath(m_FileName, path) && !itksys::SystemTools::FileIsFullPath(elementDataFileName))
+    {
+      dataFileName = path + elementDataFileName;
+    }
+    else
+    {
+      dataFileName = elementDataFileName;
+    }
+    if (!itksys::SystemTools::FileExists(dataFileName, true))
+    {
+      // MetaIO may read a compressed file with an added extension
+      return false;
+    }
+  }
+
+  if (m_MetaImage.HeaderSize() == -1)
+  {
+    // the data is at the end of the file
+    dataOffset = static_cast<SizeType>(itksys::SystemTools::FileLength(dataFileName)) - dataSize;
+    return dataOffset >= 0;
+  }
+  dataOffset = std::max(m_MetaImage.HeaderSize(), 0);
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
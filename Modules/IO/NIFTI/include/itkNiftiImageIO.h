@@ -239,6 +239,29 @@ public:
   itkGetConstMacro(SFORM_Permissive, bool);
   itkBooleanMacro(SFORM_Permissive);
   /** @ITKEndGrouping */
+  /** Read regions of gzip compressed files through a random access index of
+   * the compressed stream, so that streaming a file does not inflate it from
+   * its start for every region. The index is built on the first read of a
+   * region: from the member headers for blocked files (see
+   * UseBlockedCompression), otherwise by inflating the file once. It is kept
+   * for the following reads of the same file. The sections of the file
+   * between access points are inflated in parallel. On by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseGzipIndex, bool);
+  itkGetConstMacro(UseGzipIndex, bool);
+  itkBooleanMacro(UseGzipIndex);
+  /** @ITKEndGrouping */
+  /** Write gzip compressed files as a series of independent gzip members of
+   * at most 64 KiB of uncompressed data each, in the style of BGZF. The
+   * blocks are compressed in parallel, any gzip reader can read the result,
+   * and UseGzipIndex indexes it without inflating it. The nifti library
+   * first writes the files uncompressed, next to the requested ones. Off by
+   * default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseBlockedCompression, bool);
+  itkGetConstMacro(UseBlockedCompression, bool);
+  itkBooleanMacro(UseBlockedCompression);
+  /** @ITKEndGrouping */
 protected:
   NiftiImageIO();
   ~NiftiImageIO() override;
@@ -281,6 +304,18 @@ private:
   void
   SetImageIOMetadataFromNIfTI();
 
+  /** Read the region of the gzip compressed image file starting at start,
+   * of size size (in nifti order), into a buffer allocated with malloc,
+   * through the gzip index. Return false when the nifti library has to read
+   * it instead. */
+  bool
+  ReadGzipIndexedRegion(const int * start, const int * size, bool wholeImage, void ** data);
+
+  /** Write the image with the nifti library, compressing it in blocks when
+   * UseBlockedCompression is on. Return the nifti library status. */
+  int
+  WriteNiftiImage();
+
   double m_RescaleSlope{ 1.0 };
   double m_RescaleIntercept{ 0.0 };
 
@@ -294,6 +329,9 @@ private:
 
   bool m_SFORM_Permissive{ false };
   bool m_SFORM_Corrected{ false };
+
+  bool m_UseGzipIndex{ true };
+  bool m_UseBlockedCompression{ false };
 };
 
 
@@ -12,6 +12,7 @@ itk_module(
   PRIVATE_DEPENDS
   ITKTransform
   ITKNIFTI
+  ITKZLIB
   TEST_DEPENDS
   ITKTestKernel
   ITKNIFTI
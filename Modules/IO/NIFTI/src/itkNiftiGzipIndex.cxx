@@ -0,0 +1,541 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkNiftiGzipIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+// Size of the deflate history window.
+constexpr size_t WindowSize = 32768;
+// Size of the reads from the compressed file.
+constexpr size_t InputSize = 65536;
+// Uncompressed data in one block of a blocked file, such that even a
+// stored block fits the 16 bit member size of the header.
+constexpr size_t BlockSize = 0xff00;
+// Header of a blocked gzip member: FEXTRA with a 'BC' subfield holding
+// the member size minus one.
+constexpr size_t BlockHeaderSize = 18;
+constexpr size_t BlockTrailerSize = 8;
+
+void
+PutLittleEndian32(unsigned char * bytes, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+  }
+}
+
+uint32_t
+GetLittleEndian32(const unsigned char * bytes)
+{
+  return uint32_t{ bytes[0] } | (uint32_t{ bytes[1] } << 8) | (uint32_t{ bytes[2] } << 16) |
+         (uint32_t{ bytes[3] } << 24);
+}
+
+// Read the member at the current position of file; set memberSize to its
+// size when it is a blocked member, or to zero otherwise.
+bool
+ReadBlockHeader(std::istream & file, uint64_t & memberSize)
+{
+  memberSize = 0;
+  unsigned char header[12];
+  if (!file.read(reinterpret_cast<char *>(header), sizeof(header)))
+  {
+    return false;
+  }
+  if (header[0] != 0x1f || header[1] != 0x8b || header[2] != 8 || (header[3] & 4) == 0)
+  {
+    return true;
+  }
+  std::vector<unsigned char> extra(header[10] | (header[11] << 8));
+  if (!file.read(reinterpret_cast<char *>(extra.data()), static_cast<std::streamsize>(extra.size())))
+  {
+    return false;
+  }
+  for (size_t i = 0; i + 4 <= extra.size();)
+  {
+    const size_t length = extra[i + 2] | (extra[i + 3] << 8);
+    if (extra[i] == 'B' && extra[i + 1] == 'C' && length == 2 && i + 6 <= extra.size())
+    {
+      memberSize = (extra[i + 4] | (extra[i + 5] << 8)) + 1;
+      return true;
+    }
+    i += 4 + length;
+  }
+  return true;
+}
+
+// Compress one block into a complete gzip member.
+bool
+CompressBlock(const char * data, size_t length, int compressionLevel, std::vector<unsigned char> & member)
+{
+  for (const int level : { compressionLevel, 0 })
+  {
+    z_stream strm{};
+    if (deflateInit2(&strm, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      return false;
+    }
+    member.resize(BlockHeaderSize + deflateBound(&strm, static_cast<uLong>(length)) + BlockTrailerSize);
+    strm.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    strm.avail_in = static_cast<uInt>(length);
+    strm.next_out = member.data() + BlockHeaderSize;
+    strm.avail_out = static_cast<uInt>(member.size() - BlockHeaderSize - BlockTrailerSize);
+    const int status = deflate(&strm, Z_FINISH);
+    const size_t compressedSize = strm.total_out;
+    deflateEnd(&strm);
+    if (status != Z_STREAM_END)
+    {
+      return false;
+    }
+    const size_t memberSize = BlockHeaderSize + compressedSize + BlockTrailerSize;
+    if (memberSize > 65536)
+    {
+      // try again storing the data, which always fits
+      continue;
+    }
+    member.resize(memberSize);
+    const unsigned char header[BlockHeaderSize] = {
+      0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0, static_cast<unsigned char>((memberSize - 1) & 0xff),
+      static_cast<unsigned char>((memberSize - 1) >> 8)
+    };
+    std::copy_n(header, BlockHeaderSize, member.begin());
+    unsigned char * trailer = member.data() + BlockHeaderSize + compressedSize;
+    PutLittleEndian32(
+      trailer,
+      static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(data), static_cast<uInt>(length))));
+    PutLittleEndian32(trailer + 4, static_cast<uint32_t>(length));
+    return true;
+  }
+  return false;
+}
+} // end anonymous namespace
+
+void
+NiftiGzipIndex::Open(const std::string & fileName)
+{
+  this->Clear();
+  m_FileName = fileName;
+  m_FileSize = itksys::SystemTools::FileLength(fileName);
+  m_ModifiedTime = itksys::SystemTools::ModifiedTime(fileName);
+}
+
+bool
+NiftiGzipIndex::Build(const std::string & fileName, uint64_t spacing)
+{
+  this->Open(fileName);
+  const bool built = IsBlocked(fileName) ? this->BuildFromBlocks(spacing) : this->BuildByInflating(spacing);
+  if (!built)
+  {
+    this->Clear();
+  }
+  return built;
+}
+
+bool
+NiftiGzipIndex::BuildAndRead(const std::string &  fileName,
+                             uint64_t             offset,
+                             uint64_t             length,
+                             const ConsumerType & consume,
+                             uint64_t             spacing)
+{
+  this->Open(fileName);
+  if (IsBlocked(fileName))
+  {
+    // indexed without inflating anything: read through the index
+    if (!this->BuildFromBlocks(spacing))
+    {
+      this->Clear();
+      return false;
+    }
+    return this->Read(offset, length, consume);
+  }
+  if (!this->BuildByInflating(spacing, offset, length, &consume))
+  {
+    this->Clear();
+    return false;
+  }
+  return offset + length <= m_UncompressedSize;
+}
+
+bool
+NiftiGzipIndex::IsIndexOf(const std::string & fileName) const
+{
+  return !m_FileName.empty() && fileName == m_FileName && itksys::SystemTools::FileLength(fileName) == m_FileSize &&
+         itksys::SystemTools::ModifiedTime(fileName) == m_ModifiedTime;
+}
+
+void
+NiftiGzipIndex::Clear()
+{
+  m_FileName.clear();
+  m_FileSize = 0;
+  m_ModifiedTime = 0;
+  m_UncompressedSize = 0;
+  m_AccessPoints.clear();
+}
+
+bool
+NiftiGzipIndex::IsBlocked(const std::string & fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  uint64_t      memberSize = 0;
+  return file && ReadBlockHeader(file, memberSize) && memberSize > 0;
+}
+
+bool
+NiftiGzipIndex::BuildFromBlocks(uint64_t spacing)
+{
+  std::ifstream file(m_FileName, std::ios::binary);
+  uint64_t      compressedOffset = 0;
+  uint64_t      lastPoint = 0;
+  while (compressedOffset < m_FileSize)
+  {
+    uint64_t memberSize = 0;
+    file.seekg(static_cast<std::streamoff>(compressedOffset));
+    if (!ReadBlockHeader(file, memberSize) || memberSize < BlockHeaderSize + BlockTrailerSize ||
+        compressedOffset + memberSize > m_FileSize)
+    {
+      // not a blocked file after all
+      return this->BuildByInflating(spacing);
+    }
+    unsigned char trailer[BlockTrailerSize];
+    file.seekg(static_cast<std::streamoff>(compressedOffset + memberSize - BlockTrailerSize));
+    if (!file.read(reinterpret_cast<char *>(trailer), BlockTrailerSize))
+    {
+      return false;
+    }
+    if (m_AccessPoints.empty() || m_UncompressedSize - lastPoint >= spacing)
+    {
+      m_AccessPoints.push_back({ m_UncompressedSize, compressedOffset, 0, true, {} });
+      lastPoint = m_UncompressedSize;
+    }
+    m_UncompressedSize += GetLittleEndian32(trailer + 4);
+    compressedOffset += memberSize;
+  }
+  return !m_AccessPoints.empty();
+}
+
+bool
+NiftiGzipIndex::BuildByInflating(uint64_t spacing, uint64_t offset, uint64_t length, const ConsumerType * consume)
+{
+  m_AccessPoints.clear();
+  m_UncompressedSize = 0;
+
+  std::ifstream file(m_FileName, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  z_stream strm{};
+  // 15 + 32: a gzip or zlib header, detected automatically
+  if (inflateInit2(&strm, 15 + 32) != Z_OK)
+  {
+    return false;
+  }
+  std::vector<unsigned char> input(InputSize);
+  std::vector<unsigned char> window(WindowSize);
+  uint64_t                   totalIn = 0;
+  uint64_t                   totalOut = 0;
+  uint64_t                   lastPoint = 0;
+  int                        status = Z_OK;
+  bool                       valid = true;
+  m_AccessPoints.push_back({ 0, 0, 0, true, {} });
+  for (;;)
+  {
+    if (strm.avail_in == 0)
+    {
+      file.read(reinterpret_cast<char *>(input.data()), static_cast<std::streamsize>(input.size()));
+      strm.avail_in = static_cast<uInt>(file.gcount());
+      strm.next_in = input.data();
+      if (strm.avail_in == 0)
+      {
+        break;
+      }
+    }
+    if (status == Z_STREAM_END)
+    {
+      // another gzip member follows
+      inflateReset(&strm);
+      if (totalOut - lastPoint >= spacing)
+      {
+        m_AccessPoints.push_back({ totalOut, totalIn, 0, true, {} });
+        lastPoint = totalOut;
+      }
+    }
+    if (strm.avail_out == 0)
+    {
+      strm.avail_out = static_cast<uInt>(WindowSize);
+      strm.next_out = window.data();
+    }
+    const uint64_t        outputOffset = totalOut;
+    const unsigned char * output = strm.next_out;
+    totalIn += strm.avail_in;
+    totalOut += strm.avail_out;
+    status = inflate(&strm, Z_BLOCK);
+    totalIn -= strm.avail_in;
+    totalOut -= strm.avail_out;
+    if (status != Z_OK && status != Z_STREAM_END)
+    {
+      valid = false;
+      break;
+    }
+    if (consume)
+    {
+      // the part of the inflated bytes which is requested
+      const uint64_t begin = std::max(outputOffset, offset);
+      const uint64_t end = std::min(totalOut, offset + length);
+      if (begin < end)
+      {
+        (*consume)(begin, reinterpret_cast<const char *>(output + (begin - outputOffset)), end - begin);
+      }
+    }
+    // at the end of a block, which is not the last one of its member
+    if (status != Z_STREAM_END && (strm.data_type & 128) != 0 && (strm.data_type & 64) == 0 &&
+        totalOut - lastPoint >= spacing)
+    {
+      AccessPoint point{ totalOut, totalIn, strm.data_type & 7, false, std::vector<unsigned char>(WindowSize) };
+      // the window buffer is circular, the oldest data follows next_out
+      const size_t used = WindowSize - strm.avail_out;
+      std::copy(window.begin() + used, window.end(), point.Window.begin());
+      std::copy_n(window.begin(), used, point.Window.begin() + (WindowSize - used));
+      m_AccessPoints.push_back(std::move(point));
+      lastPoint = totalOut;
+    }
+  }
+  inflateEnd(&strm);
+  m_UncompressedSize = totalOut;
+  return valid && status == Z_STREAM_END && !file.bad();
+}
+
+bool
+NiftiGzipIndex::InflateSection(std::istream &      file,
+                               const AccessPoint & point,
+                               uint64_t            skip,
+                               char *              data,
+                               size_t              length) const
+{
+  file.clear();
+  z_stream strm{};
+  bool     raw = !point.MemberStart;
+  if (inflateInit2(&strm, raw ? -15 : 15 + 32) != Z_OK)
+  {
+    return false;
+  }
+  bool valid = true;
+  if (raw)
+  {
+    file.seekg(static_cast<std::streamoff>(point.CompressedOffset - (point.Bits != 0 ? 1 : 0)));
+    if (point.Bits != 0)
+    {
+      const int byte = file.get();
+      valid = byte != EOF && inflatePrime(&strm, point.Bits, byte >> (8 - point.Bits)) == Z_OK;
+    }
+    valid = valid && inflateSetDictionary(&strm, point.Window.data(), static_cast<uInt>(point.Window.size())) == Z_OK;
+  }
+  else
+  {
+    file.seekg(static_cast<std::streamoff>(point.CompressedOffset));
+  }
+
+  std::vector<unsigned char> input(InputSize);
+  std::vector<char>          discard(skip > 0 ? WindowSize : 0);
+  size_t                     trailerToSkip = 0;
+  size_t                     produced = 0;
+  while (valid && produced < length)
+  {
+    if (strm.avail_in == 0)
+    {
+      file.read(reinterpret_cast<char *>(input.data()), static_cast<std::streamsize>(input.size()));
+      strm.avail_in = static_cast<uInt>(file.gcount());
+      strm.next_in = input.data();
+      if (strm.avail_in == 0)
+      {
+        valid = false;
+        break;
+      }
+    }
+    if (trailerToSkip > 0)
+    {
+      // the trailer of a member inflated in raw mode
+      const size_t n = std::min<size_t>(trailerToSkip, strm.avail_in);
+      strm.next_in += n;
+      strm.avail_in -= static_cast<uInt>(n);
+      trailerToSkip -= n;
+      continue;
+    }
+    if (skip > 0)
+    {
+      strm.next_out = reinterpret_cast<Bytef *>(discard.data());
+      strm.avail_out = static_cast<uInt>(std::min<uint64_t>(skip, discard.size()));
+    }
+    else
+    {
+      strm.next_out = reinterpret_cast<Bytef *>(data + produced);
+      strm.avail_out = static_cast<uInt>(std::min<size_t>(length - produced, std::numeric_limits<uInt>::max()));
+    }
+    const uInt available = strm.avail_out;
+    const int  status = inflate(&strm, Z_NO_FLUSH);
+    const uInt inflated = available - strm.avail_out;
+    if (skip > 0)
+    {
+      skip -= inflated;
+    }
+    else
+    {
+      produced += inflated;
+    }
+    if (status == Z_STREAM_END)
+    {
+      // the next gzip member follows; in raw mode, inflate stopped before the trailer
+      if (raw)
+      {
+        trailerToSkip = BlockTrailerSize;
+        raw = false;
+        valid = inflateReset2(&strm, 15 + 32) == Z_OK;
+      }
+      else
+      {
+        valid = inflateReset(&strm) == Z_OK;
+      }
+    }
+    else if (status != Z_OK && status != Z_BUF_ERROR)
+    {
+      valid = false;
+    }
+  }
+  inflateEnd(&strm);
+  return valid;
+}
+
+bool
+NiftiGzipIndex::Read(uint64_t offset, uint64_t length, const ConsumerType & consume) const
+{
+  if (m_AccessPoints.empty() || offset + length > m_UncompressedSize)
+  {
+    return false;
+  }
+  if (length == 0)
+  {
+    return true;
+  }
+  const auto byOffset = [](uint64_t value, const AccessPoint & point) { return value < point.UncompressedOffset; };
+  // the sections starting at the last access point before offset, up to the
+  // one containing the last byte
+  const size_t first =
+    std::upper_bound(m_AccessPoints.begin(), m_AccessPoints.end(), offset, byOffset) - m_AccessPoints.begin() - 1;
+  const size_t last = std::upper_bound(m_AccessPoints.begin(), m_AccessPoints.end(), offset + length - 1, byOffset) -
+                      m_AccessPoints.begin() - 1;
+
+  const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const auto                       numberOfWorkUnits =
+    std::min<SizeValueType>(threader->GetNumberOfWorkUnits(), static_cast<SizeValueType>(last - first + 1));
+  std::atomic<size_t> nextSection{ first };
+  std::atomic<bool>   valid{ true };
+  threader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType) {
+      std::ifstream     file(m_FileName, std::ios::binary);
+      std::vector<char> section;
+      for (size_t k = nextSection++; k <= last && valid; k = nextSection++)
+      {
+        const AccessPoint & point = m_AccessPoints[k];
+        const uint64_t      sectionEnd =
+          k + 1 < m_AccessPoints.size() ? m_AccessPoints[k + 1].UncompressedOffset : m_UncompressedSize;
+        const uint64_t begin = std::max(point.UncompressedOffset, offset);
+        const uint64_t end = std::min(sectionEnd, offset + length);
+        section.resize(end - begin);
+        if (!file || !this->InflateSection(file, point, begin - point.UncompressedOffset, section.data(), section.size()))
+        {
+          valid = false;
+          break;
+        }
+        consume(begin, section.data(), section.size());
+      }
+    },
+    nullptr);
+  return valid;
+}
+
+bool
+NiftiGzipIndex::WriteBlocked(const std::string & source, const std::string & destination, int compressionLevel)
+{
+  std::ifstream input(source, std::ios::binary);
+  std::ofstream output(destination, std::ios::binary | std::ios::trunc);
+  if (!input || !output)
+  {
+    return false;
+  }
+  const MultiThreaderBase::Pointer        threader = MultiThreaderBase::New();
+  const size_t                            batchSize = 4 * static_cast<size_t>(threader->GetNumberOfWorkUnits());
+  std::vector<char>                       data(batchSize * BlockSize);
+  std::vector<std::vector<unsigned char>> members(batchSize);
+  for (;;)
+  {
+    input.read(data.data(), static_cast<std::streamsize>(data.size()));
+    const auto dataSize = static_cast<size_t>(input.gcount());
+    if (dataSize == 0)
+    {
+      break;
+    }
+    const size_t      numberOfBlocks = (dataSize + BlockSize - 1) / BlockSize;
+    std::atomic<bool> valid{ true };
+    threader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType k) {
+        const size_t begin = k * BlockSize;
+        if (!CompressBlock(
+              data.data() + begin, std::min(BlockSize, dataSize - begin), compressionLevel, members[k]))
+        {
+          valid = false;
+        }
+      },
+      nullptr);
+    if (!valid)
+    {
+      return false;
+    }
+    for (size_t k = 0; k < numberOfBlocks; ++k)
+    {
+      output.write(reinterpret_cast<const char *>(members[k].data()), static_cast<std::streamsize>(members[k].size()));
+    }
+  }
+  // an empty member marks the end of a blocked file
+  std::vector<unsigned char> endOfFile;
+  if (input.bad() || !CompressBlock(nullptr, 0, compressionLevel, endOfFile))
+  {
+    return false;
+  }
+  output.write(reinterpret_cast<const char *>(endOfFile.data()), static_cast<std::streamsize>(endOfFile.size()));
+  output.close();
+  return !output.fail();
+}
+} // end namespace itk
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNiftiGzipIndex_h
+#define itkNiftiGzipIndex_h
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class NiftiGzipIndex
+ * \brief Random access into a gzip compressed file.
+ *
+ * The index records access points in the deflate stream, at which
+ * inflating can start without processing the data before it. A point
+ * inside a deflate stream keeps the last 32 KiB of uncompressed data,
+ * which later blocks may refer to, and the bits of the compressed byte it
+ * shares with the previous block. The start of a gzip member needs
+ * neither.
+ *
+ * Blocked files, written by WriteBlocked() as a series of gzip members in
+ * the style of BGZF, are indexed from the sizes stored in the member
+ * headers and trailers. Any other gzip file is inflated once to build the
+ * index.
+ *
+ * The data between consecutive access points is independent, so Read()
+ * inflates these sections in parallel.
+ *
+ * \ingroup ITKIONIFTI
+ */
+class NiftiGzipIndex
+{
+public:
+  /** Called with consecutive uncompressed bytes of the file, starting at
+   * offset; calls for different sections may be concurrent. */
+  using ConsumerType = std::function<void(uint64_t offset, const char * data, size_t length)>;
+
+  /** Index fileName, with an access point about every spacing bytes of
+   * uncompressed data. Return false when fileName is not a valid gzip
+   * file. */
+  bool
+  Build(const std::string & fileName, uint64_t spacing = uint64_t{ 1 } << 20);
+
+  /** Index fileName as Build() does, and pass the uncompressed bytes
+   * [offset, offset + length) of the file to consume. A file which is not
+   * blocked is inflated only once, to build the index and to read the
+   * bytes. */
+  bool
+  BuildAndRead(const std::string &  fileName,
+               uint64_t             offset,
+               uint64_t             length,
+               const ConsumerType & consume,
+               uint64_t             spacing = uint64_t{ 1 } << 20);
+
+  /** Return whether the index is up to date for fileName. */
+  bool
+  IsIndexOf(const std::string & fileName) const;
+
+  /** Forget the indexed file. */
+  void
+  Clear();
+
+  /** Inflate the uncompressed bytes [offset, offset + length) of the indexed
+   * file, passing them to consume. Return false on a read or inflate
+   * error. */
+  bool
+  Read(uint64_t offset, uint64_t length, const ConsumerType & consume) const;
+
+  /** Return whether the first gzip member of fileName is a block written by
+   * WriteBlocked(). */
+  static bool
+  IsBlocked(const std::string & fileName);
+
+  /** Compress source into destination as a blocked gzip file, compressing
+   * the blocks in parallel. Return false on a read or write error. */
+  static bool
+  WriteBlocked(const std::string & source, const std::string & destination, int compressionLevel);
+
+private:
+  struct AccessPoint
+  {
+    uint64_t                   UncompressedOffset;
+    uint64_t                   CompressedOffset;
+    /** Number of bits of the byte before CompressedOffset belonging to the
+     * block starting here. */
+    int                        Bits;
+    /** A gzip member starts at CompressedOffset. */
+    bool                       MemberStart;
+    std::vector<unsigned char> Window;
+  };
+
+  bool
+  BuildFromBlocks(uint64_t spacing);
+  /** Index the file by inflating it. The inflated bytes in
+   * [offset, offset + length) are passed to consume, when it is not null. */
+  bool
+  BuildByInflating(uint64_t spacing, uint64_t offset = 0, uint64_t length = 0, const ConsumerType * consume = nullptr);
+  void
+  Open(const std::string & fileName);
+  bool
+  InflateSection(std::istream & file, const AccessPoint & point, uint64_t skip, char * data, size_t length) const;
+
+  std::string              m_FileName;
+  uint64_t                 m_FileSize{ 0 };
+  long int                 m_ModifiedTime{ 0 };
+  uint64_t                 m_UncompressedSize{ 0 };
+  std::vector<AccessPoint> m_AccessPoints;
+};
+} // end namespace itk
+
+#endif // itkNiftiGzipIndex_h
@@ -22,9 +22,15 @@
 #include "itkAnatomicalOrientation.h"
 #include <nifti1_io.h>
 #include "itkNiftiImageIOConfigurePrivate.h"
+#include "itkNiftiGzipIndex.h"
 #include "itkMakeUniqueForOverwrite.h"
 #include "itksys/SystemTools.hxx"
 #include "itksys/SystemInformation.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace itk
 {
@@ -418,6 +424,9 @@ public:
   operator=(NiftiImageProxy &&) = delete;
 
   std::unique_ptr<nifti_image, NiftiImageDeleter> ptr;
+
+  // Random access index of the last gzip compressed image file read.
+  NiftiGzipIndex GzipIndex;
 };
 
 
@@ -463,6 +472,8 @@ NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "OnDiskComponentType: " << m_OnDiskComponentType << std::endl;
   os << indent << "LegacyAnalyze75Mode: " << m_LegacyAnalyze75Mode << std::endl;
   os << indent << "SFORM permissive: " << (m_SFORM_Permissive ? "On" : "Off") << std::endl;
+  itkPrintSelfBooleanMacro(UseGzipIndex);
+  itkPrintSelfBooleanMacro(UseBlockedCompression);
 }
 
 bool
@@ -509,6 +520,22 @@ CastCopy(float * to, const void * from, size_t pixelcount)
   }
 }
 
+// Internal function to set non finite values to zero, as the nifti library
+// does when it reads floating point data.
+template <typename TBuffer>
+void
+ZeroNonFinite(void * buffer, size_t size)
+{
+  auto * values = static_cast<TBuffer *>(buffer);
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (!std::isfinite(values[i]))
+    {
+      values[i] = 0;
+    }
+  }
+}
+
 // Internal function to convert vectors between RAS and LPS coordinate systems.
 // Dimensions are CXYZT (ITK memory layout)
 template <typename TBuffer>
@@ -606,16 +633,20 @@ NiftiImageIO::Read(void * buffer)
     // all data as a block
     if (i == this->GetNumberOfDimensions())
     {
-      if (nifti_image_load(m_Holder->ptr.get()) == -1)
+      if (!this->ReadGzipIndexedRegion(_origin, _size, true, &data))
       {
-        itkExceptionMacro("nifti_image_load failed for file: " << this->GetFileName());
+        if (nifti_image_load(m_Holder->ptr.get()) == -1)
+        {
+          itkExceptionMacro("nifti_image_load failed for file: " << this->GetFileName());
+        }
+        data = m_Holder->ptr->data;
       }
-      data = m_Holder->ptr->data;
     }
     else
     {
       // read in a subregion
-      if (nifti_read_subregion_image(m_Holder->ptr.get(), _origin, _size, &data) == -1)
+      if (!this->ReadGzipIndexedRegion(_origin, _size, false, &data) &&
+          nifti_read_subregion_image(m_Holder->ptr.get(), _origin, _size, &data) == -1)
       {
         itkExceptionMacro("nifti_read_subregion_image failed for file: " << this->GetFileName());
       }
@@ -836,6 +867,126 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+bool
+NiftiImageIO::ReadGzipIndexedRegion(const int * start, const int * size, bool wholeImage, void ** data)
+{
+  const nifti_image * nim = m_Holder->ptr.get();
+  if (!m_UseGzipIndex || nim->iname == nullptr || !nifti_is_gzfile(nim->iname) || nim->iname_offset < 0 ||
+      nim->nifti_type == NIFTI_FTYPE_ASCII)
+  {
+    return false;
+  }
+  NiftiGzipIndex & index = m_Holder->GzipIndex;
+  const bool       indexed = index.IsIndexOf(nim->iname);
+  // without an index, the nifti library reads the whole image in a single pass
+  if (!indexed && wholeImage && !NiftiGzipIndex::IsBlocked(nim->iname))
+  {
+    return false;
+  }
+
+  size_t dims[7];
+  size_t strides[7];
+  for (int d = 0; d < 7; ++d)
+  {
+    dims[d] = d < nim->ndim ? static_cast<size_t>(nim->dim[d + 1]) : 1;
+    strides[d] = d == 0 ? static_cast<size_t>(nim->nbyper) : strides[d - 1] * dims[d - 1];
+    if (start[d] < 0 || size[d] < 1 || static_cast<size_t>(start[d] + size[d]) > dims[d])
+    {
+      return false;
+    }
+  }
+  // the region is a series of runs of contiguous bytes in the file: the
+  // leading dimensions which are read whole, and the next one, make up a run
+  int    runDimensions = 1;
+  size_t runBytes = size[0] * strides[0];
+  while (runDimensions < 7 && static_cast<size_t>(size[runDimensions - 1]) == dims[runDimensions - 1])
+  {
+    runBytes *= size[runDimensions];
+    ++runDimensions;
+  }
+  std::vector<uint64_t> runOffsets;
+  {
+    int index7[7];
+    std::copy_n(start, 7, index7);
+    for (;;)
+    {
+      uint64_t offset = nim->iname_offset;
+      for (int d = 0; d < 7; ++d)
+      {
+        offset += index7[d] * strides[d];
+      }
+      runOffsets.push_back(offset);
+      int d = runDimensions;
+      for (; d < 7; ++d)
+      {
+        if (++index7[d] < start[d] + size[d])
+        {
+          break;
+        }
+        index7[d] = start[d];
+      }
+      if (d >= 7)
+      {
+        break;
+      }
+    }
+  }
+  const size_t totalBytes = runOffsets.size() * runBytes;
+  // Malloc instead of new to be consistent with allocation used in niftilib
+  auto * region = static_cast<char *>(malloc(totalBytes));
+  if (region == nullptr)
+  {
+    return false;
+  }
+  // copy the runs overlapping each inflated section
+  const auto consume = [&runOffsets, runBytes, region](uint64_t offset, const char * bytes, size_t length) {
+    auto run = std::upper_bound(runOffsets.begin(), runOffsets.end(), offset);
+    if (run != runOffsets.begin())
+    {
+      --run;
+    }
+    for (; run != runOffsets.end() && *run < offset + length; ++run)
+    {
+      const uint64_t begin = std::max(*run, offset);
+      const uint64_t end = std::min(*run + runBytes, offset + length);
+      if (begin < end)
+      {
+        std::memcpy(region + (run - runOffsets.begin()) * runBytes + (begin - *run), bytes + (begin - offset), end - begin);
+      }
+    }
+  };
+  // the index is built in the same pass as the first read
+  const uint64_t regionOffset = runOffsets.front();
+  const uint64_t regionLength = runOffsets.back() + runBytes - regionOffset;
+  if (!(indexed ? index.Read(regionOffset, regionLength, consume)
+                : index.BuildAndRead(nim->iname, regionOffset, regionLength, consume)))
+  {
+    free(region);
+    return false;
+  }
+
+  // as nifti_read_buffer does
+  if (nim->swapsize > 1 && nim->byteorder != nifti_short_order())
+  {
+    nifti_swap_Nbytes(totalBytes / nim->swapsize, nim->swapsize, region);
+  }
+  switch (nim->datatype)
+  {
+    case NIFTI_TYPE_FLOAT32:
+    case NIFTI_TYPE_COMPLEX64:
+      ZeroNonFinite<float>(region, totalBytes / sizeof(float));
+      break;
+    case NIFTI_TYPE_FLOAT64:
+    case NIFTI_TYPE_COMPLEX128:
+      ZeroNonFinite<double>(region, totalBytes / sizeof(double));
+      break;
+    default:
+      break;
+  }
+  *data = region;
+  return true;
+}
+
 NiftiImageIOEnums::NiftiFileEnum
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
@@ -2395,7 +2546,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory
     // for writing.
     m_Holder->ptr->data = const_cast<void *>(buffer);
-    const int nifti_write_status = nifti_image_write_status(m_Holder->ptr.get());
+    const int nifti_write_status = this->WriteNiftiImage();
     m_Holder->ptr->data = nullptr; // Must free before throwing exception.
                                    // if left pointing to data buffer
                                    // nifti_image_free inside Destructor of ITKNiftiIO
@@ -2504,7 +2655,7 @@ NiftiImageIO::Write(const void * buffer)
     // Need a const cast here so that we don't have to copy the memory for
     // writing.
     m_Holder->ptr->data = static_cast<void *>(nifti_buf.get());
-    const int nifti_write_status = nifti_image_write_status(m_Holder->ptr.get());
+    const int nifti_write_status = this->WriteNiftiImage();
     m_Holder->ptr->data = nullptr; // if left pointing to data buffer
     if (nifti_write_status)
     {
@@ -2513,6 +2664,52 @@ NiftiImageIO::Write(const void * buffer)
   }
 }
 
+int
+NiftiImageIO::WriteNiftiImage()
+{
+  nifti_image * nim = m_Holder->ptr.get();
+  if (!m_UseBlockedCompression)
+  {
+    return nifti_image_write_status(nim);
+  }
+  // Let the nifti library write the gzip compressed files uncompressed, to
+  // temporary files, then compress these in blocks.
+  std::vector<std::pair<std::string, std::string>> temporaryFiles;
+  const auto uncompressedName = [&temporaryFiles](const char * name) -> char * {
+    if (name == nullptr || !nifti_is_gzfile(name))
+    {
+      return name == nullptr ? nullptr : nifti_strdup(name);
+    }
+    for (const auto & temporaryFile : temporaryFiles)
+    {
+      if (temporaryFile.second == name)
+      {
+        return nifti_strdup(temporaryFile.first.c_str());
+      }
+    }
+    temporaryFiles.emplace_back(std::string(name) + ".tmp", name);
+    return nifti_strdup(temporaryFiles.back().first.c_str());
+  };
+  char * const fname = nim->fname;
+  char * const iname = nim->iname;
+  nim->fname = uncompressedName(fname);
+  nim->iname = uncompressedName(iname);
+  int status = nifti_image_write_status(nim);
+  free(nim->fname);
+  free(nim->iname);
+  nim->fname = fname;
+  nim->iname = iname;
+  for (const auto & temporaryFile : temporaryFiles)
+  {
+    if (status == 0 && !NiftiGzipIndex::WriteBlocked(temporaryFile.first, temporaryFile.second, Z_DEFAULT_COMPRESSION))
+    {
+      status = 1;
+    }
+    itksys::SystemTools::RemoveFile(temporaryFile.first);
+  }
+  return status;
+}
+
 std::ostream &
 operator<<(std::ostream & out, const NiftiImageIOEnums::Analyze75Flavor value)
 {
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNiftiImageIO.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 4;
+using PixelType = short;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+// Values which do not compress to nothing, so that the deflate stream has
+// many blocks.
+PixelType
+ExpectedValue(const ImageType::IndexType & index)
+{
+  const auto hash = static_cast<unsigned int>((index[0] * 73856093) ^ (index[1] * 19349663) ^ (index[2] * 83492791) ^
+                                              (index[3] * 2654435761u));
+  return static_cast<PixelType>((hash % 512) + 100 * index[3]);
+}
+
+bool
+CheckRegion(const ImageType * image, const ImageType::RegionType & region)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    std::cerr << "Region " << region << " was not read" << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue(it.GetIndex()))
+    {
+      std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << ", expected "
+                << ExpectedValue(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+ReadAndCheck(const std::string & fileName, bool useGzipIndex)
+{
+  std::cout << fileName << (useGzipIndex ? " with" : " without") << " gzip index" << std::endl;
+  auto imageIO = itk::NiftiImageIO::New();
+  imageIO->SetUseGzipIndex(useGzipIndex);
+
+  // streamed read, one volume at a time
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(imageIO);
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(7);
+  streamer->Update();
+  if (!CheckRegion(streamer->GetOutput(), streamer->GetOutput()->GetLargestPossibleRegion()))
+  {
+    return false;
+  }
+
+  // sub-regions, reusing the index built by the previous reads
+  using IndexType = ImageType::IndexType;
+  using SizeType = ImageType::SizeType;
+  const ImageType::RegionType regions[] = { { IndexType{ { 3, 5, 7, 4 } }, SizeType{ { 40, 20, 11, 3 } } },
+                                            { IndexType{ { 0, 0, 0, 6 } }, SizeType{ { 64, 64, 40, 1 } } },
+                                            { IndexType{ { 63, 0, 39, 0 } }, SizeType{ { 1, 64, 1, 7 } } } };
+  for (const auto & region : regions)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+    if (!CheckRegion(reader->GetOutput(), region))
+    {
+      return false;
+    }
+  }
+
+  // whole image
+  reader->GetOutput()->SetRequestedRegion(reader->GetOutput()->GetLargestPossibleRegion());
+  reader->Update();
+  return CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+}
+} // namespace
+
+int
+itkNiftiImageIOGzipIndexTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing arguments" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+
+  // more than one access point apart in the uncompressed stream
+  auto                        image = ImageType::New();
+  const ImageType::RegionType region(ImageType::SizeType{ { 64, 64, 40, 7 } });
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+
+  const std::string streamFileName = std::string(argv[1]) + "/itkNiftiImageIOGzipIndexTest.nii.gz";
+  const std::string blockedFileName = std::string(argv[1]) + "/itkNiftiImageIOGzipIndexTestBlocked.nii.gz";
+
+  auto imageIO = itk::NiftiImageIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(imageIO, UseGzipIndex, true);
+  ITK_TEST_SET_GET_BOOLEAN(imageIO, UseBlockedCompression, false);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, streamFileName, true));
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  imageIO->SetUseBlockedCompression(true);
+  writer->SetImageIO(imageIO);
+  writer->SetInput(image);
+  writer->SetFileName(blockedFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  bool passed = true;
+  for (const auto & fileName : { streamFileName, blockedFileName })
+  {
+    for (const bool useGzipIndex : { true, false })
+    {
+      try
+      {
+        passed = ReadAndCheck(fileName, useGzipIndex) && passed;
+      }
+      catch (const itk::ExceptionObject & error)
+      {
+        std::cerr << error << std::endl;
+        passed = false;
+      }
+    }
+  }
+
+  std::cout << "Test " << (passed ? "finished." : "failed.") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -78,6 +78,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Raw encoded data in the native byte order, attached or in a single
+   * detached data file, can be memory mapped. */
+  bool
+  CanMemoryMapData(std::string & dataFileName, SizeType & dataOffset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
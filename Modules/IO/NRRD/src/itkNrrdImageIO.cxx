@@ -849,6 +849,83 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::CanMemoryMapData(std::string & dataFileName, SizeType & dataOffset)
+{
+  if (IOPixelEnum::SYMMETRICSECONDRANKTENSOR == this->GetPixelType())
+  {
+    // masked tensors are cropped after reading
+    return false;
+  }
+
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState(false);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = FloatingPointExceptions::GetEnabled();
+    FloatingPointExceptions::Disable();
+  }
+
+  // read the header again, keeping the data file open at the first byte of
+  // the data, after any skipped lines and bytes
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+  const bool loaded = (nrrdLoad(nrrd, this->GetFileName(), nio) == 0);
+
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+
+  bool canMap = false;
+  if (!loaded)
+  {
+    free(biffGetDone(NRRD));
+  }
+  else if (nio->dataFile != nullptr)
+  {
+    unsigned int       rangeAxisIdx[NRRD_DIM_MAX];
+    const unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrd, rangeAxisIdx);
+    const long         position = ftell(nio->dataFile);
+
+    // Read() permutes the axes when the range axis is not the fastest
+    canMap = nrrdFormatNRRD == nio->format && nrrdEncodingRaw == nio->encoding && nio->dataFNFormat == nullptr &&
+             nio->dataFNArr->len <= 1 && (nrrdElementSize(nrrd) == 1 || nio->endian == airMyEndian()) &&
+             (rangeAxisNum == 0 || (rangeAxisNum == 1 && rangeAxisIdx[0] == 0)) && position >= 0;
+    if (canMap && nio->dataFNArr->len == 1)
+    {
+      // header-relative data file name, as in nrrdIoStateDataFileIterNext
+      const std::string name = nio->dataFN[0];
+      if (name == "-")
+      {
+        canMap = false;
+      }
+      else if (name[0] != '/' && (name.size() < 2 || name[1] != ':'))
+      {
+        dataFileName = std::string(nio->path != nullptr ? nio->path : "") + '/' + name;
+      }
+      else
+      {
+        dataFileName = name;
+      }
+    }
+    else
+    {
+      dataFileName = this->GetFileName();
+    }
+    dataOffset = position;
+    airFclose(nio->dataFile);
+    nio->dataFile = nullptr;
+  }
+
+  nrrdNix(nrrd);
+  nrrdIoStateNix(nio);
+  return canMap;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
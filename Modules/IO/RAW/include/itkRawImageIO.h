@@ -124,6 +124,10 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Binary data in the native byte order can be memory mapped. */
+  bool
+  CanMemoryMapData(std::string & dataFileName, ImageIOBase::SizeType & dataOffset) override;
+
   /** Set/Get the Data mask. */
   /** @ITKStartGrouping */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
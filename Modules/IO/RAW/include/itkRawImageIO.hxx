@@ -161,6 +161,21 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+bool
+RawImageIO<TPixel, VImageDimension>::CanMemoryMapData(std::string & dataFileName, ImageIOBase::SizeType & dataOffset)
+{
+  if (m_FileType != IOFileEnum::Binary ||
+      (this->GetComponentSize() > 1 && m_ByteOrder != IOByteOrderEnum::OrderNotApplicable &&
+       (m_ByteOrder == IOByteOrderEnum::BigEndian) != ByteSwapperType::SystemIsBigEndian()))
+  {
+    return false;
+  }
+  dataFileName = m_FileName;
+  dataOffset = static_cast<ImageIOBase::SizeType>(this->GetHeaderSize());
+  return true;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
@@ -79,6 +79,22 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Determine if the ImageIO can stream reading from this file. This is
+   * the case for files which are decoded natively strip by strip or tile
+   * by tile: the strips or tiles overlapping the requested IORegion are
+   * decompressed concurrently, and only the requested pixels are
+   * copied. It is valid after ReadImageInformation() has been called. */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** Returns the requested region when streamed reading is enabled and
+   * the file can be streamed, otherwise the whole image. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /** Reads 3D data from multi-pages tiff. */
   virtual void
   ReadVolume(void * buffer);
@@ -263,6 +279,19 @@ private:
   void
   ReadCurrentPage(void * buffer, size_t pixelOffset);
 
+  /** Reads the IORegion, strip by strip or tile by tile. */
+  void
+  ReadRegion(void * buffer);
+
+  template <typename TComponent>
+  void
+  ReadRegion(void * buffer);
+
+  /** Converts xsize pixels of one decoded row to the output pixel format. */
+  template <typename TComponent>
+  void
+  PutRow(TComponent * to, void * from, unsigned int xsize);
+
   template <typename TComponent>
   void
   ReadGenericImage(void * _out, unsigned int width, unsigned int height);
@@ -317,6 +346,7 @@ private:
   uint16_t *   m_ColorBlue{};
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  bool         m_CanStreamRead{ false };
 };
 } // end namespace itk
 
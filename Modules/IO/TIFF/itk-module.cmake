@@ -13,6 +13,7 @@ itk_module(
   ITKTIFF
   TEST_DEPENDS
   ITKTestKernel
+  ITKTIFF
   FACTORY_NAMES
   ImageIO::TIFF
   DESCRIPTION
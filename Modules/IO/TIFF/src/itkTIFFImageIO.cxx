@@ -21,9 +21,13 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace itk
 {
 
@@ -191,7 +195,11 @@ TIFFImageIO::Read(void * buffer)
 
   // The IO region should be of dimensions 3 otherwise we read only the first
   // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  if (m_CanStreamRead)
+  {
+    this->ReadRegion(buffer);
+  }
+  else if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
   {
     this->ReadVolume(buffer);
   }
@@ -244,6 +252,7 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "CanStreamRead: " << m_CanStreamRead << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:" << '\n';
@@ -491,7 +500,18 @@ TIFFImageIO::ReadImageInformation()
   }
 
 
-  if (!m_InternalImage->CanRead())
+  // Files which can be read natively, tiled or not, are decoded strip by
+  // strip or tile by tile, which also allows to stream a sub region.
+  const unsigned int format = this->GetFormat();
+  m_CanStreamRead = m_InternalImage->CanRead(true) && m_InternalImage->m_IgnoredSubFiles == 0 &&
+                    (this->GetNumberOfDimensions() == 2 || m_Dimensions[2] == m_InternalImage->m_NumberOfPages) &&
+                    (format == TIFFImageIO::GRAYSCALE || format == TIFFImageIO::RGB_ ||
+                     format == TIFFImageIO::PALETTE_GRAYSCALE || format == TIFFImageIO::PALETTE_RGB) &&
+                    (m_ComponentType == IOComponentEnum::UCHAR || m_ComponentType == IOComponentEnum::CHAR ||
+                     m_ComponentType == IOComponentEnum::USHORT || m_ComponentType == IOComponentEnum::SHORT ||
+                     m_ComponentType == IOComponentEnum::FLOAT);
+
+  if (!m_CanStreamRead && !m_InternalImage->CanRead())
   {
     //  exception if compression is not supported
     if (TIFFIsCODECConfigured(this->m_InternalImage->m_Compression) != 1)
@@ -1319,6 +1339,214 @@ TIFFImageIO::ReadCurrentPage(void * buffer, size_t pixelOffset)
   }
 }
 
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+
+  // only the strips or tiles overlapping the requested region are decoded
+  return requested;
+}
+
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  if (m_ComponentType == IOComponentEnum::UCHAR)
+  {
+    this->ReadRegion<unsigned char>(buffer);
+  }
+  else if (m_ComponentType == IOComponentEnum::CHAR)
+  {
+    this->ReadRegion<char>(buffer);
+  }
+  else if (m_ComponentType == IOComponentEnum::USHORT)
+  {
+    this->ReadRegion<unsigned short>(buffer);
+  }
+  else if (m_ComponentType == IOComponentEnum::SHORT)
+  {
+    this->ReadRegion<short>(buffer);
+  }
+  else if (m_ComponentType == IOComponentEnum::FLOAT)
+  {
+    this->ReadRegion<float>(buffer);
+  }
+  else
+  {
+    itkExceptionMacro("Logic Error: Unexpected buffer type!");
+  }
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  const ImageIORegion & region = this->GetIORegion();
+
+  const uint32_t height = m_InternalImage->m_Height;
+  const bool     bottomLeft = (m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT);
+
+  const auto     x0 = static_cast<uint32_t>(region.GetIndex(0));
+  const auto     x1 = x0 + static_cast<uint32_t>(region.GetSize(0));
+  const auto     y0 = static_cast<uint32_t>(region.GetIndex(1));
+  const auto     y1 = y0 + static_cast<uint32_t>(region.GetSize(1));
+  uint32_t       firstPage = 0;
+  uint32_t       numberOfPages = 1;
+  if (region.GetImageDimension() > 2)
+  {
+    firstPage = static_cast<uint32_t>(region.GetIndex(2));
+    numberOfPages = static_cast<uint32_t>(region.GetSize(2));
+  }
+
+  // the rows of the file holding the rows of the region
+  const uint32_t fileRowBegin = bottomLeft ? height - y1 : y0;
+  const uint32_t fileRowEnd = bottomLeft ? height - y0 : y1;
+
+  this->InitializeColors();
+  // evaluate the format once, PutRow is then safe to call concurrently
+  this->GetFormat();
+
+  // The region is split into bands of rows, one strip or one row of tiles
+  // high, each of which can be decoded independently.
+  uint32_t bandHeight = m_InternalImage->m_TileHeight;
+  if (!TIFFIsTiled(m_InternalImage->m_Image))
+  {
+    TIFFGetFieldDefaulted(m_InternalImage->m_Image, TIFFTAG_ROWSPERSTRIP, &bandHeight);
+  }
+  bandHeight = std::clamp(bandHeight, uint32_t{ 1 }, height);
+
+  struct Band
+  {
+    uint32_t page;
+    uint32_t rowBegin;
+    uint32_t rowEnd;
+  };
+  std::vector<Band> bands;
+  for (uint32_t page = firstPage; page < firstPage + numberOfPages; ++page)
+  {
+    for (uint32_t row = fileRowBegin - fileRowBegin % bandHeight; row < fileRowEnd; row += bandHeight)
+    {
+      bands.push_back({ page, std::max(row, fileRowBegin), std::min(row + bandHeight, fileRowEnd) });
+    }
+  }
+
+  const size_t regionWidth = x1 - x0;
+  const size_t regionHeight = y1 - y0;
+  const size_t numberOfComponents = this->GetNumberOfComponents();
+  const size_t bytesPerPixel = size_t{ m_InternalImage->m_SamplesPerPixel } * (m_InternalImage->m_BitsPerSample / 8);
+  auto * const out = static_cast<TComponent *>(buffer);
+
+  const auto outputPointer = [=](uint32_t page, uint32_t fileRow, uint32_t column) {
+    const uint32_t imageRow = bottomLeft ? height - 1 - fileRow : fileRow;
+    return out + (((page - firstPage) * regionHeight + (imageRow - y0)) * regionWidth + (column - x0)) *
+                   numberOfComponents;
+  };
+
+  // Decodes the strips or tiles of a band, and copies their pixels
+  // which are inside the region.
+  const auto readBand = [this, x0, x1, bytesPerPixel, &outputPointer](
+                          TIFF * tiff, const Band & band, std::vector<uint8_t> & decoded) {
+    if (TIFFCurrentDirectory(tiff) != band.page && !TIFFSetDirectory(tiff, band.page))
+    {
+      itkExceptionMacro("Cannot read page " << band.page << " of file " << m_FileName);
+    }
+
+    if (TIFFIsTiled(tiff))
+    {
+      uint32_t tileWidth = 0;
+      uint32_t tileHeight = 0;
+      TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tileWidth);
+      TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tileHeight);
+      const tmsize_t tileSize = TIFFTileSize(tiff);
+      const tmsize_t tileRowSize = TIFFTileRowSize(tiff);
+      decoded.resize(static_cast<size_t>(tileSize));
+
+      for (uint32_t tileY = band.rowBegin - band.rowBegin % tileHeight; tileY < band.rowEnd; tileY += tileHeight)
+      {
+        for (uint32_t tileX = x0 - x0 % tileWidth; tileX < x1; tileX += tileWidth)
+        {
+          if (TIFFReadEncodedTile(tiff, TIFFComputeTile(tiff, tileX, tileY, 0, 0), decoded.data(), tileSize) < 0)
+          {
+            itkExceptionMacro("Problem reading the tile at: " << tileX << ", " << tileY);
+          }
+          const uint32_t columnBegin = std::max(tileX, x0);
+          const uint32_t columnEnd = std::min(tileX + tileWidth, x1);
+          const uint32_t rowEnd = std::min(tileY + tileHeight, band.rowEnd);
+          for (uint32_t row = std::max(tileY, band.rowBegin); row < rowEnd; ++row)
+          {
+            this->PutRow(outputPointer(band.page, row, columnBegin),
+                         decoded.data() + (row - tileY) * tileRowSize + (columnBegin - tileX) * bytesPerPixel,
+                         columnEnd - columnBegin);
+          }
+        }
+      }
+    }
+    else
+    {
+      uint32_t rowsPerStrip = 0;
+      TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+      rowsPerStrip = std::max(rowsPerStrip, uint32_t{ 1 });
+      const tmsize_t stripSize = TIFFStripSize(tiff);
+      const tmsize_t scanlineSize = TIFFScanlineSize(tiff);
+      decoded.resize(static_cast<size_t>(stripSize));
+
+      for (uint32_t stripY = band.rowBegin - band.rowBegin % rowsPerStrip; stripY < band.rowEnd;
+           stripY += rowsPerStrip)
+      {
+        if (TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, stripY, 0), decoded.data(), stripSize) < 0)
+        {
+          itkExceptionMacro("Problem reading the strip at row: " << stripY);
+        }
+        const uint32_t rowEnd = std::min(stripY + rowsPerStrip, band.rowEnd);
+        for (uint32_t row = std::max(stripY, band.rowBegin); row < rowEnd; ++row)
+        {
+          this->PutRow(outputPointer(band.page, row, x0),
+                       decoded.data() + (row - stripY) * scanlineSize + x0 * bytesPerPixel,
+                       x1 - x0);
+        }
+      }
+    }
+  };
+
+  const auto numberOfWorkUnits = static_cast<ThreadIdType>(
+    std::min<size_t>(MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), bands.size()));
+
+  if (numberOfWorkUnits <= 1)
+  {
+    std::vector<uint8_t> decoded;
+    for (const Band & band : bands)
+    {
+      readBand(m_InternalImage->m_Image, band, decoded);
+    }
+    return;
+  }
+
+  // A libtiff handle can not be shared between threads, so each work
+  // unit opens the file, and then decodes the next band not yet taken.
+  std::atomic<size_t> nextBand{ 0 };
+  const auto          multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [this, &nextBand, &bands, &readBand](SizeValueType) {
+      TIFFReaderInternal reader;
+      if (!reader.Open(m_FileName.c_str()))
+      {
+        itkExceptionMacro("Cannot open file " << this->m_FileName << '!');
+      }
+      std::vector<uint8_t> decoded;
+      for (size_t k = nextBand++; k < bands.size(); k = nextBand++)
+      {
+        readBand(reader.m_Image, bands[k], decoded);
+      }
+    },
+    nullptr);
+}
+
 template <typename TComponent>
 void
 TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int height)
@@ -1390,71 +1618,78 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       image = out + inc * width * (height - (row + 1));
     }
 
-    switch (this->GetFormat())
-    {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+    this->PutRow<ComponentType>(image, buf, width);
+  }
+
+  _TIFFfree(buf);
+}
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+template <typename TComponent>
+void
+TIFFImageIO::PutRow(TComponent * to, void * from, unsigned int xsize)
+{
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<TComponent>(to, static_cast<TComponent *>(from), xsize, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<TComponent>(to, static_cast<TComponent *>(from), xsize, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<TComponent, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<TComponent, unsigned short>(
+            to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                                                                << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<TComponent, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<TComponent, unsigned short>(to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
             break;
           default:
             itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                                                                   << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                                                    << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                                                    << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<TComponent, unsigned char>(to, static_cast<unsigned char *>(from), xsize, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<TComponent, unsigned short>(
+              to, static_cast<unsigned short *>(from), xsize, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                                                                  << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
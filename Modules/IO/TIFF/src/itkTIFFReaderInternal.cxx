@@ -189,6 +189,8 @@ TIFFReaderInternal::Clean()
 
 TIFFReaderInternal::TIFFReaderInternal() { this->Clean(); }
 
+TIFFReaderInternal::~TIFFReaderInternal() { this->Clean(); }
+
 int
 TIFFReaderInternal::Initialize()
 {
@@ -282,13 +284,11 @@ TIFFReaderInternal::Initialize()
 }
 
 int
-TIFFReaderInternal::CanRead()
+TIFFReaderInternal::CanRead(bool allowTiles)
 {
   const bool compressionSupported = (TIFFIsCODECConfigured(this->m_Compression) == 1);
   return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_SamplesPerPixel > 0) &&
-          compressionSupported && (m_NumberOfTiles == 0) // just use TIFFReadRGBAImage, an
-                                                         // native optimized version would be nice
-          && (this->m_HasValidPhotometricInterpretation) &&
+          compressionSupported && (allowTiles || m_NumberOfTiles == 0) && (this->m_HasValidPhotometricInterpretation) &&
           (this->m_Photometrics == PHOTOMETRIC_RGB || this->m_Photometrics == PHOTOMETRIC_MINISWHITE ||
            this->m_Photometrics == PHOTOMETRIC_MINISBLACK ||
            (this->m_Photometrics == PHOTOMETRIC_PALETTE && this->m_BitsPerSample != 32)) &&
@@ -30,14 +30,19 @@ class ITKIOTIFF_HIDDEN TIFFReaderInternal
 {
 public:
   TIFFReaderInternal();
+  ~TIFFReaderInternal();
+
   int
   Initialize();
 
   void
   Clean();
 
+  /** Whether the pixels can be read without TIFFReadRGBAImage. Tiled
+   * images are only accepted with allowTiles, since they can not be read
+   * scanline by scanline. */
   int
-  CanRead();
+  CanRead(bool allowTiles = false);
 
   int
   Open(const char * filename, bool silent = false);
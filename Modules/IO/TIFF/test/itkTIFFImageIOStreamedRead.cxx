@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTIFFImageIO.h"
+#include "itk_tiff.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+#include <string>
+#include <vector>
+
+
+#define _STRING(s) #s
+#define TOSTRING(s) std::string(_STRING(s))
+
+namespace
+{
+
+struct ITKIOTIFFStreamedRead : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+
+    itksys::SystemTools::MakeDirectory(m_TempDir);
+
+    // make sure the strips and tiles are decoded concurrently
+    m_NumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+  }
+
+  void
+  TearDown() override
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(m_NumberOfThreads);
+
+    // Remove the temporary directory and its contents
+    itksys::SystemTools::RemoveADirectory(m_TempDir);
+  }
+
+  static unsigned short
+  ExpectedValue(itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z = 0)
+  {
+    return static_cast<unsigned short>(x + 100 * y + 7000 * z);
+  }
+
+  template <typename TImage>
+  static void
+  CheckPixels(const TImage * image)
+  {
+    itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const typename TImage::IndexType index = it.GetIndex();
+      const itk::IndexValueType        z = TImage::ImageDimension > 2 ? index[TImage::ImageDimension - 1] : 0;
+      ASSERT_EQ(it.Get(), ExpectedValue(index[0], index[1], z)) << "at index " << index;
+    }
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  ReadRegion(const std::string & fileName, const typename TImage::RegionType & region)
+  {
+    auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->GetOutput()->Update();
+    return reader->GetOutput();
+  }
+
+  std::string m_TempDir = TOSTRING(ITK_TEST_OUTPUT_DIR) + "/TIFFImageIO.StreamedRead";
+
+  itk::ThreadIdType m_NumberOfThreads{};
+};
+
+} // namespace
+
+
+TEST_F(ITKIOTIFFStreamedRead, TiledImage)
+{
+  using ImageType = itk::Image<unsigned short, 2>;
+
+  constexpr uint32_t width = 100;
+  constexpr uint32_t height = 70;
+  constexpr uint32_t tileWidth = 32;
+  constexpr uint32_t tileHeight = 16;
+
+  const std::string fileName = m_TempDir + "/tiled.tif";
+  {
+    TIFF * tiff = TIFFOpen(fileName.c_str(), "w");
+    ASSERT_NE(tiff, nullptr);
+    TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, width);
+    TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, height);
+    TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, 16);
+    TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, 1);
+    TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+    TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField(tiff, TIFFTAG_COMPRESSION, COMPRESSION_ADOBE_DEFLATE);
+    TIFFSetField(tiff, TIFFTAG_TILEWIDTH, tileWidth);
+    TIFFSetField(tiff, TIFFTAG_TILELENGTH, tileHeight);
+
+    std::vector<unsigned short> tile(tileWidth * tileHeight);
+    for (uint32_t tileY = 0; tileY < height; tileY += tileHeight)
+    {
+      for (uint32_t tileX = 0; tileX < width; tileX += tileWidth)
+      {
+        for (uint32_t y = 0; y < tileHeight; ++y)
+        {
+          for (uint32_t x = 0; x < tileWidth; ++x)
+          {
+            tile[y * tileWidth + x] = ExpectedValue(tileX + x, tileY + y);
+          }
+        }
+        ASSERT_GE(TIFFWriteTile(tiff, tile.data(), tileX, tileY, 0, 0), 0);
+      }
+    }
+    TIFFClose(tiff);
+  }
+
+  auto imageIO = itk::TIFFImageIO::New();
+  imageIO->SetFileName(fileName);
+  imageIO->ReadImageInformation();
+  EXPECT_TRUE(imageIO->CanStreamRead());
+  EXPECT_EQ(imageIO->GetComponentType(), itk::IOComponentEnum::USHORT);
+  EXPECT_EQ(imageIO->GetNumberOfComponents(), 1u);
+
+  const ImageType::Pointer image = itk::ReadImage<ImageType>(fileName);
+  EXPECT_EQ(image->GetBufferedRegion().GetSize(), ImageType::SizeType({ { width, height } }));
+  CheckPixels(image.GetPointer());
+
+  const ImageType::RegionType region({ { 20, 10 } }, { { 50, 30 } });
+  const ImageType::Pointer    streamed = ReadRegion<ImageType>(fileName, region);
+  EXPECT_EQ(streamed->GetBufferedRegion(), region);
+  CheckPixels(streamed.GetPointer());
+}
+
+
+TEST_F(ITKIOTIFFStreamedRead, MultiPageStripImage)
+{
+  using ImageType = itk::Image<unsigned short, 3>;
+
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size{ { 60, 45, 5 } };
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(ExpectedValue(index[0], index[1], index[2]));
+  }
+
+  const std::string fileName = m_TempDir + "/pages.tif";
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  auto              writerIO = itk::TIFFImageIO::New();
+  writerIO->SetCompressionToDeflate();
+  writer->SetImageIO(writerIO);
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->Update();
+
+  CheckPixels(itk::ReadImage<ImageType>(fileName).GetPointer());
+
+  const ImageType::RegionType region({ { 7, 11, 1 } }, { { 40, 20, 3 } });
+  const ImageType::Pointer    streamed = ReadRegion<ImageType>(fileName, region);
+  EXPECT_EQ(streamed->GetBufferedRegion(), region);
+  CheckPixels(streamed.GetPointer());
+}
@@ -83,6 +83,7 @@ public:
   using MeasureType = CostFunctionType::MeasureType;
   using ValueType = ParametersType::ValueType;
   using RandomVariateGeneratorType = Statistics::MersenneTwisterRandomVariateGenerator;
+  using CostFunctionsListType = std::vector<CostFunctionPointer>;
 
   /** Specify whether to initialize the particles using a normal distribution
    * centered on the user supplied initial value or a uniform distribution.
@@ -195,6 +196,20 @@ public:
   itkGetMacro(UseSeed, bool);
   itkBooleanMacro(UseSeed);
   /** @ITKEndGrouping */
+  /** Set/Get cost functions that evaluate the particles concurrently with
+   * the cost function. Each of them must compute the same values as the cost
+   * function, and keep its own state (for example, its own transform), so
+   * that the particles of a generation are evaluated by the cost function
+   * and these cost functions in parallel. A cost function that is safe to
+   * evaluate concurrently may be listed several times. The swarm evolves
+   * exactly as with sequential evaluation. */
+  /** @ITKStartGrouping */
+  void
+  SetConcurrentCostFunctions(const CostFunctionsListType & costFunctions);
+  const CostFunctionsListType &
+  GetConcurrentCostFunctions() const;
+  /** @ITKEndGrouping */
+
   /** Get the function value for the current position.
    *  NOTE: This value is only valid during and after the execution of the
    *        StartOptimization() method.*/
@@ -239,6 +254,12 @@ protected:
   void
   FileInitialization();
 
+  /** Sets the current value of each particle to the cost function value at
+   * its current parameters, concurrently when concurrent cost functions are
+   * set. */
+  void
+  EvaluateParticles();
+
   bool                                    m_PrintSwarm{};
   std::ostringstream                      m_StopConditionDescription{};
   bool                                    m_InitializeNormalDistribution{};
@@ -256,6 +277,7 @@ protected:
   NumberOfIterationsType                  m_IterationIndex{ 0 };
   RandomVariateGeneratorType::IntegerType m_Seed{};
   bool                                    m_UseSeed{};
+  CostFunctionsListType                   m_ConcurrentCostFunctions{};
 };
 } // end namespace itk
 
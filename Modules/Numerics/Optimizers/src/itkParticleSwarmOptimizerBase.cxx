@@ -16,7 +16,9 @@
  *
  *=========================================================================*/
 #include <algorithm>
+#include <atomic>
 #include "itkParticleSwarmOptimizerBase.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -123,6 +125,24 @@ ParticleSwarmOptimizerBase::SetParametersConvergenceTolerance(ParametersType::Va
 }
 
 
+void
+ParticleSwarmOptimizerBase::SetConcurrentCostFunctions(const CostFunctionsListType & costFunctions)
+{
+  if (costFunctions != this->m_ConcurrentCostFunctions)
+  {
+    this->m_ConcurrentCostFunctions = costFunctions;
+    Modified();
+  }
+}
+
+
+auto
+ParticleSwarmOptimizerBase::GetConcurrentCostFunctions() const -> const CostFunctionsListType &
+{
+  return this->m_ConcurrentCostFunctions;
+}
+
+
 ParticleSwarmOptimizerBase::CostFunctionType::MeasureType
 ParticleSwarmOptimizerBase::GetValue() const
 {
@@ -482,11 +502,48 @@ ParticleSwarmOptimizerBase::RandomInitialization()
     }
   }
   // initial function evaluations
+  this->EvaluateParticles();
   for (unsigned int i = 0; i < this->m_NumberOfParticles; ++i)
   {
-    this->m_Particles[i].m_CurrentValue = this->m_CostFunction->GetValue(m_Particles[i].m_CurrentParameters);
     this->m_Particles[i].m_BestValue = m_Particles[i].m_CurrentValue;
   }
 }
 
+
+void
+ParticleSwarmOptimizerBase::EvaluateParticles()
+{
+  if (this->m_ConcurrentCostFunctions.empty())
+  {
+    for (auto & particle : this->m_Particles)
+    {
+      particle.m_CurrentValue = this->m_CostFunction->GetValue(particle.m_CurrentParameters);
+    }
+    return;
+  }
+
+  CostFunctionsListType costFunctions{ this->m_CostFunction };
+  costFunctions.insert(
+    costFunctions.end(), this->m_ConcurrentCostFunctions.begin(), this->m_ConcurrentCostFunctions.end());
+
+  // The particles are handed out one by one to the cost functions, which
+  // evaluate them at different speeds.
+  std::atomic<SizeValueType> nextParticle(0);
+  const auto                 numberOfParticles = static_cast<SizeValueType>(this->m_Particles.size());
+
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(static_cast<ThreadIdType>(costFunctions.size()));
+  multiThreader->ParallelizeArray(
+    0,
+    costFunctions.size(),
+    [this, &costFunctions, &nextParticle, numberOfParticles](SizeValueType c) {
+      const CostFunctionType * const costFunction = costFunctions[c];
+      for (SizeValueType i = nextParticle++; i < numberOfParticles; i = nextParticle++)
+      {
+        this->m_Particles[i].m_CurrentValue = costFunction->GetValue(this->m_Particles[i].m_CurrentParameters);
+      }
+    },
+    nullptr);
+}
+
 } // namespace itk
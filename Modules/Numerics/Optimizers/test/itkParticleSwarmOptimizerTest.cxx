@@ -48,6 +48,14 @@ PSOTest2();
 int
 PSOTest3();
 
+
+/**
+ * Test that concurrent evaluation of the particles gives the same swarm
+ * evolution as sequential evaluation.
+ */
+int
+PSOTestConcurrentCostFunctions();
+
 namespace
 {
 bool verboseFlag = false;
@@ -90,6 +98,12 @@ itkParticleSwarmOptimizerTest(int argc, char * argv[])
     }
   }
 
+  if (PSOTestConcurrentCostFunctions() == EXIT_FAILURE)
+  {
+    std::cout << "[FAILURE]\n";
+    return EXIT_FAILURE;
+  }
+
   std::cout << "All Tests Completed." << std::endl;
 
   if (static_cast<double>(success1) / static_cast<double>(allIterations) <= threshold ||
@@ -485,3 +499,64 @@ PSOTest3()
   std::cout << "[Test 3 SUCCESS]" << std::endl;
   return EXIT_SUCCESS;
 }
+
+
+int
+PSOTestConcurrentCostFunctions()
+{
+  std::cout << "Particle Swarm Optimizer Test with concurrent cost functions\n";
+  std::cout << "----------------------------------\n";
+
+  const auto runOptimizer = [](const OptimizerType::CostFunctionsListType & concurrentCostFunctions,
+                               OptimizerType::ParametersType &              finalParameters,
+                               OptimizerType::MeasureType &                 finalValue) {
+    auto itkOptimizer = OptimizerType::New();
+    itkOptimizer->UseSeedOn();
+    itkOptimizer->SetSeed(8775070);
+
+    OptimizerType::ParameterBoundsType bounds;
+    bounds.emplace_back(-10, 10);
+    bounds.emplace_back(-10, 10);
+    OptimizerType::ParametersType initialParameters(2);
+    initialParameters[0] = 9;
+    initialParameters[1] = -9;
+
+    const itk::ParticleSwarmTestF2::Pointer costFunction = itk::ParticleSwarmTestF2::New();
+    itkOptimizer->SetParameterBounds(bounds);
+    itkOptimizer->SetNumberOfParticles(10);
+    itkOptimizer->SetMaximalNumberOfIterations(100);
+    itkOptimizer->SetParametersConvergenceTolerance(0.1, costFunction->GetNumberOfParameters());
+    itkOptimizer->SetFunctionConvergenceTolerance(0.001);
+    itkOptimizer->SetCostFunction(costFunction);
+    itkOptimizer->SetConcurrentCostFunctions(concurrentCostFunctions);
+    itkOptimizer->SetInitialPosition(initialParameters);
+    itkOptimizer->StartOptimization();
+
+    finalParameters = itkOptimizer->GetCurrentPosition();
+    finalValue = itkOptimizer->GetValue();
+    return itkOptimizer->GetConcurrentCostFunctions().size();
+  };
+
+  OptimizerType::ParametersType sequentialParameters;
+  OptimizerType::MeasureType    sequentialValue{};
+  runOptimizer({}, sequentialParameters, sequentialValue);
+
+  const OptimizerType::CostFunctionsListType concurrentCostFunctions{ itk::ParticleSwarmTestF2::New(),
+                                                                      itk::ParticleSwarmTestF2::New(),
+                                                                      itk::ParticleSwarmTestF2::New() };
+  OptimizerType::ParametersType              concurrentParameters;
+  OptimizerType::MeasureType                 concurrentValue{};
+  const auto                                 numberOfConcurrentCostFunctions =
+    runOptimizer(concurrentCostFunctions, concurrentParameters, concurrentValue);
+
+  std::cout << "Sequential parameters = " << sequentialParameters << "   ";
+  std::cout << "Concurrent parameters = " << concurrentParameters << std::endl;
+  if (numberOfConcurrentCostFunctions != concurrentCostFunctions.size() ||
+      concurrentParameters != sequentialParameters || concurrentValue != sequentialValue)
+  {
+    std::cout << "[Test with concurrent cost functions FAILURE]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "[Test with concurrent cost functions SUCCESS]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -98,6 +98,7 @@ public:
   /** Metric type over which this class is templated */
   using typename Superclass::MetricType;
   using MetricTypePointer = typename MetricType::Pointer;
+  using MetricsListType = std::vector<MetricTypePointer>;
 
   /** Derivative type */
   using DerivativeType = typename MetricType::DerivativeType;
@@ -147,6 +148,23 @@ public:
   ParametersType
   GetBestParameters();
 
+  /** Set/Get metrics that evaluate start points concurrently with the
+   * metric. Each of them must be set up and initialized like the metric, with
+   * its own moving transform, so that the start points are evaluated by the
+   * metric and these metrics in parallel, each on one work unit of the
+   * optimizer. The metrics keep their own threading, which shares the thread
+   * pool with the other evaluations. A metric that is safe to evaluate
+   * concurrently may be listed several times.
+   * The start points are evaluated concurrently only when no local optimizer
+   * is set. The results, the events and the best start point are the same as
+   * with sequential evaluation. */
+  /** @ITKStartGrouping */
+  void
+  SetConcurrentMetrics(const MetricsListType & metrics);
+  const MetricsListType &
+  GetConcurrentMetrics() const;
+  /** @ITKEndGrouping */
+
   /** Set/Get the optimizer. */
   /** @ITKStartGrouping */
   itkSetObjectMacro(LocalOptimizer, OptimizerType);
@@ -167,6 +185,14 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Evaluates the start points from \c firstIndex on with the metric and the
+   * concurrent metrics in parallel. \c evaluated is false for the start points
+   * whose evaluation threw an exception. */
+  void
+  EvaluateParametersListConcurrently(ParameterListSizeType firstIndex,
+                                     MetricValuesListType & values,
+                                     std::vector<bool> &    evaluated);
+
   /* Common variables for optimization control and reporting */
   bool                                     m_Stop{ false };
   StopConditionObjectToObjectOptimizerEnum m_StopCondition{};
@@ -177,6 +203,7 @@ protected:
   MeasureType                              m_MaximumMetricValue{};
   ParameterListSizeType                    m_BestParametersIndex{};
   OptimizerPointer                         m_LocalOptimizer{};
+  MetricsListType                          m_ConcurrentMetrics{};
 };
 
 /** This helps to meet backward compatibility */
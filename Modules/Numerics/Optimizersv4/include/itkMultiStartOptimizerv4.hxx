@@ -19,7 +19,10 @@
 #define itkMultiStartOptimizerv4_hxx
 
 #include "itkPrintHelper.h"
+#include "itkMultiThreaderBase.h"
 
+#include <algorithm>
+#include <atomic>
 
 namespace itk
 {
@@ -60,6 +63,7 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::PrintSelf(std::ost
      << static_cast<typename NumericTraits<ParameterListSizeType>::PrintType>(m_BestParametersIndex) << std::endl;
 
   itkPrintSelfObjectMacro(LocalOptimizer);
+  os << indent << "NumberOfConcurrentMetrics: " << m_ConcurrentMetrics.size() << std::endl;
 }
 
 template <typename TInternalComputationValueType>
@@ -89,6 +93,24 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::GetMetricValuesLis
   return this->m_MetricValuesList;
 }
 
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::SetConcurrentMetrics(const MetricsListType & metrics)
+{
+  if (metrics != this->m_ConcurrentMetrics)
+  {
+    this->m_ConcurrentMetrics = metrics;
+    this->Modified();
+  }
+}
+
+template <typename TInternalComputationValueType>
+auto
+MultiStartOptimizerv4Template<TInternalComputationValueType>::GetConcurrentMetrics() const -> const MetricsListType &
+{
+  return this->m_ConcurrentMetrics;
+}
+
 template <typename TInternalComputationValueType>
 auto
 MultiStartOptimizerv4Template<TInternalComputationValueType>::GetBestParameters() -> ParametersType
@@ -162,6 +184,18 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
   this->InvokeEvent(StartEvent());
 
+  // Without a local optimizer, the start points are independent and may be
+  // evaluated beforehand. The loop below then only collects the results, so
+  // that the events and the best start point do not depend on the evaluation
+  // order.
+  const bool           evaluateConcurrently = !this->m_ConcurrentMetrics.empty() && !this->m_LocalOptimizer;
+  MetricValuesListType concurrentValues;
+  std::vector<bool>    concurrentlyEvaluated;
+  if (evaluateConcurrently)
+  {
+    this->EvaluateParametersListConcurrently(this->m_CurrentIteration, concurrentValues, concurrentlyEvaluated);
+  }
+
   this->m_Stop = false;
   while (!this->m_Stop)
   {
@@ -169,13 +203,24 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
     try
     {
       this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
-      if (this->m_LocalOptimizer)
+      if (evaluateConcurrently)
       {
-        this->m_LocalOptimizer->SetMetric(this->m_Metric);
-        this->m_LocalOptimizer->StartOptimization();
-        this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        if (!concurrentlyEvaluated[this->m_CurrentIteration])
+        {
+          itkExceptionMacro("The metric could not be evaluated at start point " << this->m_CurrentIteration << '.');
+        }
+        this->m_CurrentMetricValue = concurrentValues[this->m_CurrentIteration];
+      }
+      else
+      {
+        if (this->m_LocalOptimizer)
+        {
+          this->m_LocalOptimizer->SetMetric(this->m_Metric);
+          this->m_LocalOptimizer->StartOptimization();
+          this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        }
+        this->m_CurrentMetricValue = this->m_Metric->GetValue();
       }
-      this->m_CurrentMetricValue = this->m_Metric->GetValue();
       this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
     }
     catch (const ExceptionObject &)
@@ -215,6 +260,57 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   }
 }
 
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::EvaluateParametersListConcurrently(
+  ParameterListSizeType  firstIndex,
+  MetricValuesListType & values,
+  std::vector<bool> &    evaluated)
+{
+  const ParameterListSizeType numberOfParameters = this->m_ParametersList.size();
+  values.assign(numberOfParameters, MeasureType{});
+  evaluated.assign(numberOfParameters, false);
+
+  MetricsListType metrics{ this->m_Metric };
+  metrics.insert(metrics.end(), this->m_ConcurrentMetrics.begin(), this->m_ConcurrentMetrics.end());
+  const auto numberOfMetrics =
+    std::min(static_cast<SizeValueType>(metrics.size()), static_cast<SizeValueType>(this->m_NumberOfWorkUnits));
+
+  // The start points are handed out one by one to the metrics, which
+  // evaluate them at different speeds. std::vector<bool> cannot be written
+  // concurrently, hence the separate flags.
+  std::atomic<ParameterListSizeType> nextIndex(firstIndex);
+  std::vector<char>                  succeeded(numberOfParameters, 0);
+
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(std::max(numberOfMetrics, SizeValueType{ 1 }));
+  multiThreader->ParallelizeArray(
+    0,
+    std::max(numberOfMetrics, SizeValueType{ 1 }),
+    [this, &metrics, &nextIndex, &values, &succeeded, numberOfParameters](SizeValueType m) {
+      MetricType * const metric = metrics[m];
+      for (ParameterListSizeType i = nextIndex++; i < numberOfParameters; i = nextIndex++)
+      {
+        try
+        {
+          metric->SetParameters(this->m_ParametersList[i]);
+          values[i] = metric->GetValue();
+          succeeded[i] = 1;
+        }
+        catch (const ExceptionObject &)
+        {
+          // Reported while the results are collected.
+        }
+      }
+    },
+    nullptr);
+
+  for (ParameterListSizeType i = firstIndex; i < numberOfParameters; ++i)
+  {
+    evaluated[i] = (succeeded[i] != 0);
+  }
+}
+
 } // namespace itk
 
 #endif
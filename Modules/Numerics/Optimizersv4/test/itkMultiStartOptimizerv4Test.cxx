@@ -254,6 +254,31 @@ itkMultiStartOptimizerv4Test(int, char *[])
   }
   std::cout << "Test 1 passed." << std::endl;
 
+  /*
+   * Test concurrent evaluation of the start points of test 1
+   */
+  std::cout << "Test optimization 1 with concurrent metrics:" << std::endl;
+  const OptimizerType::MetricValuesListType sequentialMetricValues = itkOptimizer->GetMetricValuesList();
+  const auto                                sequentialBestIndex = itkOptimizer->GetBestParametersIndex();
+
+  const OptimizerType::MetricsListType concurrentMetrics{ MultiStartOptimizerv4TestMetric::New(),
+                                                          MultiStartOptimizerv4TestMetric::New(),
+                                                          MultiStartOptimizerv4TestMetric::New() };
+  itkOptimizer->SetConcurrentMetrics(concurrentMetrics);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetConcurrentMetrics().size(), concurrentMetrics.size());
+  itkOptimizer->SetNumberOfWorkUnits(4);
+  metric->SetParameters(parametersList[0]);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(itkOptimizer->GetMetricValuesList() == sequentialMetricValues);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetBestParametersIndex(), sequentialBestIndex);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetCurrentIteration(), parametersList.size());
+
+  itkOptimizer->SetConcurrentMetrics({});
+  std::cout << "Test with concurrent metrics passed." << std::endl;
+
   /*
    * Test 2
    */
@@ -560,6 +560,13 @@ public:
    * The length is obtained from the input sample. */
   itkGetConstMacro(MeasurementVectorSize, MeasurementVectorSizeType);
 
+  /** Set/Get the margin by which the searches widen the bounds of the nodes.
+   * A search remains exact as long as no measurement vector of the sample has
+   * moved further than this margin since the tree was generated, so that the
+   * tree can be reused for slightly moved points. Defaults to zero. */
+  itkSetMacro(BoundsMargin, double);
+  itkGetConstMacro(BoundsMargin, double);
+
   /** DistanceMetric type for the distance calculation and comparison */
   using DistanceMetricType = EuclideanDistanceMetric<MeasurementVectorType>;
 
@@ -835,6 +842,9 @@ private:
 
   /** Measurement vector size */
   MeasurementVectorSizeType m_MeasurementVectorSize{};
+
+  /** Margin by which the searches widen the bounds of the nodes */
+  double m_BoundsMargin{ 0.0 };
 }; // end of class
 } // namespace itk::Statistics
 
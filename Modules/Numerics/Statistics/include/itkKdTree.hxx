@@ -112,6 +112,7 @@ KdTree<TSample>::PrintSelf(std::ostream & os, Indent indent) const
     os << "not set." << std::endl;
   }
   os << indent << "MeasurementVectorSize: " << this->m_MeasurementVectorSize << std::endl;
+  os << indent << "BoundsMargin: " << this->m_BoundsMargin << std::endl;
 }
 
 template <typename TSample>
@@ -447,10 +448,11 @@ KdTree<TSample>::BallWithinBounds(const MeasurementVectorType & query,
                                   MeasurementVectorType &       upperBound,
                                   double                        radius) const
 {
+  const double widenedRadius = radius + this->m_BoundsMargin;
   for (unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d)
   {
-    if ((this->m_DistanceMetric->Evaluate(query[d], lowerBound[d]) <= radius) ||
-        (this->m_DistanceMetric->Evaluate(query[d], upperBound[d]) <= radius))
+    if ((this->m_DistanceMetric->Evaluate(query[d], lowerBound[d]) <= widenedRadius) ||
+        (this->m_DistanceMetric->Evaluate(query[d], upperBound[d]) <= widenedRadius))
     {
       return false;
     }
@@ -465,7 +467,7 @@ KdTree<TSample>::BoundsOverlapBall(const MeasurementVectorType & query,
                                    MeasurementVectorType &       upperBound,
                                    double                        radius) const
 {
-  const double squaredSearchRadius = itk::Math::sqr(radius);
+  const double squaredSearchRadius = itk::Math::sqr(radius + this->m_BoundsMargin);
 
   double sum = 0.0;
   for (unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d)
@@ -27,6 +27,8 @@
 #include "itkVectorContainer.h"
 #include "itkVectorContainerToListSampleAdaptor.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -78,6 +80,7 @@ public:
   using TreeGeneratorType = Statistics::KdTreeGenerator<SampleAdaptorType>;
   using TreeGeneratorPointer = typename TreeGeneratorType::Pointer;
   using TreeType = typename TreeGeneratorType::KdTreeType;
+  using TreePointer = typename TreeType::Pointer;
   using TreeConstPointer = typename TreeType::ConstPointer;
   using NeighborsIdentifierType = typename TreeType::InstanceIdentifierVectorType;
 
@@ -91,6 +94,22 @@ public:
   void
   Initialize();
 
+  /** Update the kd-tree after the points have moved, for example when
+   * SetPoints() was given the transformed points, with the same identifiers.
+   * The current kd-tree is kept, and its searches widen the bounds of its
+   * nodes by the largest displacement of a point, so that the queries remain
+   * exact. Once that displacement exceeds RefitTolerance times the average
+   * spacing of the points, the kd-tree is computed anew, as by Initialize(). */
+  void
+  Refit();
+
+  /** Set/Get the largest displacement of the points, relative to their
+   * average spacing, for which Refit() keeps the current kd-tree. The average
+   * spacing is estimated from the bounding box of the points. Zero makes
+   * Refit() compute a new kd-tree whenever a point has moved. Defaults to 0.5. */
+  itkSetMacro(RefitTolerance, double);
+  itkGetConstMacro(RefitTolerance, double);
+
   /** Find the closest point */
   PointIdentifier
   FindClosestPoint(const PointType & query) const;
@@ -117,7 +136,12 @@ private:
   PointsContainerPointer m_Points{};
   SampleAdaptorPointer   m_SampleAdaptor{};
   TreeGeneratorPointer   m_KdTreeGenerator{};
-  TreeConstPointer       m_Tree{};
+  TreePointer            m_Tree{};
+
+  /** The points from which the kd-tree was computed, and their average spacing. */
+  std::vector<PointType> m_TreePoints{};
+  double                 m_AveragePointSpacing{ 0.0 };
+  double                 m_RefitTolerance{ 0.5 };
 };
 
 } // end namespace itk
@@ -18,6 +18,9 @@
 #ifndef itkPointsLocator_hxx
 #define itkPointsLocator_hxx
 
+#include <algorithm>
+#include <cmath>
+
 namespace itk
 {
 
@@ -54,6 +57,70 @@ PointsLocator<TPointsContainer>::Initialize()
   this->m_KdTreeGenerator->Update();
 
   this->m_Tree = this->m_KdTreeGenerator->GetOutput();
+
+  // Keep the points of the kd-tree, to measure how far they move until
+  // Refit(), and estimate their average spacing from their bounding box,
+  // ignoring the dimensions along which the points are flat.
+  const auto numberOfPoints = static_cast<size_t>(this->m_SampleAdaptor->Size());
+  this->m_TreePoints.resize(numberOfPoints);
+  auto minimumPoint = MakeFilled<PointType>(NumericTraits<typename PointType::ValueType>::max());
+  auto maximumPoint = MakeFilled<PointType>(NumericTraits<typename PointType::ValueType>::NonpositiveMin());
+  for (size_t id = 0; id < numberOfPoints; ++id)
+  {
+    this->m_TreePoints[id] = this->m_SampleAdaptor->GetMeasurementVector(id);
+    for (unsigned int d = 0; d < PointDimension; ++d)
+    {
+      minimumPoint[d] = std::min(minimumPoint[d], this->m_TreePoints[id][d]);
+      maximumPoint[d] = std::max(maximumPoint[d], this->m_TreePoints[id][d]);
+    }
+  }
+
+  double       volume = 1.0;
+  unsigned int numberOfExtendedDimensions = 0;
+  for (unsigned int d = 0; d < PointDimension; ++d)
+  {
+    const double extent = static_cast<double>(maximumPoint[d]) - static_cast<double>(minimumPoint[d]);
+    if (extent > 0.0)
+    {
+      volume *= extent;
+      ++numberOfExtendedDimensions;
+    }
+  }
+  this->m_AveragePointSpacing =
+    (numberOfExtendedDimensions > 0)
+      ? std::pow(volume / static_cast<double>(numberOfPoints), 1.0 / static_cast<double>(numberOfExtendedDimensions))
+      : 0.0;
+}
+
+template <typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>::Refit()
+{
+  if (!this->m_Tree || !this->m_Points || this->m_Points->Size() != this->m_TreePoints.size())
+  {
+    this->Initialize();
+    return;
+  }
+
+  // The kd-tree reads the current points through the sample adaptor.
+  this->m_SampleAdaptor->SetVectorContainer(const_cast<PointsContainer *>(this->m_Points.GetPointer()));
+
+  double maximumSquaredDisplacement = 0.0;
+  for (size_t id = 0; id < this->m_TreePoints.size(); ++id)
+  {
+    const PointType & point = this->m_SampleAdaptor->GetMeasurementVector(id);
+    maximumSquaredDisplacement =
+      std::max(maximumSquaredDisplacement, static_cast<double>(this->m_TreePoints[id].SquaredEuclideanDistanceTo(point)));
+  }
+  const double maximumDisplacement = std::sqrt(maximumSquaredDisplacement);
+
+  // Written such that a NaN displacement computes a new kd-tree.
+  if (!(maximumDisplacement <= this->m_RefitTolerance * this->m_AveragePointSpacing))
+  {
+    this->Initialize();
+    return;
+  }
+  this->m_Tree->SetBoundsMargin(maximumDisplacement);
 }
 
 template <typename TPointsContainer>
@@ -119,6 +186,9 @@ void
 PointsLocator<TPointsContainer>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "RefitTolerance: " << this->m_RefitTolerance << std::endl;
+  os << indent << "AveragePointSpacing: " << this->m_AveragePointSpacing << std::endl;
 }
 
 } // end namespace itk
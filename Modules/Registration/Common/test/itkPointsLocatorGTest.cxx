@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPointsLocator.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+
+namespace
+{
+using PointsContainerType = itk::VectorContainer<itk::Point<float, 3>>;
+using PointsLocatorType = itk::PointsLocator<PointsContainerType>;
+using PointType = PointsLocatorType::PointType;
+
+PointsContainerType::Pointer
+MakeRandomPoints(unsigned int numberOfPoints, std::mt19937 & generator)
+{
+  std::uniform_real_distribution<float> distribution(0.0f, 20.0f);
+
+  auto points = PointsContainerType::New();
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    points->InsertElement(i, itk::MakePoint(distribution(generator), distribution(generator), distribution(generator)));
+  }
+  return points;
+}
+
+PointsContainerType::Pointer
+MakeDisplacedPoints(const PointsContainerType & points, float maximumDisplacement, std::mt19937 & generator)
+{
+  std::uniform_real_distribution<float> distribution(-maximumDisplacement, maximumDisplacement);
+
+  auto displacedPoints = PointsContainerType::New();
+  for (unsigned int i = 0; i < points.Size(); ++i)
+  {
+    PointType point = points.ElementAt(i);
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      point[d] += distribution(generator);
+    }
+    displacedPoints->InsertElement(i, point);
+  }
+  return displacedPoints;
+}
+
+// Expects the queries of the refitted locator to return the same points as those of a locator initialized anew.
+void
+ExpectSameQueryResults(const PointsLocatorType & refitted, PointsContainerType * points, std::mt19937 & generator)
+{
+  auto initialized = PointsLocatorType::New();
+  initialized->SetPoints(points);
+  initialized->Initialize();
+
+  std::uniform_real_distribution<float> distribution(-2.0f, 22.0f);
+  for (unsigned int q = 0; q < 50; ++q)
+  {
+    const auto query = itk::MakePoint(distribution(generator), distribution(generator), distribution(generator));
+
+    EXPECT_EQ(refitted.FindClosestPoint(query), initialized->FindClosestPoint(query)) << query;
+
+    // The closest points are not sorted, and the kd-trees may visit them in a different order.
+    PointsLocatorType::NeighborsIdentifierType refittedNeighbors;
+    PointsLocatorType::NeighborsIdentifierType initializedNeighbors;
+    refitted.FindClosestNPoints(query, 8, refittedNeighbors);
+    initialized->FindClosestNPoints(query, 8, initializedNeighbors);
+    std::sort(refittedNeighbors.begin(), refittedNeighbors.end());
+    std::sort(initializedNeighbors.begin(), initializedNeighbors.end());
+    EXPECT_EQ(refittedNeighbors, initializedNeighbors) << query;
+
+    refitted.FindPointsWithinRadius(query, 3.0, refittedNeighbors);
+    initialized->FindPointsWithinRadius(query, 3.0, initializedNeighbors);
+    std::sort(refittedNeighbors.begin(), refittedNeighbors.end());
+    std::sort(initializedNeighbors.begin(), initializedNeighbors.end());
+    EXPECT_EQ(refittedNeighbors, initializedNeighbors) << query;
+  }
+}
+} // namespace
+
+
+TEST(PointsLocator, RefitAfterSmallDisplacementsKeepsQueriesExact)
+{
+  std::mt19937 generator(1);
+  const auto   points = MakeRandomPoints(500, generator);
+
+  auto locator = PointsLocatorType::New();
+  EXPECT_EQ(locator->GetRefitTolerance(), 0.5);
+  locator->SetPoints(points);
+  locator->Initialize();
+
+  // Move the points a few times by less than the tolerance, so that the
+  // kd-tree is kept and only its bounds are widened.
+  auto displacedPoints = points;
+  for (unsigned int iteration = 0; iteration < 3; ++iteration)
+  {
+    displacedPoints = MakeDisplacedPoints(*displacedPoints, 0.1f, generator);
+    locator->SetPoints(displacedPoints);
+    locator->Refit();
+    ExpectSameQueryResults(*locator, displacedPoints, generator);
+  }
+}
+
+
+TEST(PointsLocator, RefitAfterLargeDisplacementsKeepsQueriesExact)
+{
+  std::mt19937 generator(2);
+  const auto   points = MakeRandomPoints(500, generator);
+
+  auto locator = PointsLocatorType::New();
+  locator->SetPoints(points);
+  locator->Initialize();
+
+  const auto displacedPoints = MakeDisplacedPoints(*points, 5.0f, generator);
+  locator->SetPoints(displacedPoints);
+  locator->Refit();
+  ExpectSameQueryResults(*locator, displacedPoints, generator);
+
+  // A zero tolerance computes a new kd-tree for any displacement.
+  locator->SetRefitTolerance(0.0);
+  const auto slightlyDisplacedPoints = MakeDisplacedPoints(*displacedPoints, 0.01f, generator);
+  locator->SetPoints(slightlyDisplacedPoints);
+  locator->Refit();
+  ExpectSameQueryResults(*locator, slightlyDisplacedPoints, generator);
+}
+
+
+TEST(PointsLocator, RefitInitializesWhenTheNumberOfPointsChanges)
+{
+  std::mt19937 generator(3);
+
+  auto locator = PointsLocatorType::New();
+  locator->SetPoints(MakeRandomPoints(100, generator));
+
+  // Refit() without a kd-tree computes one.
+  locator->Refit();
+
+  const auto otherPoints = MakeRandomPoints(300, generator);
+  locator->SetPoints(otherPoints);
+  locator->Refit();
+  ExpectSameQueryResults(*locator, otherPoints, generator);
+}
@@ -60,6 +60,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
@@ -104,6 +105,11 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /** Map the whole block into the fixed and moving spaces at once, then
+   * call \c ProcessPoint on each of its valid points. */
+  void
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
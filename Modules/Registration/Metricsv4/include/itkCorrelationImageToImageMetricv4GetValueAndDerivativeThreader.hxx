@@ -258,6 +258,49 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
+void
+CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TCorrelationMetric>::ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId)
+{
+  this->MapPointBlock(block, this->m_CorrelationAssociate->GetComputeDerivative());
+
+  /* Call the user method in derived classes to do the specific
+   * calculations for value and derivative. */
+  MeasureType metricValueResult;
+  for (const SizeValueType i : block.ValidPoints)
+  {
+    bool pointIsValid = false;
+    try
+    {
+      pointIsValid = this->ProcessPoint(block.VirtualIndices[i],
+                                        block.VirtualPoints[i],
+                                        block.MappedFixedPoints[i],
+                                        block.MappedFixedPixelValues[i],
+                                        block.MappedFixedImageGradients[i],
+                                        block.MappedMovingPoints[i],
+                                        block.MappedMovingPixelValues[i],
+                                        block.MappedMovingImageGradients[i],
+                                        metricValueResult,
+                                        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives,
+                                        threadId);
+    }
+    catch (const ExceptionObject & exc)
+    {
+      std::string msg("Exception in GetValueAndDerivativeProcessPoint:\n");
+      msg += exc.what();
+      ExceptionObject err(__FILE__, __LINE__, msg);
+      throw err;
+    }
+    if (pointIsValid)
+    {
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+    }
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
 bool
 CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -63,6 +63,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
@@ -103,6 +104,11 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId) override;
 
+  /* Overload: map the whole block into the fixed and moving spaces at once,
+   * without the image gradients, and sum the values of its valid points. */
+  void
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId) override;
+
 
   /**
    * Not using. All processing is done in ProcessVirtualPoint.
@@ -164,6 +164,21 @@ CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageM
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
+void
+CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageMetric, TCorrelationMetric>::
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId)
+{
+  this->MapPointBlock(block, false);
+
+  for (const SizeValueType i : block.ValidPoints)
+  {
+    this->m_CorrelationMetricPerThreadVariables[threadId].FixSum += block.MappedFixedPixelValues[i];
+    this->m_CorrelationMetricPerThreadVariables[threadId].MovSum += block.MappedMovingPixelValues[i];
+  }
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints += block.ValidPoints.size();
+}
+
 } // end namespace itk
 
 #endif
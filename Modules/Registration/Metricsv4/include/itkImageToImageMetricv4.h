@@ -587,6 +587,30 @@ public:
   /** Get Moving Gradient Image. */
   itkGetModifiableObjectMacro(MovingImageGradientImage, MovingImageGradientImageType);
 
+  /** Provide the gradient image of \c image, as computed beforehand by a
+   * filter like the fixed image gradient filter, for example by the metric of
+   * a previous registration. While \c image is the fixed image, Initialize()
+   * uses this gradient image instead of running the fixed image gradient
+   * filter. Passing nullptr discards it. */
+  void
+  SetPrecomputedFixedImageGradientImage(const FixedImageType * image, FixedImageGradientImageType * gradientImage);
+
+  /** Provide the gradient image of \c image, as computed beforehand by a
+   * filter like the moving image gradient filter. \sa SetPrecomputedFixedImageGradientImage */
+  void
+  SetPrecomputedMovingImageGradientImage(const MovingImageType * image, MovingImageGradientImageType * gradientImage);
+
+  /** Initialize the default image gradient filters. This must only
+   * be called once the fixed and moving images have been set. Initialize()
+   * calls them; they may be called beforehand to get the parameters that the
+   * gradient filters will use, e.g. to look up precomputed gradient images. */
+  /** @ITKStartGrouping */
+  virtual void
+  InitializeDefaultFixedImageGradientFilter();
+  virtual void
+  InitializeDefaultMovingImageGradientFilter();
+  /** @ITKEndGrouping */
+
   /** Get the number of points in the domain used to evaluate
    * the metric. This will differ depending on whether a sampled
    * point set or dense sampling is used, and will be greater than
@@ -745,14 +769,6 @@ protected:
   virtual void
   GetValueAndDerivativeExecute() const;
 
-  /** Initialize the default image gradient filters. This must only
-   * be called once the fixed and moving images have been set. */
-  /** @ITKStartGrouping */
-  virtual void
-  InitializeDefaultFixedImageGradientFilter();
-  virtual void
-  InitializeDefaultMovingImageGradientFilter();
-  /** @ITKEndGrouping */
   /** Get accessor for flag to calculate derivative. */
   itkGetConstMacro(ComputeDerivative, bool);
 
@@ -788,6 +804,12 @@ protected:
   mutable FixedImageGradientImagePointer  m_FixedImageGradientImage{};
   mutable MovingImageGradientImagePointer m_MovingImageGradientImage{};
 
+  /** Gradient images computed beforehand, and the images they belong to. */
+  FixedImageConstPointer          m_PrecomputedFixedImageGradientSource{};
+  FixedImageGradientImagePointer  m_PrecomputedFixedImageGradientImage{};
+  MovingImageConstPointer         m_PrecomputedMovingImageGradientSource{};
+  MovingImageGradientImagePointer m_PrecomputedMovingImageGradientImage{};
+
   /** Image gradient calculators */
   FixedImageGradientCalculatorPointer  m_FixedImageGradientCalculator{};
   MovingImageGradientCalculatorPointer m_MovingImageGradientCalculator{};
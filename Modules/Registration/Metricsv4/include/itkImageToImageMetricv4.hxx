@@ -434,9 +434,17 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   ComputeFixedImageGradientFilterImage()
 {
-  this->m_FixedImageGradientFilter->SetInput(this->m_FixedImage);
-  this->m_FixedImageGradientFilter->Update();
-  this->m_FixedImageGradientImage = this->m_FixedImageGradientFilter->GetOutput();
+  if (this->m_PrecomputedFixedImageGradientImage &&
+      this->m_PrecomputedFixedImageGradientSource == this->m_FixedImage)
+  {
+    this->m_FixedImageGradientImage = this->m_PrecomputedFixedImageGradientImage;
+  }
+  else
+  {
+    this->m_FixedImageGradientFilter->SetInput(this->m_FixedImage);
+    this->m_FixedImageGradientFilter->Update();
+    this->m_FixedImageGradientImage = this->m_FixedImageGradientFilter->GetOutput();
+  }
   this->m_FixedImageGradientInterpolator->SetInputImage(this->m_FixedImageGradientImage);
 }
 
@@ -449,12 +457,58 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   ComputeMovingImageGradientFilterImage() const
 {
-  this->m_MovingImageGradientFilter->SetInput(this->m_MovingImage);
-  this->m_MovingImageGradientFilter->Update();
-  this->m_MovingImageGradientImage = this->m_MovingImageGradientFilter->GetOutput();
+  if (this->m_PrecomputedMovingImageGradientImage &&
+      this->m_PrecomputedMovingImageGradientSource == this->m_MovingImage)
+  {
+    this->m_MovingImageGradientImage = this->m_PrecomputedMovingImageGradientImage;
+  }
+  else
+  {
+    this->m_MovingImageGradientFilter->SetInput(this->m_MovingImage);
+    this->m_MovingImageGradientFilter->Update();
+    this->m_MovingImageGradientImage = this->m_MovingImageGradientFilter->GetOutput();
+  }
   this->m_MovingImageGradientInterpolator->SetInputImage(this->m_MovingImageGradientImage);
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetPrecomputedFixedImageGradientImage(const FixedImageType * image, FixedImageGradientImageType * gradientImage)
+{
+  const FixedImageType * const source = (gradientImage != nullptr) ? image : nullptr;
+  if (this->m_PrecomputedFixedImageGradientSource != source ||
+      this->m_PrecomputedFixedImageGradientImage != gradientImage)
+  {
+    this->m_PrecomputedFixedImageGradientSource = source;
+    this->m_PrecomputedFixedImageGradientImage = gradientImage;
+    this->Modified();
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  SetPrecomputedMovingImageGradientImage(const MovingImageType * image, MovingImageGradientImageType * gradientImage)
+{
+  const MovingImageType * const source = (gradientImage != nullptr) ? image : nullptr;
+  if (this->m_PrecomputedMovingImageGradientSource != source ||
+      this->m_PrecomputedMovingImageGradientImage != gradientImage)
+  {
+    this->m_PrecomputedMovingImageGradientSource = source;
+    this->m_PrecomputedMovingImageGradientImage = gradientImage;
+    this->Modified();
+  }
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
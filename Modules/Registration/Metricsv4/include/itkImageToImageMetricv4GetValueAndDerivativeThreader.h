@@ -83,6 +83,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
 
   using typename Superclass::FixedTransformType;
   using typename Superclass::FixedOutputPointType;
@@ -102,8 +103,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPointBlock on
+   * every block of \c PointBlockSize consecutive points. */
   void
   ThreadedExecution(const DomainType & imageSubRegion, const ThreadIdType threadId) override;
 
@@ -161,6 +162,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
 
   using typename Superclass::FixedTransformType;
   using typename Superclass::FixedOutputPointType;
@@ -179,8 +181,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPointBlock on
+   * every block of \c PointBlockSize consecutive points. */
   void
   ThreadedExecution(const DomainType & indexSubRange, const ThreadIdType threadId) override;
 
@@ -31,12 +31,21 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
   using IteratorType = ImageRegionConstIteratorWithIndex<VirtualImageType>;
-  VirtualPointType virtualPoint;
+  PointBlockType block;
   for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
   {
     const VirtualIndexType & virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    block.VirtualIndices[block.NumberOfPoints] = virtualIndex;
+    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, block.VirtualPoints[block.NumberOfPoints]);
+    if (++block.NumberOfPoints == Superclass::PointBlockSize)
+    {
+      this->ProcessVirtualPointBlock(block, threadId);
+      block.NumberOfPoints = 0;
+    }
+  }
+  if (block.NumberOfPoints > 0)
+  {
+    this->ProcessVirtualPointBlock(block, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -53,11 +62,21 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
+  PointBlockType block;
   for (ElementIdentifierType i = begin; i <= end; ++i)
   {
     const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
-    const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    block.VirtualIndices[block.NumberOfPoints] = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+    block.VirtualPoints[block.NumberOfPoints] = virtualPoint;
+    if (++block.NumberOfPoints == Superclass::PointBlockSize)
+    {
+      this->ProcessVirtualPointBlock(block, threadId);
+      block.NumberOfPoints = 0;
+    }
+  }
+  if (block.NumberOfPoints > 0)
+  {
+    this->ProcessVirtualPointBlock(block, threadId);
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
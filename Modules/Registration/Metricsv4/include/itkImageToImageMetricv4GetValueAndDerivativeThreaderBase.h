@@ -22,6 +22,7 @@
 #include "itkCompensatedSummation.h"
 
 #include <memory> // For unique_ptr.
+#include <vector>
 
 namespace itk
 {
@@ -37,9 +38,15 @@ namespace itk
  *  AfterThreadedExecution.
  *
  *  The \c ThreadedExecution in
- *  ImageToImageMetricv4GetValueAndDerivativeThreader calls \c
- *  ProcessVirtualPoint on every point in the virtual image domain.  \c
- *  ProcessVirtualPoint calls \c ProcessPoint on each point.
+ *  ImageToImageMetricv4GetValueAndDerivativeThreader gathers the points of
+ *  the virtual image domain in blocks of \c PointBlockSize points and calls
+ *  \c ProcessVirtualPointBlock on each block.  By default, this calls \c
+ *  ProcessVirtualPoint on every point of the block, which in turn calls \c
+ *  ProcessPoint.  Derived classes may instead map the whole block into the
+ *  fixed and moving spaces at once with \c MapPointBlock, which transforms
+ *  and interpolates the block with one call per block to the transforms and
+ *  interpolators rather than one per point, and then call \c
+ *  ProcessMappedPointBlock.
  *
  * \ingroup ITKMetricsv4 */
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
@@ -91,6 +98,43 @@ public:
   using CompensatedDerivativeValueType = CompensatedSummation<DerivativeValueType>;
   using CompensatedDerivativeType = std::vector<CompensatedDerivativeValueType>;
 
+  using FixedInterpolatorType = typename ImageToImageMetricv4Type::FixedInterpolatorType;
+  using MovingInterpolatorType = typename ImageToImageMetricv4Type::MovingInterpolatorType;
+  using FixedImageGradientInterpolatorType = typename ImageToImageMetricv4Type::FixedImageGradientInterpolatorType;
+  using MovingImageGradientInterpolatorType = typename ImageToImageMetricv4Type::MovingImageGradientInterpolatorType;
+
+  /** Number of virtual points gathered by the threaders before calling
+   * \c ProcessVirtualPointBlock. */
+  static constexpr SizeValueType PointBlockSize = 128;
+
+  /** A block of virtual points and the results of mapping them into the fixed
+   * and moving spaces, stored as one array per quantity. */
+  struct PointBlockType
+  {
+    PointBlockType();
+
+    /** Number of points in the block, at most \c PointBlockSize. */
+    SizeValueType                        NumberOfPoints{ 0 };
+    std::vector<VirtualIndexType>        VirtualIndices;
+    std::vector<VirtualPointType>        VirtualPoints;
+    std::vector<FixedImagePointType>     MappedFixedPoints;
+    std::vector<FixedImagePixelType>     MappedFixedPixelValues;
+    std::vector<FixedImageGradientType>  MappedFixedImageGradients;
+    std::vector<MovingImagePointType>    MappedMovingPoints;
+    std::vector<MovingImagePixelType>    MappedMovingPixelValues;
+    std::vector<MovingImageGradientType> MappedMovingImageGradients;
+    /** Positions in the block of the points which are valid in both spaces,
+     * in increasing order. Set by \c MapPointBlock. */
+    std::vector<SizeValueType> ValidPoints;
+
+    /** Scratch storage of \c MapPointBlock, holding the continuous indices
+     * and interpolated values of the valid points only. */
+    std::vector<typename FixedInterpolatorType::ContinuousIndexType>  FixedContinuousIndices;
+    std::vector<typename FixedInterpolatorType::OutputType>           FixedInterpolatedValues;
+    std::vector<typename MovingInterpolatorType::ContinuousIndexType> MovingContinuousIndices;
+    std::vector<typename MovingInterpolatorType::OutputType>          MovingInterpolatedValues;
+  };
+
   /** Access the GetValueAndDerivative() accesor in image metric base. */
   virtual bool
   GetComputeDerivative() const;
@@ -122,6 +166,32 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** Method called by the threaders to process a block of virtual points.
+   * The default calls \c ProcessVirtualPoint on every point of the block.
+   * Derived classes which override this method with \c MapPointBlock and
+   * \c ProcessMappedPointBlock evaluate the block in batches. */
+  virtual void
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId);
+
+  /** Transform all the virtual points of \c block into the fixed and moving
+   * spaces, and evaluate the images there, and their gradients when
+   * \c computeImageGradients is true and the gradient source includes the
+   * image. Gives the same results as \c TransformAndEvaluateFixedPoint,
+   * \c TransformAndEvaluateMovingPoint and the image gradient methods of the
+   * metric, called on each point, but calls the transforms and the
+   * interpolators once per block. The image gradient methods of the metric
+   * are still called on each point, as derived metrics may override them.
+   * The points which are valid in both spaces are listed in
+   * \c block.ValidPoints. */
+  void
+  MapPointBlock(PointBlockType & block, const bool computeImageGradients) const;
+
+  /** Call \c ProcessPoint on each valid point of a block mapped by
+   * \c MapPointBlock, and accumulate its results as \c ProcessVirtualPoint
+   * does. */
+  void
+  ProcessMappedPointBlock(const PointBlockType & block, const ThreadIdType threadId);
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -170,6 +240,19 @@ protected:
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Call \c ProcessPoint on a point mapped into the fixed and moving spaces,
+   * and accumulate its results in the per-thread variables. */
+  bool
+  ProcessMappedPoint(const VirtualIndexType &        virtualIndex,
+                     const VirtualPointType &        virtualPoint,
+                     const FixedImagePointType &     mappedFixedPoint,
+                     const FixedImagePixelType &     mappedFixedPixelValue,
+                     const FixedImageGradientType &  mappedFixedImageGradient,
+                     const MovingImagePointType &    mappedMovingPoint,
+                     const MovingImagePixelType &    mappedMovingPixelValue,
+                     const MovingImageGradientType & mappedMovingImageGradient,
+                     const ThreadIdType              threadId);
+
   struct GetValueAndDerivativePerThreadStruct
   {
     /** Intermediary threaded metric value storage. */
@@ -21,6 +21,8 @@
 #include "itkNumericTraits.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <type_traits>
+
 namespace itk
 {
 
@@ -32,6 +34,25 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   , m_CachedNumberOfLocalParameters(0)
 {}
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::PointBlockType::
+  PointBlockType()
+  : VirtualIndices(PointBlockSize)
+  , VirtualPoints(PointBlockSize)
+  , MappedFixedPoints(PointBlockSize)
+  , MappedFixedPixelValues(PointBlockSize)
+  , MappedFixedImageGradients(PointBlockSize)
+  , MappedMovingPoints(PointBlockSize)
+  , MappedMovingPixelValues(PointBlockSize)
+  , MappedMovingImageGradients(PointBlockSize)
+  , FixedContinuousIndices(PointBlockSize)
+  , FixedInterpolatedValues(PointBlockSize)
+  , MovingContinuousIndices(PointBlockSize)
+  , MovingInterpolatedValues(PointBlockSize)
+{
+  ValidPoints.reserve(PointBlockSize);
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 void
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
@@ -185,7 +206,6 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   MovingImagePixelType    mappedMovingPixelValue;
   MovingImageGradientType mappedMovingImageGradient;
   bool                    pointIsValid = false;
-  MeasureType             metricValueResult;
 
   /* Transform the point into fixed and moving spaces, and evaluate.
    * Do this in a try block to catch exceptions and print more useful info
@@ -235,6 +255,33 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
     return pointIsValid;
   }
 
+  return this->ProcessMappedPoint(virtualIndex,
+                                  virtualPoint,
+                                  mappedFixedPoint,
+                                  mappedFixedPixelValue,
+                                  mappedFixedImageGradient,
+                                  mappedMovingPoint,
+                                  mappedMovingPixelValue,
+                                  mappedMovingImageGradient,
+                                  threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessMappedPoint(
+  const VirtualIndexType &        virtualIndex,
+  const VirtualPointType &        virtualPoint,
+  const FixedImagePointType &     mappedFixedPoint,
+  const FixedImagePixelType &     mappedFixedPixelValue,
+  const FixedImageGradientType &  mappedFixedImageGradient,
+  const MovingImagePointType &    mappedMovingPoint,
+  const MovingImagePixelType &    mappedMovingPixelValue,
+  const MovingImageGradientType & mappedMovingImageGradient,
+  const ThreadIdType              threadId)
+{
+  bool        pointIsValid = false;
+  MeasureType metricValueResult;
+
   /* Call the user method in derived classes to do the specific
    * calculations for value and derivative. */
   try
@@ -272,6 +319,168 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   return pointIsValid;
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId)
+{
+  for (SizeValueType i = 0; i < block.NumberOfPoints; ++i)
+  {
+    this->ProcessVirtualPoint(block.VirtualIndices[i], block.VirtualPoints[i], threadId);
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::MapPointBlock(
+  PointBlockType & block,
+  const bool       computeImageGradients) const
+{
+  const ImageToImageMetricv4Type * const associate = this->m_Associate;
+  const SizeValueType                    numberOfPoints = block.NumberOfPoints;
+  std::vector<SizeValueType> &           validPoints = block.ValidPoints;
+
+  /* Do this in a try block to catch exceptions and print more useful info
+   * then we otherwise get when exceptions are caught in MultiThreaderBase. */
+  try
+  {
+    /* Map the whole block into fixed space, and keep the points which lie
+     * within the fixed image mask and buffer. */
+    using FixedInputPointType = typename FixedTransformType::InputPointType;
+    if constexpr (std::is_same_v<VirtualPointType, FixedInputPointType> &&
+                  std::is_same_v<FixedImagePointType, FixedOutputPointType>)
+    {
+      associate->m_FixedTransform->TransformPoints(
+        block.VirtualPoints.data(), block.MappedFixedPoints.data(), numberOfPoints);
+    }
+    else
+    {
+      for (SizeValueType i = 0; i < numberOfPoints; ++i)
+      {
+        associate->LocalTransformPoint(block.VirtualPoints[i], block.MappedFixedPoints[i]);
+      }
+    }
+
+    validPoints.clear();
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      const FixedImagePointType & mappedFixedPoint = block.MappedFixedPoints[i];
+      if (associate->m_FixedImageMask && !associate->m_FixedImageMask->IsInsideInWorldSpace(mappedFixedPoint))
+      {
+        continue;
+      }
+      auto & continuousIndex = block.FixedContinuousIndices[validPoints.size()];
+      associate->m_FixedInterpolator->ConvertPointToContinuousIndex(mappedFixedPoint, continuousIndex);
+      if (associate->m_FixedInterpolator->IsInsideBuffer(continuousIndex))
+      {
+        validPoints.push_back(i);
+      }
+    }
+    associate->m_FixedInterpolator->EvaluateAtContinuousIndices(
+      block.FixedContinuousIndices.data(), block.FixedInterpolatedValues.data(), validPoints.size());
+    for (SizeValueType k = 0; k < validPoints.size(); ++k)
+    {
+      block.MappedFixedPixelValues[validPoints[k]] = block.FixedInterpolatedValues[k];
+    }
+
+    /* Map the points which are valid in fixed space into moving space. When
+     * all of them are, the whole block is passed to the transform. */
+    using MovingInputPointType = typename MovingTransformType::InputPointType;
+    if constexpr (std::is_same_v<VirtualPointType, MovingInputPointType> &&
+                  std::is_same_v<MovingImagePointType, MovingOutputPointType>)
+    {
+      if (validPoints.size() == numberOfPoints)
+      {
+        associate->m_MovingTransform->TransformPoints(
+          block.VirtualPoints.data(), block.MappedMovingPoints.data(), numberOfPoints);
+      }
+      else
+      {
+        for (const SizeValueType i : validPoints)
+        {
+          block.MappedMovingPoints[i] = associate->m_MovingTransform->TransformPoint(block.VirtualPoints[i]);
+        }
+      }
+    }
+    else
+    {
+      for (const SizeValueType i : validPoints)
+      {
+        MovingInputPointType localVirtualPoint;
+        localVirtualPoint.CastFrom(block.VirtualPoints[i]);
+        block.MappedMovingPoints[i].CastFrom(associate->m_MovingTransform->TransformPoint(localVirtualPoint));
+      }
+    }
+
+    SizeValueType numberOfValidPoints = 0;
+    for (const SizeValueType i : validPoints)
+    {
+      const MovingImagePointType & mappedMovingPoint = block.MappedMovingPoints[i];
+      if (associate->m_MovingImageMask && !associate->m_MovingImageMask->IsInsideInWorldSpace(mappedMovingPoint))
+      {
+        continue;
+      }
+      auto & continuousIndex = block.MovingContinuousIndices[numberOfValidPoints];
+      associate->m_MovingInterpolator->ConvertPointToContinuousIndex(mappedMovingPoint, continuousIndex);
+      if (associate->m_MovingInterpolator->IsInsideBuffer(continuousIndex))
+      {
+        validPoints[numberOfValidPoints++] = i;
+      }
+    }
+    validPoints.resize(numberOfValidPoints);
+    associate->m_MovingInterpolator->EvaluateAtContinuousIndices(
+      block.MovingContinuousIndices.data(), block.MovingInterpolatedValues.data(), numberOfValidPoints);
+    for (SizeValueType k = 0; k < numberOfValidPoints; ++k)
+    {
+      block.MappedMovingPixelValues[validPoints[k]] = block.MovingInterpolatedValues[k];
+    }
+
+    /* Image gradients, only at the points which are valid in both spaces.
+     * They are computed one point at a time, through the virtual methods of
+     * the metric, which derived metrics may override. */
+    if (computeImageGradients && associate->GetGradientSourceIncludesFixed())
+    {
+      for (const SizeValueType i : validPoints)
+      {
+        associate->ComputeFixedImageGradientAtPoint(block.MappedFixedPoints[i], block.MappedFixedImageGradients[i]);
+      }
+    }
+    if (computeImageGradients && associate->GetGradientSourceIncludesMoving())
+    {
+      for (const SizeValueType i : validPoints)
+      {
+        associate->ComputeMovingImageGradientAtPoint(block.MappedMovingPoints[i], block.MappedMovingImageGradients[i]);
+      }
+    }
+  }
+  catch (const ExceptionObject & exc)
+  {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessMappedPointBlock(const PointBlockType & block, const ThreadIdType threadId)
+{
+  for (const SizeValueType i : block.ValidPoints)
+  {
+    this->ProcessMappedPoint(block.VirtualIndices[i],
+                             block.VirtualPoints[i],
+                             block.MappedFixedPoints[i],
+                             block.MappedFixedPixelValues[i],
+                             block.MappedFixedImageGradients[i],
+                             block.MappedMovingPoints[i],
+                             block.MappedMovingPixelValues[i],
+                             block.MappedMovingImageGradients[i],
+                             threadId);
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 void
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
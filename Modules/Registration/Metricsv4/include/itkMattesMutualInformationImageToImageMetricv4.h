@@ -65,10 +65,18 @@ namespace itk
  * \warning Local-support transforms are not yet supported. If used,
  * an exception is thrown during Initialize().
  *
- * \note The per-iteration post-processing code is not multi-threaded, but could be
- * readily be made so for a small performance gain.
- * See GetValueCommonAfterThreadedExecution(), GetValueAndDerivative()
- * and threader::AfterThreadedExecution().
+ * For transforms without local support, the derivatives of the joint PDF
+ * with respect to the transform parameters are stored explicitly by default.
+ * They take (number of parameters) x (number of histogram bins)^2 values,
+ * which is large for B-spline transforms, and the threads add to them under
+ * a lock. With UseExplicitPDFDerivativesOff(), GetValueAndDerivative()
+ * instead visits the points twice: once to estimate the PDFs, and once to
+ * add the derivative contribution of each point straight to a per-thread
+ * derivative. For cubic B-spline transforms, this second pass only visits
+ * the parameters in the support of each point.
+ *
+ * The per-thread joint and fixed marginal PDFs are summed in parallel, over
+ * the rows of the joint PDF. See GetValueCommonAfterThreadedExecution().
  *
  * The algorithm and much of the code was copied from the previous
  * Mattes MI metric, i.e. itkMattesMutualInformationImageToImageMetric.
@@ -176,8 +184,8 @@ public:
   /**
    * Get the internal JointPDFDeriviative image that was used in
    * creating the metric derivative value.
-   * This is only created when a global support transform is used, and
-   * derivatives are requested.
+   * This is only created when a global support transform is used,
+   * derivatives are requested, and UseExplicitPDFDerivatives is on.
    */
   const typename JointPDFDerivativesType::Pointer
   GetJointPDFDerivatives() const
@@ -185,6 +193,22 @@ public:
     return this->m_JointPDFDerivatives;
   }
 
+  /** Set/Get whether the derivatives of the joint PDF with respect to the
+   * parameters of a transform without local support are stored explicitly.
+   * When off, GetValueAndDerivative() visits the points a second time
+   * instead, once the PDFs are known. This trades the (number of parameters)
+   * x (number of histogram bins)^2 derivatives, and the lock which guards
+   * them, for a second transform and interpolation of every point. Default
+   * is on. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+  /** @ITKEndGrouping */
+
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override;
+
   void
   FinalizeThread(const ThreadIdType threadId) override;
 
@@ -355,6 +379,19 @@ protected:
 
   PDFValueType m_JointPDFSum{};
 
+  bool m_UseExplicitPDFDerivatives{ true };
+
+  /** The pass of GetValueAndDerivative() in progress when the joint PDF
+   * derivatives are not stored explicitly: the first pass estimates the PDFs
+   * and the ratios of m_PRatioArray, the second accumulates the derivative. */
+  enum class ImplicitPDFDerivativesPass : uint8_t
+  {
+    None,
+    JointPDF,
+    Derivative
+  };
+  mutable ImplicitPDFDerivativesPass m_ImplicitPDFDerivativesPass{ ImplicitPDFDerivativesPass::None };
+
   /** Store the per-point local derivative result by parzen window bin.
    * For local-support transforms only. */
   mutable std::vector<DerivativeType> m_LocalDerivativeByParzenBin{};
@@ -283,12 +283,52 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) &&
+      this->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::None)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivative(MeasureType &    value,
+                                                                                  DerivativeType & derivative) const
+{
+  if (this->m_UseExplicitPDFDerivatives || this->HasLocalSupport())
+  {
+    Superclass::GetValueAndDerivative(value, derivative);
+    return;
+  }
+
+  try
+  {
+    // The first pass estimates the PDFs, the value, and the ratios which
+    // weight the derivative contributions of the points.
+    this->m_ImplicitPDFDerivativesPass = ImplicitPDFDerivativesPass::JointPDF;
+    Superclass::GetValue();
+
+    // The second pass adds the derivative contribution of every point, and
+    // keeps the value of the first pass.
+    this->m_ImplicitPDFDerivativesPass = ImplicitPDFDerivativesPass::Derivative;
+    Superclass::GetValueAndDerivative(value, derivative);
+  }
+  catch (...)
+  {
+    this->m_ImplicitPDFDerivativesPass = ImplicitPDFDerivativesPass::None;
+    throw;
+  }
+  this->m_ImplicitPDFDerivativesPass = ImplicitPDFDerivativesPass::None;
+}
+
 
 template <typename TFixedImage,
           typename TMovingImage,
@@ -389,30 +429,30 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
           const PDFValueType pRatio = std::log(jointPDFValue / movingImageMarginalPDF);
           sum += jointPDFValue * (pRatio - logfixedImageMarginalPDFValue);
 
-          if (this->GetComputeDerivative())
+          if (this->GetComputeDerivative() && !this->HasLocalSupport())
           {
-            if (!this->HasLocalSupport())
+            // Collect global derivative contributions
+            const JointPDFValueType * derivPtr = this->m_JointPDFDerivatives->GetBufferPointer() +
+                                                 (fixedIndex * this->m_JointPDFDerivatives->GetOffsetTable()[2]) +
+                                                 (movingIndex * this->m_JointPDFDerivatives->GetOffsetTable()[1]);
+            // move joint pdf derivative pointer to the right position
+            for (unsigned int parameter = 0, lastParameter = this->GetNumberOfLocalParameters();
+                 parameter < lastParameter;
+                 ++parameter, derivPtr++)
             {
-              // Collect global derivative contributions
-              const JointPDFValueType * derivPtr = this->m_JointPDFDerivatives->GetBufferPointer() +
-                                                   (fixedIndex * this->m_JointPDFDerivatives->GetOffsetTable()[2]) +
-                                                   (movingIndex * this->m_JointPDFDerivatives->GetOffsetTable()[1]);
-              // move joint pdf derivative pointer to the right position
-              for (unsigned int parameter = 0, lastParameter = this->GetNumberOfLocalParameters();
-                   parameter < lastParameter;
-                   ++parameter, derivPtr++)
-              {
-                // Ref: eqn 23 of Thevenaz & Unser paper [3]
-                (*(this->m_DerivativeResult))[parameter] += (*derivPtr) * pRatio;
-              } // end for-loop over parameters
-            }
-            else
-            {
-              // Collect the pRatio per pdf indices.
-              // Will be applied subsequently to local-support derivative
-              const OffsetValueType index = movingIndex + (fixedIndex * this->m_NumberOfHistogramBins);
-              this->m_PRatioArray[index] = pRatio * nFactor;
-            }
+              // Ref: eqn 23 of Thevenaz & Unser paper [3]
+              (*(this->m_DerivativeResult))[parameter] += (*derivPtr) * pRatio;
+            } // end for-loop over parameters
+          }
+          else if (this->GetComputeDerivative() ||
+                   this->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::JointPDF)
+          {
+            // Collect the pRatio per pdf indices.
+            // Will be applied subsequently to local-support derivative, or to
+            // the derivative contributions of the points in the second pass
+            // when the PDF derivatives are not stored explicitly.
+            const OffsetValueType index = movingIndex + (fixedIndex * this->m_NumberOfHistogramBins);
+            this->m_PRatioArray[index] = pRatio * nFactor;
           }
         } // end if( jointPDFValue > closeToZero && movingImageMarginalPDF > closeToZero )
       } // end for-loop over moving index
@@ -462,19 +502,28 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   const SizeValueType       numberOfVoxels = this->m_NumberOfHistogramBins * this->m_NumberOfHistogramBins;
   JointPDFValueType * const pdfPtrStart = this->m_ThreaderJointPDF[0]->GetBufferPointer();
 
-  for (unsigned int t = 1; t < localNumberOfWorkUnitsUsed; ++t)
-  {
-    JointPDFValueType *             pdfPtr = pdfPtrStart;
-    const JointPDFValueType *       tPdfPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer();
-    const JointPDFValueType * const tPdfPtrEnd = tPdfPtr + numberOfVoxels;
-    while (tPdfPtr < tPdfPtrEnd)
+  // Each row of the joint PDF, and the matching bin of the fixed marginal PDF,
+  // is summed over the work units independently of the other rows, in the
+  // same order as a serial sum.
+  const auto sumRowOverWorkUnits = [this, localNumberOfWorkUnitsUsed, pdfPtrStart](SizeValueType row) {
+    const SizeValueType numberOfBins = this->m_NumberOfHistogramBins;
+    JointPDFValueType * rowPtr = pdfPtrStart + row * numberOfBins;
+    for (unsigned int t = 1; t < localNumberOfWorkUnitsUsed; ++t)
     {
-      *(pdfPtr++) += *(tPdfPtr++);
-    }
-    for (SizeValueType i = 0; i < this->m_NumberOfHistogramBins; ++i)
-    {
-      this->m_ThreaderFixedImageMarginalPDF[0][i] += this->m_ThreaderFixedImageMarginalPDF[t][i];
+      const JointPDFValueType * tRowPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer() + row * numberOfBins;
+      for (SizeValueType i = 0; i < numberOfBins; ++i)
+      {
+        rowPtr[i] += tRowPtr[i];
+      }
+      this->m_ThreaderFixedImageMarginalPDF[0][row] += this->m_ThreaderFixedImageMarginalPDF[t][row];
     }
+  };
+  if (localNumberOfWorkUnitsUsed > 1)
+  {
+    MultiThreaderBase * const multiThreader = this->m_UseSampledPointSet
+                                                ? this->m_SparseGetValueAndDerivativeThreader->GetMultiThreader()
+                                                : this->m_DenseGetValueAndDerivativeThreader->GetMultiThreader();
+    multiThreader->ParallelizeArray(0, this->m_NumberOfHistogramBins, sumRowOverWorkUnits, nullptr);
   }
 
   // Sum of this threads domain into the this->m_JointPDFSum that covers that part of the domain.
@@ -501,6 +550,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseExplicitPDFDerivatives);
 }
 
 template <typename TFixedImage,
@@ -19,6 +19,7 @@
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_h
 
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
+#include "itkBSplineBaseTransform.h"
 
 #include <mutex>
 
@@ -61,6 +62,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
@@ -86,6 +88,12 @@ public:
 
   using JacobianType = typename TMattesMutualInformationMetric::JacobianType;
 
+  /** The cubic B-spline transforms whose Jacobian is evaluated sparsely when
+   * the PDF derivatives are not stored explicitly. */
+  using MovingBSplineTransformType = BSplineBaseTransform<typename MovingTransformType::ParametersValueType,
+                                                          ImageToImageMetricv4Type::MovingImageDimension,
+                                                          3>;
+
 protected:
   MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_MattesAssociate(nullptr)
@@ -97,6 +105,11 @@ protected:
   void
   AfterThreadedExecution() override;
 
+  /** Map the whole block into the fixed and moving spaces at once, then
+   * process its valid points. */
+  void
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -120,10 +133,27 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Add the derivative contribution of a point to the per-thread derivative,
+   * in the second pass over the points when the PDF derivatives are not
+   * stored explicitly. \c pRatio points to the ratios of the four joint PDF
+   * bins affected by the point, and \c movingImageParzenWindowArg is the
+   * Parzen window argument of the first of these bins. */
+  virtual void
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType *            pRatio,
+                                PDFValueType                    movingImageParzenWindowArg,
+                                const ThreadIdType              threadId) const;
+
 private:
+  using ImplicitPDFDerivativesPass = typename TMattesMutualInformationMetric::ImplicitPDFDerivativesPass;
+
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate{};
+
+  /** The moving transform, when it is a cubic B-spline transform. */
+  const MovingBSplineTransformType * m_MovingBSplineTransform{};
 };
 
 } // end namespace itk
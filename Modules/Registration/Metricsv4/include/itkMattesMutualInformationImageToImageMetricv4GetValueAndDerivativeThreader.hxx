@@ -44,6 +44,15 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionMacro("Dynamic casting of associate pointer failed.");
   }
 
+  if (this->m_MattesAssociate->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::Derivative)
+  {
+    // The PDFs and ratios of the first pass are kept, and the derivative is
+    // accumulated in the per-thread derivatives of the superclass.
+    this->m_MovingBSplineTransform =
+      dynamic_cast<const MovingBSplineTransformType *>(this->m_MattesAssociate->GetMovingTransform());
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -135,6 +144,13 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
   }
+  if (this->m_MattesAssociate->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::JointPDF)
+  {
+    // The ratios weight the derivative contributions of the points in the
+    // second pass.
+    this->m_MattesAssociate->m_PRatioArray.assign(
+      this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+  }
 
   if (this->m_MattesAssociate->GetComputeDerivative() && this->m_MattesAssociate->HasLocalSupport())
   {
@@ -212,6 +228,17 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMattesMutualInformationMetric>::ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId)
+{
+  this->MapPointBlock(block, this->m_MattesAssociate->GetComputeDerivative());
+  this->ProcessMappedPointBlock(block, threadId);
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 bool
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -269,6 +296,19 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
+  if (this->m_MattesAssociate->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::Derivative)
+  {
+    this->ComputeImplicitPDFDerivatives(
+      virtualPoint,
+      movingImageGradient,
+      this->m_MattesAssociate->m_PRatioArray.data() +
+        (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) + pdfMovingIndex,
+      static_cast<PDFValueType>(pdfMovingIndex) - movingImageParzenWindowTerm,
+      threadId);
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+    return false;
+  }
+
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -410,6 +450,66 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  ComputeImplicitPDFDerivatives(const VirtualPointType &        virtualPoint,
+                                const MovingImageGradientType & movingImageGradient,
+                                const PDFValueType *            pRatio,
+                                PDFValueType                    movingImageParzenWindowArg,
+                                const ThreadIdType              threadId) const
+{
+  // Sum the Parzen window derivative over the four affected bins, weighted by
+  // the ratio of each bin, so that every parameter is only visited once.
+  PDFValueType weight = 0.0;
+  for (unsigned int bin = 0; bin < 4; ++bin)
+  {
+    weight += CubicBSplineDerivativeFunctionType::FastEvaluate(movingImageParzenWindowArg) * pRatio[bin];
+    movingImageParzenWindowArg += 1.0;
+  }
+
+  auto & derivatives = this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives;
+  if (this->m_MovingBSplineTransform != nullptr)
+  {
+    // Only the parameters of the support region of the point have a non-zero
+    // Jacobian: the same interpolation weights for each dimension.
+    typename MovingBSplineTransformType::WeightsType             weights;
+    typename MovingBSplineTransformType::ParameterIndexArrayType indices;
+    this->m_MovingBSplineTransform->ComputeJacobianFromBSplineWeightsWithRespectToPosition(
+      virtualPoint, weights, indices);
+    const NumberOfParametersType numberOfParametersPerDimension =
+      this->m_MovingBSplineTransform->GetNumberOfParametersPerDimension();
+    for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+    {
+      const PDFValueType           weightedGradient = weight * movingImageGradient[dim];
+      const NumberOfParametersType dimensionOffset = dim * numberOfParametersPerDimension;
+      for (unsigned int k = 0; k < MovingBSplineTransformType::NumberOfWeights; ++k)
+      {
+        derivatives[dimensionOffset + indices[k]] -= weightedGradient * weights[k];
+      }
+    }
+  }
+  else
+  {
+    JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+    JacobianType & jacobianPositional =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+    this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+      virtualPoint, jacobian, jacobianPositional);
+    for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement; ++mu)
+    {
+      PDFValueType innerProduct = 0.0;
+      for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+      {
+        innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+      }
+      derivatives[mu] -= weight * innerProduct;
+    }
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -428,6 +528,22 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_GetValueAndDerivativePerThreadVariables[workUnitID].NumberOfValidPoints;
   }
 
+  if (this->m_MattesAssociate->m_ImplicitPDFDerivativesPass == ImplicitPDFDerivativesPass::Derivative)
+  {
+    // The value was computed in the first pass; only sum the derivatives.
+    CompensatedSummation<DerivativeValueType> sum;
+    for (NumberOfParametersType p = 0; p < this->GetCachedNumberOfParameters(); ++p)
+    {
+      sum.ResetToZero();
+      for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        sum += this->m_GetValueAndDerivativePerThreadVariables[workUnitID].CompensatedDerivatives[p].GetSum();
+      }
+      (*(this->m_MattesAssociate->m_DerivativeResult))[p] += sum.GetSum();
+    }
+    return;
+  }
+
   /* Porting: This code is from
    * MattesMutualInformationImageToImageMetric::GetValueAndDerivativeThreadPostProcess */
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
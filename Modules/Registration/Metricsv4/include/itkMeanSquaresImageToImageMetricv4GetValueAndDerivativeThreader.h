@@ -58,6 +58,7 @@ public:
   using typename Superclass::MovingImagePointType;
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
+  using typename Superclass::PointBlockType;
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
@@ -66,6 +67,11 @@ public:
 protected:
   MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
+  /** Map the whole block into the fixed and moving spaces at once, then
+   * process its valid points. */
+  void
+  ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -23,6 +23,17 @@
 namespace itk
 {
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMeanSquaresMetric>
+void
+MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMeanSquaresMetric>::ProcessVirtualPointBlock(PointBlockType & block, const ThreadIdType threadId)
+{
+  this->MapPointBlock(block, this->GetComputeDerivative());
+  this->ProcessMappedPointBlock(block, threadId);
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMeanSquaresMetric>
 bool
 MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -588,8 +588,10 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     {
       this->m_FixedTransformedPointsLocator = PointsLocatorType::New();
     }
+    // The points keep their identifiers as the transform changes, so the
+    // kd-tree of the previous iteration is refitted rather than rebuilt.
     this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
-    this->m_FixedTransformedPointsLocator->Initialize();
+    this->m_FixedTransformedPointsLocator->Refit();
     this->m_FixedTransformPointLocatorsNeedInitialization = false;
   }
 
@@ -603,8 +605,10 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     {
       this->m_MovingTransformedPointsLocator = PointsLocatorType::New();
     }
+    // The points keep their identifiers as the transform changes, so the
+    // kd-tree of the previous iteration is refitted rather than rebuilt.
     this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
-    this->m_MovingTransformedPointsLocator->Initialize();
+    this->m_MovingTransformedPointsLocator->Refit();
     this->m_MovingTransformPointLocatorsNeedInitialization = false;
   }
 }
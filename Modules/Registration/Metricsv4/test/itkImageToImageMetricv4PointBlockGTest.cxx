@@ -0,0 +1,412 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// The metrics which map the virtual points into the fixed and moving spaces by blocks:
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+
+#include "itkAffineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkImageMaskSpatialObject.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using PointType = ImageType::PointType;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+using MaskImageType = itk::Image<unsigned char, Dimension>;
+using MaskType = itk::ImageMaskSpatialObject<Dimension>;
+
+// A smooth image, shifted by the given phase. Its size is not a multiple of the size of the blocks.
+ImageType::Pointer
+MakeImage(double phase)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 21, 18, 15 } });
+  image->SetSpacing(itk::MakeVector(1.0, 1.2, 0.9));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(100.0 + 40.0 * std::sin(0.3 * index[0] + phase) * std::cos(0.2 * index[1]) +
+                              10.0 * std::sin(0.4 * index[2] - phase)));
+  }
+  return image;
+}
+
+// A mask excluding a slab of the fixed image, so that some blocks are only partly valid.
+MaskType::Pointer
+MakeMask(const ImageType * image)
+{
+  auto maskImage = MaskImageType::New();
+  maskImage->CopyInformation(image);
+  maskImage->SetRegions(image->GetLargestPossibleRegion());
+  maskImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(maskImage, maskImage->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(it.GetIndex()[1] % 7 == 3 ? 0 : 1);
+  }
+  auto mask = MaskType::New();
+  mask->SetImage(maskImage);
+  mask->Update();
+  return mask;
+}
+
+// A small rotation and translation, which maps part of the fixed image outside of the moving image.
+AffineTransformType::Pointer
+MakeAffineTransform()
+{
+  auto affine = AffineTransformType::New();
+  affine->SetCenter(itk::MakePoint(10.0, 10.0, 7.0));
+  AffineTransformType::ParametersType parameters = affine->GetParameters();
+  parameters[1] = 0.05;
+  parameters[3] = -0.05;
+  parameters[5] = 0.02;
+  parameters[9] = 1.5;
+  parameters[10] = -0.7;
+  parameters[11] = 0.3;
+  affine->SetParameters(parameters);
+  return affine;
+}
+
+CompositeTransformType::Pointer
+MakeCompositeTransform()
+{
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(MakeAffineTransform());
+  return composite;
+}
+
+std::vector<PointType>
+AllVirtualPoints(const ImageType * image)
+{
+  std::vector<PointType> points;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    points.push_back(image->TransformIndexToPhysicalPoint<double>(it.GetIndex()));
+  }
+  return points;
+}
+
+// A metric whose per-point methods, which the blocks are compared with, are accessible.
+template <typename TMetric>
+class PointwiseMetric : public TMetric
+{
+public:
+  using Self = PointwiseMetric;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  using TMetric::ComputeMovingImageGradientAtPoint;
+  using TMetric::TransformAndEvaluateFixedPoint;
+  using TMetric::TransformAndEvaluateMovingPoint;
+
+protected:
+  PointwiseMetric() = default;
+  ~PointwiseMetric() override = default;
+};
+
+// A metric which doubles the moving image gradient, as derived metrics may override how it is computed.
+template <typename TMetric>
+class DoubledGradientMetric : public TMetric
+{
+public:
+  using Self = DoubledGradientMetric;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  DoubledGradientMetric() = default;
+  ~DoubledGradientMetric() override = default;
+
+  void
+  ComputeMovingImageGradientAtPoint(const typename TMetric::MovingImagePointType & mappedPoint,
+                                    typename TMetric::MovingImageGradientType &    gradient) const override
+  {
+    TMetric::ComputeMovingImageGradientAtPoint(mappedPoint, gradient);
+    gradient *= 2.0;
+  }
+};
+
+// The fixed and moving values, and the product of the moving image gradient with the Jacobian of the moving
+// transform, at the virtual points which are valid in both spaces, evaluated one point at a time.
+struct PointwiseEvaluation
+{
+  std::vector<double>              FixedValues;
+  std::vector<double>              MovingValues;
+  std::vector<std::vector<double>> GradientTimesJacobian;
+};
+
+template <typename TMetric>
+PointwiseEvaluation
+EvaluatePointwise(const TMetric * metric, const std::vector<PointType> & virtualPoints)
+{
+  PointwiseEvaluation            evaluation;
+  typename TMetric::JacobianType jacobian;
+  const unsigned int             numberOfParameters = metric->GetNumberOfLocalParameters();
+  for (const PointType & virtualPoint : virtualPoints)
+  {
+    typename TMetric::FixedImagePointType  mappedFixedPoint;
+    typename TMetric::FixedImagePixelType  fixedValue;
+    typename TMetric::MovingImagePointType mappedMovingPoint;
+    typename TMetric::MovingImagePixelType movingValue;
+    if (!metric->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedValue) ||
+        !metric->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingValue))
+    {
+      continue;
+    }
+    typename TMetric::MovingImageGradientType gradient;
+    metric->ComputeMovingImageGradientAtPoint(mappedMovingPoint, gradient);
+    metric->GetMovingTransform()->ComputeJacobianWithRespectToParameters(virtualPoint, jacobian);
+
+    std::vector<double> gradientTimesJacobian(numberOfParameters);
+    for (unsigned int p = 0; p < numberOfParameters; ++p)
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        gradientTimesJacobian[p] += gradient[d] * jacobian(d, p);
+      }
+    }
+    evaluation.FixedValues.push_back(fixedValue);
+    evaluation.MovingValues.push_back(movingValue);
+    evaluation.GradientTimesJacobian.push_back(gradientTimesJacobian);
+  }
+  return evaluation;
+}
+
+template <typename TMetric, template <typename> class TDerivedMetric = PointwiseMetric>
+typename TDerivedMetric<TMetric>::Pointer
+MakeMetric(bool useMask, bool useGradientFilter)
+{
+  const auto fixedImage = MakeImage(0.0);
+  auto       metric = TDerivedMetric<TMetric>::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(MakeImage(0.4));
+  metric->SetMovingTransform(MakeCompositeTransform());
+  if (useMask)
+  {
+    metric->SetFixedImageMask(MakeMask(fixedImage));
+  }
+  metric->SetUseMovingImageGradientFilter(useGradientFilter);
+  metric->SetMaximumNumberOfWorkUnits(3);
+  metric->Initialize();
+  return metric;
+}
+
+void
+ExpectNearRelative(double actual, double expected)
+{
+  EXPECT_NEAR(actual, expected, 1e-9 * std::max(1.0, std::abs(expected)));
+}
+} // namespace
+
+
+TEST(ImageToImageMetricv4PointBlock, MeanSquaresMatchesPointwiseEvaluation)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+  for (const bool useMask : { false, true })
+  {
+    for (const bool useGradientFilter : { false, true })
+    {
+      const auto                metric = MakeMetric<MetricType>(useMask, useGradientFilter);
+      const PointwiseEvaluation evaluation =
+        EvaluatePointwise(metric.GetPointer(), AllVirtualPoints(metric->GetVirtualImage()));
+      const size_t numberOfValidPoints = evaluation.FixedValues.size();
+      ASSERT_GT(numberOfValidPoints, 0u);
+
+      double              expectedValue = 0.0;
+      std::vector<double> expectedDerivative(metric->GetNumberOfParameters());
+      for (size_t i = 0; i < numberOfValidPoints; ++i)
+      {
+        const double difference = evaluation.FixedValues[i] - evaluation.MovingValues[i];
+        expectedValue += difference * difference;
+        for (size_t p = 0; p < expectedDerivative.size(); ++p)
+        {
+          expectedDerivative[p] += 2.0 * difference * evaluation.GradientTimesJacobian[i][p];
+        }
+      }
+
+      MetricType::MeasureType    value;
+      MetricType::DerivativeType derivative;
+      metric->GetValueAndDerivative(value, derivative);
+      EXPECT_EQ(metric->GetNumberOfValidPoints(), numberOfValidPoints);
+      ExpectNearRelative(value, expectedValue / numberOfValidPoints);
+      for (size_t p = 0; p < expectedDerivative.size(); ++p)
+      {
+        ExpectNearRelative(derivative[p], expectedDerivative[p] / numberOfValidPoints);
+      }
+    }
+  }
+}
+
+
+TEST(ImageToImageMetricv4PointBlock, MeanSquaresWithSampledPointSetMatchesPointwiseEvaluation)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+  const auto metric = MakeMetric<MetricType>(true, true);
+
+  // Every 11th virtual point, which is two full blocks and a partial one.
+  const std::vector<PointType> allPoints = AllVirtualPoints(metric->GetVirtualImage());
+  std::vector<PointType>       sampledPoints;
+  auto                         pointSet = MetricType::FixedSampledPointSetType::New();
+  for (size_t i = 0; i < allPoints.size(); i += 11)
+  {
+    // The point set stores its coordinates in single precision.
+    pointSet->SetPoint(sampledPoints.size(), allPoints[i]);
+    sampledPoints.push_back(pointSet->GetPoint(sampledPoints.size()));
+  }
+  metric->SetFixedSampledPointSet(pointSet);
+  metric->SetUseSampledPointSet(true);
+  metric->Initialize();
+
+  const PointwiseEvaluation evaluation = EvaluatePointwise(metric.GetPointer(), sampledPoints);
+  const size_t              numberOfValidPoints = evaluation.FixedValues.size();
+  ASSERT_GT(numberOfValidPoints, 0u);
+  double expectedValue = 0.0;
+  for (size_t i = 0; i < numberOfValidPoints; ++i)
+  {
+    const double difference = evaluation.FixedValues[i] - evaluation.MovingValues[i];
+    expectedValue += difference * difference;
+  }
+
+  ExpectNearRelative(metric->GetValue(), expectedValue / numberOfValidPoints);
+  EXPECT_EQ(metric->GetNumberOfValidPoints(), numberOfValidPoints);
+}
+
+
+TEST(ImageToImageMetricv4PointBlock, CorrelationMatchesPointwiseEvaluation)
+{
+  using MetricType = itk::CorrelationImageToImageMetricv4<ImageType, ImageType>;
+
+  for (const bool useMask : { false, true })
+  {
+    const auto                metric = MakeMetric<MetricType>(useMask, true);
+    const PointwiseEvaluation evaluation =
+      EvaluatePointwise(metric.GetPointer(), AllVirtualPoints(metric->GetVirtualImage()));
+    const size_t numberOfValidPoints = evaluation.FixedValues.size();
+    ASSERT_GT(numberOfValidPoints, 0u);
+
+    double fixedMean = 0.0;
+    double movingMean = 0.0;
+    for (size_t i = 0; i < numberOfValidPoints; ++i)
+    {
+      fixedMean += evaluation.FixedValues[i];
+      movingMean += evaluation.MovingValues[i];
+    }
+    fixedMean /= numberOfValidPoints;
+    movingMean /= numberOfValidPoints;
+
+    double              fm = 0.0;
+    double              f2 = 0.0;
+    double              m2 = 0.0;
+    std::vector<double> fdm(metric->GetNumberOfParameters());
+    std::vector<double> mdm(metric->GetNumberOfParameters());
+    for (size_t i = 0; i < numberOfValidPoints; ++i)
+    {
+      const double f = evaluation.FixedValues[i] - fixedMean;
+      const double m = evaluation.MovingValues[i] - movingMean;
+      fm += f * m;
+      f2 += f * f;
+      m2 += m * m;
+      for (size_t p = 0; p < fdm.size(); ++p)
+      {
+        fdm[p] += f * evaluation.GradientTimesJacobian[i][p];
+        mdm[p] += m * evaluation.GradientTimesJacobian[i][p];
+      }
+    }
+
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+    EXPECT_EQ(metric->GetNumberOfValidPoints(), numberOfValidPoints);
+    ExpectNearRelative(value, -fm * fm / (f2 * m2));
+    for (size_t p = 0; p < fdm.size(); ++p)
+    {
+      ExpectNearRelative(derivative[p], 2.0 * fm / (f2 * m2) * (fdm[p] - fm / m2 * mdm[p]));
+    }
+  }
+}
+
+
+TEST(ImageToImageMetricv4PointBlock, MattesDoesNotDependOnCompositeTransform)
+{
+  using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  const auto composite = MakeMetric<MetricType>(true, true);
+  const auto affine = MakeMetric<MetricType>(true, true);
+  affine->SetMovingTransform(MakeAffineTransform());
+  affine->Initialize();
+
+  MetricType::MeasureType    compositeValue;
+  MetricType::DerivativeType compositeDerivative;
+  composite->GetValueAndDerivative(compositeValue, compositeDerivative);
+  MetricType::MeasureType    affineValue;
+  MetricType::DerivativeType affineDerivative;
+  affine->GetValueAndDerivative(affineValue, affineDerivative);
+
+  const PointwiseEvaluation evaluation =
+    EvaluatePointwise(composite.GetPointer(), AllVirtualPoints(composite->GetVirtualImage()));
+  EXPECT_EQ(composite->GetNumberOfValidPoints(), evaluation.FixedValues.size());
+  EXPECT_EQ(affine->GetNumberOfValidPoints(), evaluation.FixedValues.size());
+  EXPECT_LT(compositeValue, 0.0);
+  ExpectNearRelative(affineValue, compositeValue);
+  ASSERT_EQ(affineDerivative.size(), compositeDerivative.size());
+  for (unsigned int p = 0; p < compositeDerivative.size(); ++p)
+  {
+    ExpectNearRelative(affineDerivative[p], compositeDerivative[p]);
+  }
+}
+
+
+TEST(ImageToImageMetricv4PointBlock, MeanSquaresCallsOverriddenImageGradient)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+  for (const bool useGradientFilter : { false, true })
+  {
+    const auto metric = MakeMetric<MetricType>(true, useGradientFilter);
+    const auto doubledGradientMetric = MakeMetric<MetricType, DoubledGradientMetric>(true, useGradientFilter);
+
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+    MetricType::MeasureType    doubledGradientValue;
+    MetricType::DerivativeType doubledGradientDerivative;
+    doubledGradientMetric->GetValueAndDerivative(doubledGradientValue, doubledGradientDerivative);
+
+    ExpectNearRelative(doubledGradientValue, value);
+    ASSERT_EQ(doubledGradientDerivative.size(), derivative.size());
+    for (unsigned int p = 0; p < derivative.size(); ++p)
+    {
+      ExpectNearRelative(doubledGradientDerivative[p], 2.0 * derivative[p]);
+    }
+  }
+}
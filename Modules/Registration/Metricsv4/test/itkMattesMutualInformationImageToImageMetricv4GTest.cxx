@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+ImageType::Pointer
+MakeImage(double phase)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 47, 39 } });
+  image->SetSpacing(itk::MakeVector(1.0, 1.3));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(100.0 + 60.0 * std::sin(0.21 * index[0] + phase) * std::cos(0.17 * index[1]) +
+                              15.0 * std::cos(0.05 * index[0] * index[1])));
+  }
+  return image;
+}
+
+AffineTransformType::Pointer
+MakeAffineTransform()
+{
+  auto affine = AffineTransformType::New();
+  affine->SetCenter(itk::MakePoint(23.0, 25.0));
+  AffineTransformType::ParametersType parameters = affine->GetParameters();
+  parameters[0] = 1.02;
+  parameters[1] = 0.04;
+  parameters[2] = -0.03;
+  parameters[3] = 0.97;
+  parameters[4] = 1.3;
+  parameters[5] = -0.8;
+  affine->SetParameters(parameters);
+  return affine;
+}
+
+BSplineTransformType::Pointer
+MakeBSplineTransform(const ImageType * image)
+{
+  auto bspline = BSplineTransformType::New();
+  bspline->SetTransformDomainOrigin(image->GetOrigin());
+  bspline->SetTransformDomainDirection(image->GetDirection());
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    physicalDimensions[d] = image->GetSpacing()[d] * (image->GetLargestPossibleRegion().GetSize()[d] - 1);
+  }
+  bspline->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  bspline->SetTransformDomainMeshSize(BSplineTransformType::MeshSizeType::Filled(5));
+
+  BSplineTransformType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int p = 0; p < parameters.size(); ++p)
+  {
+    parameters[p] = 0.8 * std::sin(0.7 * p);
+  }
+  bspline->SetParameters(parameters);
+  return bspline;
+}
+
+MetricType::Pointer
+MakeMetric(MetricType::MovingTransformType * transform, bool useExplicitPDFDerivatives, itk::ThreadIdType workUnits)
+{
+  auto metric = MetricType::New();
+  metric->SetFixedImage(MakeImage(0.0));
+  metric->SetMovingImage(MakeImage(0.5));
+  metric->SetMovingTransform(transform);
+  metric->SetNumberOfHistogramBins(24);
+  metric->SetUseExplicitPDFDerivatives(useExplicitPDFDerivatives);
+  metric->SetMaximumNumberOfWorkUnits(workUnits);
+  metric->Initialize();
+  return metric;
+}
+
+void
+ExpectSameValueAndDerivative(MetricType::MovingTransformType * transform, itk::ThreadIdType implicitWorkUnits)
+{
+  MetricType::MeasureType    explicitValue;
+  MetricType::DerivativeType explicitDerivative;
+  const auto                 explicitMetric = MakeMetric(transform, true, 3);
+  explicitMetric->GetValueAndDerivative(explicitValue, explicitDerivative);
+  ASSERT_NE(explicitMetric->GetJointPDFDerivatives(), nullptr);
+
+  MetricType::MeasureType    implicitValue;
+  MetricType::DerivativeType implicitDerivative;
+  const auto                 implicitMetric = MakeMetric(transform, false, implicitWorkUnits);
+  implicitMetric->GetValueAndDerivative(implicitValue, implicitDerivative);
+  EXPECT_EQ(implicitMetric->GetJointPDFDerivatives(), nullptr);
+
+  EXPECT_EQ(implicitMetric->GetNumberOfValidPoints(), explicitMetric->GetNumberOfValidPoints());
+  EXPECT_NEAR(implicitValue, explicitValue, 1e-12 * std::abs(explicitValue));
+  EXPECT_NEAR(implicitMetric->GetValue(), explicitValue, 1e-12 * std::abs(explicitValue));
+
+  ASSERT_EQ(implicitDerivative.size(), explicitDerivative.size());
+  const double scale = explicitDerivative.inf_norm();
+  ASSERT_GT(scale, 0.0);
+  for (unsigned int p = 0; p < explicitDerivative.size(); ++p)
+  {
+    EXPECT_NEAR(implicitDerivative[p], explicitDerivative[p], 1e-9 * scale) << "parameter " << p;
+  }
+}
+} // namespace
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ImplicitPDFDerivativesMatchExplicitForAffineTransform)
+{
+  ExpectSameValueAndDerivative(MakeAffineTransform(), 3);
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ImplicitPDFDerivativesMatchExplicitForBSplineTransform)
+{
+  ExpectSameValueAndDerivative(MakeBSplineTransform(MakeImage(0.0)), 3);
+  ExpectSameValueAndDerivative(MakeBSplineTransform(MakeImage(0.0)), 1);
+  ExpectSameValueAndDerivative(MakeBSplineTransform(MakeImage(0.0)), 8);
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, JointPDFDoesNotDependOnNumberOfWorkUnits)
+{
+  const auto transform = MakeAffineTransform();
+  const auto serial = MakeMetric(transform, true, 1);
+  serial->GetValue();
+  for (const itk::ThreadIdType workUnits : { 2, 5, 16 })
+  {
+    const auto parallel = MakeMetric(transform, true, workUnits);
+    parallel->GetValue();
+    const MetricType::JointPDFType * serialPDF = serial->GetJointPDF();
+    const MetricType::JointPDFType * parallelPDF = parallel->GetJointPDF();
+    const size_t                     numberOfBins = serialPDF->GetBufferedRegion().GetNumberOfPixels();
+    for (size_t i = 0; i < numberOfBins; ++i)
+    {
+      EXPECT_NEAR(parallelPDF->GetBufferPointer()[i], serialPDF->GetBufferPointer()[i], 1e-12)
+        << "bin " << i << " with " << workUnits << " work units";
+    }
+  }
+}
@@ -28,6 +28,7 @@
 #include "itkImageToImageMetricv4.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
+#include "itkImageRegistrationPyramidCache.h"
 #include "itkIdentityTransform.h"
 #include "itkTransformParametersAdaptorBase.h"
 #include "ITKRegistrationMethodsv4Export.h"
@@ -47,12 +48,25 @@ public:
    * \class MetricSamplingStrategy
    * \ingroup ITKRegistrationMethodsv4
    * \brief enum type for metric sampling strategy
+   *
+   * REGULAR takes every n-th voxel of the virtual domain and RANDOM a random
+   * subset of its voxels, both jittered within the voxel. STRATIFIED splits
+   * the virtual domain into cells of about 1 / percentage voxels and draws
+   * one uniform point in each cell. HALTON takes the points of a randomly
+   * shifted Halton sequence, which cover the domain more evenly than
+   * independent random points. GRADIENT_WEIGHTED draws voxels with a
+   * probability proportional to the gradient magnitude of the fixed image
+   * plus its mean, so that edges are sampled more densely while homogeneous
+   * regions keep some samples.
    */
   enum class MetricSamplingStrategy : uint8_t
   {
     NONE,
     REGULAR,
-    RANDOM
+    RANDOM,
+    STRATIFIED,
+    HALTON,
+    GRADIENT_WEIGHTED
   };
 };
 // Define how to print enumeration
@@ -182,6 +196,9 @@ public:
   using MovingImageMaskConstPointer = typename MovingImageMaskType::ConstPointer;
   using MovingImageMasksContainerType = std::vector<MovingImageMaskConstPointer>;
 
+  using PyramidCacheType = ImageRegistrationPyramidCache<FixedImageType, MovingImageType>;
+  using PyramidCachePointer = typename PyramidCacheType::Pointer;
+
   /**
    * Type for the output: Using Decorator pattern for enabling the transform to be
    * passed in the data pipeline
@@ -460,6 +477,19 @@ public:
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
   /** @ITKEndGrouping */
 
+  /**
+   * Set/Get a cache of the smoothed images and image gradients of each level.
+   * Registration methods that share a cache, such as the successive stages of
+   * a registration, or the registrations of several moving images to the same
+   * fixed image, smooth each image and compute its gradient image only once.
+   * The gradient images are reused when the image metrics use their gradient
+   * filters. By default, no cache is used.
+   */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(PyramidCache, PyramidCacheType);
+  itkGetModifiableObjectMacro(PyramidCache, PyramidCacheType);
+  /** @ITKEndGrouping */
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -593,6 +623,7 @@ protected:
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel{};
   SmoothingSigmasArrayType                            m_SmoothingSigmasPerLevel{};
   bool                                                m_SmoothingSigmasAreSpecifiedInPhysicalUnits{};
+  PyramidCachePointer                                 m_PyramidCache{};
 
   bool m_ReseedIterator{};
   int  m_RandomSeed{};
@@ -609,6 +640,29 @@ protected:
 
 
 private:
+  /** Returns the image metrics, that is the metric or the image metrics of the multi-metric. */
+  std::vector<ImageMetricType *>
+  GetImageMetrics() const;
+
+  /** Passes the gradient images that the pyramid cache holds for the current
+   * images to the image metrics, and stores the gradient images that the
+   * initialized image metrics computed in the pyramid cache. */
+  /** @ITKStartGrouping */
+  void
+  SetPrecomputedImageGradientsFromPyramidCache() const;
+  void
+  AddImageGradientsToPyramidCache() const;
+  /** @ITKEndGrouping */
+
+  /** Describes an image gradient filter to the pyramid cache: the name of its
+   * class, and the parameters of a GradientRecursiveGaussianImageFilter, the
+   * default gradient filter of the metrics. Other filters are described by
+   * their address and modification time, so that only the same, unmodified
+   * filter gets their gradient images. */
+  template <typename TGaussianGradientFilter, typename TGradientFilter>
+  static std::string
+  GetGradientFilterDescription(const TGradientFilter * gradientFilter);
+
   bool m_InPlace{};
 
   bool m_InitializeCenterOfLinearOutputTransform{};
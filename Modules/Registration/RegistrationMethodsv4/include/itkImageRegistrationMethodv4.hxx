@@ -20,16 +20,23 @@
 
 
 #include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "itkGradientDescentOptimizerv4.h"
 #include "itkImageRandomConstIteratorWithIndex.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageToImageMetricv4.h"
+#include "itkIndexRange.h"
 #include "itkIterationReporter.h"
 #include "itkMattesMutualInformationImageToImageMetricv4.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkRegistrationParameterScalesFromPhysicalShift.h"
 #include "itkPrintHelper.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
 namespace itk
 {
 
@@ -588,7 +595,26 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
          multiMetric->GetMetricQueue()[n]->GetMetricCategory() ==
            ObjectToObjectMetricBaseTemplateEnums::MetricCategory::IMAGE_METRIC))
     {
-      if (this->m_SmoothingSigmasPerLevel[level] > 0)
+      if (this->m_PyramidCache)
+      {
+        typename PyramidCacheType::SigmaArrayType fixedImageSigmaArray;
+        typename PyramidCacheType::SigmaArrayType movingImageSigmaArray;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          fixedImageSigmaArray[i] = std::max(static_cast<double>(this->m_SmoothingSigmasPerLevel[level]), 0.0);
+          movingImageSigmaArray[i] = fixedImageSigmaArray[i];
+          if (!this->m_SmoothingSigmasAreSpecifiedInPhysicalUnits)
+          {
+            fixedImageSigmaArray[i] *= this->GetFixedImage(n)->GetSpacing()[i];
+            movingImageSigmaArray[i] *= this->GetMovingImage(n)->GetSpacing()[i];
+          }
+        }
+        this->m_FixedSmoothImages[n] =
+          this->m_PyramidCache->GetSmoothedFixedImage(this->GetFixedImage(n), fixedImageSigmaArray);
+        this->m_MovingSmoothImages[n] =
+          this->m_PyramidCache->GetSmoothedMovingImage(this->GetMovingImage(n), movingImageSigmaArray);
+      }
+      else if (this->m_SmoothingSigmasPerLevel[level] > 0)
       {
         using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
         auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
@@ -696,6 +722,11 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
     }
   }
 
+  if (this->m_PyramidCache)
+  {
+    this->SetPrecomputedImageGradientsFromPyramidCache();
+  }
+
   if (this->m_MetricSamplingStrategy != MetricSamplingStrategyEnum::NONE)
   {
     this->SetMetricSamplePoints();
@@ -799,10 +830,134 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
     this->m_Metric->Initialize();
 
+    if (this->m_PyramidCache)
+    {
+      this->AddImageGradientsToPyramidCache();
+    }
+
     this->m_Optimizer->StartOptimization();
   }
 }
 
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+auto
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::GetImageMetrics() const
+  -> std::vector<ImageMetricType *>
+{
+  std::vector<ImageMetricType *> imageMetrics;
+  if (this->m_Metric->GetMetricCategory() == ObjectToObjectMetricBaseTemplateEnums::MetricCategory::MULTI_METRIC)
+  {
+    for (const auto & metric : dynamic_cast<MultiMetricType *>(this->m_Metric.GetPointer())->GetMetricQueue())
+    {
+      if (auto * const imageMetric = dynamic_cast<ImageMetricType *>(metric.GetPointer()))
+      {
+        imageMetrics.push_back(imageMetric);
+      }
+    }
+  }
+  else if (auto * const imageMetric = dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer()))
+  {
+    imageMetrics.push_back(imageMetric);
+  }
+  return imageMetrics;
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+void
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
+  SetPrecomputedImageGradientsFromPyramidCache() const
+{
+  using FixedImageGradientImageType = typename ImageMetricType::FixedImageGradientImageType;
+  using MovingImageGradientImageType = typename ImageMetricType::MovingImageGradientImageType;
+
+  for (auto * const imageMetric : this->GetImageMetrics())
+  {
+    // The default gradient filters get their parameters from the images, so
+    // they are initialized before they are described to the pyramid cache.
+    if (imageMetric->GetFixedImageGradientFilter() && imageMetric->GetFixedImage())
+    {
+      imageMetric->InitializeDefaultFixedImageGradientFilter();
+      imageMetric->SetPrecomputedFixedImageGradientImage(
+        imageMetric->GetFixedImage(),
+        this->m_PyramidCache->template GetGradientImage<FixedImageGradientImageType>(
+          imageMetric->GetFixedImage(),
+          GetGradientFilterDescription<typename ImageMetricType::DefaultFixedImageGradientFilter>(
+            imageMetric->GetFixedImageGradientFilter())));
+    }
+    if (imageMetric->GetMovingImageGradientFilter() && imageMetric->GetMovingImage())
+    {
+      imageMetric->InitializeDefaultMovingImageGradientFilter();
+      imageMetric->SetPrecomputedMovingImageGradientImage(
+        imageMetric->GetMovingImage(),
+        this->m_PyramidCache->template GetGradientImage<MovingImageGradientImageType>(
+          imageMetric->GetMovingImage(),
+          GetGradientFilterDescription<typename ImageMetricType::DefaultMovingImageGradientFilter>(
+            imageMetric->GetMovingImageGradientFilter())));
+    }
+  }
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+void
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
+  AddImageGradientsToPyramidCache() const
+{
+  for (auto * const imageMetric : this->GetImageMetrics())
+  {
+    // The gradient filters overwrite their outputs at the next level, so the
+    // outputs which are cached are disconnected from them.
+    if (imageMetric->GetUseFixedImageGradientFilter() && imageMetric->GetGradientSourceIncludesFixed() &&
+        imageMetric->GetFixedImageGradientImage() && imageMetric->GetFixedImageGradientFilter())
+    {
+      if (imageMetric->GetFixedImageGradientFilter()->GetOutput() == imageMetric->GetFixedImageGradientImage())
+      {
+        imageMetric->GetFixedImageGradientFilter()->GetOutput()->DisconnectPipeline();
+      }
+      this->m_PyramidCache->AddGradientImage(
+        imageMetric->GetFixedImage(),
+        GetGradientFilterDescription<typename ImageMetricType::DefaultFixedImageGradientFilter>(
+          imageMetric->GetFixedImageGradientFilter()),
+        imageMetric->GetFixedImageGradientImage());
+    }
+    if (imageMetric->GetUseMovingImageGradientFilter() && imageMetric->GetGradientSourceIncludesMoving() &&
+        imageMetric->GetMovingImageGradientImage() && imageMetric->GetMovingImageGradientFilter())
+    {
+      if (imageMetric->GetMovingImageGradientFilter()->GetOutput() == imageMetric->GetMovingImageGradientImage())
+      {
+        imageMetric->GetMovingImageGradientFilter()->GetOutput()->DisconnectPipeline();
+      }
+      this->m_PyramidCache->AddGradientImage(
+        imageMetric->GetMovingImage(),
+        GetGradientFilterDescription<typename ImageMetricType::DefaultMovingImageGradientFilter>(
+          imageMetric->GetMovingImageGradientFilter()),
+        imageMetric->GetMovingImageGradientImage());
+    }
+  }
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+template <typename TGaussianGradientFilter, typename TGradientFilter>
+std::string
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
+  GetGradientFilterDescription(const TGradientFilter * gradientFilter)
+{
+  std::ostringstream description;
+  description.precision(std::numeric_limits<double>::max_digits10);
+  description << gradientFilter->GetNameOfClass();
+  if (const auto * const gaussianFilter = dynamic_cast<const TGaussianGradientFilter *>(gradientFilter))
+  {
+    description << " Sigma: " << gaussianFilter->GetSigmaArray()
+                << " NormalizeAcrossScale: " << gaussianFilter->GetNormalizeAcrossScale()
+                << " UseImageDirection: " << gaussianFilter->GetUseImageDirection();
+  }
+  else
+  {
+    description << " Filter: " << static_cast<const void *>(gradientFilter)
+                << " MTime: " << gradientFilter->GetMTime();
+  }
+  return description.str();
+}
+
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
 void
 ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
@@ -915,9 +1070,28 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   const VirtualDomainRegionType &                    virtualDomainRegion = virtualImage->GetRequestedRegion();
   const typename VirtualDomainImageType::SpacingType oneThirdVirtualSpacing = virtualImage->GetSpacing() / 3.0;
+  const RealType samplingPercentage = this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel];
+
+  using VirtualContinuousIndexType = ContinuousIndex<typename VirtualDomainImageType::PointValueType, ImageDimension>;
+
+  // The continuous index of a point at the given fraction of the extent of
+  // the virtual domain along each dimension, the voxels spanning
+  // [index - 0.5, index + 0.5].
+  const auto continuousIndexAtFraction = [&virtualDomainRegion](const FixedArray<double, ImageDimension> & fraction) {
+    VirtualContinuousIndexType continuousIndex;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      continuousIndex[d] =
+        virtualDomainRegion.GetIndex(d) - 0.5 + fraction[d] * static_cast<double>(virtualDomainRegion.GetSize(d));
+    }
+    return continuousIndex;
+  };
 
   for (SizeValueType n = 0; n < numberOfLocalMetrics; ++n)
   {
+    auto * const imageMetric = dynamic_cast<ImageMetricType *>(
+      multiMetric ? multiMetric->GetMetricQueue()[n].GetPointer() : this->m_Metric.GetPointer());
+
     auto samplePointSet = MetricSamplePointSetType::New();
 
     using SamplePointType = typename MetricSamplePointSetType::PointType;
@@ -933,15 +1107,22 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       randomizer->SetSeed(m_CurrentRandomSeed++);
     }
 
-
     unsigned long index = 0;
 
+    // Add the point if it is inside the fixed image mask.
+    const auto addSamplePoint = [&samplePointSet, &index, fixedMaskImage](const SamplePointType & point) {
+      if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+      {
+        samplePointSet->SetPoint(index, point);
+        ++index;
+      }
+    };
+
     switch (this->m_MetricSamplingStrategy)
     {
       case MetricSamplingStrategyEnum::REGULAR:
       {
-        const auto sampleCount =
-          static_cast<unsigned long>(std::ceil(1.0 / this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]));
+        const auto    sampleCount = static_cast<unsigned long>(std::ceil(1.0 / samplingPercentage));
         unsigned long count =
           sampleCount; // Start at sampleCount to keep behavior backwards identical, using first element.
         ImageRegionConstIteratorWithIndex<VirtualDomainImageType> It(virtualImage, virtualDomainRegion);
@@ -958,11 +1139,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             {
               point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
             }
-            if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
-            {
-              samplePointSet->SetPoint(index, point);
-              ++index;
-            }
+            addSamplePoint(point);
           }
           ++count;
         }
@@ -972,8 +1149,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       {
         const unsigned long totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
         const auto          sampleCount =
-          static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) *
-                                     this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]);
+          static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) * samplingPercentage);
         ImageRandomConstIteratorWithIndex<VirtualDomainImageType> ItR(virtualImage, virtualDomainRegion);
         if (m_ReseedIterator)
         {
@@ -994,10 +1170,175 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
           {
             point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
           }
-          if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+          addSamplePoint(point);
+        }
+        break;
+      }
+      case MetricSamplingStrategyEnum::STRATIFIED:
+      {
+        // Cells of cellWidth^ImageDimension voxels, each holding one point.
+        // The points of the cells which overhang the far end of the domain
+        // are dropped when they fall outside, which keeps the density uniform.
+        const double cellWidth = std::pow(1.0 / samplingPercentage, 1.0 / ImageDimension);
+        ImageRegion<ImageDimension> cellRegion;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          cellRegion.SetSize(
+            d, static_cast<SizeValueType>(std::ceil(static_cast<double>(virtualDomainRegion.GetSize(d)) / cellWidth)));
+        }
+        for (const auto & cellIndex : ImageRegionIndexRange<ImageDimension>(cellRegion))
+        {
+          FixedArray<double, ImageDimension> fraction;
+          bool                               isInside = true;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            fraction[d] = (cellIndex[d] + randomizer->GetUniformVariate(0.0, 1.0)) * cellWidth /
+                          static_cast<double>(virtualDomainRegion.GetSize(d));
+            isInside = isInside && fraction[d] < 1.0;
+          }
+          if (isInside)
+          {
+            SamplePointType point;
+            virtualImage->TransformContinuousIndexToPhysicalPoint(continuousIndexAtFraction(fraction), point);
+            addSamplePoint(point);
+          }
+        }
+        break;
+      }
+      case MetricSamplingStrategyEnum::HALTON:
+      {
+        // The Halton sequence uses the radical inverse of the sample number
+        // in the d-th prime base along dimension d. A random shift, modulo 1,
+        // gives a different, equally even, point set for every seed.
+        static constexpr unsigned int primes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+        static_assert(ImageDimension <= std::size(primes), "No Halton base for this image dimension.");
+        const auto radicalInverse = [](SizeValueType number, unsigned int base) {
+          double result = 0.0;
+          double digitWeight = 1.0 / base;
+          for (; number > 0; number /= base)
+          {
+            result += (number % base) * digitWeight;
+            digitWeight /= base;
+          }
+          return result;
+        };
+
+        FixedArray<double, ImageDimension> shift;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          shift[d] = randomizer->GetUniformVariate(0.0, 1.0);
+        }
+        const auto sampleCount = static_cast<SizeValueType>(
+          static_cast<double>(virtualDomainRegion.GetNumberOfPixels()) * samplingPercentage);
+        for (SizeValueType i = 1; i <= sampleCount; ++i)
+        {
+          FixedArray<double, ImageDimension> fraction;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
           {
-            samplePointSet->SetPoint(index, point);
-            ++index;
+            fraction[d] = radicalInverse(i, primes[d]) + shift[d];
+            fraction[d] -= std::floor(fraction[d]);
+          }
+          SamplePointType point;
+          virtualImage->TransformContinuousIndexToPhysicalPoint(continuousIndexAtFraction(fraction), point);
+          addSamplePoint(point);
+        }
+        break;
+      }
+      case MetricSamplingStrategyEnum::GRADIENT_WEIGHTED:
+      {
+        if (imageMetric == nullptr || imageMetric->GetFixedImage() == nullptr)
+        {
+          itkExceptionMacro("Gradient weighted sampling requires the fixed image of the metric.");
+        }
+        const auto * const fixedImage = imageMetric->GetFixedImage();
+        const auto * const fixedTransform = imageMetric->GetFixedTransform();
+        const auto &       fixedRegion = fixedImage->GetBufferedRegion();
+        using FixedPixelTraits = DefaultConvertPixelTraits<typename FixedImageType::PixelType>;
+
+        // The central difference gradient magnitude of the fixed image at the
+        // voxel which each virtual voxel maps to, or zero outside of the
+        // fixed image.
+        std::vector<double> weights;
+        weights.reserve(virtualDomainRegion.GetNumberOfPixels());
+        double weightSum = 0.0;
+        for (const auto & virtualIndex : ImageRegionIndexRange<ImageDimension>(virtualDomainRegion))
+        {
+          typename FixedImageType::PointType virtualPoint;
+          virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
+          const typename FixedImageType::IndexType fixedIndex =
+            fixedImage->TransformPhysicalPointToIndex(fixedTransform->TransformPoint(virtualPoint));
+          if (!fixedRegion.IsInside(fixedIndex))
+          {
+            weights.push_back(0.0);
+            continue;
+          }
+          double squaredGradientMagnitude = 0.0;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            typename FixedImageType::IndexType lower = fixedIndex;
+            typename FixedImageType::IndexType upper = fixedIndex;
+            lower[d] = std::max(lower[d] - 1, fixedRegion.GetIndex(d));
+            upper[d] = std::min(upper[d] + 1, fixedRegion.GetUpperIndex()[d]);
+            if (upper[d] == lower[d])
+            {
+              continue;
+            }
+            const auto & upperValue = fixedImage->GetPixel(upper);
+            const auto & lowerValue = fixedImage->GetPixel(lower);
+            const double distance = (upper[d] - lower[d]) * fixedImage->GetSpacing()[d];
+            for (unsigned int c = 0; c < FixedPixelTraits::GetNumberOfComponents(upperValue); ++c)
+            {
+              const double difference = (static_cast<double>(FixedPixelTraits::GetNthComponent(c, upperValue)) -
+                                         static_cast<double>(FixedPixelTraits::GetNthComponent(c, lowerValue))) /
+                                        distance;
+              squaredGradientMagnitude += difference * difference;
+            }
+          }
+          // Mark the voxel as inside, whatever its gradient.
+          weights.push_back(std::sqrt(squaredGradientMagnitude) + NumericTraits<double>::min());
+          weightSum += weights.back();
+        }
+
+        // Add the mean gradient magnitude to the voxels inside the fixed image.
+        const auto numberOfInsideVoxels = static_cast<double>(
+          std::count_if(weights.cbegin(), weights.cend(), [](const double weight) { return weight > 0.0; }));
+        if (numberOfInsideVoxels == 0.0)
+        {
+          break;
+        }
+        const double meanWeight = weightSum / numberOfInsideVoxels;
+        for (double & weight : weights)
+        {
+          weight += weight > 0.0 ? meanWeight : 0.0;
+        }
+        weightSum *= 2.0;
+
+        // Systematic sampling: one point at every step of the cumulative
+        // weight, starting at a random offset within the first step.
+        const auto sampleCount = static_cast<SizeValueType>(
+          static_cast<double>(virtualDomainRegion.GetNumberOfPixels()) * samplingPercentage);
+        if (sampleCount == 0)
+        {
+          break;
+        }
+        const double step = weightSum / sampleCount;
+        double       nextSample = randomizer->GetUniformVariate(0.0, step);
+        double       cumulativeWeight = 0.0;
+        auto         weightIt = weights.cbegin();
+        for (const auto & virtualIndex : ImageRegionIndexRange<ImageDimension>(virtualDomainRegion))
+        {
+          cumulativeWeight += *(weightIt++);
+          for (; nextSample < cumulativeWeight; nextSample += step)
+          {
+            SamplePointType point;
+            virtualImage->TransformIndexToPhysicalPoint(virtualIndex, point);
+
+            // randomly perturb the point within a voxel (approximately)
+            for (unsigned int d = 0; d < ImageDimension; ++d)
+            {
+              point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
+            }
+            addSamplePoint(point);
           }
         }
         break;
@@ -1008,19 +1349,9 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       }
     }
 
-    if (multiMetric)
-    {
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())
-        ->SetVirtualSampledPointSet(samplePointSet);
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())->UseSampledPointSetOn();
-      dynamic_cast<ImageMetricType *>(multiMetric->GetMetricQueue()[n].GetPointer())->UseVirtualSampledPointSetOn();
-    }
-    else
-    {
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->SetVirtualSampledPointSet(samplePointSet);
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->UseSampledPointSetOn();
-      dynamic_cast<ImageMetricType *>(this->m_Metric.GetPointer())->UseVirtualSampledPointSetOn();
-    }
+    imageMetric->SetVirtualSampledPointSet(samplePointSet);
+    imageMetric->UseSampledPointSetOn();
+    imageMetric->UseVirtualSampledPointSetOn();
   }
 }
 
@@ -1163,6 +1494,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   os << indent << "ShrinkFactorsPerLevel: " << m_ShrinkFactorsPerLevel << std::endl;
   os << indent << "SmoothingSigmasPerLevel: " << m_SmoothingSigmasPerLevel << std::endl;
   itkPrintSelfBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
+  itkPrintSelfObjectMacro(PyramidCache);
 
   itkPrintSelfBooleanMacro(ReseedIterator);
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
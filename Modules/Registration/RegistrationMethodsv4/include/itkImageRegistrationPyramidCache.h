@@ -0,0 +1,255 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_h
+#define itkImageRegistrationPyramidCache_h
+
+#include "itkObject.h"
+#include "itkFixedArray.h"
+#include "itkImage.h"
+#include "itkNumericTraits.h"
+
+#include <array>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+/** \class ImageRegistrationPyramidCache
+ * \brief Cache of the smoothed images and image gradients of a multi-resolution registration.
+ *
+ * ImageRegistrationMethodv4 smooths the fixed and moving images at each level
+ * of its pyramid, and its image metrics compute gradient images of these
+ * smoothed images. Successive registration methods, such as a rigid, an
+ * affine and a deformable stage, or the registrations of many subjects to the
+ * same template, repeat this work for the same images. When the methods share
+ * an ImageRegistrationPyramidCache through SetPyramidCache(), the smoothed
+ * images and gradient images are computed once and reused.
+ *
+ * The smoothed images are identified by the content of the input image, that
+ * is its pixels, region, spacing, origin and direction, together with the
+ * smoothing sigmas. An image that is read again from file, or a copy of it,
+ * therefore hits the cache. The pixels are identified by a 128-bit hash, so
+ * the cache does not keep the images the smoothed images were smoothed from.
+ * The gradient images are identified by the image they were computed from, as
+ * long as it is not modified, and a description of the gradient filter, that
+ * is the name of its class and its parameters. The gradient images do not keep
+ * the image they were computed from either.
+ *
+ * The cache keeps the images until their total size exceeds
+ * MaximumNumberOfBytes, and then removes the least recently used ones. As the
+ * cache only holds smoothed images and gradient images, this bounds its
+ * memory. By default, the size is not limited. ClearMovingImages() removes the
+ * images which are specific to the moving images, keeping the ones of the
+ * fixed image, e.g. a template which is registered to many subjects, and
+ * Clear() removes all of them.
+ *
+ * The cache may be shared by registrations that run concurrently. It is not
+ * locked while an image is smoothed, and an image which is requested while it
+ * is being smoothed by another thread is waited for rather than smoothed again.
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TFixedImage, typename TMovingImage = TFixedImage>
+class ITK_TEMPLATE_EXPORT ImageRegistrationPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegistrationPyramidCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegistrationPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegistrationPyramidCache);
+
+  /** Input image types. */
+  using FixedImageType = TFixedImage;
+  using FixedImageConstPointer = typename FixedImageType::ConstPointer;
+  using MovingImageType = TMovingImage;
+  using MovingImageConstPointer = typename MovingImageType::ConstPointer;
+
+  static constexpr unsigned int ImageDimension = FixedImageType::ImageDimension;
+
+  /** Gaussian smoothing sigmas, in physical units. */
+  using SigmaArrayType = FixedArray<double, ImageDimension>;
+
+  /** Returns the fixed image smoothed by SmoothingRecursiveGaussianImageFilter
+   * with the specified sigmas. The smoothed image is computed only if the
+   * cache does not hold it yet. When all the sigmas are zero, the image itself
+   * is returned. */
+  FixedImageConstPointer
+  GetSmoothedFixedImage(const FixedImageType * image, const SigmaArrayType & sigmas);
+
+  /** Same as GetSmoothedFixedImage(), for the moving image. */
+  MovingImageConstPointer
+  GetSmoothedMovingImage(const MovingImageType * image, const SigmaArrayType & sigmas);
+
+  /** Returns the gradient image of an image, as computed by the described
+   * filter, or nullptr when the cache does not hold it. The description
+   * identifies the class of the gradient filter and all its parameters which
+   * affect the gradient image. */
+  template <typename TGradientImage, typename TImage>
+  typename TGradientImage::Pointer
+  GetGradientImage(const TImage * image, const std::string & gradientFilterDescription) const;
+
+  /** Stores the gradient image of an image, as computed by the described
+   * filter. \sa GetGradientImage() */
+  template <typename TGradientImage, typename TImage>
+  void
+  AddGradientImage(const TImage * image, const std::string & gradientFilterDescription, TGradientImage * gradientImage);
+
+  /** Removes all the images from the cache. */
+  void
+  Clear();
+
+  /** Removes the smoothed moving images, and the gradient images of all but
+   * the smoothed fixed images and the fixed images they were smoothed from. */
+  void
+  ClearMovingImages();
+
+  /** Set/Get the total size, in bytes, of the smoothed images and gradient
+   * images above which the least recently used ones are removed. Images which
+   * are still being smoothed are not counted. Defaults to the largest value,
+   * that is, no limit. */
+  /** @ITKStartGrouping */
+  void
+  SetMaximumNumberOfBytes(SizeValueType numberOfBytes);
+  itkGetConstMacro(MaximumNumberOfBytes, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Get the total size, in bytes, of the images held by the cache. */
+  SizeValueType
+  GetNumberOfBytes() const;
+
+  /** Get the number of smoothed images that were served by the cache, and
+   * the number of smoothed images that were computed. */
+  /** @ITKStartGrouping */
+  itkGetConstMacro(NumberOfHits, SizeValueType);
+  itkGetConstMacro(NumberOfMisses, SizeValueType);
+  /** @ITKEndGrouping */
+
+protected:
+  ImageRegistrationPyramidCache() = default;
+  ~ImageRegistrationPyramidCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Identifies an input image by its content, and the sigmas of its smoothing. */
+  struct KeyType
+  {
+    std::array<uint64_t, 2> PixelHash;
+    size_t                  NumberOfPixelBytes;
+    std::vector<double>     Geometry;
+    SigmaArrayType          Sigmas;
+
+    [[nodiscard]] bool
+    operator==(const KeyType & other) const
+    {
+      return PixelHash == other.PixelHash && NumberOfPixelBytes == other.NumberOfPixelBytes &&
+             Geometry == other.Geometry && Sigmas == other.Sigmas;
+    }
+  };
+
+  /** A smoothed image, or the future one while it is being smoothed. */
+  template <typename TImage>
+  struct SmoothedEntryType
+  {
+    SizeValueType Id;
+    KeyType       Key;
+    /** The image which was smoothed. Not a smart pointer, so that the image
+     * can be released. */
+    const DataObject *                                Source;
+    std::shared_future<typename TImage::ConstPointer> SmoothedImage;
+    /** Set when the image is smoothed. */
+    const TImage * ReadySmoothedImage{ nullptr };
+    SizeValueType  NumberOfBytes{ 0 };
+    SizeValueType  LastUse;
+  };
+
+  struct GradientEntryType
+  {
+    /** Not a smart pointer, so that the image can be released. Together with
+     * its modification time, which is unique, it still identifies the image. */
+    const DataObject *  Image;
+    ModifiedTimeType    ImageMTime;
+    std::string         GradientFilterDescription;
+    DataObject::Pointer GradientImage;
+    SizeValueType       NumberOfBytes;
+    /** Updated by GetGradientImage(). */
+    mutable SizeValueType LastUse;
+  };
+
+  template <typename TImage>
+  static KeyType
+  MakeKey(const TImage * image, const SigmaArrayType & sigmas);
+
+  template <typename TImage>
+  static SizeValueType
+  GetNumberOfPixelBytes(const TImage * image);
+
+  template <typename TImage>
+  typename TImage::ConstPointer
+  GetSmoothedImage(std::vector<SmoothedEntryType<TImage>> & smoothedImages,
+                   const TImage *                           image,
+                   const SigmaArrayType &                   sigmas);
+
+  /** Removes an entry, and the gradient images of its smoothed image. To be
+   * called with m_Mutex locked. */
+  template <typename TImage>
+  void
+  RemoveSmoothedEntry(std::vector<SmoothedEntryType<TImage>> & smoothedImages, SizeValueType id);
+
+  /** Removes the least recently used images until the total size is within
+   * MaximumNumberOfBytes. To be called with m_Mutex locked. */
+  void
+  RemoveLeastRecentlyUsedImages();
+
+  std::vector<SmoothedEntryType<FixedImageType>>  m_SmoothedFixedImages{};
+  std::vector<SmoothedEntryType<MovingImageType>> m_SmoothedMovingImages{};
+  std::vector<GradientEntryType>                  m_GradientImages{};
+
+  SizeValueType m_MaximumNumberOfBytes{ NumericTraits<SizeValueType>::max() };
+  SizeValueType m_NumberOfBytes{ 0 };
+
+  /** Incremented on each use of an image, for the least recently used order
+   * and the identifiers of the entries. */
+  mutable SizeValueType m_UseCounter{ 0 };
+
+  SizeValueType m_NumberOfHits{ 0 };
+  SizeValueType m_NumberOfMisses{ 0 };
+
+  mutable std::mutex m_Mutex{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageRegistrationPyramidCache.hxx"
+#endif
+
+#endif
@@ -0,0 +1,430 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_hxx
+#define itkImageRegistrationPyramidCache_hxx
+
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+
+namespace itk
+{
+
+template <typename TFixedImage, typename TMovingImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetSmoothedFixedImage(const FixedImageType * image,
+                                                                               const SigmaArrayType & sigmas)
+  -> FixedImageConstPointer
+{
+  return this->GetSmoothedImage<FixedImageType>(this->m_SmoothedFixedImages, image, sigmas);
+}
+
+template <typename TFixedImage, typename TMovingImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetSmoothedMovingImage(const MovingImageType * image,
+                                                                                const SigmaArrayType &  sigmas)
+  -> MovingImageConstPointer
+{
+  return this->GetSmoothedImage<MovingImageType>(this->m_SmoothedMovingImages, image, sigmas);
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TGradientImage, typename TImage>
+typename TGradientImage::Pointer
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetGradientImage(
+  const TImage *      image,
+  const std::string & gradientFilterDescription) const
+{
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+  for (const auto & entry : this->m_GradientImages)
+  {
+    if (entry.Image == image && entry.ImageMTime == image->GetMTime() &&
+        entry.GradientFilterDescription == gradientFilterDescription)
+    {
+      entry.LastUse = ++this->m_UseCounter;
+      return dynamic_cast<TGradientImage *>(entry.GradientImage.GetPointer());
+    }
+  }
+  return nullptr;
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TGradientImage, typename TImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::AddGradientImage(
+  const TImage *      image,
+  const std::string & gradientFilterDescription,
+  TGradientImage *    gradientImage)
+{
+  const SizeValueType numberOfBytes = GetNumberOfPixelBytes(gradientImage);
+
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+  const auto found = std::find_if(this->m_GradientImages.begin(),
+                                  this->m_GradientImages.end(),
+                                  [image, &gradientFilterDescription](const GradientEntryType & entry) {
+                                    return entry.Image == image &&
+                                           entry.GradientFilterDescription == gradientFilterDescription;
+                                  });
+  if (found != this->m_GradientImages.end())
+  {
+    this->m_NumberOfBytes -= found->NumberOfBytes;
+    found->ImageMTime = image->GetMTime();
+    found->GradientImage = gradientImage;
+    found->NumberOfBytes = numberOfBytes;
+    found->LastUse = ++this->m_UseCounter;
+  }
+  else
+  {
+    this->m_GradientImages.push_back(
+      { image, image->GetMTime(), gradientFilterDescription, gradientImage, numberOfBytes, ++this->m_UseCounter });
+  }
+  this->m_NumberOfBytes += numberOfBytes;
+  this->RemoveLeastRecentlyUsedImages();
+}
+
+template <typename TFixedImage, typename TMovingImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::Clear()
+{
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+  // the images which are being smoothed are removed as well: their threads
+  // do not find them anymore when they are done
+  this->m_SmoothedFixedImages.clear();
+  this->m_SmoothedMovingImages.clear();
+  this->m_GradientImages.clear();
+  this->m_NumberOfBytes = 0;
+}
+
+template <typename TFixedImage, typename TMovingImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::ClearMovingImages()
+{
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+  for (const auto & entry : this->m_SmoothedMovingImages)
+  {
+    this->m_NumberOfBytes -= entry.NumberOfBytes;
+  }
+  this->m_SmoothedMovingImages.clear();
+
+  const auto isOfFixedImage = [this](const GradientEntryType & gradientEntry) {
+    return std::any_of(this->m_SmoothedFixedImages.cbegin(),
+                       this->m_SmoothedFixedImages.cend(),
+                       [&gradientEntry](const SmoothedEntryType<FixedImageType> & entry) {
+                         return gradientEntry.Image == entry.ReadySmoothedImage ||
+                                gradientEntry.Image == entry.Source;
+                       });
+  };
+  for (const auto & gradientEntry : this->m_GradientImages)
+  {
+    if (!isOfFixedImage(gradientEntry))
+    {
+      this->m_NumberOfBytes -= gradientEntry.NumberOfBytes;
+    }
+  }
+  this->m_GradientImages.erase(std::remove_if(this->m_GradientImages.begin(),
+                                              this->m_GradientImages.end(),
+                                              [&isOfFixedImage](const GradientEntryType & gradientEntry) {
+                                                return !isOfFixedImage(gradientEntry);
+                                              }),
+                               this->m_GradientImages.end());
+}
+
+template <typename TFixedImage, typename TMovingImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::SetMaximumNumberOfBytes(SizeValueType numberOfBytes)
+{
+  {
+    const std::lock_guard<std::mutex> lock(this->m_Mutex);
+    if (this->m_MaximumNumberOfBytes == numberOfBytes)
+    {
+      return;
+    }
+    this->m_MaximumNumberOfBytes = numberOfBytes;
+    this->RemoveLeastRecentlyUsedImages();
+  }
+  this->Modified();
+}
+
+template <typename TFixedImage, typename TMovingImage>
+SizeValueType
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetNumberOfBytes() const
+{
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_NumberOfBytes;
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::MakeKey(const TImage * image, const SigmaArrayType & sigmas)
+  -> KeyType
+{
+  KeyType key;
+
+  // Hash the pixel buffer word by word, with two independent 64-bit hashes.
+  // Each step of each hash is invertible, so that two buffers that differ in a
+  // single word never have the same hash. The second hash also depends on the
+  // position of the words, so that swapped words change it.
+  const auto * const bytes = reinterpret_cast<const unsigned char *>(image->GetBufferPointer());
+  key.NumberOfPixelBytes = GetNumberOfPixelBytes(image);
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  uint64_t positionHash = 0x84222325cbf29ce4ULL;
+  for (size_t i = 0; i < key.NumberOfPixelBytes; i += sizeof(uint64_t))
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + i, std::min(sizeof(uint64_t), key.NumberOfPixelBytes - i));
+    hash ^= word;
+    hash *= 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 29;
+    positionHash += word ^ (i * 0xc2b2ae3d27d4eb4fULL);
+    positionHash *= 0xff51afd7ed558ccdULL;
+    positionHash ^= positionHash >> 33;
+  }
+  key.PixelHash = { { hash, positionHash } };
+
+  const auto & largestRegion = image->GetLargestPossibleRegion();
+  const auto & bufferedRegion = image->GetBufferedRegion();
+  key.Geometry.push_back(image->GetNumberOfComponentsPerPixel());
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    key.Geometry.push_back(largestRegion.GetIndex(d));
+    key.Geometry.push_back(largestRegion.GetSize(d));
+    key.Geometry.push_back(bufferedRegion.GetIndex(d));
+    key.Geometry.push_back(bufferedRegion.GetSize(d));
+    key.Geometry.push_back(image->GetSpacing()[d]);
+    key.Geometry.push_back(image->GetOrigin()[d]);
+    for (unsigned int e = 0; e < ImageDimension; ++e)
+    {
+      key.Geometry.push_back(image->GetDirection()[d][e]);
+    }
+  }
+
+  key.Sigmas = sigmas;
+  return key;
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TImage>
+SizeValueType
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetNumberOfPixelBytes(const TImage * image)
+{
+  return image->GetPixelContainer()->Size() * sizeof(typename TImage::InternalPixelType);
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TImage>
+typename TImage::ConstPointer
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::GetSmoothedImage(
+  std::vector<SmoothedEntryType<TImage>> & smoothedImages,
+  const TImage *                           image,
+  const SigmaArrayType &                   sigmas)
+{
+  using ImageConstPointer = typename TImage::ConstPointer;
+
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The image to smooth is not set.");
+  }
+  if (sigmas == SigmaArrayType::Filled(0.0))
+  {
+    return image;
+  }
+
+  const KeyType key = MakeKey(image, sigmas);
+
+  std::promise<ImageConstPointer>       promise;
+  std::shared_future<ImageConstPointer> cachedImage;
+  SizeValueType                         id = 0;
+  {
+    const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+    const auto found = std::find_if(smoothedImages.begin(),
+                                    smoothedImages.end(),
+                                    [&key](const SmoothedEntryType<TImage> & entry) { return entry.Key == key; });
+    if (found != smoothedImages.end())
+    {
+      ++this->m_NumberOfHits;
+      found->LastUse = ++this->m_UseCounter;
+      cachedImage = found->SmoothedImage;
+    }
+    else
+    {
+      // smoothed below, outside of the lock
+      id = ++this->m_UseCounter;
+      ++this->m_NumberOfMisses;
+      smoothedImages.push_back({ id, key, image, promise.get_future().share(), nullptr, 0, id });
+    }
+  }
+  if (cachedImage.valid())
+  {
+    // waits, without the lock, if the image is still being smoothed
+    return cachedImage.get();
+  }
+
+  ImageConstPointer smoothedImage;
+  try
+  {
+    using SmoothingFilterType = SmoothingRecursiveGaussianImageFilter<TImage, TImage>;
+    auto                                         smoothingFilter = SmoothingFilterType::New();
+    typename SmoothingFilterType::SigmaArrayType sigmaArray;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      sigmaArray[d] = sigmas[d];
+    }
+    smoothingFilter->SetSigmaArray(sigmaArray);
+    smoothingFilter->SetInput(image);
+    smoothingFilter->Update();
+
+    const typename TImage::Pointer output = smoothingFilter->GetOutput();
+    output->DisconnectPipeline();
+    smoothedImage = output.GetPointer();
+  }
+  catch (...)
+  {
+    // threads waiting for the image get the exception, and later requests
+    // try again
+    promise.set_exception(std::current_exception());
+    const std::lock_guard<std::mutex> lock(this->m_Mutex);
+    this->RemoveSmoothedEntry(smoothedImages, id);
+    throw;
+  }
+  promise.set_value(smoothedImage);
+
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+  for (auto & entry : smoothedImages)
+  {
+    if (entry.Id == id)
+    {
+      entry.ReadySmoothedImage = smoothedImage.GetPointer();
+      entry.NumberOfBytes = GetNumberOfPixelBytes(smoothedImage.GetPointer());
+      this->m_NumberOfBytes += entry.NumberOfBytes;
+      this->RemoveLeastRecentlyUsedImages();
+      break;
+    }
+  }
+  return smoothedImage;
+}
+
+template <typename TFixedImage, typename TMovingImage>
+template <typename TImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::RemoveSmoothedEntry(
+  std::vector<SmoothedEntryType<TImage>> & smoothedImages,
+  SizeValueType                            id)
+{
+  const auto found = std::find_if(smoothedImages.begin(),
+                                  smoothedImages.end(),
+                                  [id](const SmoothedEntryType<TImage> & entry) { return entry.Id == id; });
+  if (found == smoothedImages.end())
+  {
+    return;
+  }
+  const DataObject * const smoothedImage = found->ReadySmoothedImage;
+  this->m_NumberOfBytes -= found->NumberOfBytes;
+  smoothedImages.erase(found);
+
+  if (smoothedImage)
+  {
+    for (const auto & gradientEntry : this->m_GradientImages)
+    {
+      if (gradientEntry.Image == smoothedImage)
+      {
+        this->m_NumberOfBytes -= gradientEntry.NumberOfBytes;
+      }
+    }
+    this->m_GradientImages.erase(std::remove_if(this->m_GradientImages.begin(),
+                                                this->m_GradientImages.end(),
+                                                [smoothedImage](const GradientEntryType & gradientEntry) {
+                                                  return gradientEntry.Image == smoothedImage;
+                                                }),
+                                 this->m_GradientImages.end());
+  }
+}
+
+template <typename TFixedImage, typename TMovingImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::RemoveLeastRecentlyUsedImages()
+{
+  while (this->m_NumberOfBytes > this->m_MaximumNumberOfBytes)
+  {
+    // the least recently used image which is not being smoothed
+    SizeValueType leastRecentUse = NumericTraits<SizeValueType>::max();
+    const auto    findLeastRecentlyUsed = [&leastRecentUse](const auto & entries, auto isReady) {
+      auto leastRecentlyUsed = entries.end();
+      for (auto it = entries.begin(); it != entries.end(); ++it)
+      {
+        if (isReady(*it) && it->LastUse < leastRecentUse)
+        {
+          leastRecentUse = it->LastUse;
+          leastRecentlyUsed = it;
+        }
+      }
+      return leastRecentlyUsed;
+    };
+    const auto isSmoothed = [](const auto & entry) { return entry.ReadySmoothedImage != nullptr; };
+    const auto fixedEntry = findLeastRecentlyUsed(this->m_SmoothedFixedImages, isSmoothed);
+    const auto movingEntry = findLeastRecentlyUsed(this->m_SmoothedMovingImages, isSmoothed);
+    const auto gradientEntry = findLeastRecentlyUsed(this->m_GradientImages, [](const auto &) { return true; });
+
+    // each search only finds an entry used less recently than those found before
+    if (gradientEntry != this->m_GradientImages.end())
+    {
+      this->m_NumberOfBytes -= gradientEntry->NumberOfBytes;
+      this->m_GradientImages.erase(gradientEntry);
+    }
+    else if (movingEntry != this->m_SmoothedMovingImages.end())
+    {
+      this->RemoveSmoothedEntry(this->m_SmoothedMovingImages, movingEntry->Id);
+    }
+    else if (fixedEntry != this->m_SmoothedFixedImages.end())
+    {
+      this->RemoveSmoothedEntry(this->m_SmoothedFixedImages, fixedEntry->Id);
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+template <typename TFixedImage, typename TMovingImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lock(this->m_Mutex);
+
+  os << indent << "NumberOfSmoothedFixedImages: " << this->m_SmoothedFixedImages.size() << std::endl;
+  os << indent << "NumberOfSmoothedMovingImages: " << this->m_SmoothedMovingImages.size() << std::endl;
+  os << indent << "NumberOfGradientImages: " << this->m_GradientImages.size() << std::endl;
+  os << indent << "NumberOfBytes: " << this->m_NumberOfBytes << std::endl;
+  os << indent << "MaximumNumberOfBytes: " << this->m_MaximumNumberOfBytes << std::endl;
+  os << indent << "NumberOfHits: " << this->m_NumberOfHits << std::endl;
+  os << indent << "NumberOfMisses: " << this->m_NumberOfMisses << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -46,6 +46,11 @@ namespace itk
  * The method evolved since that time with crucial contributions from Gang Song and
  * Nick Tustison. Though similar in spirit, this implementation is not identical.
  *
+ * The precision of the displacement fields is that of \c TOutputTransform.
+ * With a DisplacementFieldTransform<float, ImageDimension>, the fields and
+ * their updates are stored in single precision, which halves the memory and
+ * the memory bandwidth of the field operations of each iteration.
+ *
  * \todo Need to allow the fixed image to have a composite transform.
  *
  * \author Nick Tustison
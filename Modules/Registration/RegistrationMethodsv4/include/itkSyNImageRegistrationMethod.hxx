@@ -21,6 +21,7 @@
 
 #include "itkComposeDisplacementFieldsImageFilter.h"
 #include "itkGaussianOperator.h"
+#include "itkImageDuplicator.h"
 #include "itkImageMaskSpatialObject.h"
 #include "itkImportImageFilter.h"
 #include "itkInvertDisplacementFieldImageFilter.h"
@@ -193,12 +194,14 @@ SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtual
 
     if (this->m_AverageMidPointGradients)
     {
-      ImageRegionIteratorWithIndex<DisplacementFieldType> ItF(
-        fixedToMiddleSmoothUpdateField, fixedToMiddleSmoothUpdateField->GetLargestPossibleRegion());
-      for (ItF.GoToBegin(); !ItF.IsAtEnd(); ++ItF)
+      ImageRegionIterator<DisplacementFieldType> ItF(fixedToMiddleSmoothUpdateField,
+                                                     fixedToMiddleSmoothUpdateField->GetLargestPossibleRegion());
+      ImageRegionIterator<DisplacementFieldType> ItM(movingToMiddleSmoothUpdateField,
+                                                     movingToMiddleSmoothUpdateField->GetLargestPossibleRegion());
+      for (ItF.GoToBegin(), ItM.GoToBegin(); !ItF.IsAtEnd(); ++ItF, ++ItM)
       {
-        ItF.Set(ItF.Get() - movingToMiddleSmoothUpdateField->GetPixel(ItF.GetIndex()));
-        movingToMiddleSmoothUpdateField->SetPixel(ItF.GetIndex(), -ItF.Get());
+        ItF.Set(ItF.Get() - ItM.Get());
+        ItM.Set(-ItF.Get());
       }
     }
 
@@ -722,18 +725,20 @@ typename SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform,
   SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform, TVirtualImage, TPointSet>::
     GaussianSmoothDisplacementField(const DisplacementFieldType * field, const RealType variance)
 {
-  using DuplicatorType = ImageDuplicator<DisplacementFieldType>;
-  auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(field);
-  duplicator->Update();
-
-  DisplacementFieldPointer smoothField = duplicator->GetOutput();
-
   if (variance <= 0.0)
   {
-    return smoothField;
+    using DuplicatorType = ImageDuplicator<DisplacementFieldType>;
+    auto duplicator = DuplicatorType::New();
+    duplicator->SetInputImage(field);
+    duplicator->Update();
+
+    return duplicator->GetOutput();
   }
 
+  // The first pass reads the input field, and each pass replaces the field
+  // of the previous one, so that the input field is never copied.
+  DisplacementFieldPointer smoothField;
+
   using GaussianSmoothingOperatorType = GaussianOperator<RealType, ImageDimension>;
   GaussianSmoothingOperatorType gaussianSmoothingOperator;
 
@@ -747,12 +752,19 @@ typename SyNImageRegistrationMethod<TFixedImage, TMovingImage, TOutputTransform,
     gaussianSmoothingOperator.SetDirection(d);
     gaussianSmoothingOperator.SetVariance(variance);
     gaussianSmoothingOperator.SetMaximumError(0.001);
-    gaussianSmoothingOperator.SetMaximumKernelWidth(smoothField->GetRequestedRegion().GetSize()[d]);
+    gaussianSmoothingOperator.SetMaximumKernelWidth(field->GetRequestedRegion().GetSize()[d]);
     gaussianSmoothingOperator.CreateDirectional();
 
     // todo: make sure we only smooth within the buffered region
     smoother->SetOperator(gaussianSmoothingOperator);
-    smoother->SetInput(smoothField);
+    if (d == 0)
+    {
+      smoother->SetInput(field);
+    }
+    else
+    {
+      smoother->SetInput(smoothField);
+    }
     try
     {
       smoother->Update();
@@ -372,7 +372,10 @@ itkBSplineImageRegistrationTest(int argc, char * argv[])
   const std::set<itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy> allMetricSamplingStrategy{
     itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::NONE,
     itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::REGULAR,
-    itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::RANDOM
+    itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::RANDOM,
+    itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::STRATIFIED,
+    itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::HALTON,
+    itk::ImageRegistrationMethodv4Enums::MetricSamplingStrategy::GRADIENT_WEIGHTED
   };
   for (const auto & ee : allMetricSamplingStrategy)
   {
@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageDuplicator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Test ImageRegistrationPyramidCache: registrations that share a cache give
+ * the same results as registrations without a cache, the smoothed images of
+ * the fixed image are reused by a registration of another moving image, even
+ * when the fixed image is a copy, and the gradient images of the moving image
+ * are reused by a second registration of the same images, unless its gradient
+ * filter has other parameters. Also test that the smoothed images of a
+ * modified image are not reused, and the size limit.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+using PyramidCacheType = RegistrationType::PyramidCacheType;
+
+ImageType::Pointer
+MakeImage(double shiftX, double shiftY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 48, 40 } });
+  image->SetSpacing(itk::MakeVector(1.0, 1.5));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const double dx = point[0] - 24.0 - shiftX;
+    const double dy = point[1] - 30.0 - shiftY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / 150.0));
+  }
+  return image;
+}
+
+RegistrationType::Pointer
+RunRegistration(const ImageType *                           fixedImage,
+                const ImageType *                           movingImage,
+                PyramidCacheType *                          pyramidCache,
+                MetricType::MovingImageGradientFilterType * movingImageGradientFilter = nullptr)
+{
+  auto metric = MetricType::New();
+  if (movingImageGradientFilter)
+  {
+    metric->SetMovingImageGradientFilter(movingImageGradientFilter);
+  }
+
+  auto scalesEstimator = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>::New();
+  scalesEstimator->SetMetric(metric);
+  scalesEstimator->SetTransformForward(true);
+
+  auto optimizer = itk::GradientDescentOptimizerv4::New();
+  optimizer->SetLearningRate(1.0);
+  optimizer->SetNumberOfIterations(20);
+  optimizer->SetDoEstimateLearningRateOnce(false);
+  optimizer->SetDoEstimateLearningRateAtEachIteration(true);
+  optimizer->SetMaximumStepSizeInPhysicalUnits(1.0);
+  optimizer->SetScalesEstimator(scalesEstimator);
+
+  RegistrationType::ShrinkFactorsArrayType shrinkFactors(3);
+  shrinkFactors[0] = 4;
+  shrinkFactors[1] = 2;
+  shrinkFactors[2] = 1;
+  RegistrationType::SmoothingSigmasArrayType smoothingSigmas(3);
+  smoothingSigmas[0] = 2.0;
+  smoothingSigmas[1] = 1.0;
+  smoothingSigmas[2] = 0.0;
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(3);
+  registration->SetShrinkFactorsPerLevel(shrinkFactors);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  registration->SetPyramidCache(pyramidCache);
+  registration->Update();
+  return registration;
+}
+} // namespace
+
+int
+itkImageRegistrationPyramidCacheTest(int, char *[])
+{
+  const auto fixedImage = MakeImage(0.0, 0.0);
+  const auto movingImage = MakeImage(2.0, -1.5);
+  const auto otherMovingImage = MakeImage(-1.0, 2.5);
+
+  auto pyramidCache = PyramidCacheType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(pyramidCache, ImageRegistrationPyramidCache, Object);
+
+  // The first registration computes the smoothed images of the two levels
+  // that are smoothed, for the fixed and the moving image.
+  const auto registration = RunRegistration(fixedImage, movingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfMisses(), 4);
+  ITK_TEST_SET_GET_VALUE(pyramidCache, registration->GetModifiablePyramidCache());
+
+  const auto uncachedRegistration = RunRegistration(fixedImage, movingImage, nullptr);
+  ITK_TEST_EXPECT_EQUAL(registration->GetTransform()->GetParameters(),
+                        uncachedRegistration->GetTransform()->GetParameters());
+
+  // The registration of another moving image to a copy of the fixed image
+  // reuses the smoothed fixed images.
+  const auto fixedImageDuplicator = itk::ImageDuplicator<ImageType>::New();
+  fixedImageDuplicator->SetInputImage(fixedImage);
+  fixedImageDuplicator->Update();
+  const auto otherRegistration = RunRegistration(fixedImageDuplicator->GetOutput(), otherMovingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfHits(), 2);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfMisses(), 6);
+  ITK_TEST_EXPECT_EQUAL(otherRegistration->GetTransform()->GetParameters(),
+                        RunRegistration(fixedImage, otherMovingImage, nullptr)->GetTransform()->GetParameters());
+
+  // A second registration of the same images, like a successive stage,
+  // reuses the smoothed images and the gradient image of the moving image.
+  const auto secondRegistration = RunRegistration(fixedImage, movingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfHits(), 6);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfMisses(), 6);
+  ITK_TEST_EXPECT_EQUAL(secondRegistration->GetTransform()->GetParameters(),
+                        registration->GetTransform()->GetParameters());
+
+  const auto * const metric = dynamic_cast<MetricType *>(registration->GetModifiableMetric());
+  const auto * const secondMetric = dynamic_cast<MetricType *>(secondRegistration->GetModifiableMetric());
+  ITK_TEST_EXPECT_TRUE(metric->GetMovingImageGradientImage() != nullptr);
+  ITK_TEST_EXPECT_EQUAL(secondMetric->GetMovingImageGradientImage(), metric->GetMovingImageGradientImage());
+
+  // A gradient filter with another sigma computes other gradient images.
+  using GradientFilterType =
+    itk::GradientRecursiveGaussianImageFilter<ImageType, MetricType::MovingImageGradientImageType>;
+  auto gradientFilter = GradientFilterType::New();
+  gradientFilter->SetSigma(3.0);
+  gradientFilter->SetNormalizeAcrossScale(true);
+  gradientFilter->SetUseImageDirection(true);
+  const auto otherGradientRegistration = RunRegistration(fixedImage, movingImage, pyramidCache, gradientFilter);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<MetricType *>(otherGradientRegistration->GetModifiableMetric())
+                         ->GetMovingImageGradientImage() != metric->GetMovingImageGradientImage());
+  const auto uncachedGradientRegistration = RunRegistration(fixedImage, movingImage, nullptr, gradientFilter);
+  ITK_TEST_EXPECT_EQUAL(otherGradientRegistration->GetTransform()->GetParameters(),
+                        uncachedGradientRegistration->GetTransform()->GetParameters());
+
+  pyramidCache->Clear();
+  const auto registrationAfterClear = RunRegistration(fixedImage, movingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfMisses(), 10);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<MetricType *>(registrationAfterClear->GetModifiableMetric())
+                         ->GetMovingImageGradientImage() != metric->GetMovingImageGradientImage());
+
+  // ClearMovingImages() keeps the smoothed fixed images.
+  pyramidCache->ClearMovingImages();
+  RunRegistration(fixedImage, movingImage, pyramidCache);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfHits(), 12);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfMisses(), 12);
+
+  // A smoothed image is not reused once the image it was smoothed from is
+  // modified, but it still is for the images with its original pixels.
+  auto                             smallCache = PyramidCacheType::New();
+  PyramidCacheType::SigmaArrayType sigmas;
+  sigmas.Fill(1.0);
+  const auto copiedFixedImage = fixedImageDuplicator->GetOutput();
+  const auto smoothedImage = smallCache->GetSmoothedFixedImage(copiedFixedImage, sigmas);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetSmoothedFixedImage(fixedImage, sigmas), smoothedImage);
+  copiedFixedImage->SetPixel({ { 20, 20 } }, 0.0);
+  copiedFixedImage->Modified();
+  ITK_TEST_EXPECT_TRUE(smallCache->GetSmoothedFixedImage(copiedFixedImage, sigmas) != smoothedImage);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetSmoothedFixedImage(fixedImage, sigmas), smoothedImage);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfHits(), 2);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfMisses(), 2);
+
+  // The cache only counts, and holds, the smoothed images. The least recently
+  // used images are removed when the cache is full.
+  const itk::SizeValueType numberOfImageBytes = fixedImage->GetPixelContainer()->Size() * sizeof(double);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfBytes(), 2 * numberOfImageBytes);
+  smallCache->SetMaximumNumberOfBytes(numberOfImageBytes);
+  ITK_TEST_SET_GET_VALUE(numberOfImageBytes, smallCache->GetMaximumNumberOfBytes());
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfBytes(), numberOfImageBytes);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetSmoothedFixedImage(fixedImage, sigmas), smoothedImage);
+  sigmas.Fill(2.0);
+  smallCache->GetSmoothedFixedImage(fixedImage, sigmas);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfBytes(), numberOfImageBytes);
+  smallCache->GetSmoothedFixedImage(fixedImage, sigmas);
+  sigmas.Fill(1.0);
+  smallCache->GetSmoothedFixedImage(fixedImage, sigmas);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfHits(), 4);
+  ITK_TEST_EXPECT_EQUAL(smallCache->GetNumberOfMisses(), 4);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Test the STRATIFIED, HALTON and GRADIENT_WEIGHTED metric sampling strategies:
+ * the number of sample points matches the sampling percentage, the points are
+ * reproducible for a given seed, the stratified and Halton points lie inside
+ * the virtual domain, and a translation registration converges with each of
+ * them.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+using SamplingStrategyEnum = RegistrationType::MetricSamplingStrategyEnum;
+
+ImageType::Pointer
+MakeImage(double shiftX, double shiftY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48 } });
+  image->SetSpacing(itk::MakeVector(1.0, 1.5));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const double dx = point[0] - 32.0 - shiftX;
+    const double dy = point[1] - 36.0 - shiftY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / 200.0));
+  }
+  return image;
+}
+
+RegistrationType::Pointer
+RunRegistration(SamplingStrategyEnum strategy, double samplingPercentage, int seed)
+{
+  auto metric = MetricType::New();
+
+  auto scalesEstimator = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>::New();
+  scalesEstimator->SetMetric(metric);
+  scalesEstimator->SetTransformForward(true);
+
+  auto optimizer = itk::GradientDescentOptimizerv4::New();
+  optimizer->SetLearningRate(1.0);
+  optimizer->SetNumberOfIterations(100);
+  optimizer->SetMinimumConvergenceValue(1e-12);
+  optimizer->SetConvergenceWindowSize(10);
+  optimizer->SetDoEstimateLearningRateOnce(true);
+  optimizer->SetDoEstimateLearningRateAtEachIteration(false);
+  optimizer->SetMaximumStepSizeInPhysicalUnits(1.0);
+  optimizer->SetScalesEstimator(scalesEstimator);
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(MakeImage(0.0, 0.0));
+  registration->SetMovingImage(MakeImage(2.5, -1.5));
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(1);
+  registration->SetShrinkFactorsPerLevel(RegistrationType::ShrinkFactorsArrayType(1, 1));
+  registration->SetSmoothingSigmasPerLevel(RegistrationType::SmoothingSigmasArrayType(1, 0.0));
+  registration->SetMetricSamplingStrategy(strategy);
+  registration->SetMetricSamplingPercentage(samplingPercentage);
+  registration->MetricSamplingReinitializeSeed(seed);
+  registration->Update();
+  return registration;
+}
+
+const MetricType::VirtualPointSetType *
+GetSamplePoints(RegistrationType * registration)
+{
+  return dynamic_cast<MetricType *>(registration->GetModifiableMetric())->GetVirtualSampledPointSet();
+}
+} // namespace
+
+int
+itkImageRegistrationSamplingStrategiesTest(int, char *[])
+{
+  constexpr double samplingPercentage = 0.2;
+  const auto       virtualImage = MakeImage(0.0, 0.0);
+  const double     expectedNumberOfPoints =
+    samplingPercentage * virtualImage->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  bool testPassed = true;
+  for (const auto strategy :
+       { SamplingStrategyEnum::STRATIFIED, SamplingStrategyEnum::HALTON, SamplingStrategyEnum::GRADIENT_WEIGHTED })
+  {
+    std::cout << "Strategy: " << strategy << std::endl;
+
+    const auto registration = RunRegistration(strategy, samplingPercentage, 42);
+    const auto samplePoints = GetSamplePoints(registration);
+
+    const double numberOfPoints = samplePoints->GetNumberOfPoints();
+    if (std::abs(numberOfPoints - expectedNumberOfPoints) > 0.05 * expectedNumberOfPoints)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the number of sample points." << std::endl;
+      std::cerr << "Expected about " << expectedNumberOfPoints << ", but got " << numberOfPoints << std::endl;
+      testPassed = false;
+    }
+
+    const auto otherRegistration = RunRegistration(strategy, samplingPercentage, 42);
+    const auto otherSamplePoints = GetSamplePoints(otherRegistration);
+    if (otherSamplePoints->GetNumberOfPoints() != samplePoints->GetNumberOfPoints())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The number of sample points differs for the same seed." << std::endl;
+      testPassed = false;
+    }
+    else
+    {
+      for (unsigned int i = 0; i < samplePoints->GetNumberOfPoints(); ++i)
+      {
+        if (samplePoints->GetPoint(i) != otherSamplePoints->GetPoint(i))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Sample point " << i << " differs for the same seed." << std::endl;
+          testPassed = false;
+          break;
+        }
+      }
+    }
+
+    if (strategy != SamplingStrategyEnum::GRADIENT_WEIGHTED)
+    {
+      for (unsigned int i = 0; i < samplePoints->GetNumberOfPoints(); ++i)
+      {
+        const auto continuousIndex =
+          virtualImage->TransformPhysicalPointToContinuousIndex<double>(samplePoints->GetPoint(i));
+        if (!virtualImage->GetLargestPossibleRegion().IsInside(continuousIndex))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Sample point " << samplePoints->GetPoint(i) << " is outside of the virtual domain."
+                    << std::endl;
+          testPassed = false;
+          break;
+        }
+      }
+    }
+
+    const TransformType::OutputVectorType offset = registration->GetTransform()->GetOffset();
+    std::cout << "  Number of points: " << numberOfPoints << ", offset: " << offset << std::endl;
+    if (std::abs(offset[0] - 2.5) > 0.02 || std::abs(offset[1] + 1.5) > 0.02)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The registration did not converge to the offset [2.5, -1.5]." << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
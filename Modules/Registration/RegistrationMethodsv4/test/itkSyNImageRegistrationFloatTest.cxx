@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkSyNImageRegistrationMethod.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+/*
+ * Test SyNImageRegistrationMethod with single precision displacement fields:
+ * the registration of two synthetic images in float gives the same
+ * displacement fields as in double, up to the rounding of the fields.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+
+ImageType::Pointer
+MakeImage(double radiusX, double radiusY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 56 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double dx = (it.GetIndex()[0] - 32.0) / radiusX;
+    const double dy = (it.GetIndex()[1] - 28.0) / radiusY;
+    it.Set(static_cast<float>(100.0 * std::exp(-(dx * dx + dy * dy))));
+  }
+  return image;
+}
+
+template <typename TRealType>
+typename itk::DisplacementFieldTransform<TRealType, Dimension>::DisplacementFieldType::Pointer
+RegisterImages(const ImageType * fixedImage, const ImageType * movingImage, double & metricValue)
+{
+  using OutputTransformType = itk::DisplacementFieldTransform<TRealType, Dimension>;
+  using RegistrationType = itk::SyNImageRegistrationMethod<ImageType, ImageType, OutputTransformType>;
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType, ImageType, TRealType>;
+  using DisplacementFieldType = typename OutputTransformType::DisplacementFieldType;
+
+  auto displacementField = DisplacementFieldType::New();
+  displacementField->CopyInformation(fixedImage);
+  displacementField->SetRegions(fixedImage->GetBufferedRegion());
+  displacementField->AllocateInitialized();
+
+  auto inverseDisplacementField = DisplacementFieldType::New();
+  inverseDisplacementField->CopyInformation(fixedImage);
+  inverseDisplacementField->SetRegions(fixedImage->GetBufferedRegion());
+  inverseDisplacementField->AllocateInitialized();
+
+  auto outputTransform = OutputTransformType::New();
+  outputTransform->SetDisplacementField(displacementField);
+  outputTransform->SetInverseDisplacementField(inverseDisplacementField);
+
+  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(1);
+  shrinkFactorsPerLevel[0] = 1;
+  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(1);
+  smoothingSigmasPerLevel[0] = 0;
+  typename RegistrationType::NumberOfIterationsArrayType numberOfIterationsPerLevel(1);
+  numberOfIterationsPerLevel[0] = 15;
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(MetricType::New());
+  registration->SetInitialTransform(outputTransform);
+  registration->InPlaceOn();
+  registration->SetNumberOfLevels(1);
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+  registration->SetNumberOfIterationsPerLevel(numberOfIterationsPerLevel);
+  registration->SetLearningRate(0.25);
+  registration->SetConvergenceThreshold(0.0);
+  registration->SetGaussianSmoothingVarianceForTheUpdateField(3.0);
+  registration->SetGaussianSmoothingVarianceForTheTotalField(0.25);
+  registration->Update();
+
+  metricValue = registration->GetCurrentMetricValue();
+  return registration->GetModifiableTransform()->GetModifiableDisplacementField();
+}
+} // namespace
+
+int
+itkSyNImageRegistrationFloatTest(int, char *[])
+{
+  const auto fixedImage = MakeImage(10.0, 8.0);
+  const auto movingImage = MakeImage(12.0, 7.0);
+
+  double     doubleMetricValue = 0.0;
+  const auto doubleField = RegisterImages<double>(fixedImage, movingImage, doubleMetricValue);
+
+  double     floatMetricValue = 0.0;
+  const auto floatField = RegisterImages<float>(fixedImage, movingImage, floatMetricValue);
+
+  // The registration moves the points of the fixed blob towards those of the
+  // larger, flatter moving blob.
+  const auto displacement = doubleField->GetPixel({ { 40, 28 } });
+  std::cout << "Displacement at (40, 28): " << displacement << std::endl;
+  ITK_TEST_EXPECT_TRUE(displacement[0] > 0.5);
+
+  double maximumDifference = 0.0;
+  double maximumDisplacement = 0.0;
+  using DoubleFieldType = std::remove_reference_t<decltype(*doubleField)>;
+  using FloatFieldType = std::remove_reference_t<decltype(*floatField)>;
+  itk::ImageRegionConstIterator<DoubleFieldType> doubleIt(doubleField, doubleField->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FloatFieldType>  floatIt(floatField, floatField->GetBufferedRegion());
+  for (; !doubleIt.IsAtEnd(); ++doubleIt, ++floatIt)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      maximumDifference = std::max(maximumDifference, std::abs(doubleIt.Get()[d] - floatIt.Get()[d]));
+      maximumDisplacement = std::max(maximumDisplacement, std::abs(doubleIt.Get()[d]));
+    }
+  }
+  std::cout << "Metric values (double, float): " << doubleMetricValue << ", " << floatMetricValue << std::endl;
+  std::cout << "Maximum displacement: " << maximumDisplacement << std::endl;
+  std::cout << "Maximum difference between the double and float fields: " << maximumDifference << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(maximumDifference < 1.0e-3 * maximumDisplacement);
+  // the float metric also sums the squared differences in single precision
+  ITK_TEST_EXPECT_TRUE(std::abs(doubleMetricValue - floatMetricValue) <= 1.0e-2 * std::abs(doubleMetricValue));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -24,10 +24,11 @@
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkShapedImageNeighborhoodRange.h"
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkLexicographicCompare.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
-#include <algorithm> // For min and max.
+#include <algorithm> // For min, max and sort.
 
 namespace itk
 {
@@ -124,10 +125,7 @@ void
 ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
   using FunctionType = BinaryThresholdImageFunction<InputImageType, double>;
-  using SecondFunctionType = BinaryThresholdImageFunction<OutputImageType, double>;
-
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-  using SecondIteratorType = FloodFilledImageFunctionConditionalConstIterator<InputImageType, SecondFunctionType>;
+  using FloodFillType = ParallelFloodFill<OutputImageType::ImageDimension>;
 
   const typename Superclass::InputImageConstPointer inputImage = this->GetInput();
   const typename Superclass::OutputImagePointer     outputImage = this->GetOutput();
@@ -270,48 +268,41 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   itkDebugMacro("\nLower intensity = " << lower << ", Upper intensity = " << upper << "\nmean = " << m_Mean
                                        << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
 
-  // Segment the image, the iterator walks the output image (so Set()
-  // writes into the output image), starting at the seed point.  As
-  // the iterator walks, if the corresponding pixel in the input image
-  // (accessed via the "function" assigned to the iterator) is within
-  // the [lower, upper] bounds prescribed, the pixel is added to the
-  // output segmentation and its neighbors become candidates for the
-  // iterator to walk.
-  IteratorType it(outputImage, function, m_Seeds);
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-  }
+  // Segment the image, starting at the seed points. The pixels whose
+  // value in the input image (evaluated by "function") is within the
+  // [lower, upper] bounds prescribed are added to the output
+  // segmentation, and their neighbors become candidates for the flood.
+  // The flood runs on several threads, so the order of the segmented
+  // pixels depends on the threads. They are sorted before computing the
+  // statistics, which thus do not depend on the number of work units.
+  FloodFillType floodFill(region, false, this->GetMultiThreader(), this->GetNumberOfWorkUnits());
+  const auto    isIncluded = [&function](const IndexType & index) { return function->EvaluateAtIndex(index); };
+  const auto    setReplaceValue = [this, &outputImage](const IndexType & index) {
+    outputImage->SetPixel(index, m_ReplaceValue);
+    return true;
+  };
+
+  typename FloodFillType::IndexListType segmented;
+  floodFill.Fill(m_Seeds, isIncluded, setReplaceValue, nullptr, &segmented);
+  std::sort(segmented.begin(), segmented.end(), Functor::LexicographicCompare());
 
   ProgressReporter progress(this, 0, region.GetNumberOfPixels() * m_NumberOfIterations);
 
   for (unsigned int loop = 0; loop < m_NumberOfIterations; ++loop)
   {
     // Now that we have an initial segmentation, let's recalculate the
-    // statistics.  Since we have already labelled the output, we visit
-    // pixels in the input image that have been set in the output image.
-    // Essentially, we flip the iterator around, so we walk the input
-    // image (so Get() will get pixel values from the input) and constrain
-    // iterator such it only visits pixels that were set in the output.
-    auto secondFunction = SecondFunctionType::New();
-    secondFunction->SetInputImage(outputImage);
-    secondFunction->ThresholdBetween(m_ReplaceValue, m_ReplaceValue);
-
+    // statistics over the input pixels that have been set in the output
+    // image. They are visited in lexicographic order.
     InputRealType                        sum{};
     InputRealType                        sumOfSquares{};
     typename TOutputImage::SizeValueType numberOfSamples = 0;
 
-    SecondIteratorType sit(inputImage, secondFunction, m_Seeds);
-    sit.GoToBegin();
-    while (!sit.IsAtEnd())
+    for (const IndexType & index : segmented)
     {
-      const auto value = static_cast<InputRealType>(sit.Get());
+      const auto value = static_cast<InputRealType>(inputImage->GetPixel(index));
       sum += value;
       sumOfSquares += value * value;
       ++numberOfSamples;
-      ++sit;
     }
     m_Mean = sum / static_cast<double>(numberOfSamples);
     m_Variance = (sumOfSquares - (sum * sum / static_cast<double>(numberOfSamples))) /
@@ -352,24 +343,18 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
                                          << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
     itkDebugMacro("\nsum = " << sum << ", sumOfSquares = " << sumOfSquares << "\nnum = " << numberOfSamples);
 
-    // Rerun the segmentation, the iterator walks the output image,
-    // starting at the seed point.  As the iterator walks, if the
-    // corresponding pixel in the input image (accessed via the
-    // "function" assigned to the iterator) is within the [lower,
-    // upper] bounds prescribed, the pixel is added to the output
-    // segmentation and its neighbors become candidates for the
-    // iterator to walk.
-    outputImage->FillBuffer(OutputImagePixelType{});
-    IteratorType thirdIt(outputImage, function, m_Seeds);
-    thirdIt.GoToBegin();
+    // Rerun the segmentation from the seed points with the new bounds.
+    // Only the pixels of the previous segmentation have to be reset.
+    for (const IndexType & index : segmented)
+    {
+      outputImage->SetPixel(index, OutputImagePixelType{});
+    }
+    segmented.clear();
+    floodFill.ClearVisited();
     try
     {
-      while (!thirdIt.IsAtEnd())
-      {
-        thirdIt.Set(m_ReplaceValue);
-        ++thirdIt;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
+      floodFill.Fill(m_Seeds, isIncluded, setReplaceValue, &progress, &segmented);
+      std::sort(segmented.begin(), segmented.end(), Functor::LexicographicCompare());
     }
     catch (const ProcessAborted &)
     {
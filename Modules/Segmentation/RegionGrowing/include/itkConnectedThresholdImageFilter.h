@@ -58,6 +58,10 @@ operator<<(std::ostream & out, const ConnectedThresholdImageFilterEnums::Connect
  * connected to an initial Seed AND lie within a Lower and Upper
  * threshold range.
  *
+ * The region is grown on several threads with ParallelFloodFill. The
+ * output does not depend on the number of work units.
+ *
+ * \sa ParallelFloodFill
  * \ingroup RegionGrowingSegmentation
  * \ingroup ITKRegionGrowing
  * \sphinx
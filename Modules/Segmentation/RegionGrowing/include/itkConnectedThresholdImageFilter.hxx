@@ -19,10 +19,8 @@
 #define itkConnectedThresholdImageFilter_hxx
 
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
-
-#include "itkShapedFloodFilledImageFunctionConditionalIterator.h"
 #include "itkMath.h"
 
 namespace itk
@@ -241,38 +239,20 @@ ConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   ProgressReporter progress(this, 0, region.GetNumberOfPixels());
 
-  if (this->m_Connectivity == ConnectivityEnum::FaceConnectivity)
-  {
-    using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-    IteratorType it(outputImage, function, m_Seeds);
-    it.GoToBegin();
-
-    while (!it.IsAtEnd())
-    {
-      it.Set(m_ReplaceValue);
-      ++it;
-      progress.CompletedPixel(); // potential exception thrown here
-    }
-  }
-  else if (this->m_Connectivity == ConnectivityEnum::FullConnectivity)
-  {
-    // Use the fully connected iterator here. The fully connected iterator
-    // below is a superset of the above. However, it is reported to be 20%
-    // slower. Hence we use this "if" block to use the old iterator when
-    // we don't need full connectivity.
-
-    using IteratorType = ShapedFloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-    IteratorType it(outputImage, function, m_Seeds);
-    it.FullyConnectedOn();
-    it.GoToBegin();
-
-    while (!it.IsAtEnd())
-    {
-      it.Set(m_ReplaceValue);
-      ++it;
-      progress.CompletedPixel(); // potential exception thrown here
-    }
-  }
+  // Flood from the seeds on several threads. The pixels are labeled by the
+  // work unit which includes them, so each one is written only once.
+  ParallelFloodFill<OutputImageDimension> floodFill(region,
+                                                    this->m_Connectivity == ConnectivityEnum::FullConnectivity,
+                                                    this->GetMultiThreader(),
+                                                    this->GetNumberOfWorkUnits());
+  floodFill.Fill(
+    m_Seeds,
+    [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+    [this, &outputImage](const IndexType & index) {
+      outputImage->SetPixel(index, m_ReplaceValue);
+      return true;
+    },
+    &progress);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -64,6 +64,9 @@ namespace itk
  * isolating threshold because no such threshold exists.  The user can
  * check for this by querying the GetThresholdingFailed() flag.
  *
+ * Each step of the binary search only floods the pixels added to the
+ * last segmentation which did not reach the second seeds, since the
+ * segmentation grows with the threshold.
  *
  * \ingroup RegionGrowingSegmentation
  * \ingroup ITKRegionGrowing
@@ -19,7 +19,7 @@
 #define itkIsolatedConnectedImageFilter_hxx
 
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkIterationReporter.h"
 #include "itkMath.h"
@@ -188,16 +188,68 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputImage->AllocateInitialized();
 
   using FunctionType = BinaryThresholdImageFunction<InputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
+  using FloodFillType = ParallelFloodFill<OutputImageType::ImageDimension>;
+  using IndexListType = typename FloodFillType::IndexListType;
 
   auto function = FunctionType::New();
   function->SetInputImage(inputImage);
 
   float             progressWeight = 0.0f;
   float             cumulatedProgress = 0.0f;
-  IteratorType      it(outputImage, function, m_Seeds1);
   IterationReporter iterate(this, 0, 1);
 
+  FloodFillType floodFill(region, false, this->GetMultiThreader(), this->GetNumberOfWorkUnits());
+  const auto    isIncluded = [&function](const IndexType & index) { return function->EvaluateAtIndex(index); };
+
+  // The region flooded from the first seeds grows with the threshold
+  // searched. The last flood which did not reach the second seeds is
+  // kept in the output image, and the next guess only has to flood from
+  // the pixels rejected on its boundary. A flood which reaches the
+  // second seeds is reverted.
+  IndexListType boundary = m_Seeds1;
+  IndexListType trialIncluded;
+  IndexListType trialRejected;
+  const auto    floodFromBoundary = [&](ProgressReporter & progress) {
+    trialIncluded.clear();
+    trialRejected.clear();
+    floodFill.ClearVisited(boundary);
+    floodFill.Fill(
+      boundary,
+      isIncluded,
+      [this, &outputImage](const IndexType & index) {
+        outputImage->SetPixel(index, m_ReplaceValue);
+        return index != m_Seeds2.front();
+      },
+      &progress,
+      &trialIncluded,
+      &trialRejected);
+
+    // Find the sum of the intensities in m_Seeds2.  If the second
+    // seeds are not included, the sum should be zero.  Otherwise,
+    // it will be other than zero.
+    InputRealType seedIntensitySum{};
+    for (const IndexType & seed : m_Seeds2)
+    {
+      seedIntensitySum += static_cast<InputRealType>(outputImage->GetPixel(seed));
+    }
+
+    const bool reached = Math::NotExactlyEquals(seedIntensitySum, InputRealType{});
+    if (reached)
+    {
+      for (const IndexType & index : trialIncluded)
+      {
+        outputImage->SetPixel(index, OutputImagePixelType{});
+      }
+      floodFill.ClearVisited(trialIncluded);
+      floodFill.ClearVisited(trialRejected);
+    }
+    else
+    {
+      boundary.swap(trialRejected);
+    }
+    return reached;
+  };
+
   // If the upper threshold has not been set, find it.
   if (m_FindUpperThreshold)
   {
@@ -218,34 +270,9 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
     {
       ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, cumulatedProgress, progressWeight);
       cumulatedProgress += progressWeight;
-      outputImage->FillBuffer(OutputImagePixelType{});
       function->ThresholdBetween(m_Lower, static_cast<InputImagePixelType>(guess));
-      it.GoToBegin();
-      while (!it.IsAtEnd())
-      {
-        it.Set(m_ReplaceValue);
-        if (it.GetIndex() == m_Seeds2.front())
-        {
-          break;
-        }
-        ++it;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
       // If any of second seeds are included, decrease the upper bound.
-      // Find the sum of the intensities in m_Seeds2.  If the second
-      // seeds are not included, the sum should be zero.  Otherwise,
-      // it will be other than zero.
-      InputRealType seedIntensitySum{};
-      auto          si = m_Seeds2.begin();
-      const auto    li = m_Seeds2.end();
-      while (si != li)
-      {
-        const auto value = static_cast<InputRealType>(outputImage->GetPixel(*si));
-        seedIntensitySum += value;
-        ++si;
-      }
-
-      if (Math::NotExactlyEquals(seedIntensitySum, InputRealType{}))
+      if (floodFromBoundary(progress))
       {
         upper = guess;
       }
@@ -283,34 +310,9 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
     {
       ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, cumulatedProgress, progressWeight);
       cumulatedProgress += progressWeight;
-      outputImage->FillBuffer(OutputImagePixelType{});
       function->ThresholdBetween(static_cast<InputImagePixelType>(guess), m_Upper);
-      it.GoToBegin();
-      while (!it.IsAtEnd())
-      {
-        it.Set(m_ReplaceValue);
-        if (it.GetIndex() == m_Seeds2.front())
-        {
-          break;
-        }
-        ++it;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
       // If any of second seeds are included, increase the lower bound.
-      // Find the sum of the intensities in m_Seeds2.  If the second
-      // seeds are not included, the sum should be zero.  Otherwise,
-      // it will be other than zero.
-      InputRealType seedIntensitySum{};
-      auto          si = m_Seeds2.begin();
-      const auto    li = m_Seeds2.end();
-      while (si != li)
-      {
-        const auto value = static_cast<InputRealType>(outputImage->GetPixel(*si));
-        seedIntensitySum += value;
-        ++si;
-      }
-
-      if (Math::NotExactlyEquals(seedIntensitySum, InputRealType{}))
+      if (floodFromBoundary(progress))
       {
         lower = guess;
       }
@@ -342,13 +344,15 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   {
     function->ThresholdBetween(m_IsolatedValue, m_Upper);
   }
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-    progress.CompletedPixel(); // potential exception thrown here
-  }
+  floodFill.ClearVisited();
+  floodFill.Fill(
+    m_Seeds1,
+    isIncluded,
+    [this, &outputImage](const IndexType & index) {
+      outputImage->SetPixel(index, m_ReplaceValue);
+      return true;
+    },
+    &progress);
 
   // If any of the second seeds are included or some of the first
   // seeds are not included, the algorithm could not find any threshold
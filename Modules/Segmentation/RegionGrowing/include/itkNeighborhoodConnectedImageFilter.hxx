@@ -18,10 +18,12 @@
 #ifndef itkNeighborhoodConnectedImageFilter_hxx
 #define itkNeighborhoodConnectedImageFilter_hxx
 
+#include "itkLexicographicCompare.h"
 #include "itkNeighborhoodBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -114,21 +116,35 @@ NeighborhoodConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputImage->FillBuffer(OutputImagePixelType{});
 
   using FunctionType = NeighborhoodBinaryThresholdImageFunction<InputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
 
   auto function = FunctionType::New();
   function->SetInputImage(inputImage);
   function->ThresholdBetween(m_Lower, m_Upper);
   function->SetRadius(m_Radius);
-  IteratorType it(outputImage, function, m_Seeds);
 
   ProgressReporter progress(this, 0, outputImage->GetRequestedRegion().GetNumberOfPixels());
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-    progress.CompletedPixel();
-  }
+
+  // The seeds are always part of the output, even when their neighborhood
+  // is not within the thresholds.
+  std::vector<IndexType> sortedSeeds = m_Seeds;
+  std::sort(sortedSeeds.begin(), sortedSeeds.end(), Functor::LexicographicCompare());
+
+  // Flood from the seeds on several threads. The neighborhood function is
+  // evaluated concurrently, and each pixel is labeled by the work unit which
+  // includes it.
+  ParallelFloodFill<OutputImageDimension> floodFill(
+    outputImage->GetRequestedRegion(), false, this->GetMultiThreader(), this->GetNumberOfWorkUnits());
+  floodFill.Fill(
+    m_Seeds,
+    [&function, &sortedSeeds](const IndexType & index) {
+      return function->EvaluateAtIndex(index) ||
+             std::binary_search(sortedSeeds.begin(), sortedSeeds.end(), index, Functor::LexicographicCompare());
+    },
+    [this, &outputImage](const IndexType & index) {
+      outputImage->SetPixel(index, m_ReplaceValue);
+      return true;
+    },
+    &progress);
 }
 } // end namespace itk
 
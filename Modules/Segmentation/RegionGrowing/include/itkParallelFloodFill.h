@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_h
+#define itkParallelFloodFill_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+#include "itkProgressReporter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ParallelFloodFill
+ * \brief Multithreaded flood fill of the pixels connected to a set of seeds.
+ *
+ * The pixels are visited level by level, as in a breadth first search. The
+ * frontier is split between several work units, each one testing the
+ * unvisited neighbors of its part of the frontier to build the next one.
+ * The visited pixels are recorded in a bitmap of atomic words, and a work
+ * unit only tests the neighbors whose bit it sets first, so each pixel is
+ * tested only once. Small frontiers are expanded by the calling thread.
+ *
+ * The bitmap is kept between the calls to Fill(), which makes it possible to
+ * grow a region incrementally. ClearVisited() marks pixels as not visited.
+ *
+ * With a single work unit, the pixels are included in the same order as
+ * with FloodFilledImageFunctionConditionalIterator when the seeds are given
+ * in the same order and the face connectivity is used. With several work
+ * units, the order within a level depends on the scheduling of the threads,
+ * but the set of included pixels never depends on the number of work units.
+ *
+ * \sa FloodFilledImageFunctionConditionalIterator
+ * \ingroup RegionGrowingSegmentation
+ * \ingroup ITKRegionGrowing
+ */
+template <unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT ParallelFloodFill
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelFloodFill);
+
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  using IndexType = Index<VImageDimension>;
+  using OffsetType = Offset<VImageDimension>;
+  using RegionType = ImageRegion<VImageDimension>;
+  using IndexListType = std::vector<IndexType>;
+
+  /** Create a flood fill over region. All the pixels are initially not
+   * visited. */
+  ParallelFloodFill(const RegionType &  region,
+                    bool                fullyConnected,
+                    MultiThreaderBase * multiThreader,
+                    unsigned int        numberOfWorkUnits);
+
+  ~ParallelFloodFill() = default;
+
+  /** Mark all the pixels as not visited. */
+  void
+  ClearVisited();
+
+  /** Mark the given pixels as not visited. */
+  void
+  ClearVisited(const IndexListType & indices);
+
+  /** Return true if the pixel has already been tested. */
+  bool
+  IsVisited(const IndexType & index) const;
+
+  /** Flood from the seeds.
+   *
+   * isIncluded(index) is called once for each pixel of the region reached by
+   * the flood which has not been visited yet, including the seeds. For each
+   * included pixel, visitIncluded(index) is called. It can return false to
+   * stop the flood after the current level. Both functors are called
+   * concurrently on different pixels.
+   *
+   * The included and the rejected pixels are appended to includedList and
+   * rejectedList when they are not null. progress is incremented once for
+   * each included pixel, from the calling thread.
+   *
+   * Returns false if the flood has been stopped by visitIncluded. */
+  template <typename TIsIncluded, typename TVisitIncluded>
+  bool
+  Fill(const IndexListType &  seeds,
+       const TIsIncluded &    isIncluded,
+       const TVisitIncluded & visitIncluded,
+       ProgressReporter *     progress = nullptr,
+       IndexListType *        includedList = nullptr,
+       IndexListType *        rejectedList = nullptr);
+
+private:
+  using WordType = uint32_t;
+
+  static constexpr unsigned int BitsPerWord = 32;
+
+  /** Minimum number of frontier pixels given to a work unit. */
+  static constexpr SizeValueType MinimumFrontierSizePerWorkUnit = 4096;
+
+  /** Mark the pixel as visited, and return true if it was not visited
+   * before. Only one of the threads claiming a pixel gets true. */
+  bool
+  TestAndSetVisited(const IndexType & index);
+
+  /** Call function(chunk) for each chunk, on several threads if there is
+   * more than one chunk. */
+  template <typename TFunction>
+  void
+  ParallelizeChunks(unsigned int numberOfChunks, const TFunction & function);
+
+  SizeValueType
+  ComputeOffset(const IndexType & index) const;
+
+  RegionType                         m_Region;
+  OffsetValueType                    m_OffsetTable[VImageDimension]{};
+  std::vector<OffsetType>            m_NeighborOffsets;
+  std::vector<std::atomic<WordType>> m_Visited;
+  MultiThreaderBase *                m_MultiThreader;
+  unsigned int                       m_NumberOfWorkUnits;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelFloodFill.hxx"
+#endif
+
+#endif
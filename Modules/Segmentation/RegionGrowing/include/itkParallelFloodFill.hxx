@@ -0,0 +1,262 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_hxx
+#define itkParallelFloodFill_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+template <unsigned int VImageDimension>
+ParallelFloodFill<VImageDimension>::ParallelFloodFill(const RegionType &  region,
+                                                      bool                fullyConnected,
+                                                      MultiThreaderBase * multiThreader,
+                                                      unsigned int        numberOfWorkUnits)
+  : m_Region(region)
+  , m_Visited((region.GetNumberOfPixels() + BitsPerWord - 1) / BitsPerWord)
+  , m_MultiThreader(multiThreader)
+  , m_NumberOfWorkUnits(std::max(numberOfWorkUnits, 1u))
+{
+  OffsetValueType stride = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    m_OffsetTable[i] = stride;
+    stride *= static_cast<OffsetValueType>(region.GetSize(i));
+  }
+
+  if (fullyConnected)
+  {
+    // all the neighbors in the 3x3x...x3 neighborhood, in raster order
+    OffsetType offset;
+    offset.Fill(-1);
+    for (;;)
+    {
+      if (offset != OffsetType{})
+      {
+        m_NeighborOffsets.push_back(offset);
+      }
+      unsigned int i = 0;
+      while (i < ImageDimension && offset[i] == 1)
+      {
+        offset[i] = -1;
+        ++i;
+      }
+      if (i == ImageDimension)
+      {
+        break;
+      }
+      ++offset[i];
+    }
+  }
+  else
+  {
+    // the face neighbors, in the order of FloodFilledFunctionConditionalConstIterator
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      for (const OffsetValueType j : { -1, 1 })
+      {
+        OffsetType offset{};
+        offset[i] = j;
+        m_NeighborOffsets.push_back(offset);
+      }
+    }
+  }
+
+  this->ClearVisited();
+}
+
+template <unsigned int VImageDimension>
+void
+ParallelFloodFill<VImageDimension>::ClearVisited()
+{
+  for (std::atomic<WordType> & word : m_Visited)
+  {
+    word.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+ParallelFloodFill<VImageDimension>::ClearVisited(const IndexListType & indices)
+{
+  for (const IndexType & index : indices)
+  {
+    const SizeValueType offset = this->ComputeOffset(index);
+    m_Visited[offset / BitsPerWord].fetch_and(~(WordType{ 1 } << (offset % BitsPerWord)), std::memory_order_relaxed);
+  }
+}
+
+template <unsigned int VImageDimension>
+bool
+ParallelFloodFill<VImageDimension>::IsVisited(const IndexType & index) const
+{
+  const SizeValueType offset = this->ComputeOffset(index);
+  return (m_Visited[offset / BitsPerWord].load(std::memory_order_relaxed) >> (offset % BitsPerWord)) & 1;
+}
+
+template <unsigned int VImageDimension>
+bool
+ParallelFloodFill<VImageDimension>::TestAndSetVisited(const IndexType & index)
+{
+  const SizeValueType     offset = this->ComputeOffset(index);
+  const WordType          bit = WordType{ 1 } << (offset % BitsPerWord);
+  std::atomic<WordType> & word = m_Visited[offset / BitsPerWord];
+  // the plain load avoids writing to the words of the pixels already visited
+  if (word.load(std::memory_order_relaxed) & bit)
+  {
+    return false;
+  }
+  return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+}
+
+template <unsigned int VImageDimension>
+template <typename TFunction>
+void
+ParallelFloodFill<VImageDimension>::ParallelizeChunks(unsigned int numberOfChunks, const TFunction & function)
+{
+  if (numberOfChunks <= 1)
+  {
+    // not worth the synchronization of the threads
+    function(0);
+    return;
+  }
+  m_MultiThreader->ParallelizeArray(
+    0, numberOfChunks, [&function](SizeValueType chunk) { function(static_cast<unsigned int>(chunk)); }, nullptr);
+}
+
+template <unsigned int VImageDimension>
+SizeValueType
+ParallelFloodFill<VImageDimension>::ComputeOffset(const IndexType & index) const
+{
+  OffsetValueType offset = 0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    offset += (index[i] - m_Region.GetIndex(i)) * m_OffsetTable[i];
+  }
+  return static_cast<SizeValueType>(offset);
+}
+
+template <unsigned int VImageDimension>
+template <typename TIsIncluded, typename TVisitIncluded>
+bool
+ParallelFloodFill<VImageDimension>::Fill(const IndexListType &  seeds,
+                                         const TIsIncluded &    isIncluded,
+                                         const TVisitIncluded & visitIncluded,
+                                         ProgressReporter *     progress,
+                                         IndexListType *        includedList,
+                                         IndexListType *        rejectedList)
+{
+  std::atomic<bool> stop{ false };
+
+  IndexListType frontier;
+  for (const IndexType & seed : seeds)
+  {
+    if (m_Region.IsInside(seed) && this->TestAndSetVisited(seed))
+    {
+      if (isIncluded(seed))
+      {
+        frontier.push_back(seed);
+        if (!visitIncluded(seed))
+        {
+          stop = true;
+        }
+      }
+      else if (rejectedList)
+      {
+        rejectedList->push_back(seed);
+      }
+    }
+  }
+
+  // the frontier is split in chunks which are expanded concurrently. Each
+  // unvisited neighbor is claimed in the bitmap by the work unit which sets
+  // its bit first, and is tested by that work unit. The chunks of the next
+  // frontier are concatenated in order, so the pixels are included in the
+  // order of a sequential breadth first search when the frontiers are
+  // expanded by a single work unit.
+  std::vector<IndexListType> chunkIncluded;
+  std::vector<IndexListType> chunkRejected;
+  while (!frontier.empty())
+  {
+    if (includedList)
+    {
+      includedList->insert(includedList->end(), frontier.begin(), frontier.end());
+    }
+    if (progress)
+    {
+      for (SizeValueType p = 0; p < frontier.size(); ++p)
+      {
+        progress->CompletedPixel(); // potential exception thrown here
+      }
+    }
+    if (stop)
+    {
+      return false;
+    }
+
+    const SizeValueType frontierSize = frontier.size();
+    unsigned int        numberOfChunks = static_cast<unsigned int>(
+      std::min<SizeValueType>(m_NumberOfWorkUnits, frontierSize / MinimumFrontierSizePerWorkUnit));
+    numberOfChunks = std::max(numberOfChunks, 1u);
+    chunkIncluded.resize(numberOfChunks);
+    chunkRejected.resize(numberOfChunks);
+    this->ParallelizeChunks(numberOfChunks, [&](unsigned int chunk) {
+      IndexListType & included = chunkIncluded[chunk];
+      IndexListType & rejected = chunkRejected[chunk];
+      included.clear();
+      rejected.clear();
+      const SizeValueType last = frontierSize * (chunk + 1) / numberOfChunks;
+      for (SizeValueType p = frontierSize * chunk / numberOfChunks; p < last; ++p)
+      {
+        for (const OffsetType & offset : m_NeighborOffsets)
+        {
+          const IndexType neighbor = frontier[p] + offset;
+          if (m_Region.IsInside(neighbor) && this->TestAndSetVisited(neighbor))
+          {
+            if (isIncluded(neighbor))
+            {
+              included.push_back(neighbor);
+              if (!visitIncluded(neighbor))
+              {
+                stop = true;
+              }
+            }
+            else if (rejectedList)
+            {
+              rejected.push_back(neighbor);
+            }
+          }
+        }
+      }
+    });
+
+    frontier.clear();
+    for (unsigned int chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      frontier.insert(frontier.end(), chunkIncluded[chunk].begin(), chunkIncluded[chunk].end());
+      if (rejectedList)
+      {
+        rejectedList->insert(rejectedList->end(), chunkRejected[chunk].begin(), chunkRejected[chunk].end());
+      }
+    }
+  }
+  return !stop;
+}
+} // end namespace itk
+
+#endif
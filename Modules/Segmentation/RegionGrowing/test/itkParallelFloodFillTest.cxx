@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelFloodFill.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkLexicographicCompare.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using ImageType = itk::Image<unsigned char, Dimension>;
+using FloodFillType = itk::ParallelFloodFill<Dimension>;
+using IndexListType = FloodFillType::IndexListType;
+
+// Sequential breadth first search with the face connectivity
+IndexListType
+ReferenceFloodFill(const ImageType * mask, const IndexListType & seeds)
+{
+  const auto region = mask->GetLargestPossibleRegion();
+  auto       visited = ImageType::New();
+  visited->SetRegions(region);
+  visited->AllocateInitialized();
+
+  IndexListType                        included;
+  std::queue<FloodFillType::IndexType> queue;
+  for (const auto & seed : seeds)
+  {
+    if (region.IsInside(seed) && !visited->GetPixel(seed))
+    {
+      visited->SetPixel(seed, 1);
+      if (mask->GetPixel(seed))
+      {
+        queue.push(seed);
+      }
+    }
+  }
+  while (!queue.empty())
+  {
+    const auto index = queue.front();
+    queue.pop();
+    included.push_back(index);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (const itk::IndexValueType j : { -1, 1 })
+      {
+        auto neighbor = index;
+        neighbor[i] += j;
+        if (region.IsInside(neighbor) && !visited->GetPixel(neighbor))
+        {
+          visited->SetPixel(neighbor, 1);
+          if (mask->GetPixel(neighbor))
+          {
+            queue.push(neighbor);
+          }
+        }
+      }
+    }
+  }
+  return included;
+}
+
+IndexListType
+ParallelFloodFill(const ImageType * mask, const IndexListType & seeds, bool fullyConnected, unsigned int workUnits)
+{
+  auto          multiThreader = itk::MultiThreaderBase::New();
+  FloodFillType floodFill(mask->GetLargestPossibleRegion(), fullyConnected, multiThreader, workUnits);
+  IndexListType included;
+  floodFill.Fill(
+    seeds,
+    [mask](const FloodFillType::IndexType & index) { return mask->GetPixel(index) != 0; },
+    [](const FloodFillType::IndexType &) { return true; },
+    nullptr,
+    &included);
+  return included;
+}
+
+IndexListType
+Sorted(IndexListType indices)
+{
+  std::sort(indices.begin(), indices.end(), itk::Functor::LexicographicCompare());
+  return indices;
+}
+} // namespace
+
+int
+itkParallelFloodFillTest(int, char *[])
+{
+  // a random mask large enough to give several work units to each level of
+  // the flood, seeded from a whole slice
+  auto size = ImageType::SizeType::Filled(128);
+  size[2] = 16;
+
+  auto mask = ImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  for (itk::ImageRegionIterator<ImageType> it(mask, mask->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(generator->GetVariate() < 0.6);
+  }
+
+  IndexListType seeds;
+  for (itk::IndexValueType y = 0; y < 128; ++y)
+  {
+    for (itk::IndexValueType x = 0; x < 128; ++x)
+    {
+      seeds.push_back({ { x, y, 0 } });
+    }
+  }
+
+  const IndexListType expected = ReferenceFloodFill(mask, seeds);
+
+  // with a single work unit, the pixels are included in the order of the
+  // sequential flood fill
+  if (ParallelFloodFill(mask, seeds, false, 1) != expected)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error in Fill() with 1 work unit: the pixels are included in a different order than the "
+              << expected.size() << " pixels of the sequential flood fill" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // with several work units, each pixel is claimed by a single work unit
+  const IndexListType sortedExpected = Sorted(expected);
+  for (const unsigned int workUnits : { 2, 5 })
+  {
+    const IndexListType included = ParallelFloodFill(mask, seeds, false, workUnits);
+    if (Sorted(included) != sortedExpected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in Fill() with " << workUnits << " work units: " << included.size()
+                << " pixels included instead of the " << expected.size() << " pixels of the sequential flood fill"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const IndexListType fullyConnected = Sorted(ParallelFloodFill(mask, seeds, true, 5));
+  ITK_TEST_EXPECT_EQUAL(fullyConnected == Sorted(ParallelFloodFill(mask, seeds, true, 1)), true);
+  ITK_TEST_EXPECT_EQUAL(fullyConnected.size() >= expected.size(), true);
+
+  // a flood stopped by the visitor
+  auto          multiThreader = itk::MultiThreaderBase::New();
+  FloodFillType floodFill(mask->GetLargestPossibleRegion(), false, multiThreader, 5);
+  ITK_TEST_EXPECT_TRUE(!floodFill.Fill(
+    seeds,
+    [&mask](const FloodFillType::IndexType & index) { return mask->GetPixel(index) != 0; },
+    [](const FloodFillType::IndexType & index) { return index[2] < 4; }));
+
+  // a flood resumed from its rejected pixels after a change of the predicate
+  floodFill.ClearVisited();
+  IndexListType included;
+  IndexListType rejected;
+  ITK_TEST_EXPECT_TRUE(floodFill.Fill(
+    seeds,
+    [&mask](const FloodFillType::IndexType & index) { return index[2] < 8 && mask->GetPixel(index) != 0; },
+    [](const FloodFillType::IndexType &) { return true; },
+    nullptr,
+    &included,
+    &rejected));
+
+  floodFill.ClearVisited(rejected);
+  floodFill.Fill(
+    rejected,
+    [&mask](const FloodFillType::IndexType & index) { return mask->GetPixel(index) != 0; },
+    [](const FloodFillType::IndexType &) { return true; },
+    nullptr,
+    &included);
+  ITK_TEST_EXPECT_EQUAL(included.size(), expected.size());
+  for (const auto & index : expected)
+  {
+    ITK_TEST_EXPECT_TRUE(floodFill.IsVisited(index));
+  }
+
+  floodFill.ClearVisited();
+  ITK_TEST_EXPECT_TRUE(!floodFill.IsVisited(expected.front()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
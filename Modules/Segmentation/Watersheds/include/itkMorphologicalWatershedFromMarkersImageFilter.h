@@ -19,6 +19,8 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -64,6 +66,23 @@ namespace itk
  * The morphological watershed transform algorithm is described in
  * \cite soille2004c.
  *
+ * The initialization of the hierarchical queue from the markers is run on
+ * several threads. By default, the flooding itself processes the queue in
+ * order and is single threaded, so the output does not depend on the number
+ * of work units.
+ *
+ * When TiledFlooding is on and MarkWatershedLine is off, the image is split
+ * into slabs which are flooded on several threads, and the labels are then
+ * propagated across the slab borders, where a marker of a neighbor slab
+ * reaches a pixel at a lower level, until no pixel changes. Each pixel gets
+ * the label of a marker that it is connected to by a path whose highest
+ * value is as low as possible, like with the sequential flooding, but a
+ * pixel that several markers reach at the same level may get another of
+ * these labels, so the output depends on the number of work units. With a
+ * single work unit, the output is the same as without TiledFlooding. This
+ * mode needs an additional image of the input pixel type, and one of
+ * unsigned char.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
@@ -162,6 +181,17 @@ public:
   itkGetConstReferenceMacro(MarkWatershedLine, bool);
   itkBooleanMacro(MarkWatershedLine);
   /** @ITKEndGrouping */
+
+  /**
+   * Set/Get whether the image is flooded by slabs on several threads, when
+   * MarkWatershedLine is off. The output is then not exactly the same as the
+   * sequential flooding, see the class documentation. Default is false.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(TiledFlooding, bool);
+  itkGetConstReferenceMacro(TiledFlooding, bool);
+  itkBooleanMacro(TiledFlooding);
+  /** @ITKEndGrouping */
 protected:
   MorphologicalWatershedFromMarkersImageFilter();
   ~MorphologicalWatershedFromMarkersImageFilter() override = default;
@@ -180,14 +210,27 @@ protected:
   void
   EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override;
 
-  /** The filter is single threaded. */
+  /** The init stage is multithreaded; the flooding stage is single
+   * threaded, unless TiledFlooding is on. */
   void
   GenerateData() override;
 
 private:
+  /** Return true if index1 comes before index2 in raster order. */
+  static bool
+  IndexPrecedes(const IndexType & index1, const IndexType & index2);
+
+  /** Beucher's flooding of the slabs of the image on several threads, from
+   * the queued marker pixels of each slab. */
+  void
+  FloodSlabs(const LabelImageRegionType &                                             region,
+             const std::vector<std::vector<std::pair<InputImagePixelType, IndexType>>> & seeds);
+
   bool m_FullyConnected{ false };
 
   bool m_MarkWatershedLine{ true };
+
+  bool m_TiledFlooding{ false };
 }; // end of class
 } // end namespace itk
 
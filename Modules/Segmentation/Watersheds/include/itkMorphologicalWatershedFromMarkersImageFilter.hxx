@@ -21,7 +21,11 @@
 #include <algorithm>
 #include <queue>
 #include <list>
+#include <map>
+#include <vector>
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkConstShapedNeighborhoodIterator.h"
@@ -101,34 +105,39 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
   const InputImageType * inputImage = this->GetInput();
   LabelImageType *       outputImage = this->GetOutput();
 
-  // Set up the progress reporter
-  // we can't found the exact number of pixel to process in the 2nd pass, so we
-  // use the maximum number possible.
-  ProgressReporter progress(this, 0, markerImage->GetRequestedRegion().GetNumberOfPixels() * 2);
-
   // mask and marker must have the same size
   if (markerImage->GetRequestedRegion().GetSize() != inputImage->GetRequestedRegion().GetSize())
   {
     itkExceptionMacro("Marker and input must have the same size.");
   }
 
+  const LabelImageRegionType region = markerImage->GetRequestedRegion();
+
   // FAH (in french: File d'Attente Hierarchique)
   using QueueType = std::queue<IndexType>;
   using MapType = std::map<InputImagePixelType, QueueType>;
   MapType fah;
 
+  // The init stage only depends on the marker image, so it is run on slabs
+  // of the image in parallel. Each slab collects the pixels it would have
+  // pushed in the fah, in raster order, and the slabs are appended to the fah
+  // in raster order afterward, so the fah content, and thus the output, is
+  // exactly the same as with a single thread. The flooding stage is a single
+  // ordered traversal of the fah and stays sequential.
+  using SeedType = std::pair<InputImagePixelType, IndexType>;
+  using SeedListType = std::vector<SeedType>;
+  auto               splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(region, this->GetNumberOfWorkUnits());
+  std::vector<SeedListType> seeds(numberOfSlabs);
+
   // the radius which will be used for all the shaped iterators
   constexpr auto radius = Size<ImageDimension>::Filled(1);
 
   // iterator for the marker image
   using MarkerIteratorType = ConstShapedNeighborhoodIterator<LabelImageType>;
-  typename MarkerIteratorType::ConstIterator nmIt;
-  MarkerIteratorType                         markerIt(radius, markerImage, markerImage->GetRequestedRegion());
   // add a boundary constant to avoid adding pixels on the border in the fah
   ConstantBoundaryCondition<LabelImageType> lcbc;
   lcbc.SetConstant(NumericTraits<LabelImagePixelType>::max());
-  markerIt.OverrideBoundaryCondition(&lcbc);
-  setConnectivity(&markerIt, m_FullyConnected);
 
   // iterator for the input image
   using InputIteratorType = ConstShapedNeighborhoodIterator<InputImageType>;
@@ -183,51 +192,88 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     // the overhead should be small
     statusImage->FillBuffer(false);
 
-    for (markerIt.GoToBegin(), statusIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd();
-         ++markerIt, ++outputIt)
-    {
-      const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
-      if (markerPixel != bgLabel)
-      {
-        const IndexType idx = markerIt.GetIndex();
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        LabelImageRegionType slabRegion = region;
+        splitter->GetSplit(slab, numberOfSlabs, slabRegion);
+        TotalProgressReporter slabProgress(this, region.GetNumberOfPixels(), 100, 0.5f);
 
-        // move the iterators to the right place
-        const OffsetType shift = idx - statusIt.GetIndex();
-        statusIt += shift;
-        inputIt += shift;
+        MarkerIteratorType markerIt(radius, markerImage, slabRegion);
+        markerIt.OverrideBoundaryCondition(&lcbc);
+        setConnectivity(&markerIt, m_FullyConnected);
+        typename MarkerIteratorType::ConstIterator nmIt;
 
-        // this pixel belongs to a marker
-        // mark it as already processed
-        statusIt.SetCenterPixel(true);
-        // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
-        // and increase progress because this pixel will not be used in the
-        // flooding stage.
-        progress.CompletedPixel();
+        ImageRegionIterator<LabelImageType>  oIt(outputImage, slabRegion);
+        ImageRegionIterator<StatusImageType> sIt(statusImage, slabRegion);
+        SeedListType &                       slabSeeds = seeds[slab];
 
-        // search the background pixels in the neighborhood
-        for (nmIt = markerIt.Begin(), nsIt = statusIt.Begin(), niIt = inputIt.Begin(); nmIt != markerIt.End();
-             ++nmIt, ++nsIt, ++niIt)
+        for (markerIt.GoToBegin(); !markerIt.IsAtEnd(); ++markerIt, ++oIt, ++sIt)
         {
-          if (!nsIt.Get() && nmIt.Get() == bgLabel)
+          const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+          if (markerPixel != bgLabel)
+          {
+            const IndexType idx = markerIt.GetIndex();
+
+            // this pixel belongs to a marker
+            // mark it as already processed
+            sIt.Set(true);
+            // copy it to the output image
+            oIt.Set(markerPixel);
+
+            // search the background pixels in the neighborhood
+            for (nmIt = markerIt.Begin(); nmIt != markerIt.End(); ++nmIt)
+            {
+              if (nmIt.Get() != bgLabel)
+              {
+                continue;
+              }
+              // this neighbor is a background pixel. It is added to the fah
+              // by the first marker pixel in raster order which has it in its
+              // neighborhood, so look for a marker pixel in its neighborhood
+              // which comes before the current one.
+              const IndexType bgIdx = idx + nmIt.GetNeighborhoodOffset();
+              bool            alreadyInFah = false;
+              for (const auto activeIndex : markerIt.GetActiveIndexList())
+              {
+                const IndexType nIdx = bgIdx + markerIt.GetOffset(activeIndex);
+                if (IndexPrecedes(nIdx, idx) && region.IsInside(nIdx) && markerImage->GetPixel(nIdx) != bgLabel)
+                {
+                  alreadyInFah = true;
+                  break;
+                }
+              }
+              if (!alreadyInFah)
+              {
+                // add its index to fah
+                slabSeeds.emplace_back(inputImage->GetPixel(bgIdx), bgIdx);
+                // mark it as already in the fah. No other marker pixel will
+                // try to add it, so there is no concurrent access here.
+                statusImage->SetPixel(bgIdx, true);
+              }
+            }
+          }
+          else
           {
-            // this neighbor is a background pixel and is not already
-            // processed; add its index to fah
-            fah[niIt.Get()].push(markerIt.GetIndex() + nmIt.GetNeighborhoodOffset());
-            // mark it as already in the fah to avoid adding it several times
-            nsIt.Set(true);
+            // Some pixels may be never processed so, by default, non marked pixels
+            // must be marked as watershed
+            oIt.Set(wsLabel);
           }
+          // one more pixel done in the init stage
+          slabProgress.CompletedPixel();
         }
-      }
-      else
+      },
+      nullptr);
+
+    for (const auto & slabSeeds : seeds)
+    {
+      for (const auto & seed : slabSeeds)
       {
-        // Some pixels may be never processed so, by default, non marked pixels
-        // must be marked as watershed
-        outputIt.SetCenterPixel(wsLabel);
+        fah[seed.first].push(seed.second);
       }
-      // one more pixel done in the init stage
-      progress.CompletedPixel();
     }
+    seeds.clear();
     // fill the borders of the status image with "true"
     // FillSides<StatusImageType>(statusImage, true);
     // Now disable the boundary checks
@@ -236,6 +282,11 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     // inputIt.NeedToUseBoundaryConditionOff();
     // end of init stage
 
+    // Set up the progress reporter
+    // we can't found the exact number of pixel to process in the 2nd pass, so we
+    // use the maximum number possible.
+    ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, 0.5f, 0.5f);
+
     // flooding
     // init all the iterators
     outputIt.GoToBegin();
@@ -247,7 +298,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     {
       // store the current vars
       const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
+      QueueType                 currentQueue = std::move(fah.begin()->second);
       // and remove them from the fah
       fah.erase(fah.begin());
 
@@ -326,48 +377,77 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     lcbc2.SetConstant(NumericTraits<LabelImagePixelType>::max());
     outputIt.OverrideBoundaryCondition(&lcbc2);
 
-    for (markerIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd(); ++markerIt, ++outputIt)
-    {
-      const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
-      if (markerPixel != bgLabel)
-      {
-        const IndexType  idx = markerIt.GetIndex();
-        const OffsetType shift = idx - inputIt.GetIndex();
-        inputIt += shift;
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        LabelImageRegionType slabRegion = region;
+        splitter->GetSplit(slab, numberOfSlabs, slabRegion);
+        TotalProgressReporter slabProgress(this, region.GetNumberOfPixels(), 100, 0.5f);
 
-        // this pixels belongs to a marker
-        // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
-        // search if it has background pixel in its neighborhood
-        bool haveBgNeighbor = false;
-        for (nmIt = markerIt.Begin(); nmIt != markerIt.End(); ++nmIt)
+        MarkerIteratorType markerIt(radius, markerImage, slabRegion);
+        markerIt.OverrideBoundaryCondition(&lcbc);
+        setConnectivity(&markerIt, m_FullyConnected);
+        typename MarkerIteratorType::ConstIterator nmIt;
+
+        ImageRegionIterator<LabelImageType> oIt(outputImage, slabRegion);
+        SeedListType &                      slabSeeds = seeds[slab];
+
+        for (markerIt.GoToBegin(); !markerIt.IsAtEnd(); ++markerIt, ++oIt)
         {
-          if (nmIt.Get() == bgLabel)
+          const LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+          if (markerPixel != bgLabel)
           {
-            haveBgNeighbor = true;
-            break;
+            // this pixels belongs to a marker
+            // copy it to the output image
+            oIt.Set(markerPixel);
+            // search if it has background pixel in its neighborhood
+            bool haveBgNeighbor = false;
+            for (nmIt = markerIt.Begin(); nmIt != markerIt.End(); ++nmIt)
+            {
+              if (nmIt.Get() == bgLabel)
+              {
+                haveBgNeighbor = true;
+                break;
+              }
+            }
+            if (haveBgNeighbor)
+            {
+              // there is a background pixel in the neighborhood; add to fah
+              const IndexType idx = markerIt.GetIndex();
+              slabSeeds.emplace_back(inputImage->GetPixel(idx), idx);
+            }
           }
+          else
+          {
+            oIt.Set(wsLabel);
+          }
+          slabProgress.CompletedPixel();
         }
-        if (haveBgNeighbor)
-        {
-          // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push(markerIt.GetIndex());
-        }
-        else
-        {
-          // increase progress because this pixel will not be used in the
-          // flooding stage.
-          progress.CompletedPixel();
-        }
-      }
-      else
+      },
+      nullptr);
+
+    if (m_TiledFlooding)
+    {
+      this->FloodSlabs(region, seeds);
+      return;
+    }
+
+    for (const auto & slabSeeds : seeds)
+    {
+      for (const auto & seed : slabSeeds)
       {
-        outputIt.SetCenterPixel(wsLabel);
+        fah[seed.first].push(seed.second);
       }
-      progress.CompletedPixel();
     }
+    seeds.clear();
     // end of init stage
 
+    // the pixels of the markers not in the fah are not used in the flooding
+    // stage, so the number of pixels to process is at most the number of
+    // pixels in the image.
+    ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, 0.5f, 0.5f);
+
     // flooding
     // init all the iterators
     outputIt.GoToBegin();
@@ -378,7 +458,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     {
       // store the current vars
       const InputImagePixelType currentValue = fah.begin()->first;
-      QueueType                 currentQueue = fah.begin()->second;
+      QueueType                 currentQueue = std::move(fah.begin()->second);
       // and remove them from the fah
       fah.erase(fah.begin());
 
@@ -420,6 +500,332 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
 }
 
 
+template <typename TInputImage, typename TLabelImage>
+void
+MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::FloodSlabs(
+  const LabelImageRegionType &                                                region,
+  const std::vector<std::vector<std::pair<InputImagePixelType, IndexType>>> & seeds)
+{
+  static const LabelImagePixelType wsLabel{};
+
+  const InputImageType * inputImage = this->GetInput();
+  LabelImageType *       outputImage = this->GetOutput();
+
+  // The slabs are the ones of the init stage. Each slab is flooded as with the
+  // sequential algorithm, but each pixel also records the neighbor it was
+  // reached from, its parent, and the level of that parent. The marker of
+  // another slab can then take a pixel over when it reaches it from a lower
+  // level, and the new label is passed on to the pixels reached from it.
+  auto                              splitter = ImageRegionSplitterSlowDimension::New();
+  const auto                        numberOfSlabs = static_cast<unsigned int>(seeds.size());
+  std::vector<LabelImageRegionType> slabRegions(numberOfSlabs, region);
+  for (unsigned int slab = 0; slab < numberOfSlabs; ++slab)
+  {
+    splitter->GetSplit(slab, numberOfSlabs, slabRegions[slab]);
+  }
+
+  constexpr auto radius = Size<ImageDimension>::Filled(1);
+
+  // the offsets of the neighbors, in the order of the shaped iterators, and
+  // the position of the opposite of each of them
+  ConstShapedNeighborhoodIterator<LabelImageType> neighborhoodIt(radius, outputImage, region);
+  setConnectivity(&neighborhoodIt, m_FullyConnected);
+  std::vector<typename LabelImageType::OffsetType> offsets;
+  for (const auto activeIndex : neighborhoodIt.GetActiveIndexList())
+  {
+    offsets.push_back(neighborhoodIt.GetOffset(activeIndex));
+  }
+  using ParentType = unsigned char;
+  constexpr ParentType noParent = NumericTraits<ParentType>::max();
+  if (offsets.size() >= noParent)
+  {
+    itkExceptionMacro("TiledFlooding does not support " << offsets.size() << " neighbors.");
+  }
+  std::vector<ParentType> opposites(offsets.size());
+  for (unsigned int k = 0; k < offsets.size(); ++k)
+  {
+    const auto opposite = typename LabelImageType::OffsetType{} - offsets[k];
+    opposites[k] = static_cast<ParentType>(std::find(offsets.cbegin(), offsets.cend(), opposite) - offsets.cbegin());
+  }
+
+  // the level of the parent of each pixel, which is the level of the pixel
+  // itself for the markers
+  using LevelImageType = Image<InputImagePixelType, ImageDimension>;
+  auto levelImage = LevelImageType::New();
+  levelImage->SetRegions(region);
+  levelImage->Allocate();
+
+  // the position of the parent in the offsets, noParent for the markers
+  using ParentImageType = Image<ParentType, ImageDimension>;
+  auto parentImage = ParentImageType::New();
+  parentImage->SetRegions(region);
+  parentImage->Allocate();
+
+  using QueueType = std::queue<IndexType>;
+  using MapType = std::map<InputImagePixelType, QueueType>;
+
+  // floods a slab from the pixels in the fah, without leaving the slab
+  const auto floodSlab = [&](const LabelImageRegionType & slabRegion, MapType & fah) {
+    TotalProgressReporter progress(this, region.GetNumberOfPixels(), 100, 0.5f);
+
+    using InputIteratorType = ConstShapedNeighborhoodIterator<InputImageType>;
+    InputIteratorType inputIt(radius, inputImage, region);
+    setConnectivity(&inputIt, m_FullyConnected);
+    typename InputIteratorType::ConstIterator niIt;
+
+    using OutputIteratorType = ShapedNeighborhoodIterator<LabelImageType>;
+    OutputIteratorType outputIt(radius, outputImage, region);
+    setConnectivity(&outputIt, m_FullyConnected);
+    typename OutputIteratorType::Iterator noIt;
+
+    using LevelIteratorType = ShapedNeighborhoodIterator<LevelImageType>;
+    LevelIteratorType levelIt(radius, levelImage, region);
+    setConnectivity(&levelIt, m_FullyConnected);
+    typename LevelIteratorType::Iterator nlIt;
+
+    using ParentIteratorType = ShapedNeighborhoodIterator<ParentImageType>;
+    ParentIteratorType parentIt(radius, parentImage, region);
+    setConnectivity(&parentIt, m_FullyConnected);
+    typename ParentIteratorType::Iterator npIt;
+
+    while (!fah.empty())
+    {
+      const InputImagePixelType currentValue = fah.begin()->first;
+      QueueType                 currentQueue = std::move(fah.begin()->second);
+      fah.erase(fah.begin());
+
+      while (!currentQueue.empty())
+      {
+        const IndexType idx = currentQueue.front();
+        currentQueue.pop();
+
+        const auto shift = idx - outputIt.GetIndex();
+        outputIt += shift;
+        inputIt += shift;
+        levelIt += shift;
+        parentIt += shift;
+
+        // the pixel was reached from a lower level after it was queued
+        if (std::max(inputIt.GetCenterPixel(), levelIt.GetCenterPixel()) < currentValue)
+        {
+          continue;
+        }
+
+        const LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
+        unsigned int              k = 0;
+        for (noIt = outputIt.Begin(), niIt = inputIt.Begin(), nlIt = levelIt.Begin(), npIt = parentIt.Begin();
+             noIt != outputIt.End();
+             ++noIt, ++niIt, ++nlIt, ++npIt, ++k)
+        {
+          const IndexType nIdx = idx + noIt.GetNeighborhoodOffset();
+          if (!slabRegion.IsInside(nIdx))
+          {
+            continue;
+          }
+          const LabelImagePixelType label = noIt.Get();
+          if (label == wsLabel || (npIt.Get() != noParent && currentValue < nlIt.Get()))
+          {
+            // the neighbor is reached for the first time, or from a lower
+            // level than before
+            if (label == wsLabel)
+            {
+              progress.CompletedPixel();
+            }
+            noIt.Set(currentMarker);
+            nlIt.Set(currentValue);
+            npIt.Set(opposites[k]);
+          }
+          else if (npIt.Get() == opposites[k] && label != currentMarker)
+          {
+            // the neighbor was reached from this pixel, which has a new label
+            noIt.Set(currentMarker);
+          }
+          else
+          {
+            continue;
+          }
+          const InputImagePixelType level = std::max(niIt.Get(), nlIt.Get());
+          if (level == currentValue)
+          {
+            currentQueue.push(nIdx);
+          }
+          else
+          {
+            fah[level].push(nIdx);
+          }
+        }
+      }
+    }
+  };
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      ImageRegionConstIterator<InputImageType> iIt(inputImage, slabRegions[slab]);
+      ImageRegionConstIterator<LabelImageType> oIt(outputImage, slabRegions[slab]);
+      ImageRegionIterator<LevelImageType>      lIt(levelImage, slabRegions[slab]);
+      ImageRegionIterator<ParentImageType>     pIt(parentImage, slabRegions[slab]);
+      for (; !iIt.IsAtEnd(); ++iIt, ++oIt, ++lIt, ++pIt)
+      {
+        if (oIt.Get() != wsLabel)
+        {
+          lIt.Set(iIt.Get());
+          pIt.Set(noParent);
+        }
+      }
+
+      MapType fah;
+      for (const auto & seed : seeds[slab])
+      {
+        fah[seed.first].push(seed.second);
+      }
+      floodSlab(slabRegions[slab], fah);
+    },
+    nullptr);
+
+  // The borders of the slabs are resolved in rounds: each slab first collects
+  // its border pixels which are reached from a lower level in a neighbor slab,
+  // or whose parent in a neighbor slab has a new label, and, once all the
+  // slabs are done reading, it floods again from these pixels. A pixel is
+  // only taken over from a lower level, so the rounds end.
+  struct BorderSeedType
+  {
+    IndexType           Index;
+    LabelImagePixelType Label;
+    InputImagePixelType Level;
+    ParentType          Parent;
+  };
+  std::vector<std::vector<BorderSeedType>> borderSeeds(numberOfSlabs);
+
+  // the dimension along which the image is split, which is not always the
+  // last one
+  unsigned int slabDimension = ImageDimension - 1;
+  while (slabDimension > 0 && slabRegions[0].GetSize(slabDimension) == region.GetSize(slabDimension))
+  {
+    --slabDimension;
+  }
+  while (true)
+  {
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        const LabelImageRegionType &  slabRegion = slabRegions[slab];
+        std::vector<BorderSeedType> & slabBorderSeeds = borderSeeds[slab];
+        slabBorderSeeds.clear();
+
+        // the first and the last slices of the slab, when they are not on the
+        // border of the image
+        std::vector<LabelImageRegionType> borderRegions;
+        LabelImageRegionType              borderRegion = slabRegion;
+        borderRegion.SetSize(slabDimension, 1);
+        if (slabRegion.GetIndex(slabDimension) > region.GetIndex(slabDimension))
+        {
+          borderRegions.push_back(borderRegion);
+        }
+        borderRegion.SetIndex(slabDimension, slabRegion.GetUpperIndex()[slabDimension]);
+        if (slabRegion.GetUpperIndex()[slabDimension] < region.GetUpperIndex()[slabDimension] &&
+            (borderRegions.empty() || borderRegion != borderRegions.back()))
+        {
+          borderRegions.push_back(borderRegion);
+        }
+
+        for (const auto & borderSlice : borderRegions)
+        {
+          for (ImageRegionConstIteratorWithIndex<LabelImageType> oIt(outputImage, borderSlice); !oIt.IsAtEnd();
+               ++oIt)
+          {
+            const IndexType idx = oIt.GetIndex();
+            const ParentType parent = parentImage->GetPixel(idx);
+            if (oIt.Get() != wsLabel && parent == noParent)
+            {
+              // a marker
+              continue;
+            }
+            bool           found = false;
+            BorderSeedType best{ idx, oIt.Get(), {}, parent };
+            for (unsigned int k = 0; k < offsets.size(); ++k)
+            {
+              const IndexType nIdx = idx + offsets[k];
+              if (slabRegion.IsInside(nIdx) || !region.IsInside(nIdx))
+              {
+                continue;
+              }
+              const LabelImagePixelType label = outputImage->GetPixel(nIdx);
+              if (label == wsLabel)
+              {
+                continue;
+              }
+              const InputImagePixelType level = std::max(inputImage->GetPixel(nIdx), levelImage->GetPixel(nIdx));
+              if (found ? level < best.Level : (oIt.Get() == wsLabel || level < levelImage->GetPixel(idx)))
+              {
+                best = { idx, label, level, static_cast<ParentType>(k) };
+                found = true;
+              }
+            }
+            if (!found && oIt.Get() != wsLabel && !slabRegion.IsInside(idx + offsets[parent]))
+            {
+              // the parent is in a neighbor slab, and may have a new label
+              const LabelImagePixelType parentLabel = outputImage->GetPixel(idx + offsets[parent]);
+              if (parentLabel != oIt.Get())
+              {
+                best.Label = parentLabel;
+                best.Level = levelImage->GetPixel(idx);
+                found = true;
+              }
+            }
+            if (found)
+            {
+              slabBorderSeeds.push_back(best);
+            }
+          }
+        }
+      },
+      nullptr);
+
+    if (std::all_of(borderSeeds.cbegin(), borderSeeds.cend(), [](const auto & slabBorderSeeds) {
+          return slabBorderSeeds.empty();
+        }))
+    {
+      break;
+    }
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        MapType fah;
+        for (const auto & seed : borderSeeds[slab])
+        {
+          outputImage->SetPixel(seed.Index, seed.Label);
+          levelImage->SetPixel(seed.Index, seed.Level);
+          parentImage->SetPixel(seed.Index, seed.Parent);
+          fah[std::max(inputImage->GetPixel(seed.Index), seed.Level)].push(seed.Index);
+        }
+        floodSlab(slabRegions[slab], fah);
+      },
+      nullptr);
+  }
+}
+
+
+template <typename TInputImage, typename TLabelImage>
+bool
+MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::IndexPrecedes(const IndexType & index1,
+                                                                                      const IndexType & index2)
+{
+  for (int i = ImageDimension - 1; i >= 0; --i)
+  {
+    if (index1[i] != index2[i])
+    {
+      return index1[i] < index2[i];
+    }
+  }
+  return false;
+}
+
+
 template <typename TInputImage, typename TLabelImage>
 void
 MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::PrintSelf(std::ostream & os,
@@ -429,6 +835,7 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::PrintSel
 
   itkPrintSelfBooleanMacro(FullyConnected);
   os << indent << "MarkWatershedLine: " << m_MarkWatershedLine << std::endl;
+  itkPrintSelfBooleanMacro(TiledFlooding);
 }
 
 } // end namespace itk
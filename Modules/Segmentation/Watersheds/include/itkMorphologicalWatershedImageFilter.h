@@ -104,6 +104,17 @@ public:
   itkGetConstReferenceMacro(MarkWatershedLine, bool);
   itkBooleanMacro(MarkWatershedLine);
   /** @ITKEndGrouping */
+  /**
+   * Set/Get whether the image is flooded by slabs on several threads, when
+   * MarkWatershedLine is off. See
+   * MorphologicalWatershedFromMarkersImageFilter::SetTiledFlooding(). Default
+   * is false.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(TiledFlooding, bool);
+  itkGetConstReferenceMacro(TiledFlooding, bool);
+  itkBooleanMacro(TiledFlooding);
+  /** @ITKEndGrouping */
   /**
    */
   /** @ITKStartGrouping */
@@ -136,6 +147,8 @@ private:
 
   bool m_MarkWatershedLine{ true };
 
+  bool m_TiledFlooding{ false };
+
   InputImagePixelType m_Level{};
 }; // end of class
 } // end namespace itk
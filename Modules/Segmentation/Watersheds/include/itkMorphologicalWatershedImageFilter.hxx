@@ -84,12 +84,14 @@ MorphologicalWatershedImageFilter<TInputImage, TOutputImage>::GenerateData()
   rmin->SetFullyConnected(m_FullyConnected);
   rmin->SetBackgroundValue(OutputImagePixelType{});
   rmin->SetForegroundValue(NumericTraits<OutputImagePixelType>::max());
+  rmin->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // label the components
   using ConnectedCompType = ConnectedComponentImageFilter<TOutputImage, TOutputImage>;
   auto label = ConnectedCompType::New();
   label->SetFullyConnected(m_FullyConnected);
   label->SetInput(rmin->GetOutput());
+  label->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // the watershed
   using WatershedType = MorphologicalWatershedFromMarkersImageFilter<TInputImage, TOutputImage>;
@@ -98,6 +100,8 @@ MorphologicalWatershedImageFilter<TInputImage, TOutputImage>::GenerateData()
   wshed->SetMarkerImage(label->GetOutput());
   wshed->SetFullyConnected(m_FullyConnected);
   wshed->SetMarkWatershedLine(m_MarkWatershedLine);
+  wshed->SetTiledFlooding(m_TiledFlooding);
+  wshed->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   if (m_Level != InputImagePixelType{})
   {
@@ -107,6 +111,7 @@ MorphologicalWatershedImageFilter<TInputImage, TOutputImage>::GenerateData()
     hmin->SetInput(input);
     hmin->SetHeight(m_Level);
     hmin->SetFullyConnected(m_FullyConnected);
+    hmin->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     // replace the input of the r-min filter
     rmin->SetInput(hmin->GetOutput());
 
@@ -145,6 +150,7 @@ MorphologicalWatershedImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ost
 
   itkPrintSelfBooleanMacro(FullyConnected);
   os << indent << "MarkWatershedLine: " << m_MarkWatershedLine << std::endl;
+  itkPrintSelfBooleanMacro(TiledFlooding);
   os << indent << "Level: " << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Level)
      << std::endl;
 }
@@ -21,8 +21,140 @@
 #include "itkSimpleFilterWatcher.h"
 #include "itkMorphologicalWatershedFromMarkersImageFilter.h"
 #include "itkLabelOverlayImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "itkTestingMacros.h"
 
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace
+{
+// Checks that a watershed without watershed lines is a flooding of the input
+// from the markers. Each pixel is flooded at the lowest level of the paths
+// from a marker to it, the level of a path being its highest pixel value.
+// Every pixel must be labeled, and the label of each pixel which is not a
+// marker must come from a neighbor which is flooded at the lowest level among
+// its neighbors, through a chain of such pixels down to a marker of that
+// label. Ties between markers may be resolved either way.
+template <typename TInputImage, typename TLabelImage>
+bool
+IsFlooding(const TInputImage * input, const TLabelImage * markerImage, const TLabelImage * output, bool fullyConnected)
+{
+  constexpr unsigned int Dimension = TInputImage::ImageDimension;
+  const auto             region = input->GetLargestPossibleRegion();
+  const auto             numberOfPixels = static_cast<size_t>(region.GetNumberOfPixels());
+
+  std::vector<typename TInputImage::OffsetType> offsets;
+  for (const auto & offset : itk::ZeroBasedIndexRange<Dimension>(itk::Size<Dimension>::Filled(3)))
+  {
+    typename TInputImage::OffsetType neighborOffset;
+    unsigned int                     numberOfNonZero = 0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      neighborOffset[d] = offset[d] - 1;
+      numberOfNonZero += neighborOffset[d] != 0;
+    }
+    if (numberOfNonZero > 0 && (fullyConnected || numberOfNonZero == 1))
+    {
+      offsets.push_back(neighborOffset);
+    }
+  }
+  const auto forEachNeighbor = [&](size_t pixel, const auto & function) {
+    const auto index = input->ComputeIndex(static_cast<typename TInputImage::OffsetValueType>(pixel));
+    for (const auto & offset : offsets)
+    {
+      if (region.IsInside(index + offset))
+      {
+        function(static_cast<size_t>(input->ComputeOffset(index + offset)));
+      }
+    }
+  };
+  const auto * const values = input->GetBufferPointer();
+  const auto * const markers = markerImage->GetBufferPointer();
+  const auto * const labels = output->GetBufferPointer();
+
+  // the flooding levels, by a Dijkstra search from the markers
+  using LevelType = double;
+  std::vector<LevelType> levels(numberOfPixels, std::numeric_limits<LevelType>::max());
+  using QueueItemType = std::pair<LevelType, size_t>;
+  std::priority_queue<QueueItemType, std::vector<QueueItemType>, std::greater<>> queue;
+  for (size_t pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    if (markers[pixel] != 0)
+    {
+      levels[pixel] = values[pixel];
+      queue.emplace(levels[pixel], pixel);
+    }
+  }
+  while (!queue.empty())
+  {
+    const auto [level, pixel] = queue.top();
+    queue.pop();
+    if (level > levels[pixel])
+    {
+      continue;
+    }
+    forEachNeighbor(pixel, [&, level = level](size_t neighbor) {
+      const LevelType neighborLevel = std::max(level, static_cast<LevelType>(values[neighbor]));
+      if (markers[neighbor] == 0 && neighborLevel < levels[neighbor])
+      {
+        levels[neighbor] = neighborLevel;
+        queue.emplace(neighborLevel, neighbor);
+      }
+    });
+  }
+
+  // the pixels whose label comes from a marker through neighbors flooded at
+  // the lowest level
+  std::vector<bool>  isValid(numberOfPixels, false);
+  std::queue<size_t> validPixels;
+  for (size_t pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    if (markers[pixel] != 0)
+    {
+      if (labels[pixel] != markers[pixel])
+      {
+        return false;
+      }
+      isValid[pixel] = true;
+      validPixels.push(pixel);
+    }
+  }
+  while (!validPixels.empty())
+  {
+    const size_t pixel = validPixels.front();
+    validPixels.pop();
+    forEachNeighbor(pixel, [&](size_t neighbor) {
+      if (isValid[neighbor] || labels[neighbor] != labels[pixel])
+      {
+        return;
+      }
+      LevelType lowestNeighborLevel = std::numeric_limits<LevelType>::max();
+      forEachNeighbor(neighbor, [&](size_t neighborOfNeighbor) {
+        lowestNeighborLevel = std::min(lowestNeighborLevel, levels[neighborOfNeighbor]);
+      });
+      if (levels[pixel] == lowestNeighborLevel)
+      {
+        isValid[neighbor] = true;
+        validPixels.push(neighbor);
+      }
+    });
+  }
+  for (size_t pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    if (levels[pixel] != std::numeric_limits<LevelType>::max() && (labels[pixel] == 0 || !isValid[pixel]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 
 int
 itkMorphologicalWatershedFromMarkersImageFilterTest(int argc, char * argv[])
@@ -113,6 +245,120 @@ itkMorphologicalWatershedFromMarkersImageFilterTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
 
+  // The output must not depend on the number of work units used to
+  // initialize the flooding
+  auto multiThreadedFilter = FilterType::New();
+  multiThreadedFilter->SetInput(reader->GetOutput());
+  multiThreadedFilter->SetMarkerImage(markerImage);
+  multiThreadedFilter->SetMarkWatershedLine(markWatershedLine);
+  multiThreadedFilter->SetFullyConnected(fullyConnected);
+  multiThreadedFilter->SetNumberOfWorkUnits(7);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiThreadedFilter->Update());
+
+  itk::ImageRegionConstIterator<ImageType> outputIt(filter->GetOutput(),
+                                                    filter->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> multiThreadedOutputIt(multiThreadedFilter->GetOutput(),
+                                                                 filter->GetOutput()->GetLargestPossibleRegion());
+  for (; !outputIt.IsAtEnd(); ++outputIt, ++multiThreadedOutputIt)
+  {
+    if (outputIt.Get() != multiThreadedOutputIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Output with 7 work units differs at index " << outputIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The tiled flooding gives the same output with a single work unit. With
+  // several work units, the pixels which several markers reach at the same
+  // level may get another label, but the output is still a flooding. With
+  // watershed lines, the flooding is not tiled.
+  auto tiledFilter = FilterType::New();
+  tiledFilter->SetInput(reader->GetOutput());
+  tiledFilter->SetMarkerImage(markerImage);
+  tiledFilter->SetMarkWatershedLine(markWatershedLine);
+  tiledFilter->SetFullyConnected(fullyConnected);
+  ITK_TEST_SET_GET_BOOLEAN(tiledFilter, TiledFlooding, true);
+
+  for (const unsigned int numberOfWorkUnits : { 1, 7 })
+  {
+    tiledFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(tiledFilter->Update());
+
+    if (numberOfWorkUnits == 1 || markWatershedLine)
+    {
+      itk::ImageRegionConstIterator<ImageType> tiledOutputIt(tiledFilter->GetOutput(),
+                                                             filter->GetOutput()->GetLargestPossibleRegion());
+      for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt, ++tiledOutputIt)
+      {
+        if (outputIt.Get() != tiledOutputIt.Get())
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Tiled output with " << numberOfWorkUnits << " work units differs at index "
+                    << outputIt.GetIndex() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    else if (!IsFlooding(reader->GetOutput(), markerImage.GetPointer(), tiledFilter->GetOutput(), fullyConnected))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Tiled output with " << numberOfWorkUnits << " work units is not a flooding" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!markWatershedLine &&
+      !IsFlooding(reader->GetOutput(), markerImage.GetPointer(), filter->GetOutput(), fullyConnected))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Sequential output is not a flooding" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The same on random images with few gray levels, so with many ties, and
+  // with markers whose pixels are scattered over the image
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(1);
+  for (unsigned int iteration = 0; iteration < 20; ++iteration)
+  {
+    auto randomImage = ImageType::New();
+    randomImage->SetRegions(ImageType::SizeType{ { 61, 47 } });
+    randomImage->Allocate();
+    auto randomMarkerImage = ImageType::New();
+    randomMarkerImage->SetRegions(randomImage->GetLargestPossibleRegion());
+    randomMarkerImage->Allocate();
+    const unsigned int numberOfLevels = iteration % 2 == 0 ? 4 : 256;
+    itk::ImageRegionIterator<ImageType> randomIt(randomImage, randomImage->GetLargestPossibleRegion());
+    itk::ImageRegionIterator<ImageType> randomMarkerIt(randomMarkerImage, randomImage->GetLargestPossibleRegion());
+    for (; !randomIt.IsAtEnd(); ++randomIt, ++randomMarkerIt)
+    {
+      randomIt.Set(static_cast<PixelType>(randomGenerator->GetIntegerVariate(numberOfLevels - 1)));
+      randomMarkerIt.Set(randomGenerator->GetIntegerVariate(40) == 0
+                           ? static_cast<PixelType>(1 + randomGenerator->GetIntegerVariate(4))
+                           : PixelType{});
+    }
+
+    auto randomFilter = FilterType::New();
+    randomFilter->SetInput(randomImage);
+    randomFilter->SetMarkerImage(randomMarkerImage);
+    randomFilter->SetMarkWatershedLine(false);
+    randomFilter->SetFullyConnected(fullyConnected);
+    randomFilter->SetTiledFlooding(true);
+    randomFilter->SetNumberOfWorkUnits(2 + iteration % 7);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(randomFilter->Update());
+
+    if (!IsFlooding(randomImage.GetPointer(), randomMarkerImage.GetPointer(), randomFilter->GetOutput(), fullyConnected))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Tiled output of random image " << iteration << " is not a flooding" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   if (argc > 6)
   {
     using RGBPixelType = itk::RGBPixel<PixelType>;
@@ -62,6 +62,9 @@ itkMorphologicalWatershedImageFilterTest(int argc, char * argv[])
   const bool fullyConnected = std::stoi(argv[4]);
   ITK_TEST_SET_GET_BOOLEAN(filter, FullyConnected, fullyConnected);
 
+  // the baseline is the one of the sequential flooding
+  ITK_TEST_SET_GET_BOOLEAN(filter, TiledFlooding, false);
+
   auto level = static_cast<FilterType::InputImagePixelType>(std::stod(argv[5]));
   filter->SetLevel(level);
   ITK_TEST_SET_GET_VALUE(level, filter->GetLevel());